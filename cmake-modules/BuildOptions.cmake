@@ -5,6 +5,7 @@ option(BUILD_TESTS "Build with unittests" ON)
 option(BUILD_RPC "Build RPC framework" ON)
 option(BUILD_DOC "Build documentation" OFF)
 option(BUILD_EXAMPLES "Build examples" ON)
+option(BUILD_BENCHMARKS "Build benchmarks" OFF)
 CMAKE_DEPENDENT_OPTION(WITH_PY_CLIENT "Build python client" ON "BUILD_RPC" OFF)
 CMAKE_DEPENDENT_OPTION(WITH_JAVA_CLIENT "Build java client" ON "BUILD_RPC" OFF)
 
@@ -17,4 +18,5 @@ message(STATUS "    Build java client libraries:          ${WITH_JAVA_CLIENT}")
 message(STATUS "  Build with unit tests:                  ${BUILD_TESTS}")
 message(STATUS "  Build documentation:                    ${BUILD_DOC}")
 message(STATUS "  Build examples:                         ${BUILD_EXAMPLES}")
+message(STATUS "  Build benchmarks:                       ${BUILD_BENCHMARKS}")
 message(STATUS "----------------------------------------------------------")
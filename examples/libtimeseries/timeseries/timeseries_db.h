@@ -19,24 +19,27 @@ class timeseries_db : public atomic_multilog {
   }
 
   void get_range(std::vector<record_t> &out, int64_t ts1, int64_t ts2) {
-    std::string expr = "TIMESTAMP >= " + std::to_string(ts1) + " && TIMESTAMP <= " + std::to_string(ts2);
-    for (auto r = execute_filter(expr); r->has_more(); r->advance()) {
+    for (auto r = query_time_range(static_cast<uint64_t>(ts1), static_cast<uint64_t>(ts2)); r->has_more();
+         r->advance()) {
       out.push_back(r->get());
     }
   }
 
+  void get_downsampled(std::vector<numeric> &out, const std::string &aggregate_expr, int64_t ts1, int64_t ts2,
+                       uint64_t interval) {
+    out = execute_aggregate_series(aggregate_expr, "", static_cast<uint64_t>(ts1), static_cast<uint64_t>(ts2),
+                                   interval);
+  }
+
   record_t get_nearest_value(int64_t ts, bool direction) {
-    std::string op;
+    std::unique_ptr<record_cursor> r;
     if (direction) {
-      op = ">";
-    } else {
-      op = "<";
+      r = query_time_range(static_cast<uint64_t>(ts) + 1, limits::ulong_max);
+    } else if (ts > 0) {
+      r = query_time_range(0, static_cast<uint64_t>(ts) - 1, true);
     }
 
-    std::string exp = "TIMESTAMP " + op + " " + std::to_string(ts);
-    auto r = execute_filter(exp);
-
-    if (r->has_more()) {
+    if (r != nullptr && r->has_more()) {
       return r->get();
     } else {
       return record_t();
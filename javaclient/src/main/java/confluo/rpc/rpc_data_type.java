@@ -21,6 +21,7 @@ public enum rpc_data_type implements org.apache.thrift.TEnum {
   RPC_FLOAT(10),
   RPC_DOUBLE(11),
   RPC_STRING(12),
+  RPC_VARCHAR(10000),
   RPC_RECORD(10001),
   RPC_ALERT(10002);
 
@@ -69,6 +70,8 @@ public enum rpc_data_type implements org.apache.thrift.TEnum {
         return RPC_DOUBLE;
       case 12:
         return RPC_STRING;
+      case 10000:
+        return RPC_VARCHAR;
       case 10001:
         return RPC_RECORD;
       case 10002:
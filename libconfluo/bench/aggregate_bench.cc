@@ -0,0 +1,88 @@
+#include "atomic_multilog.h"
+#include "cmd_parse.h"
+
+using namespace ::confluo;
+using namespace ::utils;
+
+/**
+ * Measures batched append throughput into a multilog whose filter carries
+ * many aggregates.
+ */
+
+/** A record with one column of each aggregated type */
+struct bench_rec {
+  int64_t ts;
+  int32_t a;
+  int64_t b;
+  double c;
+}__attribute__((packed));
+
+int main(int argc, char **argv) {
+  cmd_options opts;
+  opts.add(cmd_option("num-batches", 'n', false).set_default("2000").set_description("Number of batches to append"));
+  opts.add(cmd_option("batch-size", 'b', false).set_default("1024").set_description("Number of records per batch"));
+  opts.add(cmd_option("data-path", 'd', false).set_default("/tmp/aggregate_bench")
+                                              .set_description("Data path for the multilog"));
+
+  cmd_parser parser(argc, argv, opts);
+  if (parser.get_flag("help")) {
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  size_t num_batches;
+  size_t batch_size;
+  std::string data_path;
+  try {
+    num_batches = static_cast<size_t>(parser.get_long("num-batches"));
+    batch_size = static_cast<size_t>(parser.get_long("batch-size"));
+    data_path = parser.get("data-path");
+  } catch (std::exception &e) {
+    fprintf(stderr, "could not parse cmdline args: %s\n", e.what());
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  thread_manager::register_thread();
+  task_pool pool;
+  file_utils::clear_dir(data_path);
+  file_utils::create_dir(data_path);
+  auto schema = schema_builder()
+      .add_column(primitive_types::INT_TYPE(), "a")
+      .add_column(primitive_types::LONG_TYPE(), "b")
+      .add_column(primitive_types::DOUBLE_TYPE(), "c")
+      .get_columns();
+  atomic_multilog mlog("bench", schema, data_path, storage::IN_MEMORY, archival_mode::OFF, pool);
+
+  mlog.add_filter("all", "a >= 0");
+  size_t num_aggregates = 0;
+  for (const char *agg : {"SUM", "MIN", "MAX", "COUNT"}) {
+    for (const char *col : {"a", "b", "c"}) {
+      std::string expr = std::string(agg) + "(" + col + ")";
+      mlog.add_aggregate(std::string(agg) + "_" + col, "all", expr);
+      num_aggregates++;
+    }
+  }
+
+  std::vector<record_batch> batches;
+  int64_t ts = time_utils::cur_ns();
+  for (size_t i = 0; i < 16; i++) {
+    record_batch_builder builder = mlog.get_batch_builder();
+    for (size_t j = 0; j < batch_size; j++) {
+      bench_rec r = {ts, static_cast<int32_t>(j), static_cast<int64_t>(i * j), static_cast<double>(j) / 3};
+      builder.add_record(&r);
+    }
+    batches.push_back(builder.get_batch());
+  }
+
+  uint64_t start = time_utils::cur_ns();
+  for (size_t i = 0; i < num_batches; i++)
+    mlog.append_batch(batches[i % batches.size()]);
+  uint64_t end = time_utils::cur_ns();
+
+  double secs = static_cast<double>(end - start) / 1e9;
+  fprintf(stdout, "%zu aggregates: %.0f records/s\n", num_aggregates, num_batches * batch_size / secs);
+
+  thread_manager::deregister_thread();
+  return 0;
+}
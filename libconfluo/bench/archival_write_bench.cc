@@ -0,0 +1,85 @@
+#include <ftw.h>
+
+#include "atomic_multilog.h"
+#include "cmd_parse.h"
+
+using namespace ::confluo;
+using namespace ::utils;
+
+/**
+ * Measures archival write throughput: the time to archive the data log,
+ * filter and index of a multilog to disk, and the bytes written per second.
+ */
+
+/** A 64-byte record */
+struct bench_rec {
+  int64_t ts;
+  int64_t a;
+  char b[48];
+}__attribute__((packed));
+
+static size_t dir_bytes;
+
+static int add_file_size(const char *, const struct stat *sb, int typeflag) {
+  if (typeflag == FTW_F)
+    dir_bytes += static_cast<size_t>(sb->st_size);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  cmd_options opts;
+  opts.add(cmd_option("num-records", 'n', false).set_default("2000000").set_description("Number of records to archive"));
+  opts.add(cmd_option("data-path", 'd', false).set_default("/tmp/archival_write_bench")
+                                              .set_description("Data path for the multilog"));
+
+  cmd_parser parser(argc, argv, opts);
+  if (parser.get_flag("help")) {
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  size_t num_records;
+  std::string data_path;
+  try {
+    num_records = static_cast<size_t>(parser.get_long("num-records"));
+    data_path = parser.get("data-path");
+  } catch (std::exception &e) {
+    fprintf(stderr, "could not parse cmdline args: %s\n", e.what());
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  thread_manager::register_thread();
+  task_pool pool;
+  file_utils::clear_dir(data_path);
+  file_utils::create_dir(data_path);
+  auto schema = schema_builder()
+      .add_column(primitive_types::LONG_TYPE(), "a")
+      .add_column(primitive_types::STRING_TYPE(48), "b")
+      .get_columns();
+  atomic_multilog mlog("bench", schema, data_path, storage::IN_MEMORY, archival_mode::OFF, pool);
+  mlog.add_index("a");
+  mlog.add_filter("high", "a > 50000");
+
+  // Many distinct keys and time blocks yield many small reflog buckets
+  bench_rec r;
+  memset(&r, 'x', sizeof(r));
+  for (size_t i = 0; i < num_records; i++) {
+    r.ts = static_cast<int64_t>(i * 1000);
+    r.a = static_cast<int64_t>(i % 100000);
+    mlog.append(&r);
+  }
+
+  uint64_t start = time_utils::cur_ns();
+  mlog.archive();
+  uint64_t end = time_utils::cur_ns();
+
+  dir_bytes = 0;
+  ftw(data_path.c_str(), add_file_size, 16);
+  double elapsed_s = static_cast<double>(end - start) / 1e9;
+  fprintf(stdout, "archived %zu records in %.3f s: %zu bytes written, %.1f MB/s\n", num_records, elapsed_s,
+          dir_bytes, static_cast<double>(dir_bytes) / (1024 * 1024) / elapsed_s);
+
+  thread_manager::deregister_thread();
+  return 0;
+}
@@ -0,0 +1,105 @@
+#include <random>
+
+#include "atomic_multilog.h"
+#include "cmd_parse.h"
+#include "container/data_log.h"
+
+using namespace ::confluo;
+using namespace ::utils;
+
+/**
+ * Measures the latency of single-record reads from archived (encoded) and
+ * in-memory data log buckets.
+ */
+
+/** A 108-byte record */
+struct bench_rec {
+  int64_t ts;
+  int64_t a;
+  double b;
+  char c[84];
+}__attribute__((packed));
+
+static double read_latency_ns(const atomic_multilog &mlog, const std::vector<uint64_t> &offsets, bool raw) {
+  std::vector<uint8_t> buf(mlog.record_size());
+  size_t checksum = 0;
+  uint64_t start = time_utils::cur_ns();
+  for (uint64_t off : offsets) {
+    if (raw) {
+      mlog.read_raw(off, buf.data());
+      checksum += buf[sizeof(int64_t)];
+    } else {
+      checksum += mlog.read(off).size();
+    }
+  }
+  uint64_t end = time_utils::cur_ns();
+  if (checksum == 0)
+    fprintf(stderr, "No records read\n");
+  return static_cast<double>(end - start) / offsets.size();
+}
+
+int main(int argc, char **argv) {
+  cmd_options opts;
+  opts.add(cmd_option("num-reads", 'n', false).set_default("10000").set_description("Number of reads to time"));
+  opts.add(cmd_option("data-path", 'd', false).set_default("/tmp/archived_read_bench")
+                                              .set_description("Data path for the multilog"));
+
+  cmd_parser parser(argc, argv, opts);
+  if (parser.get_flag("help")) {
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  size_t num_reads;
+  std::string data_path;
+  try {
+    num_reads = static_cast<size_t>(parser.get_long("num-reads"));
+    data_path = parser.get("data-path");
+  } catch (std::exception &e) {
+    fprintf(stderr, "could not parse cmdline args: %s\n", e.what());
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  thread_manager::register_thread();
+  task_pool pool;
+  file_utils::clear_dir(data_path);
+  file_utils::create_dir(data_path);
+  auto schema = schema_builder()
+      .add_column(primitive_types::LONG_TYPE(), "a")
+      .add_column(primitive_types::DOUBLE_TYPE(), "b")
+      .add_column(primitive_types::STRING_TYPE(84), "c")
+      .get_columns();
+  atomic_multilog mlog("bench", schema, data_path, storage::IN_MEMORY, archival_mode::OFF, pool);
+
+  // Fill two data log buckets, and archive the first
+  const size_t bucket_size = data_log_constants::BUCKET_SIZE;
+  size_t nrecords = 2 * bucket_size / mlog.record_size();
+  bench_rec r;
+  memset(&r, 'x', sizeof(r));
+  for (size_t i = 0; i < nrecords; i++) {
+    r.ts = time_utils::cur_ns();
+    r.a = static_cast<int64_t>(i);
+    r.b = static_cast<double>(i);
+    mlog.append(&r);
+  }
+  mlog.archive(bucket_size);
+
+  std::mt19937_64 gen(0);
+  size_t records_per_bucket = bucket_size / mlog.record_size();
+  std::uniform_int_distribution<size_t> archived(0, records_per_bucket - 2);
+  std::uniform_int_distribution<size_t> in_memory(records_per_bucket + 1, nrecords - 1);
+  std::vector<uint64_t> archived_offsets, in_memory_offsets;
+  for (size_t i = 0; i < num_reads; i++) {
+    archived_offsets.push_back(archived(gen) * mlog.record_size());
+    in_memory_offsets.push_back(in_memory(gen) * mlog.record_size());
+  }
+
+  fprintf(stdout, "read (archived):      %.1f ns/op\n", read_latency_ns(mlog, archived_offsets, false));
+  fprintf(stdout, "read_raw (archived):  %.1f ns/op\n", read_latency_ns(mlog, archived_offsets, true));
+  fprintf(stdout, "read (in-memory):     %.1f ns/op\n", read_latency_ns(mlog, in_memory_offsets, false));
+  fprintf(stdout, "read_raw (in-memory): %.1f ns/op\n", read_latency_ns(mlog, in_memory_offsets, true));
+
+  thread_manager::deregister_thread();
+  return 0;
+}
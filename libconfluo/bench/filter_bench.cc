@@ -0,0 +1,83 @@
+#include "cmd_parse.h"
+#include "parser/adaptive_expression.h"
+#include "parser/expression_compiler.h"
+#include "time_utils.h"
+
+using namespace ::confluo;
+using namespace ::confluo::parser;
+using namespace ::utils;
+
+/**
+ * Measures filter evaluation throughput on skewed data, where the
+ * predicate estimated to be most selective passes on nearly every record,
+ * with the statically ordered and the adaptive evaluation orders.
+ */
+
+/** A record whose fields are tested by the filter */
+struct bench_rec {
+  int64_t ts;
+  bool a;
+  int32_t b;
+  int64_t c;
+  double d;
+}__attribute__((packed));
+
+template<typename expression>
+static double records_per_sec(expression &e, const schema_snapshot &snap, std::vector<bench_rec> &recs,
+                              size_t num_passes) {
+  size_t matches = 0;
+  uint64_t start = time_utils::cur_ns();
+  for (size_t p = 0; p < num_passes; p++)
+    for (auto &r : recs)
+      matches += e.test(snap, &r);
+  uint64_t end = time_utils::cur_ns();
+  if (matches == 0)
+    fprintf(stderr, "No records matched\n");
+  return static_cast<double>(num_passes * recs.size()) / (static_cast<double>(end - start) / 1e9);
+}
+
+int main(int argc, char **argv) {
+  cmd_options opts;
+  opts.add(cmd_option("num-records", 'n', false).set_default("65536").set_description("Number of distinct records"));
+  opts.add(cmd_option("num-passes", 'p', false).set_default("100").set_description("Passes over the records"));
+
+  cmd_parser parser(argc, argv, opts);
+  if (parser.get_flag("help")) {
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  size_t num_records;
+  size_t num_passes;
+  try {
+    num_records = static_cast<size_t>(parser.get_long("num-records"));
+    num_passes = static_cast<size_t>(parser.get_long("num-passes"));
+  } catch (std::exception &e) {
+    fprintf(stderr, "could not parse cmdline args: %s\n", e.what());
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  auto schema = schema_t(schema_builder()
+                             .add_column(primitive_types::BOOL_TYPE(), "a")
+                             .add_column(primitive_types::INT_TYPE(), "b")
+                             .add_column(primitive_types::LONG_TYPE(), "c")
+                             .add_column(primitive_types::DOUBLE_TYPE(), "d")
+                             .get_columns());
+  auto snap = schema.snapshot();
+
+  // The equalities pass on every record; only 1% of records have b > 100
+  std::vector<bench_rec> recs(num_records);
+  for (size_t i = 0; i < num_records; i++)
+    recs[i] = {0, true, i % 100 == 0 ? 101 : 0, 7, 0.5};
+
+  std::string expr = "a == true && c == 7 && d < 1.0 && b > 100";
+  compiled_expression cexpr = compile_expression(parse_expression(expr), schema);
+  adaptive_expression aexpr(cexpr);
+
+  double static_rate = records_per_sec(cexpr, snap, recs, num_passes);
+  double adaptive_rate = records_per_sec(aexpr, snap, recs, num_passes);
+  fprintf(stdout, "static:   %.0f records/s\n", static_rate);
+  fprintf(stdout, "adaptive: %.0f records/s (%zu reorders)\n", adaptive_rate, aexpr.num_reorders());
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include <thread>
+
+#include "cmd_parse.h"
+#include "partitioned_multilog.h"
+#include "time_utils.h"
+
+using namespace ::confluo;
+using namespace ::utils;
+
+/**
+ * Measures append throughput of a partitioned multilog as the number of
+ * partitions grows: a fixed number of writer threads append records
+ * round-robin across 1, 2, 4, ... partitions.
+ */
+
+/** A fixed-length record */
+struct bench_rec {
+  int64_t ts;
+  int64_t a;
+  int64_t b;
+  double c;
+}__attribute__((packed));
+
+static double run(size_t num_partitions, size_t num_threads, size_t num_records, size_t batch_size) {
+  task_pool pool;
+  std::string path = "/tmp/partitioned_ingest_bench/" + std::to_string(num_partitions);
+  file_utils::create_dir(path);
+  partitioned_multilog mlog("bench", schema_builder()
+                                         .add_column(primitive_types::LONG_TYPE(), "a")
+                                         .add_column(primitive_types::LONG_TYPE(), "b")
+                                         .add_column(primitive_types::DOUBLE_TYPE(), "c")
+                                         .get_columns(), num_partitions, "", path, storage::IN_MEMORY,
+                            archival_mode::OFF, pool);
+
+  size_t per_thread = num_records / num_threads;
+  std::vector<std::thread> workers;
+  uint64_t start = time_utils::cur_ns();
+  for (size_t t = 0; t < num_threads; t++) {
+    workers.push_back(std::thread([&mlog, t, per_thread, batch_size] {
+      thread_manager::register_thread();
+      for (size_t i = 0; i < per_thread; i += batch_size) {
+        size_t n = std::min(batch_size, per_thread - i);
+        int64_t ts = static_cast<int64_t>(time_utils::cur_ns());
+        if (n == 1) {
+          bench_rec r = {ts, static_cast<int64_t>(i), static_cast<int64_t>(t), 0.5};
+          mlog.append(&r);
+          continue;
+        }
+        record_batch_builder builder = mlog.get_batch_builder();
+        for (size_t j = 0; j < n; j++) {
+          bench_rec r = {ts, static_cast<int64_t>(i + j), static_cast<int64_t>(t), 0.5};
+          builder.add_record(&r);
+        }
+        record_batch batch = builder.get_batch();
+        mlog.append_batch(batch);
+      }
+      thread_manager::deregister_thread();
+    }));
+  }
+  for (auto &w : workers)
+    w.join();
+  uint64_t end = time_utils::cur_ns();
+  return static_cast<double>(mlog.num_records()) / (static_cast<double>(end - start) / 1e9);
+}
+
+int main(int argc, char **argv) {
+  cmd_options opts;
+  opts.add(cmd_option("num-records", 'n', false).set_default("4000000").set_description("Number of records"));
+  opts.add(cmd_option("num-threads", 't', false).set_default("4").set_description("Number of writer threads"));
+  opts.add(cmd_option("max-partitions", 'p', false).set_default("8").set_description("Largest partition count"));
+  opts.add(cmd_option("batch-size", 'b', false).set_default("1").set_description("Records per append"));
+
+  cmd_parser parser(argc, argv, opts);
+  if (parser.get_flag("help")) {
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  size_t num_records;
+  size_t num_threads;
+  size_t max_partitions;
+  size_t batch_size;
+  try {
+    num_records = static_cast<size_t>(parser.get_long("num-records"));
+    num_threads = static_cast<size_t>(parser.get_long("num-threads"));
+    max_partitions = static_cast<size_t>(parser.get_long("max-partitions"));
+    batch_size = static_cast<size_t>(parser.get_long("batch-size"));
+  } catch (std::exception &e) {
+    fprintf(stderr, "could not parse cmdline args: %s\n", e.what());
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  thread_manager::register_thread();
+  fprintf(stdout, "partitions\trecords/s\n");
+  for (size_t p = 1; p <= max_partitions; p *= 2)
+    fprintf(stdout, "%zu\t%.0f\n", p, run(p, num_threads, num_records, batch_size));
+  thread_manager::deregister_thread();
+  return 0;
+}
@@ -0,0 +1,83 @@
+#include <thread>
+
+#include "cmd_parse.h"
+#include "atomic_multilog.h"
+#include "ingest/shm_ingest.h"
+#include "ingest/shm_ring.h"
+#include "time_utils.h"
+
+using namespace ::confluo;
+using namespace ::confluo::ingest;
+using namespace ::utils;
+
+/**
+ * Measures end-to-end ingest throughput through a shared-memory ring: a
+ * producer thread writes batches of records into the ring while the
+ * drain thread appends them to an atomic multilog.
+ */
+
+/** A fixed-length record */
+struct bench_rec {
+  int64_t ts;
+  int64_t a;
+  int64_t b;
+  double c;
+}__attribute__((packed));
+
+int main(int argc, char **argv) {
+  cmd_options opts;
+  opts.add(cmd_option("num-records", 'n', false).set_default("10000000").set_description("Number of records"));
+  opts.add(cmd_option("batch-size", 'b', false).set_default("64").set_description("Records per producer write"));
+  opts.add(cmd_option("ring-path", 'r', false).set_default("/dev/shm/confluo_bench").set_description("Ring file"));
+
+  cmd_parser parser(argc, argv, opts);
+  if (parser.get_flag("help")) {
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  size_t num_records;
+  size_t batch_size;
+  std::string ring_path;
+  try {
+    num_records = static_cast<size_t>(parser.get_long("num-records"));
+    batch_size = static_cast<size_t>(parser.get_long("batch-size"));
+    ring_path = parser.get("ring-path");
+  } catch (std::exception &e) {
+    fprintf(stderr, "could not parse cmdline args: %s\n", e.what());
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  task_pool pool;
+  atomic_multilog mlog("bench", schema_builder()
+                                    .add_column(primitive_types::LONG_TYPE(), "a")
+                                    .add_column(primitive_types::LONG_TYPE(), "b")
+                                    .add_column(primitive_types::DOUBLE_TYPE(), "c")
+                                    .get_columns(), "/tmp", storage::IN_MEMORY, archival_mode::OFF, pool);
+  shm_ingest in(&mlog, ring_path);
+  in.start();
+
+  uint64_t start = time_utils::cur_ns();
+  std::thread producer([&]() {
+    shm_ring ring = shm_ring::attach(ring_path, sizeof(bench_rec));
+    std::vector<bench_rec> batch(batch_size);
+    for (size_t i = 0; i < num_records; i += batch_size) {
+      size_t n = std::min(batch_size, num_records - i);
+      int64_t ts = static_cast<int64_t>(time_utils::cur_ns());
+      for (size_t j = 0; j < n; j++)
+        batch[j] = {ts, static_cast<int64_t>(i + j), static_cast<int64_t>(j), 0.5};
+      ring.write(batch.data(), n);
+    }
+  });
+  producer.join();
+  uint64_t produced = time_utils::cur_ns();
+  in.stop();
+  uint64_t end = time_utils::cur_ns();
+
+  fprintf(stdout, "produce: %.0f records/s\n",
+          static_cast<double>(num_records) / (static_cast<double>(produced - start) / 1e9));
+  fprintf(stdout, "ingest:  %.0f records/s (%zu records)\n",
+          static_cast<double>(in.num_ingested()) / (static_cast<double>(end - start) / 1e9), mlog.num_records());
+  return 0;
+}
@@ -116,6 +116,13 @@ class aggregate_list {
    */
   numeric get(uint64_t version) const;
 
+  /**
+   * Get the most recently updated aggregate value, regardless of version.
+   *
+   * @return The aggregate value.
+   */
+  numeric latest() const;
+
   /**
    * Update the aggregate value with given version, using the combine operator.
    *
@@ -147,7 +154,31 @@ class aggregate_list {
 };
 
 /**
- * A summary of the data
+ * The aggregate list of a single thread
+ */
+struct aggregate_slot {
+  /**
+   * Constructs an empty slot for a thread
+   *
+   * @param thread_id The identifier of the thread
+   * @param type The type of the aggregate
+   * @param agg The aggregator
+   * @param next The next slot
+   */
+  aggregate_slot(int thread_id, const data_type &type, const aggregator &agg, aggregate_slot *next);
+
+  /** The identifier of the thread that updates the slot */
+  int thread_id;
+  /** The versioned aggregates of the thread */
+  aggregate_list list;
+  /** The next slot */
+  aggregate_slot *next;
+};
+
+/**
+ * A summary of the data. Each thread that updates the aggregate gets its
+ * own aggregate list, allocated on its first update; reads combine the
+ * lists of the threads that have updated it.
  */
 class aggregate {
  public:
@@ -161,9 +192,8 @@ class aggregate {
    *
    * @param type The type of the aggregate
    * @param agg The aggregate to initialize
-   * @param concurrency Max number of threads to run
    */
-  aggregate(const data_type &type, aggregator agg, int concurrency = thread_manager::get_max_concurrency());
+  aggregate(const data_type &type, aggregator agg);
 
   /**
    * Initializes an aggregate from another aggregate
@@ -229,11 +259,48 @@ class aggregate {
    */
   numeric get(uint64_t version) const;
 
+  /**
+   * Gets the aggregate including every update made so far, visible or
+   * not; combines the latest value of each thread without walking the
+   * version history
+   *
+   * @return Numeric representing the aggregated value
+   */
+  numeric latest() const;
+
+  /**
+   * Gets the number of threads that have updated the aggregate
+   *
+   * @return The number of per-thread slots
+   */
+  size_t num_slots() const;
+
  private:
+  /**
+   * Gets the slot of a thread, adding it if the thread has not updated the
+   * aggregate before
+   *
+   * @param thread_id The identifier for the thread
+   *
+   * @return The aggregate list of the thread
+   */
+  aggregate_list &slot(int thread_id);
+
+  /**
+   * Copies the slots of another aggregate
+   *
+   * @param other The other aggregate
+   */
+  void copy_slots(const aggregate &other);
+
+  /**
+   * Deallocates all slots
+   */
+  void free_slots();
+
   data_type type_;
   aggregator agg_;
-  aggregate_list *aggs_;
-  int concurrency_;
+  atomic::type<aggregate_slot *> slots_;
 };
 
 }
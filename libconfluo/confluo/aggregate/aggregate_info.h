@@ -3,6 +3,7 @@
 
 #include <utility>
 #include <utility>
+#include "aggregate/aggregate_kernel.h"
 #include "types/data_type.h"
 #include "parser/aggregate_parser.h"
 #include "trigger_log.h"
@@ -25,6 +26,19 @@ class aggregate_info {
    */
   aggregate_info(std::string name, aggregator agg, uint16_t field_idx);
 
+  /**
+   * Constructor to initialize aggregate_info with a kernel specialized to
+   * the type of the field, used for batched updates
+   *
+   * @param name The name of the aggregate.
+   * @param agg The aggregator.
+   * @param field_idx Index of field in schema.
+   * @param field_type The type of the field.
+   * @param field_offset The offset of the field in the record.
+   */
+  aggregate_info(std::string name, aggregator agg, uint16_t field_idx, const data_type &field_type,
+                 size_t field_offset);
+
   /**
    * Get the aggregate name
    * @return Aggregate name.
@@ -37,6 +51,12 @@ class aggregate_info {
    */
   data_type result_type() const;
 
+  /**
+   * Gets the aggregator, e.g., SUM, that combines values
+   * @return The aggregator
+   */
+  const aggregator &get_aggregator() const;
+
   /**
    * Gets the field index
    * @return The field index
@@ -84,6 +104,15 @@ class aggregate_info {
    */
   numeric seq_op(const numeric &a, const numeric &b);
 
+  /**
+   * Aggregates the field over a batch of records.
+   * @param s The snapshot of the schema
+   * @param records Pointers to the records
+   * @param n The number of records
+   * @return The aggregate of the records
+   */
+  numeric batch_op(const schema_snapshot &s, uint8_t *const *records, size_t n);
+
   /**
    * Returns the zero value for the aggregate
    * @return Zero value for the aggregate
@@ -136,15 +165,24 @@ class aggregate_info {
    */
   size_t num_triggers() const;
 
+  /**
+   * Checks whether any valid trigger on this aggregate is evaluated on
+   * the ingest path.
+   * @return True if the aggregate has eager triggers, false otherwise.
+   */
+  bool has_eager_triggers() const;
+
  private:
   std::string name_;
 
   // Parsed information
   aggregator agg_;
   uint16_t field_idx_;
+  std::unique_ptr<aggregate_kernel> kernel_;
 
   // Other metadata
   trigger_log triggers_;
+  atomic::type<size_t> num_eager_triggers_;
   atomic::type<bool> is_valid_;
 };
 
@@ -0,0 +1,171 @@
+#ifndef CONFLUO_AGGREGATE_AGGREGATE_KERNEL_H_
+#define CONFLUO_AGGREGATE_AGGREGATE_KERNEL_H_
+
+#include <memory>
+
+#include "aggregate_ops.h"
+#include "types/data_type.h"
+#include "types/numeric.h"
+
+namespace confluo {
+
+/**
+ * Aggregates a field over a batch of records. Kernels for the standard
+ * aggregators read the field in its raw type and accumulate in the
+ * aggregator's result type, so that no numeric is created per record.
+ */
+class aggregate_kernel {
+ public:
+  /**
+   * Destructor
+   */
+  virtual ~aggregate_kernel() = default;
+
+  /**
+   * Aggregates the field over a batch of records
+   *
+   * @param records Pointers to the records
+   * @param n The number of records; must be greater than zero
+   *
+   * @return The aggregate of the records, of the aggregator's result type
+   */
+  virtual numeric apply(uint8_t *const *records, size_t n) const = 0;
+};
+
+/**
+ * Kernel for the sum aggregator
+ *
+ * @tparam T The type of the field
+ */
+template<typename T>
+class sum_kernel : public aggregate_kernel {
+ public:
+  /**
+   * Constructs a sum kernel
+   *
+   * @param offset The offset of the field in the record
+   */
+  explicit sum_kernel(size_t offset)
+      : offset_(offset) {
+  }
+
+  numeric apply(uint8_t *const *records, size_t n) const override {
+    double acc = 0;
+    for (size_t i = 0; i < n; i++)
+      acc += static_cast<double>(*reinterpret_cast<const T *>(records[i] + offset_));
+    return numeric(acc);
+  }
+
+ private:
+  size_t offset_;
+};
+
+/**
+ * Kernel for the min aggregator
+ *
+ * @tparam T The type of the field
+ */
+template<typename T>
+class min_kernel : public aggregate_kernel {
+ public:
+  /**
+   * Constructs a min kernel
+   *
+   * @param offset The offset of the field in the record
+   */
+  explicit min_kernel(size_t offset)
+      : offset_(offset) {
+  }
+
+  numeric apply(uint8_t *const *records, size_t n) const override {
+    double acc = aggregators::min_aggregator().zero.as<double>();
+    for (size_t i = 0; i < n; i++) {
+      double v = static_cast<double>(*reinterpret_cast<const T *>(records[i] + offset_));
+      acc = acc < v ? acc : v;
+    }
+    return numeric(acc);
+  }
+
+ private:
+  size_t offset_;
+};
+
+/**
+ * Kernel for the max aggregator
+ *
+ * @tparam T The type of the field
+ */
+template<typename T>
+class max_kernel : public aggregate_kernel {
+ public:
+  /**
+   * Constructs a max kernel
+   *
+   * @param offset The offset of the field in the record
+   */
+  explicit max_kernel(size_t offset)
+      : offset_(offset) {
+  }
+
+  numeric apply(uint8_t *const *records, size_t n) const override {
+    double acc = aggregators::max_aggregator().zero.as<double>();
+    for (size_t i = 0; i < n; i++) {
+      double v = static_cast<double>(*reinterpret_cast<const T *>(records[i] + offset_));
+      acc = acc < v ? v : acc;
+    }
+    return numeric(acc);
+  }
+
+ private:
+  size_t offset_;
+};
+
+/**
+ * Kernel for the count aggregator
+ */
+class count_kernel : public aggregate_kernel {
+ public:
+  numeric apply(uint8_t *const *records, size_t n) const override {
+    return numeric(static_cast<uint64_t>(n));
+  }
+};
+
+/**
+ * Kernel for any aggregator and field type, which applies the
+ * aggregator's sequential operator on numerics
+ */
+class generic_kernel : public aggregate_kernel {
+ public:
+  /**
+   * Constructs a generic kernel
+   *
+   * @param agg The aggregator
+   * @param type The type of the field
+   * @param offset The offset of the field in the record
+   */
+  generic_kernel(const aggregator &agg, const data_type &type, size_t offset);
+
+  numeric apply(uint8_t *const *records, size_t n) const override;
+
+ private:
+  aggregator agg_;
+  data_type type_;
+  size_t offset_;
+};
+
+/**
+ * Creates the kernel for an aggregator on a field: a typed kernel for the
+ * sum, min, max and count aggregators on int, long and double fields,
+ * and a generic kernel otherwise
+ *
+ * @param agg The aggregator
+ * @param type The type of the field
+ * @param offset The offset of the field in the record
+ *
+ * @return The kernel
+ */
+std::unique_ptr<aggregate_kernel> make_aggregate_kernel(const aggregator &agg, const data_type &type, size_t offset);
+
+}
+
+#endif /* CONFLUO_AGGREGATE_AGGREGATE_KERNEL_H_ */
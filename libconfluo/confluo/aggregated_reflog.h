@@ -56,6 +56,17 @@ class aggregated_reflog : public reflog {
    */
   numeric get_aggregate(size_t aid, uint64_t version) const;
 
+  /**
+   * Gets the specified aggregate including all updates made so far,
+   * including those of records not yet visible to readers. Like the
+   * update functions, assumes no contention with the archiver.
+   *
+   * @param aid The identifier for the desired aggregate
+   *
+   * @return A numeric that contains the aggregate value
+   */
+  numeric latest_aggregate(size_t aid) const;
+
   /**
    * Updates an aggregate. Assumes no contention with archiver calling swap_aggregates.
    * Note: this assumption allows for update without performing a pointer copy.
@@ -1,6 +1,8 @@
 #ifndef CONFLUO_ALERT_INDEX_H_
 #define CONFLUO_ALERT_INDEX_H_
 
+#include <vector>
+
 #include "trigger.h"
 #include "types/byte_string.h"
 #include "types/numeric.h"
@@ -12,12 +14,30 @@ namespace confluo {
 namespace monitor {
 
 /**
- * Efficient lookup and insertions of alerts
+ * An alert as stored in the alert index; the trigger name and expression
+ * are interned in the index and referred to by the trigger identifier
+ */
+struct alert_entry {
+  /** The identifier of the trigger in the alert index */
+  uint32_t trigger_id;
+  /** The value of the aggregate that raised the alert */
+  numeric value;
+  /** The version at which the alert was raised */
+  uint64_t version;
+  /** The time bucket of the alert */
+  uint64_t time_bucket;
+};
+
+/**
+ * Efficient lookup and insertions of alerts. Alerts are indexed by time
+ * bucket, both across all triggers and per trigger; the per-trigger index
+ * keys alerts by (trigger id, time bucket), which makes duplicate
+ * detection independent of the number of triggers that fire in a bucket.
  */
 class alert_index {
  public:
   /** log containing alerts  */
-  typedef monolog::monolog_exp2<alert> alert_log;
+  typedef monolog::monolog_exp2<alert_entry> alert_log;
   /** index data structure containing the log */
   typedef index::radix_tree<alert_log> idx_t;
   /** list of alerts returned from range lookup */
@@ -28,20 +48,55 @@ class alert_index {
    */
   alert_index();
 
+  /**
+   * Deletes the per-trigger indexes
+   */
+  ~alert_index();
+
   // Note: single threaded
   /**
-   * Adds alert to the log
-   * @param time_bucket the trigger time bucket
+   * Interns a trigger; triggers with the same name and expression share
+   * an identifier
    * @param trigger_name the trigger name
    * @param trigger_expr expression for the trigger
+   * @return the identifier of the trigger
+   */
+  uint32_t add_trigger(const std::string &trigger_name, const std::string &trigger_expr);
+
+  // Note: single threaded
+  /**
+   * Adds alert to the log, unless the trigger already raised an alert with
+   * the same value in the time bucket
+   * @param time_bucket the trigger time bucket
+   * @param trigger_id the identifier returned by add_trigger
+   * @param value the trigger value
+   * @param version marker for the trigger
+   */
+  void add_alert(uint64_t time_bucket, uint32_t trigger_id, const numeric &value, uint64_t version);
+
+  /**
+   * Queues an alert raised on the ingest path. Lock-free and safe to call
+   * from any number of threads; the alert is added to the index by the
+   * next drain
+   * @param time_bucket the trigger time bucket
+   * @param trigger_id the identifier returned by add_trigger
    * @param value the trigger value
    * @param version marker for the trigger
    */
-  void add_alert(uint64_t time_bucket,
-                 const std::string &trigger_name,
-                 const std::string &trigger_expr,
-                 const numeric &value,
-                 uint64_t version);
+  void enqueue_alert(uint64_t time_bucket, uint32_t trigger_id, const numeric &value, uint64_t version);
+
+  // Note: single threaded
+  /**
+   * Adds all queued alerts to the index, in the order they were queued
+   * @return the number of alerts that were queued
+   */
+  size_t drain();
+
+  /**
+   * Checks whether there are queued alerts
+   * @return true if there are queued alerts, false otherwise
+   */
+  bool has_queued() const;
 
   /**
    * Fetches alerts from range between timestamps
@@ -51,7 +106,43 @@ class alert_index {
    */
   alert_list get_alerts(uint64_t t1, uint64_t t2) const;
 
+  /**
+   * Fetches alerts of a trigger from range between timestamps
+   * @param t1 first timestamp
+   * @param t2 second timestamp
+   * @param trigger_name the trigger name
+   * @return lists of alerts between timestamp range, one for each
+   * expression the trigger was installed with
+   */
+  std::vector<alert_list> get_alerts(uint64_t t1, uint64_t t2, const std::string &trigger_name) const;
+
+  /**
+   * Expands an indexed alert with its trigger name and expression
+   * @param entry the indexed alert
+   * @return the alert
+   */
+  alert to_alert(const alert_entry &entry) const;
+
  private:
+  /**
+   * An interned trigger along with its alerts
+   */
+  struct trigger_alerts {
+    trigger_alerts(const std::string &name, const std::string &expr);
+
+    std::string name;
+    std::string expr;
+    idx_t idx;
+  };
+
+  /**
+   * An alert queued by enqueue_alert
+   */
+  struct queued_alert {
+    alert_entry entry;
+    queued_alert *next;
+  };
+
   /**
    * Make a key from time bucket
    *
@@ -60,17 +151,9 @@ class alert_index {
    */
   byte_string make_key(uint64_t time_bucket) const;
 
-  /**
-   * Find an alert from the trigger name and value
-   *
-   * @param log The alert log
-   * @param trigger_name The trigger name
-   * @param value The trigger value
-   * @return The alert index
-   */
-  int64_t find_alert(alert_log *log, const std::string &trigger_name, const numeric &value) const;
-
   idx_t idx_;
+  monolog::monolog_exp2<trigger_alerts *> triggers_;
+  atomic::type<queued_alert *> queue_;  // Most recently queued first
 };
 
 }
@@ -6,11 +6,14 @@ namespace archival {
 
 /**
  * Describes whether or not an atomic_multilog
- * has periodic archival enabled.
+ * has periodic archival enabled, and whether
+ * cold data is archived to disk or compressed
+ * in memory.
  */
 enum archival_mode {
   OFF = 0,
-  ON = 1
+  ON = 1,
+  COMPRESS = 2
 };
 
 }
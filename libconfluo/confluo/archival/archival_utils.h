@@ -38,6 +38,16 @@ class archival_utils {
    */
   static void swap_bucket_ptr(reflog &refs, size_t idx, encoded_reflog_ptr encoded_bucket);
 
+  /**
+   * Encodes a bucket into memory allocated by the storage allocator,
+   * for the in-memory compressed tier.
+   * @param bucket unencoded bucket
+   * @param size size of the unencoded data in bytes
+   * @param encoding encoding type
+   * @return pointer to the encoded bucket, marked as archived
+   */
+  static void *encode_in_memory(void *bucket, size_t size, uint8_t encoding);
+
   /**
    * Get maximum offset stored in a reflog bucket.
    * @param bucket decoded bucket
@@ -2,6 +2,7 @@
 #define CONFLUO_ATOMIC_MULTILOG_ARCHIVAL_ARCHIVER_H_
 
 #include "container/data_log.h"
+#include "container/var_heap.h"
 #include "monolog_linear_archiver.h"
 #include "filter_log.h"
 #include "filter_log_archiver.h"
@@ -25,6 +26,7 @@ class atomic_multilog_archiver {
    * @param indexes atomic multilog indexes
    * @param schema data log schema
    * @param clear
+   * @param in_memory compress buckets in memory instead of archiving them to disk
    */
   atomic_multilog_archiver(const std::string &path,
                            read_tail rt,
@@ -32,12 +34,22 @@ class atomic_multilog_archiver {
                            filter_log *filters,
                            index_log *indexes,
                            schema_t *schema,
-                           bool clear = true);
+                           bool clear = true,
+                           bool in_memory = false);
+
+  /**
+   * Sets the heap for variable-length values, which is archived
+   * along with the data log
+   * @param heap heap for variable-length values
+   */
+  void set_var_heap(var_heap *heap);
 
   /**
    * Attempt to archive data log, filters and indexes
    * up to a particular data log offset. Best effort.
    * Does not allow for archival past the read tail.
+   * The variable-length heap is archived up to its
+   * committed tail.
    * @param offset data log offset
    */
   void archive(size_t offset);
@@ -54,6 +66,12 @@ class atomic_multilog_archiver {
    */
   std::string data_log_path();
 
+  /**
+   *
+   * @return path of directory in which variable-length heap archives are stored
+   */
+  std::string var_heap_path();
+
   /**
    *
    * @return path of directory in which filter log archives are stored
@@ -70,7 +88,10 @@ class atomic_multilog_archiver {
   std::string path_;
   read_tail rt_;
   size_t record_size_;
+  bool in_memory_;
+  var_heap *heap_;
   data_log_archiver data_log_archiver_;
+  data_log_archiver var_heap_archiver_;
   filter_log_archiver filter_log_archiver_;
   index_log_archiver index_log_archiver_;
 
@@ -29,8 +29,9 @@ class filter_archiver : public archiver {
    * Constructor.
    * @param path directory to archive in
    * @param filter filter to archive
+   * @param in_memory compress buckets in memory instead of archiving them to disk
    */
-  filter_archiver(const std::string &path, monitor::filter *filter);
+  filter_archiver(const std::string &path, monitor::filter *filter, bool in_memory = false);
 
   /**
    * Attempt to archive filter from the current archival tail up to a data log offset.
@@ -74,6 +75,7 @@ class filter_archiver : public archiver {
 
   size_t refs_tail_; // data in the current reflog up to this tail has been archived
   uint64_t ts_tail_; // reflogs in the filter up to this timestamp have been archived
+  bool in_memory_; // buckets are compressed in memory instead of archived to disk
 
 };
 
@@ -112,7 +114,7 @@ class filter_load_utils {
         for (size_t i = 0; i < num_aggs; i++) {
           data_type type = reader.read<data_type>();
           std::string data = reader.read(type.size);
-          archived_aggs[i] = aggregate(type, aggregators::sum_aggregator(), 1);
+          archived_aggs[i] = aggregate(type, aggregators::sum_aggregator());
           archived_aggs[i].seq_update(0, numeric(type, &data[0]), archival_metadata.version());
         }
         tree.get_unsafe(cur_key)->init_aggregates(num_aggs, archived_aggs);
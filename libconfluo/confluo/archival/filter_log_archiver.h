@@ -17,8 +17,9 @@ class filter_log_archiver {
    * Constructor.
    * @param path directory to archive in
    * @param filters filter log to archive
+   * @param in_memory compress buckets in memory instead of archiving them to disk
    */
-  filter_log_archiver(const std::string &path, filter_log *filters);
+  filter_log_archiver(const std::string &path, filter_log *filters, bool in_memory = false);
 
   /**
    * Default destructor.
@@ -42,6 +43,7 @@ class filter_log_archiver {
   std::string path_;
   std::vector<filter_archiver *> filter_archivers_;
   filter_log *filters_;
+  bool in_memory_;
 
 };
 
@@ -32,8 +32,9 @@ class index_archiver : public archiver {
    * @param path directory to archive in
    * @param index index to archive
    * @param column column corresponding to the index
+   * @param in_memory compress buckets in memory instead of archiving them to disk
    */
-  index_archiver(const std::string &path, index::radix_index *index, const column_t column);
+  index_archiver(const std::string &path, index::radix_index *index, const column_t column, bool in_memory = false);
 
   /**
    * Archive index up to a data log offset.
@@ -65,6 +66,7 @@ class index_archiver : public archiver {
   std::unordered_map<std::string, uint64_t> reflog_tails_;
   column_t column_;
   incremental_file_writer writer_;
+  bool in_memory_;
 
 };
 
@@ -18,8 +18,9 @@ class index_log_archiver {
    * @param path directory to archive in
    * @param indexes index log to archive
    * @param schema data schema
+   * @param in_memory compress buckets in memory instead of archiving them to disk
    */
-  index_log_archiver(const std::string &path, index_log *indexes, schema_t *schema);
+  index_log_archiver(const std::string &path, index_log *indexes, schema_t *schema, bool in_memory = false);
 
   /**
    * Default destructor.
@@ -43,6 +44,7 @@ class index_log_archiver {
   std::vector<index_archiver *> index_archivers_;
   index_log *indexes_;
   schema_t *schema_;
+  bool in_memory_;
 
 };
 
@@ -1,8 +1,7 @@
 #ifndef CONFLUO_ARCHIVAL_INCR_FILE_WRITER_H_
 #define CONFLUO_ARCHIVAL_INCR_FILE_WRITER_H_
 
-#include <iostream>
-#include <fstream>
+#include <sstream>
 #include "file_utils.h"
 #include "incremental_file_offset.h"
 #include "incremental_file_stream.h"
@@ -13,12 +12,39 @@ using namespace ::utils;
 namespace confluo {
 namespace archival {
 
+/**
+ * Appends to a sequence of archive files and their transaction log. Appends
+ * are coalesced in memory and written out in large writes, at the latest
+ * when a transaction is committed. Committed actions are grouped and logged
+ * at the next sync, which first waits for all data they refer to be durable,
+ * so the transaction log never refers to data that could be lost.
+ *
+ * A committed action is therefore not durable until the next sync: a crash
+ * loses the actions committed since, and recovery ignores the data they
+ * refer to. The writer syncs on its own once max_pending_commits actions
+ * are pending, and on close.
+ */
 class incremental_file_writer : public incremental_file_stream {
  public:
   incremental_file_writer(const std::string &path, const std::string &file_prefix, size_t max_file_size);
 
+  /**
+   * Constructor
+   *
+   * @param path The directory of the files
+   * @param file_prefix The prefix of the file names
+   * @param max_file_size The maximum size of each file
+   * @param max_pending_commits The number of committed actions after which
+   * they are synced; 0 only syncs on sync() and close()
+   */
+  incremental_file_writer(const std::string &path, const std::string &file_prefix, size_t max_file_size,
+                          size_t max_pending_commits);
+
   incremental_file_writer(const incremental_file_writer &other);
 
+  /**
+   * Closes the writer; errors are logged rather than thrown
+   */
   ~incremental_file_writer();
 
   incremental_file_writer &operator=(const incremental_file_writer &other);
@@ -33,8 +59,7 @@ class incremental_file_writer : public incremental_file_stream {
     if (!fits_in_cur_file(sizeof(T) * len))
       open_new_next();
     incremental_file_offset incr_file_off = tell();
-    io_utils::write<T>(*cur_ofs_, data, len);
-    cur_ofs_->flush();
+    buffer(data, sizeof(T) * len);
     return incr_file_off;
   }
 
@@ -43,8 +68,7 @@ class incremental_file_writer : public incremental_file_stream {
     if (!fits_in_cur_file(sizeof(T)))
       open_new_next();
     incremental_file_offset incr_file_off = tell();
-    io_utils::write<T>(*cur_ofs_, data);
-    cur_ofs_->flush();
+    buffer(&data, sizeof(T));
     return incr_file_off;
   }
 
@@ -56,24 +80,47 @@ class incremental_file_writer : public incremental_file_stream {
     if (!fits_in_cur_file((sizeof(T) * t_len) + (sizeof(U) * u_len)))
       open_new_next();
     incremental_file_offset incr_file_off = tell();
-    io_utils::write<T>(*cur_ofs_, t_data, t_len);
-    io_utils::write<U>(*cur_ofs_, u_data, u_len);
-    cur_ofs_->flush();
+    buffer(t_data, sizeof(T) * t_len);
+    buffer(u_data, sizeof(U) * u_len);
     return incr_file_off;
   }
 
+  /**
+   * Writes out all appended data and commits an action; data appended
+   * before the commit can be read from the files once it returns, and the
+   * action is logged at the next sync
+   *
+   * @param action The action to log
+   * @throw archival_exception If a write or sync fails
+   */
   template<typename ACTION>
   void commit(ACTION action) {
-    io_utils::write<ACTION>(*transaction_log_ofs_, action);
-    transaction_log_ofs_->flush();
+    std::ostringstream out;
+    io_utils::write<ACTION>(out, action);
+    commit_record(out.str());
   }
 
   incremental_file_offset tell();
 
+  /**
+   * Writes out all appended data, without waiting for it to be durable
+   */
   void flush();
 
+  /**
+   * Durability barrier: waits for the data of all committed actions to be
+   * durable, then logs the actions durably
+   */
+  void sync();
+
   void open();
 
+  /**
+   * Syncs committed actions and closes the files; the files are closed
+   * even if the sync fails
+   *
+   * @throw archival_exception If a write or sync fails
+   */
   void close();
 
  private:
@@ -82,16 +129,36 @@ class incremental_file_writer : public incremental_file_stream {
 
   incremental_file_offset open_new_next();
 
-  static std::ofstream *open_new(const std::string &path);
+  void buffer(const void *data, size_t size);
+
+  void write_buffered();
+
+  void commit_record(const std::string &record);
+
+  void close_files();
+
+  static int open_new(const std::string &path);
+
+  static int open_existing(const std::string &path);
+
+  static void close(int &fd);
 
-  static std::ofstream *open_existing(const std::string &path);
+  static void write_at(int fd, const char *data, size_t size, size_t offset);
 
-  static void close(std::ofstream *&ofs);
+  static void sync_file(int fd);
 
-  std::ofstream *cur_ofs_;
-  std::ofstream *transaction_log_ofs_;
+  int cur_fd_;
+  size_t cur_off_;
+  int transaction_log_fd_;
+  size_t transaction_log_off_;
+  std::string buffer_;
+  std::string committed_;
+  size_t pending_commits_;
 
   size_t max_file_size_;
+  size_t buffer_size_;
+  bool sync_on_commit_;
+  size_t max_pending_commits_;
 
 };
 
@@ -14,6 +14,7 @@
 #include "monolog_linear_archiver.h"
 #include "container/reflog.h"
 #include "storage/ptr_aux_block.h"
+#include "threads/backfill_task.h"
 
 namespace confluo {
 namespace archival {
@@ -59,6 +60,40 @@ class load_utils {
    */
   static void load_replay_index_log(const std::string &path, index_log &indexes, data_log &log, schema_t &schema);
 
+  /**
+   * Rebuild hash indexes, which are not archived, by replaying the
+   * data log over them in parallel batches.
+   * @param indexes hash index log to replay over
+   * @param log data log to replay records from
+   * @param schema record schema
+   */
+  static void load_replay_hash_index_log(hash_index_log &indexes, data_log &log, schema_t &schema);
+
+  /**
+   * Rebuild composite indexes, which are not archived, by replaying the
+   * data log over them in parallel batches.
+   * @param composites composite index log to replay over
+   * @param indexes index log holding the composite index radix trees
+   * @param log data log to replay records from
+   * @param schema record schema
+   */
+  static void load_replay_composite_index_log(composite_index_log &composites,
+                                              index_log &indexes,
+                                              data_log &log,
+                                              schema_t &schema);
+
+  /**
+   * Replay all records of the data log in parallel partitions.
+   * @param name name of the replay, for logging
+   * @param log data log to replay records from
+   * @param schema record schema
+   * @param update function applied to each record; must be thread-safe
+   */
+  static void rebuild_indexes(const std::string &name,
+                              data_log &log,
+                              schema_t &schema,
+                              const std::function<void(const record_t &)> &update);
+
   /**
    * Load filter archived on disk.
    * @param path path to data
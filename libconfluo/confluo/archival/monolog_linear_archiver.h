@@ -6,6 +6,7 @@
 #include "storage/allocator.h"
 #include "file_utils.h"
 #include "archival_metadata.h"
+#include "archival_utils.h"
 #include "archiver.h"
 #include "io/incremental_file_reader.h"
 #include "io/incremental_file_writer.h"
@@ -20,11 +21,11 @@ using namespace compression;
 using namespace monolog;
 using namespace storage;
 
-template<typename T, size_t MAX_BUCKETS, size_t BUCKET_SIZE, size_t BUF_SIZE>
+template<typename T, size_t BUCKET_SIZE, size_t BUF_SIZE>
 class monolog_linear_archiver : public archiver {
 
  public:
-  typedef monolog_linear<T, MAX_BUCKETS, BUCKET_SIZE, BUF_SIZE> monolog;
+  typedef monolog_linear<T, BUCKET_SIZE, BUF_SIZE> monolog;
 
   monolog_linear_archiver()
       : monolog_linear_archiver("", nullptr) {
@@ -34,11 +35,13 @@ class monolog_linear_archiver : public archiver {
    * Constructor.
    * @param path directory to archive in
    * @param log monolog to archive
+   * @param in_memory compress buckets in memory instead of archiving them to disk
    */
-  monolog_linear_archiver(const std::string &path, monolog *log)
+  monolog_linear_archiver(const std::string &path, monolog *log, bool in_memory = false)
       : writer_(path, "monolog_linear", archival_configuration_params::MAX_FILE_SIZE()),
         archival_tail_(0),
-        log_(log) {
+        log_(log),
+        in_memory_(in_memory) {
     writer_.close();
   }
 
@@ -47,24 +50,29 @@ class monolog_linear_archiver : public archiver {
    * @param offset monolog offset
    */
   void archive(size_t offset) {
-    writer_.open();
+    if (!in_memory_)
+      writer_.open();
     // TODO replace with bucket iterator later
     storage::read_only_encoded_ptr<T> bucket_ptr;
+    const bucket_geometry &geometry = log_->geometry();
     while (archival_tail_ < offset) {
+      size_t bucket_idx = geometry.bucket_idx(archival_tail_);
+      size_t bucket_end = geometry.bucket_start(bucket_idx + 1);
       log_->ptr(archival_tail_, bucket_ptr);
       T *data = bucket_ptr.get().template ptr_as<T>();
       auto aux = ptr_aux_block::get(ptr_metadata::get(data));
       if (aux.state_ != state_type::D_IN_MEMORY) {
-        archival_tail_ += BUCKET_SIZE;
+        archival_tail_ = bucket_end;
         continue;
       }
-      if (log_->size() - archival_tail_ < BUCKET_SIZE) {
+      if (log_->size() < bucket_end) {
         break;
       }
-      archive_bucket(data);
-      archival_tail_ += BUCKET_SIZE;
+      archive_bucket(bucket_idx, bucket_end, data);
+      archival_tail_ = bucket_end;
     }
-    writer_.close();
+    if (!in_memory_)
+      writer_.close();
   }
 
   size_t tail() {
@@ -75,26 +83,35 @@ class monolog_linear_archiver : public archiver {
   /**
    * Archive bucket and swap the pointer to the in-memory
    * bucket in the monolog with the archived version.
+   * @param bucket_idx index of the bucket
+   * @param bucket_end monolog offset past the end of the bucket
    * @param bucket bucket to archive
    */
-  void archive_bucket(T *bucket) {
+  void archive_bucket(size_t bucket_idx, size_t bucket_end, T *bucket) {
     auto metadata = ptr_metadata::get(bucket);
+    if (in_memory_) {
+      void *encoded_bucket = archival_utils::encode_in_memory(bucket, metadata->data_size_,
+                                                              archival_configuration_params::DATA_LOG_ENCODING_TYPE());
+      log_->bucket(bucket_idx).swap_ptr(encoded_ptr<T>(encoded_bucket));
+      return;
+    }
     auto encoded_bucket = confluo_encoder::encode(bucket, metadata->data_size_,
                                                   archival_configuration_params::DATA_LOG_ENCODING_TYPE());
     size_t enc_size = encoded_bucket.size();
     auto off = writer_.append<ptr_metadata, uint8_t>(metadata, 1, encoded_bucket.get(), enc_size);
 
-    auto action = monolog_linear_archival_action(archival_tail_ + BUCKET_SIZE);
+    auto action = monolog_linear_archival_action(bucket_end);
     writer_.commit<monolog_linear_archival_action>(action);
 
     ptr_aux_block aux(state_type::D_ARCHIVED, archival_configuration_params::DATA_LOG_ENCODING_TYPE());
-    void *archived_bucket = allocator::instance().mmap(off.path(), static_cast<off_t>(off.offset()), enc_size, aux);
-    log_->data()[archival_tail_ / BUCKET_SIZE].swap_ptr(encoded_ptr<T>(archived_bucket));
+    void *archived_bucket = allocator::instance().map_archived(off.path(), off.offset(), enc_size, aux);
+    log_->bucket(bucket_idx).swap_ptr(encoded_ptr<T>(archived_bucket));
   }
 
   incremental_file_writer writer_;
   size_t archival_tail_;
   monolog *log_;
+  bool in_memory_;
 
 };
 
@@ -102,27 +119,27 @@ class monolog_linear_load_utils {
  public:
 
   /**
-   * Load a monolog_linear archived on disk.
+   * Load a monolog_linear archived on disk. The log must have the bucket
+   * geometry it was archived with.
    * @param path path to data
    * @param log log to load into
    */
-  template<typename T, size_t MAX_BUCKETS, size_t BUCKET_SIZE, size_t BUF_SIZE>
-  static void load(const std::string &path, monolog_linear<T, MAX_BUCKETS, BUCKET_SIZE, BUF_SIZE> &log) {
+  template<typename T, size_t BUCKET_SIZE, size_t BUF_SIZE>
+  static void load(const std::string &path, monolog_linear<T, BUCKET_SIZE, BUF_SIZE> &log) {
     incremental_file_reader reader(path, "monolog_linear");
-    auto &buckets = log.data();
-    size_t load_offset = 0;
+    size_t bucket_idx = 0;
     while (reader.has_more()) {
       auto action = reader.read_action<monolog_linear_archival_action>();
       incremental_file_offset off = reader.tell();
       size_t size = reader.read<ptr_metadata>().data_size_;
 
       ptr_aux_block aux(state_type::D_ARCHIVED, archival_configuration_params::DATA_LOG_ENCODING_TYPE());
-      void *encoded_bucket = allocator::instance().mmap(off.path(), static_cast<off_t>(off.offset()), size, aux);
-      buckets[load_offset / BUCKET_SIZE].init_ptr(encoded_ptr<T>(encoded_bucket));
+      void *encoded_bucket = allocator::instance().map_archived(off.path(), off.offset(), size, aux);
+      log.bucket(bucket_idx).init_ptr(encoded_ptr<T>(encoded_bucket));
 
-      log.reserve(BUCKET_SIZE);
+      log.reserve(log.geometry().bucket_size(bucket_idx));
       reader.advance<uint8_t>(size);
-      load_offset += BUCKET_SIZE;
+      bucket_idx++;
     }
     reader.truncate(reader.tell(), reader.tell_transaction_log());
   }
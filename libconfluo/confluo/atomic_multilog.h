@@ -4,8 +4,12 @@
 #include <cmath>
 
 #include <functional>
+#include <initializer_list>
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <thread>
+#include <vector>
 
 #include "archival/archival_mode.h"
 #include "archival/load_utils.h"
@@ -19,14 +23,17 @@
 #include "atomic_multilog_metadata.h"
 #include "conf/configuration_params.h"
 #include "container/data_log.h"
+#include "container/var_heap.h"
 #include "container/cursor/record_cursors.h"
 #include "container/cursor/alert_cursor.h"
+#include "container/cursor/time_range_cursors.h"
 #include "container/monolog/monolog.h"
 #include "container/radix_tree.h"
 #include "container/string_map.h"
 #include "filter.h"
 #include "filter_log.h"
 #include "index_log.h"
+#include "materialized_view.h"
 #include "parser/schema_parser.h"
 #include "parser/expression_parser.h"
 #include "parser/expression_compiler.h"
@@ -40,8 +47,9 @@
 #include "storage/storage.h"
 #include "time_utils.h"
 #include "string_utils.h"
-#include "threads/periodic_task.h"
+#include "threads/backfill_task.h"
 #include "threads/task_pool.h"
+#include "threads/task_scheduler.h"
 
 /**
  * \mainpage libconfluo Documentation
@@ -128,9 +136,12 @@ class atomic_multilog {
    * @param path The path of the atomic multilog
    * @param mode The storage mode of the atomic multilog
    * @param pool The pool of tasks
+   * @param geometry The bucket geometry of the data log; buckets are made
+   * large enough to hold a record
    */
   atomic_multilog(const std::string &name, const std::vector<column_t> &schema, const std::string &path,
-                  const storage::storage_mode &s_mode, const archival_mode &a_mode, task_pool &pool);
+                  const storage::storage_mode &s_mode, const archival_mode &a_mode, task_pool &pool,
+                  const monolog::bucket_geometry &geometry = configured_data_log_geometry());
 
   /**
    * Initializes an atomic multilog from the given parameters
@@ -140,9 +151,11 @@ class atomic_multilog {
    * @param path The path to store multilog data
    * @param mode The storage mode of the multilog
    * @param pool The pool of tasks for the multilog
+   * @param geometry The bucket geometry of the data log
    */
   atomic_multilog(const std::string &name, const std::string &schema, const std::string &path,
-                  const storage::storage_mode &storage_mode, const archival_mode &a_mode, task_pool &pool);
+                  const storage::storage_mode &storage_mode, const archival_mode &a_mode, task_pool &pool,
+                  const monolog::bucket_geometry &geometry = configured_data_log_geometry());
 
   /**
    * Constructor that initializes atomic multilog from existing archives.
@@ -165,12 +178,40 @@ class atomic_multilog {
 
   // Management ops
   /**
-   * Adds index to the atomic multilog
+   * Adds index to the atomic multilog. Records already in the atomic
+   * multilog are indexed by a background backfill; the index is used for
+   * queries once the backfill completes.
    * @param field_name The name of the field in the atomic multilog
    * @param bucket_size The size of the bucket
+   * @param type The type of the index; hash indexes only serve equality
+   * predicates
    * @throw ex Management exception
    */
-  void add_index(const std::string &field_name, double bucket_size = configuration_params::INDEX_BUCKET_SIZE());
+  void add_index(const std::string &field_name,
+                 double bucket_size = configuration_params::INDEX_BUCKET_SIZE(),
+                 index_type_t type = RADIX_INDEX);
+
+  /**
+   * Adds a composite index over an ordered list of fields to the atomic
+   * multilog. The index key concatenates the keys of the fields in order,
+   * so that queries with equality predicates on a prefix of the fields,
+   * optionally followed by a range predicate on the next field, only read
+   * matching records.
+   * @param field_names The names of the fields, in key order
+   * @param bucket_sizes The bucket size for each field; the configured
+   * bucket size is used for every field if empty
+   * @throw ex Management exception
+   */
+  void add_index(const std::vector<std::string> &field_names, const std::vector<double> &bucket_sizes = {});
+
+  /**
+   * Adds a composite index over an ordered list of fields to the atomic
+   * multilog
+   * @param field_names The names of the fields, in key order
+   * @param bucket_sizes The bucket size for each field
+   * @throw ex Management exception
+   */
+  void add_index(std::initializer_list<std::string> field_names, const std::vector<double> &bucket_sizes = {});
 
   /**
    * Removes index from the atomic multilog
@@ -179,6 +220,13 @@ class atomic_multilog {
    */
   void remove_index(const std::string &field_name);
 
+  /**
+   * Removes a composite index from the atomic multilog
+   * @param field_names The names of the fields, in key order
+   * @throw ex Management exception
+   */
+  void remove_index(const std::vector<std::string> &field_names);
+
   /**
    * Checks whether column of atomic multilog is indexed
    * @param field_name The name of the field
@@ -188,7 +236,25 @@ class atomic_multilog {
   bool is_indexed(const std::string &field_name);
 
   /**
-   * Adds filter to the atomic multilog
+   * Gets the progress of the backfill for an index
+   * @param field_name The name of the indexed field
+   * @return The backfill status
+   * @throw ex Management exception
+   */
+  backfill_status index_backfill_status(const std::string &field_name) const;
+
+  /**
+   * Gets the progress of the backfill for a composite index
+   * @param field_names The names of the indexed fields, in key order
+   * @return The backfill status
+   * @throw ex Management exception
+   */
+  backfill_status index_backfill_status(const std::vector<std::string> &field_names) const;
+
+  /**
+   * Adds filter to the atomic multilog. Records already in the atomic
+   * multilog are filtered by a background backfill; aggregates on the
+   * filter only cover records appended after they are added.
    * @param name The name of the filter
    * @param expr The expression to filter out elements in the atomic multilog
    * @throw ex Management exception
@@ -202,6 +268,14 @@ class atomic_multilog {
    */
   void remove_filter(const std::string &name);
 
+  /**
+   * Gets the progress of the backfill for a filter
+   * @param name The name of the filter
+   * @return The backfill status
+   * @throw ex Management exception
+   */
+  backfill_status filter_backfill_status(const std::string &name) const;
+
   /**
    * Adds aggregate to the atomic multilog
    *
@@ -224,11 +298,14 @@ class atomic_multilog {
    * @param name The name of the trigger
    * @param expr The trigger expression to be executed
    * @param periodicity_ms The periodicity in milliseconds
+   * @param mode Whether the trigger is evaluated periodically by the
+   * monitor task, or on the ingest path whenever its aggregate changes
    * @throw ex Management exception
    */
   void install_trigger(const std::string &name,
                        const std::string &expr,
-                       const uint64_t periodicity_ms = configuration_params::MONITOR_PERIODICITY_MS());
+                       const uint64_t periodicity_ms = configuration_params::MONITOR_PERIODICITY_MS(),
+                       trigger_mode_t mode = POLLED_TRIGGER);
 
   /**
    * Removes trigger from the atomic multilog
@@ -237,6 +314,35 @@ class atomic_multilog {
    */
   void remove_trigger(const std::string &name);
 
+  /**
+   * Adds a materialized view to the atomic multilog; once each window
+   * closes, the filtered records in it are grouped and aggregated, and the
+   * results are appended to the target atomic multilog. Windows are
+   * materialized starting with the one in which the view is added.
+   *
+   * @param name The name of the view
+   * @param filter_name The name of the filter the view is defined on
+   * @param group_by The column to group by; empty for no grouping
+   * @param aggregate_exprs The aggregate expressions (e.g., sum(temp))
+   * @param window_ms The width of each window in milliseconds
+   * @param target The atomic multilog the results are appended to; its
+   * schema must match materialized_view::output_schema()
+   * @throw ex Management exception
+   */
+  void add_materialized_view(const std::string &name,
+                             const std::string &filter_name,
+                             const std::string &group_by,
+                             const std::vector<std::string> &aggregate_exprs,
+                             uint64_t window_ms,
+                             atomic_multilog *target);
+
+  /**
+   * Removes a materialized view from the atomic multilog
+   * @param name The name of the view
+   * @throw Management exception
+   */
+  void remove_materialized_view(const std::string &name);
+
   // Query ops
   /**
    * Get a record batch builder.
@@ -252,13 +358,14 @@ class atomic_multilog {
   size_t append_batch(record_batch &batch);
 
   /**
-   * Appends data to the atomic multilog
+   * Appends data to the atomic multilog; for schemas with
+   * variable-length columns, the data is an inline record
    * @param data The data to be stored
    * @return The offset of where the data is located
    */
   size_t append(void *data);
 
-  // TODO: Add a std::tuple based variant
+  // See typed_multilog for appending typed records without string conversions
   // TODO: Add a JSON based variant
   /**
    * Appends a record to the atomic multilog
@@ -303,7 +410,8 @@ class atomic_multilog {
    * Reads a record given an offset into the data log
    * @param offset The offset into the data log of the record
    * @param version The current version
-   * @return Pointer to the corresponding raw record bytes
+   * @return Pointer to the corresponding raw record bytes; variable-length
+   * columns hold references into the multilog's heap
    */
   std::unique_ptr<uint8_t> read_raw(uint64_t offset, uint64_t &version) const;
 
@@ -311,10 +419,22 @@ class atomic_multilog {
    * Reads a record given an offset into the data log
    * @param offset The offset into the data log of the record
    * @param version The current version
-   * @return Pointer to the corresponding raw record bytes
+   * @return Pointer to the corresponding raw record bytes; variable-length
+   * columns hold references into the multilog's heap
    */
   std::unique_ptr<uint8_t> read_raw(uint64_t offset) const;
 
+  /**
+   * Reads a record given an offset into the data log into a buffer,
+   * decoding only the record if it has been archived
+   * @param offset The offset into the data log of the record
+   * @param buffer The buffer of at least record_size() bytes to read the
+   * raw record bytes into; variable-length columns hold references into
+   * the multilog's heap
+   * @return True if the record is readable, false otherwise
+   */
+  bool read_raw(uint64_t offset, uint8_t *buffer) const;
+
   /**
    * Executes the filter expression
    * @param expr The filter expression
@@ -322,6 +442,20 @@ class atomic_multilog {
    */
   std::unique_ptr<record_cursor> execute_filter(const std::string &expr) const;
 
+  /**
+   * Queries the records whose timestamps lie in a time-range, in timestamp
+   * order. When timestamps are non-decreasing in append order, the range is
+   * located by a binary search over the data log; otherwise, a radix index
+   * on the TIMESTAMP column is walked if one exists, and the data log is
+   * scanned if not.
+   * @param begin_ts Beginning of the time-range (inclusive), in the units of
+   * the TIMESTAMP column
+   * @param end_ts End of the time-range (inclusive)
+   * @param reverse Whether to return records in decreasing timestamp order
+   * @return A cursor over the records in the time-range
+   */
+  std::unique_ptr<record_cursor> query_time_range(uint64_t begin_ts, uint64_t end_ts, bool reverse = false) const;
+
   // TODO: Add tests
   /**
    * Executes an aggregate
@@ -364,6 +498,51 @@ class atomic_multilog {
    */
   numeric get_aggregate(const std::string &aggregate_name, uint64_t begin_ms, uint64_t end_ms);
 
+  /**
+   * Gets the aggregator of a stored aggregate, so that its values can be
+   * combined with those of the same aggregate elsewhere.
+   * @param aggregate_name The name of the aggregate
+   * @return The aggregator, e.g., SUM
+   * @throw invalid_operation_exception If the aggregate does not exist
+   */
+  aggregator get_aggregator(const std::string &aggregate_name);
+
+  /**
+   * Query a stored aggregate, downsampled into fixed-width intervals. The
+   * result for each interval is combined from the per-time-block partial
+   * aggregates maintained by the aggregate's filter, so no records are read.
+   * @param aggregate_name The name of the aggregate
+   * @param begin_ms Beginning of time-range in ms
+   * @param end_ms End of time-range in ms (inclusive)
+   * @param interval_ms The width of each interval in ms
+   * @return The aggregate value for each interval, starting at begin_ms;
+   * intervals with no records hold the aggregate's zero value
+   * @throw invalid_operation_exception If the series has more than
+   * max_aggregate_series_points intervals
+   */
+  std::vector<numeric> get_aggregate_series(const std::string &aggregate_name, uint64_t begin_ms, uint64_t end_ms,
+                                            uint64_t interval_ms);
+
+  /**
+   * Executes an ad-hoc aggregate over the records in a time-range,
+   * downsampled into fixed-width intervals, by scanning the records in the
+   * time-range (see query_time_range).
+   * @param aggregate_expr The aggregate expression, e.g., "max(cpu_util)"
+   * @param filter_expr The filter expression; an empty expression selects
+   * all records
+   * @param begin_ts Beginning of the time-range, in the units of the
+   * TIMESTAMP column
+   * @param end_ts End of the time-range (inclusive)
+   * @param interval The width of each interval, in the units of the
+   * TIMESTAMP column
+   * @return The aggregate value for each interval, starting at begin_ts;
+   * intervals with no records hold the aggregate's zero value
+   * @throw invalid_operation_exception If the series has more than
+   * max_aggregate_series_points intervals
+   */
+  std::vector<numeric> execute_aggregate_series(const std::string &aggregate_expr, const std::string &filter_expr,
+                                                uint64_t begin_ts, uint64_t end_ts, uint64_t interval);
+
   /**
    * Obtain a cursor over alerts in a time-range
    * @param begin_ms Beginning of time-range in ms
@@ -399,6 +578,13 @@ class atomic_multilog {
    */
   size_t num_records() const;
 
+  /**
+   * Gets the number of polled triggers and views the monitor task
+   * evaluates; the task parks while there are none
+   * @return The number of monitored triggers and views
+   */
+  size_t num_monitored() const;
+
   /**
    * Gets the record size
    * @return The record size of the schema
@@ -419,8 +605,11 @@ class atomic_multilog {
    * @param path Path to load metadata from
    * @param s_mode Storage mode
    * @param a_mode Archival mode
+   * @param geometry Bucket geometry of the data log; left unchanged for
+   * multilogs that do not record it
    */
-  void load_metadata(const std::string &path, storage_mode &s_mode, archival_mode &a_mode);
+  void load_metadata(const std::string &path, storage_mode &s_mode, archival_mode &a_mode,
+                     monolog::bucket_geometry &geometry);
 
   /**
    * Updates the record block
@@ -430,14 +619,75 @@ class atomic_multilog {
    */
   void update_aux_record_block(uint64_t log_offset, record_block &block, size_t record_size);
 
+  /**
+   * Gets the number of intervals in an aggregate series
+   * @param begin Beginning of the range
+   * @param end End of the range (inclusive); must not be less than begin
+   * @param interval The width of each interval
+   * @return The number of intervals
+   * @throw invalid_operation_exception If the number of intervals exceeds
+   * max_aggregate_series_points
+   */
+  static size_t num_series_points(uint64_t begin, uint64_t end, uint64_t interval);
+
+  /**
+   * Checks if record timestamps have been non-decreasing in append order
+   * @return True if the timestamps are ordered, false otherwise
+   */
+  bool is_time_ordered() const;
+
+  /**
+   * Clears the time-order flag if the records in a range of the data log
+   * break timestamp order; must be called before the read tail is advanced
+   * past the range. Once cleared, the flag is never set again.
+   * @param offset The data log offset of the first record in the range
+   * @param bytes The number of bytes in the range
+   */
+  void update_time_order(uint64_t offset, size_t bytes);
+
+  /**
+   * Gets the offset of the first record with timestamp greater than (or
+   * equal to) a timestamp, using a binary search over the data log;
+   * timestamps must be ordered up to the version
+   * @param ts The timestamp
+   * @param inclusive Whether to include records with timestamp equal to ts
+   * @param version The data log version
+   * @return The data log offset of the record, or version if none exists
+   */
+  uint64_t time_bound(uint64_t ts, bool inclusive, uint64_t version) const;
+
+  /**
+   * Initializes the heap for variable-length values, if the schema has
+   * variable-length columns
+   * @param path The data path for the heap
+   * @param mode The storage mode for the heap
+   */
+  void init_var_heap(const std::string &path, const storage::storage_mode &mode);
+
+  /**
+   * Stores a sequence of inline records: writes their variable-length
+   * values to the heap, and their fixed-size portions, now referencing
+   * the heap, to the output buffer
+   * @param in The inline records
+   * @param in_size The total size of the inline records
+   * @param nrecords The number of records
+   * @param out The output buffer, of nrecords * record_size bytes
+   * @throw invalid_operation_exception If the records are malformed
+   */
+  void store_inline_records(const uint8_t *in, size_t in_size, size_t nrecords, uint8_t *out);
+
   /**
    * Adds an index to the schema for a given field
    *
    * @param field_name The name of the field to index
    * @param bucket_size The bucket_size used for indexing
+   * @param type The type of the index
    * @param ex The exception when the index could not be added
    */
-  void add_index_task(const std::string &field_name, double bucket_size, optional<management_exception> &ex);
+  void add_index_task(const std::string &field_name,
+                      double bucket_size,
+                      index_type_t type,
+                      optional<management_exception> &ex);
 
   /**
    * Removes an index for a given field in the schema
@@ -447,6 +697,42 @@ class atomic_multilog {
    */
   void remove_index_task(const std::string &field_name, optional<management_exception> &ex);
 
+  /**
+   * Adds a composite index over an ordered list of fields
+   *
+   * @param field_names The names of the fields, in key order
+   * @param bucket_sizes The bucket size for each field
+   * @param ex The exception when the index could not be added
+   */
+  void add_composite_index_task(const std::vector<std::string> &field_names,
+                                const std::vector<double> &bucket_sizes,
+                                optional<management_exception> &ex);
+
+  /**
+   * Removes a composite index
+   *
+   * @param field_names The names of the fields, in key order
+   * @param ex The exception when the index could not be removed
+   */
+  void remove_composite_index_task(const std::vector<std::string> &field_names, optional<management_exception> &ex);
+
+  /**
+   * Gets the name of the composite index over an ordered list of fields
+   *
+   * @param field_names The names of the fields, in key order
+   * @return The composite index name
+   * @throw management_exception If a field does not exist
+   */
+  std::string composite_index_name(const std::vector<std::string> &field_names) const;
+
+  /**
+   * Finds an enabled composite index by name
+   *
+   * @param name The composite index name
+   * @return The composite index, or nullptr if no such index exists
+   */
+  composite_index_t *find_composite_index(const std::string &name) const;
+
   /**
    * Adds a filter to be executed on the data
    *
@@ -493,11 +779,13 @@ class atomic_multilog {
    * @param expr The trigger expression
    * @param periodicity_ms The periodicity of the trigger measured in
    * milliseconds
+   * @param mode When the trigger is evaluated
    * @param ex The exception when the trigger cannot be added
    */
   void add_trigger_task(const std::string &name,
                         const std::string &expr,
                         uint64_t periodicity_ms,
+                        trigger_mode_t mode,
                         optional<management_exception> &ex);
 
   /**
@@ -508,17 +796,97 @@ class atomic_multilog {
    */
   void remove_trigger_task(const std::string &name, optional<management_exception> &ex);
 
+  /**
+   * Adds a materialized view to the atomic multilog
+   *
+   * @param name The name of the view
+   * @param filter_name The name of the filter the view is defined on
+   * @param group_by The column to group by
+   * @param aggregate_exprs The aggregate expressions
+   * @param window_ms The width of each window in milliseconds
+   * @param target The atomic multilog the results are appended to
+   * @param ex The exception when the view cannot be added
+   */
+  void add_view_task(const std::string &name,
+                     const std::string &filter_name,
+                     const std::string &group_by,
+                     const std::vector<std::string> &aggregate_exprs,
+                     uint64_t window_ms,
+                     atomic_multilog *target,
+                     optional<management_exception> &ex);
+
+  /**
+   * Removes a materialized view from the atomic multilog
+   *
+   * @param name The name of the view
+   * @param ex The exception when the view could not be removed
+   */
+  void remove_view_task(const std::string &name, optional<management_exception> &ex);
+
   /**
    * Archives until only a configured number of bytes
-   * of the data log are resident in memory.
+   * of the data log are resident in memory; returns right away
+   * when there is nothing new to archive.
    */
   void archival_task();
 
   /**
-   * Monitors the task executed on the atomic multilog
+   * Evaluates triggers and materializes views; parks itself when there
+   * are none, or when no records have been added for longer than any
+   * trigger or view window, until wake_monitor() is called
    */
   void monitor_task();
 
+  /**
+   * Parks the monitor task at the end of its current run, unless the
+   * state it was parked on changes in the meantime
+   *
+   * @param version The read tail the run saw
+   * @param num_monitored The number of monitored triggers and views the
+   * run saw
+   */
+  void park_monitor(uint64_t version, size_t num_monitored);
+
+  /**
+   * Re-arms the monitor task if it is parked
+   */
+  void wake_monitor();
+
+  /**
+   * Wakes the monitor task after an append, if it is parked and has
+   * work to do; a single load on the common path
+   */
+  inline void notify_monitor() {
+    // Orders the load of the flag after the append's stores; see park_monitor()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (atomic::load(&monitor_parked_) && (atomic::load(&num_monitored_) > 0 || alerts_.has_queued()))
+      wake_monitor();
+  }
+
+  /**
+   * Counts the valid polled triggers of an aggregate, which are
+   * unregistered from the monitor task when the aggregate or its filter
+   * is removed
+   *
+   * @param a The aggregate
+   * @return The number of valid polled triggers
+   */
+  static size_t num_polled_triggers(aggregate_info *a);
+
+  /**
+   * Registers a trigger or view with the monitor task; called from
+   * management tasks, which are serialized
+   *
+   * @param window_ms The trigger periodicity or view window
+   */
+  void add_monitored(uint64_t window_ms);
+
+  /**
+   * Adds the alerts that eager triggers raised on the ingest path to the
+   * alert index
+   */
+  void drain_alerts() const;
+
   /**
    * Checks the time bucket and adds alerts when necessary
    *
@@ -530,6 +898,37 @@ class atomic_multilog {
    */
   void check_time_bucket(filter *f, trigger *t, size_t tid, uint64_t time_bucket, uint64_t version);
 
+  /**
+   * Materializes the windows of all views that have closed
+   *
+   * @param cur_ms The current time in milliseconds
+   * @param version The version to materialize
+   */
+  void materialize_views(uint64_t cur_ms, uint64_t version);
+
+  /**
+   * Starts a backfill over the records preceding the boundary
+   *
+   * @param name The name of the backfill task
+   * @param boundary The data log offset up to which records are backfilled
+   * @param update Adds a record to the index or filter
+   * @param on_done Invoked once all records are backfilled
+   * @return The backfill task
+   */
+  backfill_task *start_backfill(const std::string &name, uint64_t boundary,
+                                std::function<void(const record_t &)> update,
+                                backfill_task::done_fn on_done);
+
+  /**
+   * Applies a function to every record in a range of the data log, once
+   * all records in the range have been written
+   *
+   * @param begin The data log offset of the first record
+   * @param end The data log offset past the last record
+   * @param update The function to apply
+   */
+  void backfill_records(uint64_t begin, uint64_t end, const std::function<void(const record_t &)> &update) const;
+
   /** The name of the multilog */
   std::string name_;
   /** The schema of the multilog */
@@ -537,6 +936,8 @@ class atomic_multilog {
 
   /** The data log */
   data_log_type data_log_;
+  /** The heap for variable-length values */
+  var_heap var_heap_;
   /** The read tail */
   read_tail_type rt_;
   /** The metadata associated with the multilog */
@@ -547,8 +948,16 @@ class atomic_multilog {
   filter_log filters_;
   /** The list of indexes */
   index_log indexes_;
-  /** The list of alerts */
-  alert_index alerts_;
+  /** The list of hash indexes */
+  hash_index_log hash_indexes_;
+  /** The list of composite indexes; their radix trees live in indexes_ */
+  composite_index_log composite_indexes_;
+  /** The list of alerts; readers drain alerts raised on the ingest path */
+  mutable alert_index alerts_;
+  /** Serializes additions to the alert index */
+  mutable std::mutex alerts_mtx_;
+  /** The list of materialized views */
+  view_log views_;
 
   /** A map from id to filter */
   string_map<filter_id_t> filter_map_;
@@ -556,20 +965,54 @@ class atomic_multilog {
   string_map<aggregate_id_t> aggregate_map_;
   /** A map from id to trigger */
   string_map<trigger_id_t> trigger_map_;
+  /** A map from name to materialized view */
+  string_map<size_t> view_map_;
 
   /** The query planner for the multilog */
   query_planner planner_;
 
+  /** Whether all appended timestamps are non-decreasing */
+  atomic::type<bool> time_ordered_{true};
+
   // Archival
   atomic_multilog_archiver archiver_;
-  periodic_task archival_task_;
-  task_pool archival_pool_;
+  /** Serializes periodic and forced archival */
+  std::mutex archival_mtx_;
+  /** The data log offset up to which the multilog has been archived */
+  uint64_t archived_tail_ = 0;
+
+  // Monitoring
+  /**
+   * The number of polled triggers and views the monitor task evaluates:
+   * those that are valid, and whose filter and aggregate are valid
+   */
+  atomic::type<size_t> num_monitored_;
+  /** The largest trigger periodicity or view window, in milliseconds */
+  atomic::type<uint64_t> monitor_horizon_ms_;
+  /** The read tail seen by the last monitor run */
+  uint64_t monitored_tail_ = 0;
+  /** The time at which the monitor last saw the read tail move */
+  uint64_t monitored_tail_ms_ = 0;
+  /** Whether the monitor task is parked; appends check it to re-arm the task */
+  atomic::type<bool> monitor_parked_{false};
 
   // Manangement
   /** The pool of tasks */
   task_pool &mgmt_pool_;
-  /** The monitor task */
-  periodic_task monitor_task_;
+
+  // Periodic tasks, declared after the state they use
+  /** The monitor task, run on the shared scheduler */
+  scheduled_task monitor_task_;
+  /** The archival task, run on the archival scheduler */
+  scheduled_task archival_task_;
+
+  // Backfill; declared last so that workers exit before other members are destroyed
+  /** Protects the backfill maps */
+  mutable std::mutex backfill_mtx_;
+  /** Backfill tasks for indexes, keyed by field name or composite index name */
+  std::map<std::string, std::unique_ptr<backfill_task>> index_backfills_;
+  /** Backfill tasks for filters, keyed by filter name */
+  std::map<std::string, std::unique_ptr<backfill_task>> filter_backfills_;
 };
 
 }
@@ -4,13 +4,16 @@
 #include <cstdint>
 #include <string>
 #include <fstream>
+#include <vector>
 
 #include "archival/archival_mode.h"
+#include "container/monolog/bucket_geometry.h"
 #include "types/numeric.h"
 #include "types/type_manager.h"
 #include "io_utils.h"
 #include "schema/schema.h"
 #include "storage/storage.h"
+#include "trigger.h"
 
 using namespace utils;
 
@@ -34,7 +37,15 @@ enum metadata_type
   /** Metadata for storage mode */
       D_STORAGE_MODE_METADATA = 5,
   /** Metadata for archival mode */
-      D_ARCHIVAL_MODE_METADATA = 6
+      D_ARCHIVAL_MODE_METADATA = 6,
+  /** Metadata for the hash index */
+      D_HASH_INDEX_METADATA = 7,
+  /** Metadata for the composite index */
+      D_COMPOSITE_INDEX_METADATA = 8,
+  /** Metadata for triggers evaluated on the ingest path */
+      D_EAGER_TRIGGER_METADATA = 9,
+  /** Metadata for the bucket geometry of the data log */
+      D_DATA_LOG_METADATA = 10
 };
 
 /**
@@ -69,6 +80,38 @@ struct index_metadata {
   double bucket_size_;
 };
 
+/**
+ * Metadata for a composite index
+ */
+struct composite_index_metadata {
+ public:
+  /**
+   * Constructs metadata for a composite index over the specified fields
+   *
+   * @param field_names The names of the fields, in key order
+   * @param bucket_sizes The bucket size for each field
+   */
+  composite_index_metadata(const std::vector<std::string> &field_names, const std::vector<double> &bucket_sizes);
+
+  /**
+   * Gets the field names
+   *
+   * @return The field names, in key order
+   */
+  const std::vector<std::string> &field_names() const;
+
+  /**
+   * Gets the bucket sizes
+   *
+   * @return The bucket size for each field
+   */
+  const std::vector<double> &bucket_sizes() const;
+
+ private:
+  std::vector<std::string> field_names_;
+  std::vector<double> bucket_sizes_;
+};
+
 /**
  * Metadata for the filter
  */
@@ -241,6 +284,13 @@ class metadata_writer {
    */
   void write_archival_mode(archival::archival_mode mode);
 
+  /**
+   * Write the bucket geometry of the data log
+   *
+   * @param geometry The bucket geometry to write
+   */
+  void write_data_log_geometry(const monolog::bucket_geometry &geometry);
+
   /**
    * Write the schema
    *
@@ -253,8 +303,18 @@ class metadata_writer {
    *
    * @param name The name of the index
    * @param bucket_size The bucket_size used for lookup
+   * @param index_type The type of the index
+   */
+  void write_index_metadata(const std::string &name, double bucket_size, index_type_t index_type = RADIX_INDEX);
+
+  /**
+   * Writes metadata about a composite index
+   *
+   * @param field_names The names of the indexed fields, in key order
+   * @param bucket_sizes The bucket size for each field
    */
-  void write_index_metadata(const std::string &name, double bucket_size);
+  void write_composite_index_metadata(const std::vector<std::string> &field_names,
+                                      const std::vector<double> &bucket_sizes);
 
   /**
    * Writes the metadata for a specified filter
@@ -280,10 +340,12 @@ class metadata_writer {
    * @param trigger_expr The trigger expression
    * @param periodicity_ms The periodicity of the trigger measured in
    * milliseconds
+   * @param mode When the trigger is evaluated
    */
   void write_trigger_metadata(const std::string &trigger_name,
                               const std::string &trigger_expr,
-                              uint64_t periodicity_ms);
+                              uint64_t periodicity_ms,
+                              monitor::trigger_mode_t mode = monitor::POLLED_TRIGGER);
  private:
   std::string filename_;
   std::ofstream out_;
@@ -330,6 +392,13 @@ class metadata_reader {
    */
   index_metadata next_index_metadata();
 
+  /**
+   * Reads the next metadata for a composite index
+   *
+   * @return The composite index metadata that was read
+   */
+  composite_index_metadata next_composite_index_metadata();
+
   /**
    * Reads the next metadata for a filter
    *
@@ -365,6 +434,13 @@ class metadata_reader {
    */
   archival::archival_mode next_archival_mode();
 
+  /**
+   * Reads the next bucket geometry of the data log
+   *
+   * @return The next bucket geometry
+   */
+  monolog::bucket_geometry next_data_log_geometry();
+
  private:
   std::string filename_;
   std::ifstream in_;
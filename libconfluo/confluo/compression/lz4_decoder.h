@@ -6,8 +6,10 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
 #include <iostream>
 #include <math.h>
+#include <memory>
 
 #include "lz4.h"
 #include "compression/lz4_encoder.h"
@@ -24,89 +26,32 @@ class lz4_decoder {
  public:
   /**
    * Decodes a length number of bytes from the src_index position in the
-   * input buffer
+   * input buffer; only the blocks spanned by the range are decompressed,
+   * and each of them only up to the end of the range
    *
    * @param input_buffer The LZ4 encoded buffer
-   * @param source_size The size of the unencoded buffer
-   * @param buffer The destination buffer to be filled with decoded data
+   * @param dest_buffer The destination buffer to be filled with decoded data
    * @param src_index The index into the unencoded buffer to begin decoding
    * @param length The number of bytes to decode
    */
   static void decode(uint8_t *input_buffer, uint8_t *dest_buffer, size_t src_index, size_t length) {
-    size_t decoded_buf_size = decoded_size(input_buffer);
-    input_buffer += sizeof(size_t);
-
-    size_t encode_size = lz4_encoder<BYTES_PER_BLOCK>::get_buffer_size(decoded_buf_size);
-
-    int compress_index = static_cast<int>(src_index / BYTES_PER_BLOCK);
-    int position_within_block = static_cast<int>(src_index % BYTES_PER_BLOCK);
-
-    size_t offset = *reinterpret_cast<size_t *>(input_buffer + compress_index * sizeof(size_t));
-    uint8_t *temp_buffer = new uint8_t[BYTES_PER_BLOCK];
-
-    size_t compress_size = 0;
-    int max_index = static_cast<int>(decoded_buf_size / BYTES_PER_BLOCK);
-
-    if (compress_index + 1 < max_index) {
-      compress_size = *reinterpret_cast<size_t *>(input_buffer +
-          (compress_index + 1) * sizeof(size_t)) - offset;
-    } else {
-      compress_size = encode_size - offset;
-    }
-
-    // Decompresses the block where the offset is
-    LZ4_decompress_safe((char *) input_buffer + offset, (char *) temp_buffer,
-                        static_cast<int>(compress_size), static_cast<int>(BYTES_PER_BLOCK));
-    size_t len = 0;
-    // Checks whether the number of bytes to decode is less than the block size
-    if (position_within_block + length < BYTES_PER_BLOCK) {
-      // If so we only want to decode the number of bytes passed in as a parameter
-      len = length;
-    } else {
-      // Otherwise we need to decode more bytes, so the number of bytes decoded is the block size - offset
-      len = BYTES_PER_BLOCK - position_within_block;
-    }
-    std::memcpy(dest_buffer, temp_buffer + position_within_block, len);
-    length -= len;
-    compress_index++;
-    delete[] temp_buffer;
-
-    while (length >= BYTES_PER_BLOCK) {
-      offset = *reinterpret_cast<size_t *>(input_buffer + compress_index * sizeof(size_t));
-      if (compress_index + 1 < max_index) {
-        compress_size = *reinterpret_cast<size_t *>(input_buffer +
-            (compress_index + 1) * sizeof(size_t)) - offset;
+    size_t block_idx = src_index / BYTES_PER_BLOCK;
+    size_t position_within_block = src_index % BYTES_PER_BLOCK;
+    while (length > 0) {
+      size_t len = std::min(length, BYTES_PER_BLOCK - position_within_block);
+      if (len == BYTES_PER_BLOCK) {
+        // Whole blocks are decompressed in place
+        decode_block(input_buffer, block_idx, dest_buffer, BYTES_PER_BLOCK);
       } else {
-        compress_size = encode_size - offset;
+        uint8_t *block = scratch_buffer();
+        decode_block(input_buffer, block_idx, block, position_within_block + len);
+        std::memcpy(dest_buffer, block + position_within_block, len);
       }
-
-      LZ4_decompress_safe((char *) input_buffer + offset,
-                          (char *) dest_buffer + len, static_cast<int>(compress_size),
-                          static_cast<int>(BYTES_PER_BLOCK));
-      len += BYTES_PER_BLOCK;
-      length -= BYTES_PER_BLOCK;
-      compress_index++;
+      dest_buffer += len;
+      length -= len;
+      block_idx++;
+      position_within_block = 0;
     }
-
-    if (length > 0) {
-      uint8_t *tail = new uint8_t[BYTES_PER_BLOCK];
-
-      offset = *reinterpret_cast<size_t *>(input_buffer +
-          compress_index * sizeof(size_t));
-
-      if (compress_index + 1 < max_index) {
-        compress_size = *reinterpret_cast<size_t *>(input_buffer +
-            (compress_index + 1) * sizeof(size_t)) - offset;
-      } else {
-        compress_size = encode_size - offset;
-      }
-
-      LZ4_decompress_safe((char *) input_buffer + offset,
-                          (char *) tail, static_cast<int>(compress_size), static_cast<int>(BYTES_PER_BLOCK));
-      std::memcpy(dest_buffer + len, tail, length);
-      delete[] tail;
-    }
-
   }
 
   /**
@@ -119,35 +64,8 @@ class lz4_decoder {
    * @return The decoded byte
    */
   static uint8_t decode(uint8_t *input_buffer, size_t src_index) {
-
-    size_t decoded_buf_size = decoded_size(input_buffer);
-    size_t encode_size = lz4_encoder<BYTES_PER_BLOCK>::get_buffer_size(decoded_buf_size);
-    input_buffer += sizeof(size_t);
-
-    int compress_index = static_cast<int>(src_index / BYTES_PER_BLOCK);
-    int position_within_block = static_cast<int>(src_index % BYTES_PER_BLOCK);
-
-    // Gets the offset into the buffer where the desired block lies
-    size_t offset = *reinterpret_cast<size_t *>(input_buffer + compress_index * sizeof(size_t));
-    uint8_t *temp_buffer = new uint8_t[BYTES_PER_BLOCK];
-
-    size_t compress_size = 0;
-    int max_index = static_cast<int>(decoded_buf_size / BYTES_PER_BLOCK);
-
-    // Gets the size of the encoded block
-    if (compress_index + 1 < max_index) {
-      compress_size = *reinterpret_cast<size_t *>(input_buffer +
-          (compress_index + 1) * sizeof(size_t)) - offset;
-    } else {
-      compress_size = encode_size - offset;
-    }
-
-    LZ4_decompress_safe((char *) input_buffer + offset, (char *) temp_buffer, static_cast<int>(compress_size),
-                        static_cast<int>(BYTES_PER_BLOCK));
     uint8_t val;
-    // Gets the desired byte into the buffer
-    std::memcpy(&val, &temp_buffer[position_within_block], sizeof(uint8_t));
-    delete[] temp_buffer;
+    decode(input_buffer, &val, src_index, 1);
     return val;
   }
 
@@ -159,16 +77,54 @@ class lz4_decoder {
    * @param src_index The index into the unencoded buffer to start decoding the pointer from
    */
   static void decode(uint8_t *input_buffer, uint8_t *dest_buffer, size_t src_index = 0) {
-    size_t length = decoded_size(input_buffer) - src_index;
-    size_t decoded_buf_size = decoded_size(input_buffer);
-    size_t encode_size = lz4_encoder<BYTES_PER_BLOCK>::get_buffer_size(decoded_buf_size);
-    decode(input_buffer, dest_buffer, src_index, length);
+    decode(input_buffer, dest_buffer, src_index, decoded_size(input_buffer) - src_index);
   }
 
   static size_t decoded_size(uint8_t *input_buffer) {
     return *reinterpret_cast<size_t *>(input_buffer);
   }
 
+ private:
+  /**
+   * Decompresses a prefix of an encoded block
+   *
+   * @param input_buffer The LZ4 encoded buffer
+   * @param block_idx The index of the block
+   * @param dest_buffer The destination buffer, of at least BYTES_PER_BLOCK bytes
+   * @param target_size The number of bytes of the block to decompress
+   */
+  static void decode_block(uint8_t *input_buffer, size_t block_idx, uint8_t *dest_buffer, size_t target_size) {
+    size_t decoded_buf_size = decoded_size(input_buffer);
+    size_t encode_size = lz4_encoder<BYTES_PER_BLOCK>::get_buffer_size(decoded_buf_size);
+    input_buffer += sizeof(size_t);
+
+    size_t max_index = decoded_buf_size / BYTES_PER_BLOCK;
+    size_t offset = *reinterpret_cast<size_t *>(input_buffer + block_idx * sizeof(size_t));
+    size_t compress_size = 0;
+    if (block_idx + 1 < max_index) {
+      compress_size = *reinterpret_cast<size_t *>(input_buffer + (block_idx + 1) * sizeof(size_t)) - offset;
+    } else {
+      compress_size = encode_size - offset;
+    }
+
+    LZ4_decompress_safe_partial((char *) input_buffer + offset, (char *) dest_buffer,
+                                static_cast<int>(compress_size), static_cast<int>(target_size),
+                                static_cast<int>(BYTES_PER_BLOCK));
+  }
+
+  /**
+   * Gets a block-sized buffer owned by the calling thread, for blocks that
+   * are only partially copied out
+   *
+   * @return The buffer
+   */
+  static uint8_t *scratch_buffer() {
+    static thread_local std::unique_ptr<uint8_t[]> buffer;
+    if (buffer == nullptr)
+      buffer.reset(new uint8_t[BYTES_PER_BLOCK]);
+    return buffer.get();
+  }
+
 };
 
 }
@@ -41,6 +41,32 @@ class archival_configuration_params {
     return conf::instance().get<size_t>("max_archival_file_size", archival_defaults::DEFAULT_MAX_FILE_SIZE());
   }
 
+  // Size of the extents archive files are mapped in; 0 maps each archived bucket separately.
+  static size_t MAP_EXTENT_SIZE() {
+    return conf::instance().get<size_t>("archival_map_extent_size", archival_defaults::DEFAULT_MAP_EXTENT_SIZE());
+  }
+
+  // Bytes of appended archival data buffered before they are written out ahead of a commit.
+  static size_t WRITE_BUFFER_SIZE() {
+    return conf::instance().get<size_t>("archival_write_buffer_size", archival_defaults::DEFAULT_WRITE_BUFFER_SIZE());
+  }
+
+  // Whether committing an archival transaction waits for its data to be durable (0 or 1).
+  static bool SYNC_ON_COMMIT() {
+    return conf::instance().get<bool>("archival_sync_on_commit", archival_defaults::DEFAULT_SYNC_ON_COMMIT());
+  }
+
+  // Committed archival actions after which the transaction log is synced; 0 syncs only at the end of a pass.
+  static size_t MAX_PENDING_COMMITS() {
+    return conf::instance().get<size_t>("archival_max_pending_commits",
+                                        archival_defaults::DEFAULT_MAX_PENDING_COMMITS());
+  }
+
+  // Number of threads that run the archival tasks of all multilogs.
+  static int NUM_THREADS() {
+    return conf::instance().get<int>("archival_num_threads", archival_defaults::DEFAULT_NUM_THREADS());
+  }
+
   // Archival compression parameters; TODO parse types
   static uint8_t DATA_LOG_ENCODING_TYPE() {
     return configuration_parser::to_encoding_type(
@@ -74,6 +100,28 @@ class configuration_params {
     return conf::instance().get<double>("index_block_size", defaults::DEFAULT_INDEX_BUCKET_SIZE());
   }
 
+  /** Size of the first data log bucket of a new multilog; later buckets double in size */
+  static size_t DATA_LOG_FIRST_BUCKET_SIZE() {
+    return conf::instance().get<size_t>("data_log_first_bucket_size",
+                                        defaults::DEFAULT_DATA_LOG_FIRST_BUCKET_SIZE());
+  }
+
+  /** Size at which data log buckets stop growing; set both sizes equal for fixed-size buckets */
+  static size_t DATA_LOG_MAX_BUCKET_SIZE() {
+    return conf::instance().get<size_t>("data_log_max_bucket_size", defaults::DEFAULT_DATA_LOG_MAX_BUCKET_SIZE());
+  }
+
+  /** Initial number of buckets in a hash index; buckets double as keys are added */
+  static size_t HASH_INDEX_NUM_BUCKETS() {
+    return conf::instance().get<size_t>("hash_index_num_buckets", defaults::DEFAULT_HASH_INDEX_NUM_BUCKETS());
+  }
+
+  /** Maximum number of intervals an aggregate series query may return */
+  static size_t MAX_AGGREGATE_SERIES_POINTS() {
+    return conf::instance().get<size_t>("max_aggregate_series_points",
+                                        defaults::DEFAULT_MAX_AGGREGATE_SERIES_POINTS());
+  }
+
   /** Time resolution */
   static uint64_t TIME_RESOLUTION_NS() {
     return conf::instance().get<uint64_t>("time_resolution_ns", defaults::DEFAULT_TIME_RESOLUTION_NS());
@@ -88,6 +136,21 @@ class configuration_params {
   static uint64_t MONITOR_PERIODICITY_MS() {
     return conf::instance().get<uint64_t>("monitor_periodicity_ms", defaults::DEFAULT_MONITOR_PERIODICITY_MS());
   }
+
+  /** Number of threads that run the monitor tasks of all multilogs */
+  static int SCHEDULER_NUM_THREADS() {
+    return conf::instance().get<int>("scheduler_num_threads", defaults::DEFAULT_SCHEDULER_NUM_THREADS());
+  }
+
+  /** Backfill configuration parameters */
+  static int BACKFILL_CONCURRENCY() {
+    return conf::instance().get<int>("backfill_concurrency", defaults::DEFAULT_BACKFILL_CONCURRENCY());
+  }
+
+  /** Number of records scanned per backfill partition */
+  static uint64_t BACKFILL_CHUNK_RECORDS() {
+    return conf::instance().get<uint64_t>("backfill_chunk_records", defaults::DEFAULT_BACKFILL_CHUNK_RECORDS());
+  }
 };
 
 }
@@ -1,6 +1,7 @@
 #ifndef CONFLUO_CONF_DEFAULTS_H_
 #define CONFLUO_CONF_DEFAULTS_H_
 
+#include <algorithm>
 #include <thread>
 #include "configuration_parser.h"
 #include "storage/ptr_aux_block.h"
@@ -20,6 +21,26 @@ class archival_defaults {
     return 1024 * 1024 * 1024;
   }
 
+  static inline size_t DEFAULT_MAP_EXTENT_SIZE() {
+    return 64 * 1024 * 1024;
+  }
+
+  static inline size_t DEFAULT_WRITE_BUFFER_SIZE() {
+    return 1024 * 1024;
+  }
+
+  static inline bool DEFAULT_SYNC_ON_COMMIT() {
+    return true;
+  }
+
+  static inline size_t DEFAULT_MAX_PENDING_COMMITS() {
+    return 256;
+  }
+
+  static inline int DEFAULT_NUM_THREADS() {
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()) / 8);
+  }
+
   static inline std::string DEFAULT_DATA_LOG_ENCODING_TYPE() {
     return encoding_params::LZ4();
   }
@@ -53,6 +74,26 @@ class defaults {
     return 1.0;
   }
 
+  /** Default size of the first data log bucket */
+  static inline size_t DEFAULT_DATA_LOG_FIRST_BUCKET_SIZE() {
+    return 65536;
+  }
+
+  /** Default size at which data log buckets stop growing */
+  static inline size_t DEFAULT_DATA_LOG_MAX_BUCKET_SIZE() {
+    return 67108864;
+  }
+
+  /** Default initial number of buckets in a hash index */
+  static inline size_t DEFAULT_HASH_INDEX_NUM_BUCKETS() {
+    return static_cast<size_t>(1) << 10;
+  }
+
+  /** Default maximum number of intervals in an aggregate series */
+  static inline size_t DEFAULT_MAX_AGGREGATE_SERIES_POINTS() {
+    return static_cast<size_t>(1) << 16;
+  }
+
   /** Default time resolution in nanoseconds */
   static inline uint64_t DEFAULT_TIME_RESOLUTION_NS() {
     return static_cast<const uint64_t>(1e6);
@@ -77,6 +118,21 @@ class defaults {
   static inline uint64_t DEFAULT_MONITOR_PERIODICITY_MS() {
     return 1;
   }
+
+  /** Default number of threads that run multilog monitor tasks */
+  static inline int DEFAULT_SCHEDULER_NUM_THREADS() {
+    return std::max(2, HARDWARE_CONCURRENCY() / 4);
+  }
+
+  /** Default number of threads used to backfill a new index or filter */
+  static inline int DEFAULT_BACKFILL_CONCURRENCY() {
+    return std::max(1, HARDWARE_CONCURRENCY() / 2);
+  }
+
+  /** Default number of records scanned per backfill partition */
+  static inline uint64_t DEFAULT_BACKFILL_CHUNK_RECORDS() {
+    return 16384;
+  }
 };
 
 }
@@ -2,11 +2,15 @@
 #define CONFLUO_CONFLUO_STORE_H_
 
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include "optional.h"
 #include "exceptions.h"
 #include "atomic_multilog.h"
 #include "file_utils.h"
+#include "ingest/shm_ingest.h"
 #include "storage/storage.h"
 #include "threads/task_pool.h"
 
@@ -96,7 +100,59 @@ class confluo_store {
    */
   int64_t remove_atomic_multilog(int64_t id);
 
+  /**
+   * Creates an atomic multilog that holds the results of a materialized
+   * view, and adds the view to the source atomic multilog
+   *
+   * @param name The name of the view and of the created atomic multilog
+   * @param source The name of the source atomic multilog
+   * @param filter_name The name of the filter the view is defined on
+   * @param group_by The column to group by; empty for no grouping
+   * @param aggregate_exprs The aggregate expressions (e.g., sum(temp))
+   * @param window_ms The width of each window in milliseconds
+   * @param mode The storage mode of the created atomic multilog
+   * @return The id of the created atomic multilog
+   * @throw management_exception If the view cannot be created
+   */
+  int64_t create_materialized_view(const std::string &name,
+                                   const std::string &source,
+                                   const std::string &filter_name,
+                                   const std::string &group_by,
+                                   const std::vector<std::string> &aggregate_exprs,
+                                   uint64_t window_ms,
+                                   storage::storage_mode mode = storage::IN_MEMORY);
+
+  /**
+   * Enables shared-memory ingest: every atomic multilog in the store,
+   * including ones created or loaded later, gets a ring named after it
+   * in the given directory, which local producers can attach to and write
+   * records into. Multilogs whose schema has variable-length columns are
+   * skipped.
+   *
+   * @param dir The directory of the ring files, e.g., /dev/shm
+   * @param capacity The number of records in each ring
+   */
+  void enable_shm_ingest(const std::string &dir,
+                         size_t capacity = ingest::shm_ingest::DEFAULT_CAPACITY);
+
+  /**
+   * Gets the path of the shared-memory ring of an atomic multilog
+   *
+   * @param name The name of the atomic multilog
+   * @return The path of the ring file
+   * @throw management_exception If the multilog has no ring
+   */
+  std::string get_shm_ingest_path(const std::string &name) const;
+
  private:
+  /**
+   * Creates and starts draining the shared-memory ring of an atomic
+   * multilog, if shared-memory ingest is enabled
+   *
+   * @param mlog The atomic multilog
+   */
+  void start_shm_ingest(atomic_multilog *mlog);
+
   /**
    * Memory management task
    */
@@ -159,6 +215,12 @@ class confluo_store {
   // Tables
   monolog::monolog_exp2<atomic_multilog *> atomic_multilogs_;
   string_map<size_t> multilog_map_;
+
+  // Shared-memory ingest
+  mutable std::mutex shm_ingest_mtx_;
+  std::string shm_ingest_dir_;
+  size_t shm_ingest_capacity_;
+  std::map<std::string, std::unique_ptr<ingest::shm_ingest>> shm_ingests_;
 };
 
 }
@@ -22,11 +22,12 @@ class trigger_alert_cursor : public alert_cursor {
   /**
    * Initializes a trigger alert cursor
    *
-   * @param alerts The list of alerts
-   * @param trigger_name The name of the trigger
+   * @param index The alert index the alerts belong to
+   * @param alerts The lists of alerts, returned in order
    * @param batch_size The number of records in the batch
    */
-  trigger_alert_cursor(const alert_list &alerts, const std::string &trigger_name, size_t batch_size = 64);
+  trigger_alert_cursor(const monitor::alert_index *index, std::vector<alert_list> &&alerts,
+                       size_t batch_size = 64);
 
   /**
    * Loads the next record batch
@@ -36,9 +37,11 @@ class trigger_alert_cursor : public alert_cursor {
   virtual size_t load_next_batch() override;
 
  private:
+  const monitor::alert_index *index_;
+  std::vector<alert_list> alerts_;
+  size_t cur_list_;
   alert_iterator cur_;
   alert_iterator end_;
-  std::string trigger_name_;
 };
 
 }
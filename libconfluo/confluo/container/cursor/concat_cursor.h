@@ -0,0 +1,60 @@
+#ifndef CONFLUO_CONTAINER_CURSOR_CONCAT_CURSOR_H_
+#define CONFLUO_CONTAINER_CURSOR_CONCAT_CURSOR_H_
+
+#include <memory>
+#include <vector>
+
+#include "batched_cursor.h"
+
+namespace confluo {
+
+/**
+ * A cursor that returns the elements of several cursors, one cursor after
+ * the other
+ */
+template<typename T>
+class concat_cursor : public batched_cursor<T> {
+ public:
+  /** The type of the concatenated cursors */
+  typedef batched_cursor<T> cursor_t;
+
+  /**
+   * Initializes the concatenated cursor
+   *
+   * @param cursors The cursors, returned in order
+   * @param batch_size The number of elements in a batch
+   */
+  concat_cursor(std::vector<std::unique_ptr<cursor_t>> &&cursors, size_t batch_size = 64)
+      : batched_cursor<T>(batch_size),
+        cursors_(std::move(cursors)),
+        cur_(0) {
+    this->init();
+  }
+
+  /**
+   * Loads the next batch in the cursor
+   *
+   * @return The size of the batch
+   */
+  virtual size_t load_next_batch() override {
+    size_t i = 0;
+    while (i < this->current_batch_.size() && cur_ < cursors_.size()) {
+      cursor_t *c = cursors_[cur_].get();
+      if (!c->has_more()) {
+        cur_++;
+        continue;
+      }
+      this->current_batch_[i++] = c->get();
+      c->advance();
+    }
+    return i;
+  }
+
+ private:
+  std::vector<std::unique_ptr<cursor_t>> cursors_;
+  size_t cur_;
+};
+
+}
+
+#endif /* CONFLUO_CONTAINER_CURSOR_CONCAT_CURSOR_H_ */
@@ -1,6 +1,9 @@
 #ifndef CONFLUO_CONTAINER_CURSOR_OFFSET_CURSORS_H_
 #define CONFLUO_CONTAINER_CURSOR_OFFSET_CURSORS_H_
 
+#include <memory>
+#include <vector>
+
 #include "batched_cursor.h"
 
 namespace confluo {
@@ -80,6 +83,32 @@ class offset_iterator_cursor : public offset_cursor {
   uint64_t version_;
 };
 
+/**
+ * A cursor over the concatenation of a list of offset cursors; offsets
+ * present in more than one cursor are returned once per cursor.
+ */
+class union_offset_cursor : public offset_cursor {
+ public:
+  /**
+   * Initializes the union offset cursor
+   *
+   * @param cursors The offset cursors to concatenate
+   * @param batch_size The number of records in a batch
+   */
+  union_offset_cursor(std::vector<std::unique_ptr<offset_cursor>> &&cursors, size_t batch_size = 64);
+
+  /**
+   * Loads the next batch in the cursor
+   *
+   * @return The size of the next batch
+   */
+  virtual size_t load_next_batch() override;
+
+ private:
+  std::vector<std::unique_ptr<offset_cursor>> cursors_;
+  size_t cur_;
+};
+
 }
 
 #endif /* CONFLUO_CONTAINER_CURSOR_OFFSET_CURSORS_H_ */
@@ -48,6 +48,36 @@ class distinct_record_cursor : public record_cursor {
  */
 std::unique_ptr<record_cursor> make_distinct(std::unique_ptr<record_cursor> r_cursor, size_t batch_size = 64);
 
+/**
+ * A record cursor over the records at the offsets of an offset cursor
+ */
+class offset_record_cursor : public record_cursor {
+ public:
+  /**
+   * Initializes the offset record cursor
+   *
+   * @param o_cursor The offset cursor
+   * @param dlog The data log pointer
+   * @param schema The schema
+   * @param batch_size The number of records in the batch
+   */
+  offset_record_cursor(std::unique_ptr<offset_cursor> o_cursor,
+                       const data_log *dlog, const schema_t *schema,
+                       size_t batch_size = 64);
+
+  /**
+   * Loads the next batch from the cursor
+   *
+   * @return The size of the batch
+   */
+  virtual size_t load_next_batch() override;
+
+ private:
+  std::unique_ptr<offset_cursor> o_cursor_;
+  const data_log *dlog_;
+  const schema_t *schema_;
+};
+
 /**
  * A record cursor that filters out records
  */
@@ -78,7 +108,8 @@ class filter_record_cursor : public record_cursor {
   std::unique_ptr<offset_cursor> o_cursor_;
   const data_log *dlog_;
   const schema_t *schema_;
-  const parser::compiled_expression &cexpr_;
+  // Held by value: the cursor outlives the query plan that creates it
+  parser::compiled_expression cexpr_;
 };
 
 }
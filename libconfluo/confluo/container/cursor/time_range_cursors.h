@@ -0,0 +1,151 @@
+#ifndef CONFLUO_CONTAINER_CURSOR_TIME_RANGE_CURSORS_H_
+#define CONFLUO_CONTAINER_CURSOR_TIME_RANGE_CURSORS_H_
+
+#include <utility>
+#include <vector>
+
+#include "offset_cursors.h"
+#include "container/data_log.h"
+#include "container/radix_tree.h"
+
+namespace confluo {
+
+/**
+ * Reads the timestamp of a record
+ *
+ * @param dlog The data log
+ * @param offset The data log offset of the record
+ *
+ * @return The timestamp of the record
+ */
+uint64_t record_timestamp(const data_log *dlog, uint64_t offset);
+
+/**
+ * A cursor over the records in a contiguous range of the data log, in
+ * forward or reverse order
+ */
+class data_log_range_cursor : public offset_cursor {
+ public:
+  /**
+   * Initializes the data log range cursor
+   *
+   * @param begin The offset of the first record in the range
+   * @param end The offset past the last record in the range
+   * @param record_size The size of the record
+   * @param reverse Whether to return records in reverse order
+   * @param batch_size The number of records in a batch
+   */
+  data_log_range_cursor(uint64_t begin, uint64_t end, uint64_t record_size, bool reverse,
+                        size_t batch_size = 64);
+
+  /**
+   * Loads the next batch in the cursor
+   *
+   * @return The size of the batch
+   */
+  virtual size_t load_next_batch() override;
+
+ private:
+  uint64_t begin_;
+  uint64_t end_;
+  uint64_t record_size_;
+  bool reverse_;
+};
+
+/**
+ * A cursor over the records in a timestamp range, obtained by scanning the
+ * data log. Records are returned in timestamp order (ties in offset order),
+ * or the reverse. Each batch is selected by a scan of the data log that
+ * keeps only the batch_size earliest records past the previous batch, so
+ * memory is bounded by the batch size rather than by the number of matches,
+ * at the cost of one scan per batch.
+ */
+class time_scan_cursor : public offset_cursor {
+ public:
+  /**
+   * Initializes the time scan cursor
+   *
+   * @param dlog The data log
+   * @param record_size The size of the record
+   * @param begin_ts The beginning of the timestamp range (inclusive)
+   * @param end_ts The end of the timestamp range (inclusive)
+   * @param version The version of the data log
+   * @param reverse Whether to return records in reverse timestamp order
+   * @param batch_size The number of records in a batch
+   */
+  time_scan_cursor(const data_log *dlog, uint64_t record_size, uint64_t begin_ts, uint64_t end_ts,
+                   uint64_t version, bool reverse, size_t batch_size = 4096);
+
+  /**
+   * Loads the next batch in the cursor
+   *
+   * @return The size of the batch
+   */
+  virtual size_t load_next_batch() override;
+
+ private:
+  typedef std::pair<uint64_t, uint64_t> entry_t;
+
+  bool before(const entry_t &a, const entry_t &b) const;
+
+  const data_log *dlog_;
+  uint64_t record_size_;
+  uint64_t begin_ts_;
+  uint64_t end_ts_;
+  uint64_t version_;
+  bool reverse_;
+  bool started_;
+  bool done_;
+  entry_t last_;
+  std::vector<entry_t> heap_;
+};
+
+/**
+ * A cursor over the records in a timestamp range, obtained by walking a
+ * radix index on the timestamp column. Records are returned in timestamp
+ * order (ties in offset order), or the reverse; records that share an
+ * index bucket are sorted by their timestamps.
+ */
+class time_index_cursor : public offset_cursor {
+ public:
+  /**
+   * Initializes the time index cursor
+   *
+   * @param idx The radix index on the timestamp column
+   * @param bucket_size The bucket size of the index
+   * @param dlog The data log
+   * @param begin_ts The beginning of the timestamp range (inclusive)
+   * @param end_ts The end of the timestamp range (inclusive)
+   * @param version The version of the data log
+   * @param reverse Whether to return records in reverse timestamp order
+   * @param batch_size The number of records in a batch
+   */
+  time_index_cursor(const index::radix_index *idx, double bucket_size, const data_log *dlog,
+                    uint64_t begin_ts, uint64_t end_ts, uint64_t version, bool reverse,
+                    size_t batch_size = 64);
+
+  /**
+   * Loads the next batch in the cursor
+   *
+   * @return The size of the batch
+   */
+  virtual size_t load_next_batch() override;
+
+ private:
+  bool load_next_bucket();
+
+  const data_log *dlog_;
+  uint64_t begin_ts_;
+  uint64_t end_ts_;
+  uint64_t version_;
+  bool reverse_;
+  byte_string begin_key_;
+  byte_string end_key_;
+  index::radix_index::iterator it_;
+  std::vector<std::pair<uint64_t, uint64_t>> bucket_;
+  size_t bucket_pos_;
+};
+
+}
+
+#endif /* CONFLUO_CONTAINER_CURSOR_TIME_RANGE_CURSORS_H_ */
@@ -3,6 +3,7 @@
 
 #include "monolog/monolog.h"
 #include "archival/monolog_linear_archiver.h"
+#include "conf/configuration_params.h"
 
 namespace confluo {
 
@@ -11,24 +12,30 @@ namespace confluo {
  */
 class data_log_constants {
  public:
-  /** Maximum number of blocks */
-  static const size_t MAX_BUCKETS = 65536;
-  /** The size of each block */
+  /** The size of each block in data logs created without a bucket geometry */
   static const size_t BUCKET_SIZE = 67108864;
-  /** The size of the buffer */
+  /** The maximum size of the buffer following each block */
   static const size_t BUFFER_SIZE = 1048576;
 };
 
 typedef monolog::monolog_linear<uint8_t,
-                                data_log_constants::MAX_BUCKETS,
                                 data_log_constants::BUCKET_SIZE,
                                 data_log_constants::BUFFER_SIZE> data_log;
 
 typedef archival::monolog_linear_archiver<uint8_t,
-                                          data_log_constants::MAX_BUCKETS,
                                           data_log_constants::BUCKET_SIZE,
                                           data_log_constants::BUFFER_SIZE> data_log_archiver;
 
+/**
+ * Gets the configured bucket geometry for new data logs.
+ *
+ * @return The bucket geometry.
+ */
+inline monolog::bucket_geometry configured_data_log_geometry() {
+  return monolog::bucket_geometry(configuration_params::DATA_LOG_FIRST_BUCKET_SIZE(),
+                                  configuration_params::DATA_LOG_MAX_BUCKET_SIZE());
+}
+
 typedef storage::read_only_encoded_ptr<uint8_t> read_only_data_log_ptr;
 typedef storage::encoded_ptr<uint8_t> encoded_data_log_ptr;
 typedef storage::decoded_ptr<uint8_t> data_ptr;
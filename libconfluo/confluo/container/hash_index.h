@@ -0,0 +1,387 @@
+#ifndef CONFLUO_CONTAINER_HASH_INDEX_H_
+#define CONFLUO_CONTAINER_HASH_INDEX_H_
+
+#include <sstream>
+#include <string>
+
+#include "atomic.h"
+#include "bit_utils.h"
+#include "container/monolog/bucket_directory.h"
+#include "container/reflog.h"
+#include "storage/allocator.h"
+#include "types/byte_string.h"
+
+namespace confluo {
+namespace index {
+
+/**
+ * A node in the hash table list. Nodes are immutable once published, except
+ * for their next pointer, and store the key bytes inline, after the node
+ * header. Bucket sentinels carry no key and no reflog.
+ */
+template<typename reflog>
+struct hash_table_node {
+  /** The split-order key, which orders the hash table list */
+  uint64_t so_key;
+  /** The hash of the key */
+  uint64_t hash;
+  /** The next node in the list */
+  atomic::type<hash_table_node<reflog> *> next;
+  /** The reflog for the key; null for bucket sentinels */
+  reflog *refs;
+
+  /**
+   * Gets the key bytes stored after the node header
+   *
+   * @return Pointer to the key bytes
+   */
+  inline uint8_t *key() {
+    return reinterpret_cast<uint8_t *>(this + 1);
+  }
+
+  /**
+   * Gets the key bytes stored after the node header
+   *
+   * @return Pointer to the key bytes
+   */
+  inline const uint8_t *key() const {
+    return reinterpret_cast<const uint8_t *>(this + 1);
+  }
+};
+
+/**
+ * Hash table class. Maps fixed-size byte_string keys to reflogs using a
+ * split-ordered list: all keys live in a single lock-free list sorted by
+ * their bit-reversed hash, and each bucket points to a sentinel node in
+ * that list. Doubling the number of buckets only splits buckets, so the
+ * table grows with the number of keys without moving any node; new
+ * buckets are initialized lazily on first insert. Unlike the radix tree,
+ * the hash table only supports point lookups.
+ *
+ * @tparam reflog The reflog type.
+ */
+template<typename reflog>
+class hash_table {
+ public:
+  /** The node type */
+  typedef hash_table_node<reflog> node_t;
+  /** The bucket type */
+  typedef atomic::type<node_t *> bucket_t;
+  /** The key type */
+  typedef byte_string key_t;
+  /** The value type */
+  typedef typename reflog::value_type value_t;
+
+  /** Average number of keys per bucket above which the buckets double */
+  static const size_t MAX_LOAD = 2;
+
+  /**
+   * Constructor to initialize the hash table with a given key size and
+   * initial number of buckets
+   *
+   * @param key_size The size of each key in bytes
+   * @param num_buckets The initial number of buckets; rounded up to a power
+   * of two
+   */
+  hash_table(size_t key_size, size_t num_buckets)
+      : key_size_(key_size),
+        num_keys_(0) {
+    size_t n = 1;
+    while (n < num_buckets)
+      n <<= 1;
+    atomic::init(&num_buckets_, n);
+    node_t *head = new_sentinel(0);
+    atomic::store(&buckets_.at(0, init_bucket), head);
+  }
+
+  /**
+   * Deallocates all nodes and reflogs in the hash table
+   */
+  ~hash_table() {
+    node_t *node = atomic::load(buckets_.get(0));
+    while (node != nullptr) {
+      node_t *next = atomic::load(&node->next);
+      delete_node(node);
+      node = next;
+    }
+  }
+
+  /**
+   * Get the size of each key.
+   *
+   * @return The key size in bytes.
+   */
+  inline size_t key_size() const {
+    return key_size_;
+  }
+
+  /**
+   * Get the current number of buckets.
+   *
+   * @return The number of buckets.
+   */
+  inline size_t num_buckets() const {
+    return atomic::load(&num_buckets_);
+  }
+
+  /**
+   * Get the number of distinct keys in the hash table.
+   *
+   * @return The number of distinct keys.
+   */
+  inline size_t num_keys() const {
+    return atomic::load(&num_keys_);
+  }
+
+  /**
+   * Get the reflog for the specified key, and create one if such a key
+   * does not exist
+   *
+   * @tparam ARGS Template of arguments to reflog constructor.
+   * @param key The key for the reflog.
+   * @param args The args for the reflog constructor.
+   *
+   * @return The reflog corresponding to the given key.
+   */
+  template<typename ... ARGS>
+  reflog *get_or_create(const key_t &key, ARGS &&... args) {
+    uint64_t h = hash(key);
+    uint64_t so_key = regular_key(h);
+    node_t *sentinel = get_or_create_bucket(h & (num_buckets() - 1));
+    node_t *node = find(sentinel, key, h, so_key);
+    if (node != nullptr)
+      return node->refs;
+
+    node = new_node(key, h, so_key, std::forward<ARGS>(args)...);
+    node_t *linked = find_or_link(sentinel, node, [this, &key, h](const node_t *n) {
+      return matches(n, key, h);
+    });
+    if (linked != node) {
+      delete_node(node);
+      return linked->refs;
+    }
+
+    size_t nkeys = atomic::faa(&num_keys_, static_cast<size_t>(1)) + 1;
+    size_t nbuckets = num_buckets();
+    if (nkeys > nbuckets * MAX_LOAD) {
+      // Only one thread doubles the table for a given size
+      atomic::strong::cas(&num_buckets_, &nbuckets, nbuckets << 1);
+    }
+    return node->refs;
+  }
+
+  /**
+   * Insert a new (key, value) pair into the hash table.
+   *
+   * @tparam ARGS Template for arguments to the reflog constructor.
+   * @param key The key to insert.
+   * @param value The value to insert.
+   * @param args The arguments to the reflog constructor.
+   *
+   * @return The reflog to which the value was inserted.
+   */
+  template<typename ... ARGS>
+  reflog *insert(const key_t &key, const value_t &value, ARGS &&... args) {
+    reflog *refs = get_or_create(key, std::forward<ARGS>(args)...);
+    refs->push_back(value);
+    return refs;
+  }
+
+  /**
+   * Get the reflog corresponding to a given key; returns null if the key has
+   * not been indexed.
+   *
+   * @param key The key to lookup.
+   *
+   * @return The reflog corresponding to the key.
+   */
+  reflog const *get(const key_t &key) const {
+    uint64_t h = hash(key);
+    node_t *node = find(get_bucket(h & (num_buckets() - 1)), key, h, regular_key(h));
+    return node == nullptr ? nullptr : node->refs;
+  }
+
+  /**
+   * An approximate count (potentially inconsistent) of the values for a
+   * particular key.
+   *
+   * @param key The key to lookup.
+   *
+   * @return The approximate count.
+   */
+  size_t approx_count(const key_t &key) const {
+    reflog const *refs = get(key);
+    return refs == nullptr ? 0 : refs->size();
+  }
+
+  /**
+   * Get an estimate of the memory used by the hash table structure,
+   * excluding reflog contents.
+   *
+   * @return The size of the hash table structure in bytes.
+   */
+  size_t storage_size() const {
+    return sizeof(*this) + num_buckets() * (sizeof(bucket_t) + sizeof(node_t))
+        + num_keys() * (sizeof(node_t) + key_size_ + sizeof(reflog));
+  }
+
+  /**
+   * Get the string corresponding to the hash table address.
+   *
+   * @return The string corresponding to the hash table address.
+   */
+  std::string to_string() const {
+    const void *addr = static_cast<const void *>(this);
+    std::stringstream ss;
+    ss << addr;
+    return ss.str();
+  }
+
+ private:
+  uint64_t hash(const key_t &key) const {
+    // FNV-1a, followed by a 64-bit finalizer to spread low-entropy keys
+    uint64_t h = UINT64_C(14695981039346656037);
+    for (size_t i = 0; i < key_size_; i++) {
+      h ^= key[i];
+      h *= UINT64_C(1099511628211);
+    }
+    h ^= h >> 33;
+    h *= UINT64_C(0xff51afd7ed558ccd);
+    h ^= h >> 33;
+    return h;
+  }
+
+  // Keys sort after the sentinel of every bucket they may belong to;
+  // sentinel keys are even and regular keys odd, so the two never collide.
+  static uint64_t regular_key(uint64_t h) {
+    return bit_utils::reverse_64(h | (UINT64_C(1) << 63));
+  }
+
+  static uint64_t sentinel_key(size_t bucket_idx) {
+    return bit_utils::reverse_64(bucket_idx);
+  }
+
+  // The bucket that bucket_idx was split from
+  static size_t parent_bucket(size_t bucket_idx) {
+    return bucket_idx & ~(UINT64_C(1) << bit_utils::highest_bit(bucket_idx));
+  }
+
+  static void init_bucket(size_t, bucket_t &bucket) {
+    atomic::init(&bucket, static_cast<node_t *>(nullptr));
+  }
+
+  bool matches(const node_t *node, const key_t &key, uint64_t h) const {
+    if (node->hash != h)
+      return false;
+    const uint8_t *node_key = node->key();
+    for (size_t i = 0; i < key_size_; i++)
+      if (node_key[i] != key[i])
+        return false;
+    return true;
+  }
+
+  node_t *find(node_t *start, const key_t &key, uint64_t h, uint64_t so_key) const {
+    node_t *node = atomic::load(&start->next);
+    for (; node != nullptr && node->so_key <= so_key; node = atomic::load(&node->next))
+      if (node->so_key == so_key && matches(node, key, h))
+        return node;
+    return nullptr;
+  }
+
+  // Returns the first node after prev with the same split-order key as node
+  // that satisfies match; otherwise links node into the list and returns it.
+  template<typename M>
+  node_t *find_or_link(node_t *prev, node_t *node, M match) {
+    uint64_t so_key = node->so_key;
+    while (true) {
+      node_t *next = atomic::load(&prev->next);
+      if (next != nullptr && next->so_key <= so_key) {
+        if (next->so_key == so_key && match(next))
+          return next;
+        prev = next;
+        continue;
+      }
+      // Nodes are never removed, so on failure the scan resumes at prev
+      atomic::store(&node->next, next);
+      if (atomic::strong::cas(&prev->next, &next, node))
+        return node;
+    }
+  }
+
+  // Gets the sentinel of the closest initialized ancestor of the bucket,
+  // which precedes all keys of the bucket in the list
+  node_t *get_bucket(size_t bucket_idx) const {
+    while (true) {
+      bucket_t *bucket = buckets_.get(bucket_idx);
+      node_t *sentinel = bucket == nullptr ? nullptr : atomic::load(bucket);
+      if (sentinel != nullptr)
+        return sentinel;
+      bucket_idx = parent_bucket(bucket_idx);
+    }
+  }
+
+  node_t *get_or_create_bucket(size_t bucket_idx) {
+    bucket_t &bucket = buckets_.at(bucket_idx, init_bucket);
+    node_t *sentinel = atomic::load(&bucket);
+    if (sentinel != nullptr)
+      return sentinel;
+
+    // All threads initializing the bucket link or find the same sentinel
+    node_t *parent = get_or_create_bucket(parent_bucket(bucket_idx));
+    node_t *node = new_sentinel(sentinel_key(bucket_idx));
+    sentinel = find_or_link(parent, node, [](const node_t *) {
+      return true;
+    });
+    if (sentinel != node)
+      delete_node(node);
+    atomic::store(&bucket, sentinel);
+    return sentinel;
+  }
+
+  node_t *new_sentinel(uint64_t so_key) {
+    node_t *node = static_cast<node_t *>(allocator::instance().alloc(sizeof(node_t)));
+    node->so_key = so_key;
+    node->hash = 0;
+    atomic::init(&node->next, static_cast<node_t *>(nullptr));
+    node->refs = nullptr;
+    return node;
+  }
+
+  template<typename ... ARGS>
+  node_t *new_node(const key_t &key, uint64_t h, uint64_t so_key, ARGS &&... args) {
+    void *raw = allocator::instance().alloc(sizeof(node_t) + key_size_);
+    node_t *node = static_cast<node_t *>(raw);
+    node->so_key = so_key;
+    node->hash = h;
+    atomic::init(&node->next, static_cast<node_t *>(nullptr));
+    for (size_t i = 0; i < key_size_; i++)
+      node->key()[i] = key[i];
+    void *raw_refs = allocator::instance().alloc(sizeof(reflog));
+    node->refs = new(raw_refs) reflog(std::forward<ARGS>(args)...);
+    return node;
+  }
+
+  void delete_node(node_t *node) {
+    if (node->refs != nullptr) {
+      node->refs->~reflog();
+      allocator::instance().dealloc(node->refs);
+    }
+    allocator::instance().dealloc(node);
+  }
+
+  size_t key_size_;
+  atomic::type<size_t> num_buckets_;
+  atomic::type<size_t> num_keys_;
+  mutable monolog::bucket_directory<bucket_t> buckets_;
+};
+
+template<typename reflog>
+const size_t hash_table<reflog>::MAX_LOAD;
+
+/** The hash index */
+typedef hash_table<reflog> hash_index;
+
+}
+}
+
+#endif /* CONFLUO_CONTAINER_HASH_INDEX_H_ */
@@ -0,0 +1,124 @@
+#ifndef CONFLUO_CONTAINER_MONOLOG_BUCKET_DIRECTORY_H_
+#define CONFLUO_CONTAINER_MONOLOG_BUCKET_DIRECTORY_H_
+
+#include <array>
+
+#include "atomic.h"
+#include "bit_utils.h"
+
+namespace confluo {
+namespace monolog {
+
+using namespace ::utils;
+
+/**
+ * Directory of buckets that grows as buckets are accessed. Buckets are
+ * stored in chunks that double in size, so that a directory that only
+ * covers a few buckets stays small, while the number of buckets is
+ * practically unbounded.
+ */
+template<typename T, size_t NCHUNKS = 48>
+class bucket_directory {
+ public:
+  /** The number of buckets in the first chunk */
+  static const size_t FCS = 16;
+  /** The high bit of the first chunk size */
+  static const size_t FCS_HIBIT = 4;
+
+  /** The chunk reference type */
+  typedef atomic::type<T *> __atomic_chunk_ref;
+
+  /**
+   * Constructs an empty directory.
+   */
+  bucket_directory() {
+    T *null_ptr = nullptr;
+    for (auto &x : chunks_) {
+      atomic::init(&x, null_ptr);
+    }
+  }
+
+  bucket_directory(const bucket_directory &other) = delete;
+
+  bucket_directory &operator=(const bucket_directory &other) = delete;
+
+  /**
+   * Deletes all chunks.
+   */
+  ~bucket_directory() {
+    clear();
+  }
+
+  /**
+   * Gets the bucket at the given index, allocating its chunk if necessary.
+   * Each bucket of a newly allocated chunk is passed to init along with its
+   * index before the chunk is published.
+   *
+   * @param idx The bucket index.
+   * @param init The bucket initializer.
+   * @return The bucket.
+   */
+  template<typename F>
+  T &at(size_t idx, F init) {
+    size_t pos = idx + FCS;
+    size_t hibit = bit_utils::highest_bit(pos);
+    size_t chunk_idx = hibit - FCS_HIBIT;
+    T *chunk;
+    if ((chunk = atomic::load(&chunks_[chunk_idx])) == nullptr) {
+      chunk = try_allocate_chunk(chunk_idx, init);
+    }
+    return chunk[pos ^ (UINT64_C(1) << hibit)];
+  }
+
+  /**
+   * Gets the bucket at the given index if its chunk is allocated.
+   *
+   * @param idx The bucket index.
+   * @return The bucket, or nullptr if its chunk is not allocated.
+   */
+  T *get(size_t idx) const {
+    size_t pos = idx + FCS;
+    size_t hibit = bit_utils::highest_bit(pos);
+    T *chunk = atomic::load(&chunks_[hibit - FCS_HIBIT]);
+    return chunk == nullptr ? nullptr : &chunk[pos ^ (UINT64_C(1) << hibit)];
+  }
+
+  /**
+   * Deletes all chunks. Not thread-safe.
+   */
+  void clear() {
+    for (auto &x : chunks_) {
+      delete[] atomic::load(&x);
+      atomic::store(&x, static_cast<T *>(nullptr));
+    }
+  }
+
+ private:
+  template<typename F>
+  T *try_allocate_chunk(size_t chunk_idx, F init) {
+    size_t size = (UINT64_C(1) << (chunk_idx + FCS_HIBIT));
+    size_t first_idx = size - FCS;
+    T *new_chunk = new T[size]();
+    for (size_t i = 0; i < size; i++) {
+      init(first_idx + i, new_chunk[i]);
+    }
+    T *expected = nullptr;
+
+    // Only one thread will be successful in replacing the NULL reference with
+    // the newly allocated chunk.
+    if (!atomic::strong::cas(&chunks_[chunk_idx], &expected, new_chunk)) {
+      // All other threads will deallocate the newly allocated chunk.
+      delete[] new_chunk;
+      return expected;
+    }
+
+    return new_chunk;
+  }
+
+  std::array<__atomic_chunk_ref, NCHUNKS> chunks_;
+};
+
+}
+}
+
+#endif /* CONFLUO_CONTAINER_MONOLOG_BUCKET_DIRECTORY_H_ */
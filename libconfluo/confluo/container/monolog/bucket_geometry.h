@@ -0,0 +1,150 @@
+#ifndef CONFLUO_CONTAINER_MONOLOG_BUCKET_GEOMETRY_H_
+#define CONFLUO_CONTAINER_MONOLOG_BUCKET_GEOMETRY_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "bit_utils.h"
+
+namespace confluo {
+namespace monolog {
+
+using namespace ::utils;
+
+/**
+ * Sizes of the buckets of a linear monolog. Buckets start at the first
+ * bucket size and double in size until they reach the maximum bucket size,
+ * after which all buckets have the maximum size; a monolog that only ever
+ * holds a little data thus only allocates small buckets. Both sizes are
+ * rounded up to powers of two, so that the bucket holding an offset is
+ * found with a single bit operation. Equal sizes give fixed-size buckets.
+ */
+class bucket_geometry {
+ public:
+  /**
+   * Constructs a geometry with the given first and maximum bucket sizes.
+   *
+   * @param first_bucket_size The size of the first bucket.
+   * @param max_bucket_size The size of the largest buckets.
+   */
+  bucket_geometry(size_t first_bucket_size, size_t max_bucket_size)
+      : first_hibit_(bit_utils::highest_bit(round_up(first_bucket_size))),
+        max_hibit_(std::max<size_t>(first_hibit_, bit_utils::highest_bit(round_up(max_bucket_size)))),
+        growth_buckets_(max_hibit_ - first_hibit_),
+        growth_end_((UINT64_C(1) << max_hibit_) - (UINT64_C(1) << first_hibit_)) {
+  }
+
+  /**
+   * Constructs a geometry where all buckets have the same size.
+   *
+   * @param bucket_size The size of each bucket.
+   * @return The geometry.
+   */
+  static bucket_geometry fixed(size_t bucket_size) {
+    return bucket_geometry(bucket_size, bucket_size);
+  }
+
+  /**
+   * Gets a geometry with the same maximum bucket size whose buckets hold
+   * at least the given number of elements.
+   *
+   * @param min_bucket_size The minimum bucket size.
+   * @return The geometry.
+   */
+  bucket_geometry at_least(size_t min_bucket_size) const {
+    return bucket_geometry(std::max(first_bucket_size(), min_bucket_size),
+                           std::max(max_bucket_size(), min_bucket_size));
+  }
+
+  /**
+   * Gets the size of the first bucket.
+   *
+   * @return The size of the first bucket.
+   */
+  size_t first_bucket_size() const {
+    return UINT64_C(1) << first_hibit_;
+  }
+
+  /**
+   * Gets the size of the largest buckets.
+   *
+   * @return The size of the largest buckets.
+   */
+  size_t max_bucket_size() const {
+    return UINT64_C(1) << max_hibit_;
+  }
+
+  /**
+   * Gets the index of the bucket holding an offset.
+   *
+   * @param offset The offset.
+   * @return The bucket index.
+   */
+  size_t bucket_idx(size_t offset) const {
+    if (offset >= growth_end_)
+      return growth_buckets_ + ((offset - growth_end_) >> max_hibit_);
+    return bit_utils::highest_bit((offset >> first_hibit_) + 1);
+  }
+
+  /**
+   * Gets the offset of the first element of a bucket.
+   *
+   * @param bucket_idx The bucket index.
+   * @return The offset of the bucket.
+   */
+  size_t bucket_start(size_t bucket_idx) const {
+    if (bucket_idx >= growth_buckets_)
+      return growth_end_ + ((bucket_idx - growth_buckets_) << max_hibit_);
+    return ((UINT64_C(1) << bucket_idx) - 1) << first_hibit_;
+  }
+
+  /**
+   * Gets the size of a bucket.
+   *
+   * @param bucket_idx The bucket index.
+   * @return The size of the bucket.
+   */
+  size_t bucket_size(size_t bucket_idx) const {
+    if (bucket_idx >= growth_buckets_)
+      return UINT64_C(1) << max_hibit_;
+    return UINT64_C(1) << (first_hibit_ + bucket_idx);
+  }
+
+  /**
+   * Checks whether two geometries lay out buckets identically.
+   *
+   * @param other The other geometry.
+   * @return True if the geometries are identical, false otherwise.
+   */
+  bool operator==(const bucket_geometry &other) const {
+    return first_hibit_ == other.first_hibit_ && max_hibit_ == other.max_hibit_;
+  }
+
+  /**
+   * Checks whether two geometries lay out buckets differently.
+   *
+   * @param other The other geometry.
+   * @return True if the geometries differ, false otherwise.
+   */
+  bool operator!=(const bucket_geometry &other) const {
+    return !(*this == other);
+  }
+
+ private:
+  static size_t round_up(size_t size) {
+    if (size <= 1)
+      return 1;
+    return UINT64_C(1) << (bit_utils::highest_bit(size - 1) + 1);
+  }
+
+  size_t first_hibit_;     // log2 of the first bucket size
+  size_t max_hibit_;       // log2 of the maximum bucket size
+  size_t growth_buckets_;  // Number of buckets smaller than the maximum
+  size_t growth_end_;      // Offset of the first bucket of maximum size
+};
+
+}
+}
+
+#endif /* CONFLUO_CONTAINER_MONOLOG_BUCKET_GEOMETRY_H_ */
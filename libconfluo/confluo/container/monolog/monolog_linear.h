@@ -1,12 +1,14 @@
 #ifndef CONFLUO_CONTAINER_MONOLOG_MONOLOG_LINEAR_H_
 #define CONFLUO_CONTAINER_MONOLOG_MONOLOG_LINEAR_H_
 
-#include <array>
+#include <algorithm>
 #include <vector>
 
 #include "monolog_iterator.h"
 #include "storage/swappable_encoded_ptr.h"
 #include "atomic.h"
+#include "bucket_directory.h"
+#include "bucket_geometry.h"
 #include "monolog_linear_bucket.h"
 #include "storage/storage.h"
 
@@ -15,24 +17,34 @@ namespace monolog {
 
 /**
  * Monolog linear base class. The monolog grow linearly, bucket-by-bucket, as
- * space runs out in previous blocks.
+ * space runs out in previous blocks. Bucket sizes follow the monolog's bucket
+ * geometry, and default to BUCKET_SIZE for every bucket.
  */
-template<typename T, size_t MAX_BUCKETS = 4096, size_t BUCKET_SIZE = 268435456, size_t BUFFER_SIZE = 1048576>
+template<typename T, size_t BUCKET_SIZE = 268435456, size_t BUFFER_SIZE = 1048576>
 class monolog_linear_base {
  public:
-  monolog_linear_base() = default;
+  /** The bucket type */
+  typedef monolog_linear_bucket<T, BUFFER_SIZE> bucket_type;
+
+  monolog_linear_base()
+      : geometry_(bucket_geometry::fixed(BUCKET_SIZE)),
+        mode_(storage::IN_MEMORY) {
+  }
 
   /**
-   * Constructor to initialize monolog with specified name, data path and
-   * storage mode.
+   * Constructor to initialize monolog with specified name, data path,
+   * storage mode and bucket geometry.
    *
    * @param name The name of the monolog.
    * @param data_path The data path where the monolog is stored.
    * @param storage The storage mode for the monolog.
+   * @param geometry The bucket geometry of the monolog.
    */
   monolog_linear_base(const std::string &name, const std::string &data_path,
-                      const storage::storage_mode &storage) {
-    init(name, data_path, storage);
+                      const storage::storage_mode &storage,
+                      const bucket_geometry &geometry = bucket_geometry::fixed(BUCKET_SIZE))
+      : geometry_(geometry) {
+    init(name, data_path, storage, geometry);
   }
 
   /**
@@ -41,8 +53,9 @@ class monolog_linear_base {
    * copying should be done by the super class.
    * @param other other monolog_linear
    */
-  monolog_linear_base(const monolog_linear_base &other) {
-    init(other.name_, other.data_path_, other.buckets_[0].mode());
+  monolog_linear_base(const monolog_linear_base &other)
+      : geometry_(other.geometry_) {
+    init(other.name_, other.data_path_, other.mode_, other.geometry_);
   }
 
   /**
@@ -55,31 +68,34 @@ class monolog_linear_base {
   monolog_linear_base &operator=(const monolog_linear_base &other) {
     if (&other == this)
       return *this;
-    init(other.name_, other.data_path_, other.buckets_[0].mode());
+    init(other.name_, other.data_path_, other.mode_, other.geometry_);
     return *this;
   }
 
   /**
-   * Initialize the monolog with specified name, data path and storage mode.
+   * Initialize the monolog with specified name, data path, storage mode
+   * and bucket geometry, dropping any existing buckets.
    *
    * @param name The name of the monolog.
    * @param data_path The data path where the monolog is stored.
    * @param storage The storage mode for the monolog.
+   * @param geometry The bucket geometry of the monolog.
    */
   void init(const std::string &name, const std::string &data_path,
-            const storage::storage_mode &storage) {
+            const storage::storage_mode &storage,
+            const bucket_geometry &geometry = bucket_geometry::fixed(BUCKET_SIZE)) {
     name_ = name;
     data_path_ = data_path;
-    for (size_t i = 0; i < MAX_BUCKETS; i++) {
-      buckets_[i].init(bucket_data_path(i), BUCKET_SIZE, storage);
-    }
+    mode_ = storage;
+    geometry_ = geometry;
+    buckets_.clear();
   }
 
   /**
    * Pre-allocates the first bucket.
    */
   void pre_alloc() {
-    buckets_[0].ensure_alloc();
+    bucket_at(0).ensure_alloc();
   }
 
   /**
@@ -92,11 +108,21 @@ class monolog_linear_base {
   }
 
   /**
-   * Get the bucket size.
+   * Get the bucket geometry of the monolog.
+   *
+   * @return The bucket geometry.
+   */
+  const bucket_geometry &geometry() const {
+    return geometry_;
+  }
+
+  /**
+   * Get the allocated size of a bucket, including its buffer.
+   * @param bucket_idx The bucket index.
    * @return The bucket size.
    */
-  size_t bucket_size() {
-    return BUCKET_SIZE + BUFFER_SIZE;
+  size_t bucket_size(size_t bucket_idx) const {
+    return bucket_type::alloc_size(geometry_.bucket_size(bucket_idx));
   }
 
   /**
@@ -123,10 +149,10 @@ class monolog_linear_base {
    * @param end_idx end index
    */
   void ensure_alloc(size_t start_idx, size_t end_idx) {
-    size_t bucket_idx1 = start_idx / BUCKET_SIZE;
-    size_t bucket_idx2 = end_idx / BUCKET_SIZE;
+    size_t bucket_idx1 = geometry_.bucket_idx(start_idx);
+    size_t bucket_idx2 = geometry_.bucket_idx(end_idx);
     for (size_t i = bucket_idx1; i <= bucket_idx2; i++) {
-      buckets_[i].ensure_alloc();
+      bucket_at(i).ensure_alloc();
     }
   }
 
@@ -136,7 +162,8 @@ class monolog_linear_base {
    * @param val value to set
    */
   void set(size_t idx, const T &val) {
-    buckets_[idx / BUCKET_SIZE].set(idx % BUCKET_SIZE, val);
+    size_t bucket_idx = geometry_.bucket_idx(idx);
+    bucket_at(bucket_idx).set(idx - geometry_.bucket_start(bucket_idx), val);
   }
 
   /**
@@ -146,24 +173,29 @@ class monolog_linear_base {
    * @param val value to set
    */
   void set_unsafe(size_t idx, const T val) {
-    buckets_[idx / BUCKET_SIZE].set_unsafe(idx % BUCKET_SIZE, val);
+    size_t bucket_idx = geometry_.bucket_idx(idx);
+    bucket_at(bucket_idx).set_unsafe(idx - geometry_.bucket_start(bucket_idx), val);
   }
 
   /**
-   * Write len bytes of data at idx. Allocates memory if necessary.
+   * Write len bytes of data at idx. Allocates memory if necessary. Data
+   * crossing into the next bucket is also written to the buffer of the
+   * bucket it starts in.
    * @param idx monolog index
    * @param data data to write
    * @param len length of data
    */
   void write(size_t idx, const T *data, size_t len) {
+    size_t bucket_idx = geometry_.bucket_idx(idx);
+    size_t bucket_off = idx - geometry_.bucket_start(bucket_idx);
     size_t remaining = len;
     while (remaining) {
-      size_t bucket_idx = idx / BUCKET_SIZE;
-      size_t bucket_off = idx % BUCKET_SIZE;
-      size_t bucket_len = std::min(BUCKET_SIZE - bucket_off, remaining);
-      buckets_[bucket_idx].write(bucket_off, data + len - remaining, bucket_len);
-      idx += bucket_len;
+      bucket_type &bucket = bucket_at(bucket_idx);
+      size_t bucket_len = std::min(geometry_.bucket_size(bucket_idx) - bucket_off, remaining);
+      bucket.write(bucket_off, data + len - remaining, std::min(remaining, bucket_len + bucket.buffer_size()));
       remaining -= bucket_len;
+      bucket_idx++;
+      bucket_off = 0;
     }
   }
 
@@ -175,24 +207,37 @@ class monolog_linear_base {
    * @param len length of data
    */
   void write_unsafe(size_t idx, const T *data, size_t len) {
+    size_t bucket_idx = geometry_.bucket_idx(idx);
+    size_t bucket_off = idx - geometry_.bucket_start(bucket_idx);
     size_t remaining = len;
     while (remaining) {
-      size_t bucket_idx = idx / BUCKET_SIZE;
-      size_t bucket_off = idx % BUCKET_SIZE;
-      size_t bucket_len = std::min(BUCKET_SIZE - bucket_off, remaining);
-      buckets_[bucket_idx].write_unsafe(bucket_off, data + len - remaining, bucket_len);
-      idx += bucket_len;
+      bucket_type &bucket = bucket_at(bucket_idx);
+      size_t bucket_len = std::min(geometry_.bucket_size(bucket_idx) - bucket_off, remaining);
+      bucket.write_unsafe(bucket_off, data + len - remaining, std::min(remaining, bucket_len + bucket.buffer_size()));
       remaining -= bucket_len;
+      bucket_idx++;
+      bucket_off = 0;
     }
   }
 
   /**
-   * Flush data at idx
+   * Flush data at idx, including the copies of data crossing into the
+   * next bucket.
    * @param idx monolog index
    * @param len length of data to flush
    */
   void flush(size_t idx, size_t len) {
-    buckets_[idx / BUCKET_SIZE].flush(idx % BUCKET_SIZE, len);
+    size_t bucket_idx = geometry_.bucket_idx(idx);
+    size_t bucket_off = idx - geometry_.bucket_start(bucket_idx);
+    size_t remaining = len;
+    while (remaining) {
+      bucket_type &bucket = bucket_at(bucket_idx);
+      size_t bucket_len = std::min(geometry_.bucket_size(bucket_idx) - bucket_off, remaining);
+      bucket.flush(bucket_off, std::min(remaining, bucket_len + bucket.buffer_size()));
+      remaining -= bucket_len;
+      bucket_idx++;
+      bucket_off = 0;
+    }
   }
 
   /**
@@ -201,7 +246,8 @@ class monolog_linear_base {
    * @return data
    */
   const T get(size_t idx) const {
-    return buckets_[idx / BUCKET_SIZE].at(idx % BUCKET_SIZE);
+    size_t bucket_idx = geometry_.bucket_idx(idx);
+    return bucket_at(bucket_idx).at(idx - geometry_.bucket_start(bucket_idx));
   }
 
   /**
@@ -211,14 +257,15 @@ class monolog_linear_base {
    * @param len The number of bytes to read.
    */
   void read(size_t offset, T *data, size_t len) const {
+    size_t bucket_idx = geometry_.bucket_idx(offset);
+    size_t bucket_off = offset - geometry_.bucket_start(bucket_idx);
     size_t remaining = len;
     while (remaining) {
-      size_t bucket_idx = offset / BUCKET_SIZE;
-      size_t bucket_off = offset % BUCKET_SIZE;
-      size_t bucket_len = std::min(BUCKET_SIZE - bucket_off, remaining);
-      buckets_[bucket_idx].read(bucket_off, data + len - remaining, bucket_len);
-      offset += bucket_len;
+      size_t bucket_len = std::min(geometry_.bucket_size(bucket_idx) - bucket_off, remaining);
+      bucket_at(bucket_idx).read(bucket_off, data + len - remaining, bucket_len);
       remaining -= bucket_len;
+      bucket_idx++;
+      bucket_off = 0;
     }
   }
 
@@ -228,7 +275,8 @@ class monolog_linear_base {
    * @param data_ptr read-only pointer to store in
    */
   void ptr(size_t idx, storage::read_only_encoded_ptr<T> &data_ptr) {
-    buckets_[idx / BUCKET_SIZE].ptr(idx % BUCKET_SIZE, data_ptr);
+    size_t bucket_idx = geometry_.bucket_idx(idx);
+    bucket_at(bucket_idx).ptr(idx - geometry_.bucket_start(bucket_idx), data_ptr);
   }
 
   /**
@@ -237,7 +285,8 @@ class monolog_linear_base {
    * @param data_ptr read-only pointer to store in
    */
   void cptr(size_t idx, storage::read_only_encoded_ptr<T> &data_ptr) const {
-    buckets_[idx / BUCKET_SIZE].cptr(idx % BUCKET_SIZE, data_ptr);
+    size_t bucket_idx = geometry_.bucket_idx(idx);
+    bucket_at(bucket_idx).cptr(idx - geometry_.bucket_start(bucket_idx), data_ptr);
   }
 
   /**
@@ -246,7 +295,8 @@ class monolog_linear_base {
    * @return Reference to requested data.
    */
   T &operator[](size_t idx) {
-    return buckets_[idx / BUCKET_SIZE][idx % BUCKET_SIZE];
+    size_t bucket_idx = geometry_.bucket_idx(idx);
+    return bucket_at(bucket_idx)[idx - geometry_.bucket_start(bucket_idx)];
   }
 
   /**
@@ -258,19 +308,37 @@ class monolog_linear_base {
 
   /**
    * Note: it's dangerous to modify this data structure.
-   * @return pointer to underlying array
+   * @param bucket_idx The bucket index.
+   * @return reference to the underlying bucket
    */
-  std::array<monolog_linear_bucket<T, BUFFER_SIZE>, MAX_BUCKETS> &data() {
-    return buckets_;
+  bucket_type &bucket(size_t bucket_idx) {
+    return bucket_at(bucket_idx);
   }
 
  protected:
+  /**
+   * Gets a bucket, growing the bucket directory if necessary; the
+   * directory grows on reads as well, since it is not part of the
+   * monolog's logical state.
+   * @param bucket_idx The bucket index.
+   * @return The bucket.
+   */
+  bucket_type &bucket_at(size_t bucket_idx) const {
+    return buckets_.at(bucket_idx, [this](size_t i, bucket_type &b) {
+      b.init(bucket_data_path(i), geometry_.bucket_size(i), mode_);
+    });
+  }
+
   /** The name of the monolog */
   std::string name_;
   /** The path for data of the monolog */
   std::string data_path_;
-  /** The array of monolog buckets */
-  std::array<monolog_linear_bucket<T, BUFFER_SIZE>, MAX_BUCKETS> buckets_;
+  /** The bucket geometry of the monolog */
+  bucket_geometry geometry_;
+  /** The storage mode of the monolog */
+  storage::storage_mode mode_;
+  /** The directory of monolog buckets */
+  mutable bucket_directory<bucket_type> buckets_;
 
 };
 
@@ -278,8 +346,8 @@ class monolog_linear_base {
  * Monolog linear class. The monolog grows linearly, bucket-by-bucket,
  * as space runs out in previous blocks.
  */
-template<typename T, size_t MAX_BUCKETS = 4096, size_t BUCKET_SIZE = 268435456, size_t BUFFER_SIZE = 1048576>
-class monolog_linear : public monolog_linear_base<T, MAX_BUCKETS, BUCKET_SIZE, BUFFER_SIZE> {
+template<typename T, size_t BUCKET_SIZE = 268435456, size_t BUFFER_SIZE = 1048576>
+class monolog_linear : public monolog_linear_base<T, BUCKET_SIZE, BUFFER_SIZE> {
  public:
   // Type definitions
   /** The size type */
@@ -295,35 +363,35 @@ class monolog_linear : public monolog_linear_base<T, MAX_BUCKETS, BUCKET_SIZE, B
   /** The reference type */
   typedef T reference;
   /** This type */
-  typedef monolog_linear<T, MAX_BUCKETS, BUCKET_SIZE, BUFFER_SIZE> this_type;
+  typedef monolog_linear<T, BUCKET_SIZE, BUFFER_SIZE> this_type;
+  /** The base type */
+  typedef monolog_linear_base<T, BUCKET_SIZE, BUFFER_SIZE> base_type;
   /** The iterator type */
   typedef monolog_iterator<this_type> iterator;
   /** The constant iterator type */
   typedef monolog_iterator<this_type> const_iterator;
-  /** The bucket iterator type */
-  typedef monolog_bucket_iterator<this_type, BUCKET_SIZE> bucket_iterator;
-  /** The constant bucket iterator type */
-  typedef monolog_bucket_iterator<this_type, BUCKET_SIZE> const_bucket_iterator;
 
   /**
    * Default constructor.
    */
   monolog_linear()
-      : monolog_linear_base<T, MAX_BUCKETS, BUCKET_SIZE, BUFFER_SIZE>(),
+      : base_type(),
         tail_(0UL) {
   }
 
   /**
-   * Constructor to intialize the monolog with specified name, data path and
-   * storage mode.
+   * Constructor to intialize the monolog with specified name, data path,
+   * storage mode and bucket geometry.
    *
    * @param name The name of the monolog.
    * @param data_path The data path for the monolog.
    * @param storage The storage mode for the monolog.
+   * @param geometry The bucket geometry of the monolog.
    */
   monolog_linear(const std::string &name, const std::string &data_path,
-                 const storage::storage_mode &storage = storage::IN_MEMORY)
-      : monolog_linear_base<T, MAX_BUCKETS, BUCKET_SIZE, BUFFER_SIZE>(name, data_path, storage),
+                 const storage::storage_mode &storage = storage::IN_MEMORY,
+                 const bucket_geometry &geometry = bucket_geometry::fixed(BUCKET_SIZE))
+      : base_type(name, data_path, storage, geometry),
         tail_(0UL) {
   }
 
@@ -332,7 +400,7 @@ class monolog_linear : public monolog_linear_base<T, MAX_BUCKETS, BUCKET_SIZE, B
    * @param other other monolog_linear
    */
   monolog_linear(const monolog_linear &other)
-      : monolog_linear_base<T, MAX_BUCKETS, BUCKET_SIZE, BUFFER_SIZE>(other) {
+      : base_type(other) {
     atomic::init(&tail_, 0UL);
     for (size_t i = 0; i < other.size(); i++)
       this->push_back(other.get(i));
@@ -346,7 +414,7 @@ class monolog_linear : public monolog_linear_base<T, MAX_BUCKETS, BUCKET_SIZE, B
   monolog_linear &operator=(const monolog_linear &other) {
     if (&other == this)
       return *this;
-    monolog_linear::operator=(other);
+    base_type::operator=(other);
     atomic::init(&tail_, 0UL);
     for (size_t i = 0; i < other.size(); i++)
       this->push_back(other.get(i));
@@ -447,22 +515,6 @@ class monolog_linear : public monolog_linear_base<T, MAX_BUCKETS, BUCKET_SIZE, B
     return iterator(this, size());
   }
 
-  /**
-   * Get an iterator over the first bucket
-   * @return Iterator over the first bucket
-   */
-  bucket_iterator begin_bucket() const {
-    return bucket_iterator(this, 0);
-  }
-
-  /**
-   * Get an iterator over the last bucket
-   * @return Iterator over the last bucket
-   */
-  bucket_iterator end_bucket() const {
-    return bucket_iterator(this, size() + BUCKET_SIZE - (size() % BUCKET_SIZE));
-  }
-
  private:
   atomic::type<size_t> tail_;
 };
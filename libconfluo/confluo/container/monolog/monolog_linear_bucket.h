@@ -1,6 +1,8 @@
 #ifndef CONFLUO_CONTAINER_MONOLOG_MONOLOG_LINEAR_BLOCK_H_
 #define CONFLUO_CONTAINER_MONOLOG_MONOLOG_LINEAR_BLOCK_H_
 
+#include <algorithm>
+
 #include "atomic.h"
 #include "io_utils.h"
 #include "storage/storage.h"
@@ -81,6 +83,28 @@ class monolog_linear_bucket {
     mode_ = mode;
   }
 
+  /**
+   * Gets the number of elements allocated for a block of the given size:
+   * the block followed by a buffer that holds a copy of data written past
+   * its end, so that values crossing into the next block can be read
+   * contiguously. The buffer is at most as large as the block.
+   *
+   * @param size The size of the block.
+   * @return The number of elements allocated for the block.
+   */
+  static size_t alloc_size(size_t size) {
+    return size + std::min(size, BUFFER_SIZE);
+  }
+
+  /**
+   * Gets the size of the buffer following the block.
+   *
+   * @return The size of the buffer.
+   */
+  size_t buffer_size() const {
+    return std::min(size_, BUFFER_SIZE);
+  }
+
   /**
    * Gets the storage size of the monolog
    *
@@ -88,7 +112,7 @@ class monolog_linear_bucket {
    */
   size_t storage_size() const {
     if (data_.atomic_load().ptr() != nullptr)
-      return (size_ + BUFFER_SIZE) * sizeof(T);
+      return alloc_size(size_) * sizeof(T);
     return 0;
   }
 
@@ -251,9 +275,9 @@ class monolog_linear_bucket {
   void try_allocate(__atomic_block_copy_ref &copy, size_t offset = 0) {
     block_state state = UNINIT;
     if (atomic::strong::cas(&state_, &state, INIT)) {
-      size_t file_size = (size_ + BUFFER_SIZE) * sizeof(T);
+      size_t file_size = alloc_size(size_) * sizeof(T);
       void *data_ptr = storage::storage_mode_functions::STORAGE_FNS()[mode_].allocate_bucket(path_, file_size);
-      memset(data_ptr, '\0', sizeof(T) * file_size);
+      memset(data_ptr, '\0', file_size);
       storage::encoded_ptr<T> enc_ptr(data_ptr);
       data_.atomic_init(enc_ptr);
       data_.atomic_copy(copy);
@@ -273,9 +297,9 @@ class monolog_linear_bucket {
   storage::encoded_ptr<T> try_allocate() {
     block_state state = UNINIT;
     if (atomic::strong::cas(&state_, &state, INIT)) {
-      size_t file_size = (size_ + BUFFER_SIZE) * sizeof(T);
+      size_t file_size = alloc_size(size_) * sizeof(T);
       void *data_ptr = storage::storage_mode_functions::STORAGE_FNS()[mode_].allocate_bucket(path_, file_size);
-      memset(data_ptr, '\0', sizeof(T) * file_size);
+      memset(data_ptr, '\0', file_size);
       storage::encoded_ptr<T> enc_ptr(data_ptr);
       data_.atomic_init(enc_ptr);
       return enc_ptr;
@@ -399,6 +399,18 @@ class rt_reflog_it : public std::iterator<std::forward_iterator_tag, reflog> {
     return copy;
   }
 
+  /**
+   * operator-- (prefix); moves to the reflog with the previous key in
+   * the tree.
+   *
+   * @return Updated iterator.
+   */
+  const self_type &operator--() {
+    if (node_ != nullptr)
+      node_ = node_->retreat(key_, width_, depth_);
+    return *this;
+  }
+
   /**
    * Get the iterator key.
    *
@@ -0,0 +1,132 @@
+#ifndef CONFLUO_CONTAINER_VAR_HEAP_H_
+#define CONFLUO_CONTAINER_VAR_HEAP_H_
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "atomic.h"
+#include "container/data_log.h"
+#include "storage/storage.h"
+
+namespace confluo {
+
+/**
+ * Append-only heap holding the values of variable-length columns; records
+ * store a reference to their values in the heap instead. The heap shares
+ * the bucket layout of the data log, and is stored and archived in the
+ * same manner. Appended values may be committed in any order; the
+ * committed prefix of the heap only covers completely written values.
+ */
+class var_heap {
+ public:
+  /** The type of the underlying log */
+  typedef data_log log_type;
+
+  /**
+   * Constructs an uninitialized heap; the underlying log is only allocated
+   * when the heap is initialized
+   */
+  var_heap();
+
+  /**
+   * Constructs a heap stored at the given path
+   *
+   * @param path The data path for the heap
+   * @param mode The storage mode for the heap
+   * @param geometry The bucket geometry for the heap
+   */
+  var_heap(const std::string &path, const storage::storage_mode &mode,
+           const monolog::bucket_geometry &geometry = configured_data_log_geometry());
+
+  /**
+   * Initializes the heap with the given path, storage mode and bucket
+   * geometry
+   *
+   * @param path The data path for the heap
+   * @param mode The storage mode for the heap
+   * @param geometry The bucket geometry for the heap
+   */
+  void init(const std::string &path, const storage::storage_mode &mode,
+            const monolog::bucket_geometry &geometry = configured_data_log_geometry());
+
+  /**
+   * Reserves space for len bytes in the heap
+   *
+   * @param len The number of bytes to reserve
+   *
+   * @return The offset of the reserved space
+   */
+  uint64_t reserve(size_t len);
+
+  /**
+   * Writes len bytes to previously reserved space in the heap
+   *
+   * @param offset The offset to write at
+   * @param data The data to write
+   * @param len The number of bytes to write
+   */
+  void write(uint64_t offset, const uint8_t *data, size_t len);
+
+  /**
+   * Commits previously reserved and written space in the heap. Does not
+   * wait for space reserved before it; the committed prefix grows once
+   * all such space is committed as well.
+   *
+   * @param offset The offset of the reserved space
+   * @param len The size of the reserved space
+   */
+  void commit(uint64_t offset, size_t len);
+
+  /**
+   * Appends len bytes to the heap
+   *
+   * @param data The data to append
+   * @param len The number of bytes to append
+   *
+   * @return The offset of the appended data
+   */
+  uint64_t append(const uint8_t *data, size_t len);
+
+  /**
+   * Reads len bytes from the heap
+   *
+   * @param offset The offset to read from
+   * @param data The buffer to read into
+   * @param len The number of bytes to read
+   */
+  void read(uint64_t offset, uint8_t *data, size_t len) const;
+
+  /**
+   * Gets the size of the committed prefix of the heap
+   *
+   * @return The number of committed bytes
+   */
+  size_t size() const;
+
+  /**
+   * Sets the committed prefix to the entire underlying log; used after
+   * the log has been loaded from storage
+   */
+  void recover();
+
+  /**
+   * Gets the underlying log
+   *
+   * @return The underlying log
+   */
+  log_type &log();
+
+ private:
+  std::unique_ptr<log_type> log_;
+  atomic::type<uint64_t> tail_;
+  std::mutex commit_mtx_;                 // Protects pending_
+  std::map<uint64_t, uint64_t> pending_;  // Committed ranges beyond the tail
+};
+
+}
+
+#endif /* CONFLUO_CONTAINER_VAR_HEAP_H_ */
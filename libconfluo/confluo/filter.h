@@ -2,10 +2,12 @@
 #define CONFLUO_FILTER_H_
 
 #include "aggregated_reflog.h"
+#include "alert_index.h"
 #include "container/radix_tree.h"
 #include "container/reflog.h"
 #include "trigger.h"
 #include "trigger_log.h"
+#include "parser/adaptive_expression.h"
 #include "parser/expression_compiler.h"
 #include "schema/record_batch.h"
 #include "schema/schema.h"
@@ -96,6 +98,14 @@ class filter {
    */
   size_t num_aggregates() const;
 
+  /**
+   * Sets the alert index on which eager triggers defined on the filter's
+   * aggregates raise alerts; eager triggers are not evaluated until set.
+   *
+   * @param alerts The alert index.
+   */
+  void set_alert_index(alert_index *alerts);
+
   /**
    * Updates the filter index with a new data point. If the new data point
    * passes the filter, its reference is stored.
@@ -114,6 +124,40 @@ class filter {
    */
   void update(size_t log_offset, const schema_snapshot &snap, record_block &block, size_t record_size);
 
+  /**
+   * Updates the filter index with a data point that precedes the backfill
+   * boundary. Aggregates are not updated, since they only cover records
+   * appended after they were added.
+   *
+   * @param r Record being tested.
+   */
+  void backfill(const record_t &r);
+
+  /**
+   * Marks the filter as backfilling, with the backfill boundary yet to be
+   * determined; writers wait until the boundary is set.
+   */
+  void begin_backfill();
+
+  /**
+   * Sets the data log offset below which records are left to the backfill.
+   *
+   * @param boundary The backfill boundary.
+   */
+  void set_backfill_boundary(uint64_t boundary);
+
+  /**
+   * Marks the backfill as complete.
+   */
+  void finish_backfill();
+
+  /**
+   * Gets whether existing records are still being backfilled.
+   *
+   * @return True if the filter is backfilling, false otherwise.
+   */
+  bool is_backfilling() const;
+
   // TODO rename later
   /**
    * Get the RefLog corresponding to given time-block.
@@ -169,11 +213,23 @@ class filter {
   idx_t &data();
 
  private:
-  compiled_expression exp_;         // The compiled filter expression
+  static const uint64_t UNSET_BOUNDARY = UINT64_MAX;
+
+  bool update_on_write(uint64_t offset) const;
+
+  bool has_eager_triggers(const aggregate_info *a) const;
+
+  void raise_eager_alerts(aggregate_info *a, uint64_t time_block, const numeric &before, const numeric &after,
+                          uint64_t version);
+
+  adaptive_expression exp_;         // The compiled filter expression
   filter_fn fn_;                    // Filter function
   idx_t idx_;                       // The filtered data index
   aggregate_log aggregates_;        // List of aggregates on this filter
+  alert_index *alerts_;             // Receives alerts of eager triggers
   atomic::type<bool> is_valid_;     // Marks if the filter is valid or not
+  atomic::type<bool> backfilling_;  // Marks if existing records are being backfilled
+  atomic::type<uint64_t> backfill_boundary_;  // Offsets below are left to the backfill
 };
 
 }
@@ -1,14 +1,22 @@
 #ifndef CONFLUO_INDEX_LOG_H_
 #define CONFLUO_INDEX_LOG_H_
 
+#include "container/hash_index.h"
 #include "container/monolog/monolog_exp2.h"
 #include "container/radix_tree.h"
+#include "schema/composite_index.h"
 
 namespace confluo {
 
 /** An index_log is a type of monolog for supporting indexes */
 typedef monolog::monolog_exp2<index::radix_index *> index_log;
 
+/** A hash_index_log is a type of monolog for supporting hash indexes */
+typedef monolog::monolog_exp2<index::hash_index *> hash_index_log;
+
+/** A composite_index_log is a type of monolog for composite index descriptors */
+typedef monolog::monolog_exp2<composite_index_t *> composite_index_log;
+
 }
 
 #endif /* CONFLUO_INDEX_LOG_H_ */
@@ -0,0 +1,174 @@
+#ifndef CONFLUO_INGEST_BULK_LOADER_H_
+#define CONFLUO_INGEST_BULK_LOADER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "atomic_multilog.h"
+
+namespace confluo {
+namespace ingest {
+
+/**
+ * Input formats understood by the bulk loader
+ */
+enum bulk_format {
+  /** Comma-separated values, one record per line; quoted values may span lines */
+  CSV = 0,
+  /** JSON objects keyed by attribute name, one record per line */
+  JSON = 1,
+  /** Raw records in the multilog's record format, back to back */
+  BINARY = 2
+};
+
+/**
+ * Statistics for a bulk load
+ */
+struct bulk_load_stats {
+  /** The number of records appended */
+  uint64_t num_records;
+  /** The number of input bytes consumed */
+  uint64_t num_bytes;
+  /** The number of threads that took part in the load */
+  size_t num_threads;
+  /** The wall-clock duration of the load in seconds */
+  double elapsed_s;
+
+  /**
+   * Gets the ingest rate
+   *
+   * @return The number of records appended per second
+   */
+  double records_per_s() const;
+
+  /**
+   * Gets the input bandwidth
+   *
+   * @return The number of input megabytes consumed per second
+   */
+  double mb_per_s() const;
+};
+
+/**
+ * Loads files of historical records into an atomic multilog. The input is
+ * mapped into memory and split into chunks on record boundaries; worker
+ * threads parse chunks in parallel, group the records into time blocks
+ * via the record batch builder, and append large batches, so that indexes
+ * and filters are updated once per time block rather than once per
+ * record.
+ *
+ * Text records list attribute values in schema order; the TIMESTAMP may be
+ * omitted, in which case the append time is used. Records are appended in
+ * no particular order across chunks.
+ *
+ * The calling thread must be registered with the thread manager, and takes
+ * part in the load alongside the helper threads.
+ */
+class bulk_loader {
+ public:
+  /** Default number of records per appended batch */
+  static const size_t DEFAULT_BATCH_SIZE = 16384;
+  /** Default number of input bytes handed to a worker at a time */
+  static const size_t DEFAULT_CHUNK_SIZE = 4 << 20;
+
+  /**
+   * Creates a bulk loader for an atomic multilog
+   *
+   * @param mlog The atomic multilog the records are appended to
+   * @param num_threads The number of worker threads, including the calling
+   * thread; 0 picks one per core
+   * @param batch_size The number of records per appended batch
+   * @param chunk_size The number of input bytes handed to a worker at a
+   * time
+   */
+  explicit bulk_loader(atomic_multilog *mlog, size_t num_threads = 0, size_t batch_size = DEFAULT_BATCH_SIZE,
+                       size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  /**
+   * Loads a file
+   *
+   * @param path The path of the file
+   * @param format The format of the file
+   * @param skip_header Whether to skip the first line of a CSV file
+   * @throw parse_exception If a record cannot be parsed; records in other
+   * chunks may have been appended
+   * @throw unsupported_exception If a binary file is loaded into a schema
+   * with variable-length columns
+   * @return The load statistics
+   */
+  bulk_load_stats load(const std::string &path, bulk_format format, bool skip_header = false);
+
+  /**
+   * Loads records from memory
+   *
+   * @param data The input data
+   * @param size The size of the input data
+   * @param format The format of the input data
+   * @param skip_header Whether to skip the first line of CSV input
+   * @throw parse_exception If a record cannot be parsed; records in other
+   * chunks may have been appended
+   * @throw unsupported_exception If binary input is loaded into a schema
+   * with variable-length columns
+   * @return The load statistics
+   */
+  bulk_load_stats load(const char *data, size_t size, bulk_format format, bool skip_header = false);
+
+  /**
+   * Parses a format name
+   *
+   * @param name One of csv, json or binary, in any case
+   * @throw parse_exception If the name is not recognized
+   * @return The format
+   */
+  static bulk_format parse_format(const std::string &name);
+
+  /**
+   * Splits a CSV line into attribute values; values may be enclosed in
+   * double quotes, with embedded quotes doubled
+   *
+   * @param begin The start of the line
+   * @param end The end of the line, excluding the newline
+   * @param out Set to the attribute values
+   * @throw parse_exception If a quoted value is not terminated
+   */
+  static void split_csv(const char *begin, const char *end, std::vector<std::string> &out);
+
+  /**
+   * Extracts attribute values from a flat JSON object, in schema order.
+   * Unknown keys are ignored; if TIMESTAMP is absent, the remaining values
+   * are returned so that the append time is used.
+   *
+   * @param schema The schema
+   * @param begin The start of the line
+   * @param end The end of the line, excluding the newline
+   * @param out Set to the attribute values
+   * @throw parse_exception If the object is malformed or an attribute
+   * other than TIMESTAMP is missing
+   */
+  static void split_json(const schema_t &schema, const char *begin, const char *end,
+                         std::vector<std::string> &out);
+
+ private:
+  struct chunk {
+    const char *begin;
+    const char *end;
+  };
+
+  static const char *find_record_end(const char *p, const char *end, bulk_format format);
+  std::vector<chunk> split_text(const char *data, size_t size, bulk_format format, bool skip_header) const;
+  std::vector<chunk> split_binary(const char *data, size_t size) const;
+  void load_text_chunk(const chunk &c, const char *base, bulk_format format, uint64_t &nrecords);
+  void load_binary_chunk(const chunk &c, uint64_t &nrecords);
+  void append(std::unique_ptr<record_batch_builder> &builder, size_t &nbuffered, uint64_t &nrecords);
+
+  atomic_multilog *mlog_;
+  size_t num_threads_;
+  size_t batch_size_;
+  size_t chunk_size_;
+};
+
+}
+}
+
+#endif /* CONFLUO_INGEST_BULK_LOADER_H_ */
@@ -0,0 +1,73 @@
+#ifndef CONFLUO_INGEST_RING_WAKER_H_
+#define CONFLUO_INGEST_RING_WAKER_H_
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace confluo {
+namespace ingest {
+
+/**
+ * Waits for the bells of parked shared-memory rings on a single thread.
+ * When a bell becomes readable, the callback registered for it is run on
+ * that thread; callbacks are expected to be short, e.g., waking a parked
+ * task on a task scheduler.
+ */
+class ring_waker {
+ public:
+  /**
+   * Starts the waiting thread
+   */
+  ring_waker();
+
+  ring_waker(const ring_waker &) = delete;
+  ring_waker &operator=(const ring_waker &) = delete;
+
+  /**
+   * Stops the waiting thread
+   */
+  ~ring_waker();
+
+  /**
+   * Runs a callback whenever a descriptor becomes readable; the callback
+   * must consume what is readable, or it is run again
+   *
+   * @param fd The descriptor
+   * @param callback The function to run
+   * @throw invalid_operation_exception If the descriptor cannot be watched
+   */
+  void add(int fd, std::function<void(void)> callback);
+
+  /**
+   * Stops watching a descriptor, waiting for a run of its callback in
+   * progress to complete. Must not be called from a callback.
+   *
+   * @param fd The descriptor
+   * @return True if the descriptor was watched, false otherwise
+   */
+  bool remove(int fd);
+
+  /**
+   * Gets the waker shared by all shared-memory ingests, creating it on
+   * first use
+   *
+   * @return The shared waker
+   */
+  static ring_waker &shared();
+
+ private:
+  void wait_loop();
+
+  int epoll_fd_;
+  int stop_fd_;
+  std::mutex mtx_;
+  std::map<int, std::function<void(void)>> callbacks_;
+  std::thread waiter_;
+};
+
+}
+}
+
+#endif /* CONFLUO_INGEST_RING_WAKER_H_ */
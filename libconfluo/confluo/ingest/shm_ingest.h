@@ -0,0 +1,116 @@
+#ifndef CONFLUO_INGEST_SHM_INGEST_H_
+#define CONFLUO_INGEST_SHM_INGEST_H_
+
+#include <string>
+
+#include "atomic.h"
+#include "atomic_multilog.h"
+#include "ingest/shm_ring.h"
+#include "threads/task_scheduler.h"
+
+namespace confluo {
+namespace ingest {
+
+/**
+ * Drains a shared-memory ring into an atomic multilog. The ring is
+ * created with one slot per record of the multilog's schema, so a
+ * producer process on the same host can attach to it and write records
+ * in the same format it would pass to atomic_multilog::append. A task on
+ * the shared task scheduler moves the published records into the
+ * multilog in batches via append_batch. When the ring is empty the task
+ * parks, and the producer's next write wakes it through the ring's bell,
+ * so idle rings cost no CPU time and no thread of their own.
+ */
+class shm_ingest {
+ public:
+  /** Default number of records in the ring */
+  static const size_t DEFAULT_CAPACITY = 1 << 16;
+  /** Default maximum number of records moved in one batch */
+  static const size_t DEFAULT_BATCH_SIZE = 4096;
+
+  /**
+   * Creates the ring for an atomic multilog
+   *
+   * @param mlog The atomic multilog the records are appended to
+   * @param path The path of the ring file, e.g., under /dev/shm
+   * @param capacity The number of records in the ring
+   * @param batch_size The maximum number of records moved in one batch
+   * @throw unsupported_exception If the schema has variable-length columns
+   */
+  shm_ingest(atomic_multilog *mlog, const std::string &path,
+             size_t capacity = DEFAULT_CAPACITY, size_t batch_size = DEFAULT_BATCH_SIZE);
+
+  shm_ingest(const shm_ingest &) = delete;
+  shm_ingest &operator=(const shm_ingest &) = delete;
+
+  /**
+   * Stops draining and removes the ring file
+   */
+  ~shm_ingest();
+
+  /**
+   * Starts draining the ring on the shared task scheduler
+   *
+   * @return True if draining was started, false if it was already
+   * running
+   */
+  bool start();
+
+  /**
+   * Stops the drain task, then drains whatever is left in the ring on the
+   * calling thread
+   *
+   * @return True if draining was stopped, false if it was not running
+   */
+  bool stop();
+
+  /**
+   * Moves up to one batch of records from the ring into the multilog on
+   * the calling thread, which must be registered with the thread manager.
+   * A batch the multilog rejects is logged and dropped. Must not be
+   * called while the drain task is running.
+   *
+   * @return The number of records taken from the ring
+   */
+  size_t drain();
+
+  /**
+   * Gets the number of records moved into the multilog so far
+   *
+   * @return The number of records ingested
+   */
+  uint64_t num_ingested() const;
+
+  /**
+   * Gets the number of records dropped because the multilog rejected
+   * their batch
+   *
+   * @return The number of records dropped
+   */
+  uint64_t num_dropped() const;
+
+  /**
+   * Gets the path of the ring file
+   *
+   * @return The path
+   */
+  std::string const &path() const;
+
+ private:
+  void drain_task();
+
+  void drain_all();
+
+  atomic_multilog *mlog_;
+  shm_ring ring_;
+  size_t batch_size_;
+  atomic::type<uint64_t> ingested_;
+  atomic::type<uint64_t> dropped_;
+  // Declared last, so that it is stopped before the state it uses is destroyed
+  scheduled_task drain_task_;
+};
+
+}
+}
+
+#endif /* CONFLUO_INGEST_SHM_INGEST_H_ */
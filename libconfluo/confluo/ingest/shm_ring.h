@@ -0,0 +1,224 @@
+#ifndef CONFLUO_INGEST_SHM_RING_H_
+#define CONFLUO_INGEST_SHM_RING_H_
+
+#include <cstdint>
+#include <string>
+
+#include "atomic.h"
+
+namespace confluo {
+namespace ingest {
+
+/**
+ * Layout of the control block at the start of a shared-memory ring. The
+ * head (advanced by the consumer) and the tail (advanced by the producer)
+ * live on separate cache lines so that the two sides do not contend.
+ * Both count records, and increase monotonically.
+ */
+struct shm_ring_header {
+  /** Identifies a mapped file as a ring; stored last when the ring is created */
+  atomic::type<uint64_t> magic;
+  /** The size of a record slot in bytes */
+  uint64_t record_size;
+  /** The number of record slots; always a power of two */
+  uint64_t capacity;
+  /** The number of records consumed so far */
+  alignas(64) atomic::type<uint64_t> head;
+  /** The number of records published so far */
+  alignas(64) atomic::type<uint64_t> tail;
+  /** Non-zero while the consumer waits for the producer to ring the bell */
+  alignas(64) atomic::type<uint64_t> consumer_parked;
+};
+
+/**
+ * A single-producer single-consumer ring of fixed-size records in a
+ * memory-mapped file, shared between processes on the same host. The
+ * producer copies records into free slots and publishes them with a
+ * release-store of the tail; the consumer reads published slots in place
+ * and frees them with a release-store of the head. Each side caches the
+ * other side's index and only reloads it when the ring looks full (or
+ * empty), so neither side issues a system call or touches the other's
+ * cache line on the fast path.
+ *
+ * A consumer with nothing to read can park instead of polling. The
+ * producer then rings a doorbell, a datagram socket next to the ring
+ * file, after its next write; it only issues that system call once per
+ * park.
+ *
+ * The ring supports exactly one producer: attach() takes an exclusive
+ * advisory lock on the backing file, which is held until the attached
+ * ring is destroyed and released by the kernel if the producer dies.
+ * Several collectors on a host must each write to their own multilog's
+ * ring, or funnel their records through a single producer.
+ */
+class shm_ring {
+ public:
+  /** Magic number stored in the ring header */
+  static const uint64_t MAGIC = UINT64_C(0x434f4e464c52494e);
+
+  /**
+   * Creates a new ring backed by the file at the given path, replacing
+   * any existing file
+   *
+   * @param path The path of the backing file, e.g., under /dev/shm
+   * @param record_size The size of each record in bytes
+   * @param capacity The minimum number of records the ring can hold;
+   * rounded up to a power of two
+   *
+   * @return The created ring
+   */
+  static shm_ring create(const std::string &path, size_t record_size, size_t capacity);
+
+  /**
+   * Attaches to an existing ring
+   *
+   * @param path The path of the backing file
+   * @param record_size The expected size of each record in bytes
+   * @throw invalid_operation_exception If the file is not a ring, its
+   * record size does not match, another producer is attached, or its
+   * consumer is gone
+   *
+   * @return The attached ring
+   */
+  static shm_ring attach(const std::string &path, size_t record_size);
+
+  shm_ring(shm_ring &&other) noexcept;
+  shm_ring &operator=(shm_ring &&other) noexcept;
+  shm_ring(const shm_ring &) = delete;
+  shm_ring &operator=(const shm_ring &) = delete;
+
+  /**
+   * Unmaps the ring and releases the producer lock, if held; the backing
+   * file is left in place
+   */
+  ~shm_ring();
+
+  /**
+   * Copies as many of the given records into the ring as fit, without
+   * blocking. Must only be called by the producer.
+   *
+   * @param records Pointer to nrecords contiguous records
+   * @param nrecords The number of records
+   *
+   * @return The number of records written
+   */
+  size_t try_write(const void *records, size_t nrecords);
+
+  /**
+   * Copies all of the given records into the ring, spinning while it is
+   * full. Must only be called by the producer.
+   *
+   * @param records Pointer to nrecords contiguous records
+   * @param nrecords The number of records
+   */
+  void write(const void *records, size_t nrecords);
+
+  /**
+   * Gets the longest contiguous run of published records that have not
+   * been consumed, without copying. Must only be called by the consumer.
+   *
+   * @param max_records The maximum number of records to return
+   * @param nrecords Set to the number of records in the run
+   *
+   * @return Pointer to the first record of the run
+   */
+  const uint8_t *peek(size_t max_records, size_t &nrecords);
+
+  /**
+   * Frees slots returned by peek so the producer can reuse them. Must only
+   * be called by the consumer.
+   *
+   * @param nrecords The number of records to free
+   */
+  void consume(size_t nrecords);
+
+  /**
+   * Marks the consumer as parked, so that the producer rings the bell
+   * after its next write. Must only be called by the consumer.
+   *
+   * @return True if the consumer is parked, false if records were
+   * published in the meantime and should be read first
+   */
+  bool park();
+
+  /**
+   * Gets the descriptor that becomes readable when the producer rings
+   * the bell; only valid on the consumer side
+   *
+   * @return The bell descriptor
+   */
+  int bell_fd() const;
+
+  /**
+   * Discards pending rings of the bell. Must only be called by the
+   * consumer.
+   */
+  void clear_bell();
+
+  /**
+   * Gets the number of published records that have not been consumed
+   *
+   * @return The number of records in the ring
+   */
+  size_t size() const;
+
+  /**
+   * Gets the size of each record
+   *
+   * @return The record size in bytes
+   */
+  size_t record_size() const;
+
+  /**
+   * Gets the number of record slots in the ring
+   *
+   * @return The capacity of the ring
+   */
+  size_t capacity() const;
+
+  /**
+   * Gets the path of the backing file
+   *
+   * @return The path
+   */
+  std::string const &path() const;
+
+  /**
+   * Gets the path of the bell socket of the ring at the given path
+   *
+   * @param path The path of the ring file
+   * @return The path of the bell socket
+   */
+  static std::string bell_path(const std::string &path);
+
+ private:
+  shm_ring(const std::string &path, void *map, size_t map_size, int lock_fd, int bell_fd);
+
+  void release();
+
+  void ring_bell();
+
+  uint8_t *slot(uint64_t idx) const;
+
+  std::string path_;
+  void *map_;
+  size_t map_size_;
+  // The producer's locked descriptor of the backing file, or -1
+  int lock_fd_;
+  // The bell socket: bound by the consumer, connected by the producer
+  int bell_fd_;
+  shm_ring_header *header_;
+  uint8_t *data_;
+  size_t record_size_;
+  uint64_t mask_;
+
+  // Producer-side cache of the head
+  uint64_t cached_head_;
+  // Consumer-side cache of the tail
+  uint64_t cached_tail_;
+};
+
+}
+}
+
+#endif /* CONFLUO_INGEST_SHM_RING_H_ */
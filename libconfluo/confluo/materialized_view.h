@@ -0,0 +1,136 @@
+#ifndef CONFLUO_MATERIALIZED_VIEW_H_
+#define CONFLUO_MATERIALIZED_VIEW_H_
+
+#include <string>
+#include <vector>
+
+#include "aggregate/aggregate_ops.h"
+#include "atomic.h"
+#include "container/cursor/record_cursors.h"
+#include "container/monolog/monolog_exp2.h"
+#include "schema/column.h"
+#include "schema/schema.h"
+
+namespace confluo {
+
+class atomic_multilog;
+
+/**
+ * An aggregate computed by a materialized view
+ */
+struct view_aggregate {
+  /** The aggregator */
+  aggregator agg;
+  /** The index of the aggregated field in the source schema */
+  uint16_t field_idx;
+};
+
+/**
+ * A materialized view is a continuous query on a filter of an atomic
+ * multilog. The filtered records in each fixed-width time window are
+ * grouped by a column and aggregated; once the window closes, one record
+ * per group is appended to a target atomic multilog. Each target record
+ * holds the beginning of the window as its timestamp, followed by the
+ * group-by column (if any) and the aggregates, in the order of
+ * output_schema().
+ */
+class materialized_view {
+ public:
+  /**
+   * Constructs a materialized view
+   *
+   * @param name The name of the view
+   * @param filter_id The identifier of the filter the view is defined on
+   * @param schema The schema of the source atomic multilog
+   * @param group_by The name of the column to group by; empty for no
+   * grouping
+   * @param aggregate_exprs The aggregate expressions (e.g., max(temp))
+   * @param window_ms The width of each window in milliseconds
+   * @param begin_ms The beginning of the first window in milliseconds
+   * @param target The atomic multilog that results are appended to; its
+   * schema must match output_schema()
+   * @throw invalid_operation_exception If the view is invalid
+   */
+  materialized_view(const std::string &name, size_t filter_id, const schema_t &schema, const std::string &group_by,
+                    const std::vector<std::string> &aggregate_exprs, uint64_t window_ms, uint64_t begin_ms,
+                    atomic_multilog *target);
+
+  /**
+   * Gets the schema of the records produced by a materialized view
+   *
+   * @param schema The schema of the source atomic multilog
+   * @param group_by The name of the column to group by; empty for no
+   * grouping
+   * @param aggregate_exprs The aggregate expressions
+   * @return The columns of the produced records
+   * @throw invalid_operation_exception If the columns do not exist
+   */
+  static std::vector<column_t> output_schema(const schema_t &schema, const std::string &group_by,
+                                             const std::vector<std::string> &aggregate_exprs);
+
+  /**
+   * Gets the name of the view
+   * @return The name of the view
+   */
+  const std::string &name() const;
+
+  /**
+   * Gets the identifier of the filter the view is defined on
+   * @return The filter identifier
+   */
+  size_t filter_id() const;
+
+  /**
+   * Gets the width of each window in milliseconds
+   * @return The window width
+   */
+  uint64_t window_ms() const;
+
+  /**
+   * Gets the beginning of the next window to be materialized
+   * @return The beginning of the window in milliseconds
+   */
+  uint64_t next_window_ms() const;
+
+  /**
+   * Groups and aggregates the records of the next window, appends the
+   * results to the target atomic multilog, and moves on to the following
+   * window. Must only be called from a single thread.
+   *
+   * @param records The filtered records in the window
+   */
+  void materialize(record_cursor &records);
+
+  /**
+   * Invalidates the view
+   * @return True if the view was valid, false otherwise
+   */
+  bool invalidate();
+
+  /**
+   * Gets whether the view is valid
+   * @return True if the view is valid, false otherwise
+   */
+  bool is_valid() const;
+
+ private:
+  std::string name_;
+  size_t filter_id_;
+  int32_t group_by_idx_;
+  size_t group_by_size_;
+  std::vector<view_aggregate> aggregates_;
+  uint64_t window_ms_;
+  uint64_t next_window_ms_;
+  atomic_multilog *target_;
+  size_t target_record_size_;
+  atomic::type<bool> is_valid_;
+};
+
+/**
+ * A view log is a type of monolog for materialized views
+ */
+typedef monolog::monolog_exp2<materialized_view *> view_log;
+
+}
+
+#endif /* CONFLUO_MATERIALIZED_VIEW_H_ */
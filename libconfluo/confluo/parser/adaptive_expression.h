@@ -0,0 +1,136 @@
+#ifndef CONFLUO_PARSER_ADAPTIVE_EXPRESSION_H_
+#define CONFLUO_PARSER_ADAPTIVE_EXPRESSION_H_
+
+#include <memory>
+#include <vector>
+
+#include "atomic.h"
+#include "expression_compiler.h"
+
+namespace confluo {
+namespace parser {
+
+/**
+ * A compiled expression that adapts its evaluation order to the data.
+ * A random sample of the records it is tested on is evaluated on every
+ * node of the factored tree to observe how often each node passes; once
+ * enough samples are collected, children are reordered by their observed
+ * selectivity and the new tree is installed atomically. Testing is safe
+ * with concurrent callers, which may briefly use either order.
+ *
+ * Concurrent callers may still be evaluating a replaced tree, so replaced
+ * trees are kept alive. To bound them, a new order is only adopted if it
+ * lowers the expected cost by at least MIN_REORDER_GAIN, a previously
+ * adopted tree with the same order is reused rather than copied, and at
+ * most max_trees distinct trees are ever created.
+ */
+class adaptive_expression {
+ public:
+  /** Default fraction of records sampled, as a power of two */
+  static const uint32_t DEFAULT_SAMPLE_SHIFT = 6;
+  /** Default number of samples between reorderings */
+  static const uint64_t DEFAULT_REORDER_INTERVAL = 1024;
+  /** Default maximum number of distinct trees */
+  static const size_t DEFAULT_MAX_TREES = 8;
+  /** Minimum relative reduction in expected cost for a reordering */
+  static constexpr double MIN_REORDER_GAIN = 0.1;
+
+  /**
+   * Constructs an adaptive expression that every record satisfies
+   */
+  adaptive_expression();
+
+  /**
+   * Constructs an adaptive expression from a compiled expression
+   *
+   * @param expr The compiled expression
+   * @param sample_shift One in 2^sample_shift records is sampled
+   * @param reorder_interval The number of samples between reorderings
+   * @param max_trees The maximum number of distinct trees, including the
+   * initial one
+   */
+  explicit adaptive_expression(const compiled_expression &expr,
+                               uint32_t sample_shift = DEFAULT_SAMPLE_SHIFT,
+                               uint64_t reorder_interval = DEFAULT_REORDER_INTERVAL,
+                               size_t max_trees = DEFAULT_MAX_TREES);
+
+  adaptive_expression(const adaptive_expression &) = delete;
+  adaptive_expression &operator=(const adaptive_expression &) = delete;
+
+  /**
+   * Destructor
+   */
+  ~adaptive_expression();
+
+  /**
+   * Tests the expression against a record
+   *
+   * @param r The record
+   *
+   * @return True if the record satisfies the expression, false otherwise
+   */
+  bool test(const record_t &r);
+
+  /**
+   * Tests the expression against record data
+   *
+   * @param snap The schema snapshot
+   * @param data The record data
+   *
+   * @return True if the data satisfies the expression, false otherwise
+   */
+  bool test(const schema_snapshot &snap, void *data);
+
+  /**
+   * Gets the compiled expression
+   *
+   * @return The compiled expression
+   */
+  compiled_expression const &expression() const;
+
+  /**
+   * Gets the tree currently used for evaluation
+   *
+   * @return The current tree, or nullptr if the expression is evaluated
+   * on its minterms
+   */
+  const compiled_node *current() const;
+
+  /**
+   * Gets the number of times the evaluation order was changed
+   *
+   * @return The number of reorderings
+   */
+  size_t num_reorders() const;
+
+  /**
+   * Gets the number of distinct trees kept alive for evaluation
+   *
+   * @return The number of trees
+   */
+  size_t num_trees() const;
+
+ private:
+  bool should_sample() const;
+  void end_sample();
+  void reorder();
+
+  compiled_expression expr_;
+  uint64_t sample_mask_;
+  uint64_t reorder_interval_;
+  size_t max_trees_;
+  atomic::type<const compiled_node *> current_;
+  // Replaced trees are kept alive, since concurrent callers may still be
+  // evaluating them; only the reordering thread modifies the vector
+  std::vector<std::unique_ptr<compiled_node>> trees_;
+  atomic::type<size_t> num_trees_;
+  std::unique_ptr<atomic::type<uint64_t>[]> passes_;
+  atomic::type<uint64_t> samples_;
+  atomic::type<bool> reordering_;
+  atomic::type<size_t> num_reorders_;
+};
+
+}
+}
+
+#endif /* CONFLUO_PARSER_ADAPTIVE_EXPRESSION_H_ */
@@ -1,6 +1,10 @@
 #ifndef CONFLUO_PARSER_EXPRESSION_COMPILER_H_
 #define CONFLUO_PARSER_EXPRESSION_COMPILER_H_
 
+#include <memory>
+#include <mutex>
+
+#include "atomic.h"
 #include "schema/schema.h"
 #include "schema/schema_snapshot.h"
 #include "expression_parser.h"
@@ -74,6 +78,22 @@ struct compiled_predicate {
    */
   bool test(const schema_snapshot &snap, void *data) const;
 
+  /**
+   * Estimates the cost of testing the predicate on a record, relative to
+   * a comparison of fixed-width numeric fields
+   *
+   * @return The estimated cost
+   */
+  double cost() const;
+
+  /**
+   * Estimates the fraction of records that satisfy the predicate from its
+   * relational operator
+   *
+   * @return The estimated selectivity
+   */
+  double selectivity() const;
+
   /**
    * Gets a string representation of the compiled predicate
    *
@@ -155,127 +175,309 @@ struct compiled_minterm : public std::set<compiled_predicate> {
 };
 
 /**
- * A set of compiled minterms. Manages a grouping of minterms
+ * A node of a factored AND/OR expression tree. Leaves hold a single
+ * predicate; the children of AND and OR nodes are ordered so that the
+ * cheapest, most decisive child is evaluated first, and evaluation
+ * short-circuits.
  */
-struct compiled_expression : public std::set<compiled_minterm> {
+struct compiled_node {
+  /** The type of the node */
+  enum node_type {
+    PREDICATE = 0,
+    AND = 1,
+    OR = 2
+  };
+
   /**
-   * Tests every compiled minterm in the set against a record
+   * Constructs a leaf node for a predicate
    *
-   * @param r The record to test against
+   * @param p The predicate
+   */
+  explicit compiled_node(const compiled_predicate &p);
+
+  /**
+   * Constructs an AND or OR node from its children; children of the same
+   * type are flattened into this node
+   *
+   * @param type The type of the node, AND or OR
+   * @param children The children of the node
+   */
+  compiled_node(node_type type, std::vector<compiled_node> &&children);
+
+  /**
+   * Gets the type of the node
+   *
+   * @return The type of the node
+   */
+  node_type type() const;
+
+  /**
+   * Gets the predicate of a leaf node
+   *
+   * @return The predicate
+   */
+  compiled_predicate const &predicate() const;
+
+  /**
+   * Gets the children of an AND or OR node, in evaluation order
    *
-   * @return True if every compiled minterm test is true, false otherwise
+   * @return The children of the node
+   */
+  std::vector<compiled_node> const &children() const;
+
+  /**
+   * Gets the expected cost of evaluating the node on a record
+   *
+   * @return The expected cost
+   */
+  double cost() const;
+
+  /**
+   * Gets the estimated fraction of records that satisfy the node
+   *
+   * @return The estimated selectivity
+   */
+  double selectivity() const;
+
+  /**
+   * Tests the node against a record
+   *
+   * @param r The record
+   *
+   * @return True if the record satisfies the node, false otherwise
    */
   bool test(const record_t &r) const;
 
   /**
-   * Tests every compiled minterm against the data from the schema snapshot
+   * Tests the node against record data
    *
-   * @param snap The snapshot of the schema
-   * @param data The data that is tested
+   * @param snap The schema snapshot
+   * @param data The record data
    *
-   * @return True if the all of the compiled minterm tests are true, false
-   * otherwise
+   * @return True if the data satisfies the node, false otherwise
    */
   bool test(const schema_snapshot &snap, void *data) const;
 
   /**
-   * Gets a string representation of the compiled expression
+   * Gets the identifier of the node, unique within its tree
    *
-   * @return The contents of the compiled expression in string form
+   * @return The identifier of the node
+   */
+  size_t id() const;
+
+  /**
+   * Assigns identifiers to the node and its descendants in pre-order
+   *
+   * @param next The next free identifier; advanced past the subtree
+   */
+  void assign_ids(size_t &next);
+
+  /**
+   * Tests every node of the tree against a record, without
+   * short-circuiting, and counts the nodes the record satisfies
+   *
+   * @param r The record
+   * @param passes Pass counters, indexed by node identifier
+   *
+   * @return True if the record satisfies the node, false otherwise
+   */
+  bool sample(const record_t &r, atomic::type<uint64_t> *passes) const;
+
+  /**
+   * Tests every node of the tree against record data, without
+   * short-circuiting, and counts the nodes the data satisfies
+   *
+   * @param snap The schema snapshot
+   * @param data The record data
+   * @param passes Pass counters, indexed by node identifier
+   *
+   * @return True if the data satisfies the node, false otherwise
+   */
+  bool sample(const schema_snapshot &snap, void *data, atomic::type<uint64_t> *passes) const;
+
+  /**
+   * Copies the tree with the given selectivities in place of the
+   * estimated ones, reordering children accordingly
+   *
+   * @param selectivity Observed selectivities, indexed by node identifier
+   *
+   * @return The reordered tree
+   */
+  compiled_node reordered(const std::vector<double> &selectivity) const;
+
+  /**
+   * Estimates the cost of evaluating the tree in its current order, given
+   * the selectivities of its nodes
+   *
+   * @param selectivity Observed selectivities, indexed by node identifier
+   *
+   * @return The expected cost
+   */
+  double expected_cost(const std::vector<double> &selectivity) const;
+
+  /**
+   * Checks if two trees evaluate their nodes in the same order
+   *
+   * @param other The other tree
+   *
+   * @return True if the evaluation orders match, false otherwise
+   */
+  bool same_order(const compiled_node &other) const;
+
+  /**
+   * Expands the node into disjunctive normal form
+   *
+   * @return The minterms of the node
+   */
+  std::set<compiled_minterm> expand() const;
+
+  /**
+   * Gets a string representation of the node
+   *
+   * @return The node in string form
    */
   std::string to_string() const;
+
+ private:
+  void add_child(compiled_node &&child);
+  void order_children();
+
+  size_t id_;
+  node_type type_;
+  std::shared_ptr<compiled_predicate> pred_;
+  std::vector<compiled_node> children_;
+  double cost_;
+  double selectivity_;
 };
 
 /**
- * Conjunction operation
+ * A compiled filter expression. Compiled expressions are evaluated on a
+ * factored AND/OR tree; the equivalent set of minterms in disjunctive
+ * normal form, which the query planner works on, is only expanded when
+ * it is first accessed.
  */
-class utree_expand_conjunction {
+class compiled_expression {
  public:
-  /** The result type */
-  typedef compiled_expression result_type;
+  /** Iterator over the minterms */
+  typedef std::set<compiled_minterm>::const_iterator const_iterator;
 
   /**
-   * Expands the conjunction
+   * Constructs an empty expression, which every record satisfies
+   */
+  compiled_expression();
+
+  /**
+   * Constructs an expression from its factored tree
    *
-   * @param m The compiled minterm
-   * @param schema The schema for the monolog
+   * @param root The root of the tree
    */
-  utree_expand_conjunction(const compiled_minterm &m, const schema_t &schema);
+  explicit compiled_expression(compiled_node &&root);
 
   /**
-   * Operation for all types exception functions
-   * @tparam T The type
-   * @throw parse_exception Unrecognized type
-   * @return The result
+   * Copy constructor
+   *
+   * @param other The other expression
    */
-  template<typename T>
-  result_type operator()(T) const {
-    throw parse_exception(std::string("Unrecognized type ") + typeid(T).name());
-  }
+  compiled_expression(const compiled_expression &other);
 
   /**
-   * Operation for function type
-   * @throw parse_exception Functions are not supported
-   * @return The result
+   * Assignment operator
+   *
+   * @param other The other expression
+   *
+   * @return This expression
    */
-  result_type operator()(spirit::function_base const &) const;
+  compiled_expression &operator=(const compiled_expression &other);
 
   /**
-   * Operation for an iterator range
+   * Adds a minterm to the expression; the expression is evaluated on its
+   * minterms from then on
    *
-   * @tparam Iterator type
-   * @param range The iterator range
+   * @param m The minterm
+   */
+  void insert(const compiled_minterm &m);
+
+  /**
+   * Gets the root of the factored tree
    *
-   * @return The result
+   * @return The root, or nullptr if the expression is evaluated on minterms
    */
-  template<typename Iterator>
-  result_type operator()(boost::iterator_range<Iterator> const &range) const {
-    typedef typename boost::iterator_range<Iterator>::const_iterator iterator;
-    result_type e;
-    iterator i = range.begin();
-    int op = spirit::utree::visit(*i, utree_to_op());
-    switch (op) {
-      case reational_op_id::EQ:
-      case reational_op_id::NEQ:
-      case reational_op_id::LT:
-      case reational_op_id::GT:
-      case reational_op_id::LE:
-      case reational_op_id::GE: {
-        compiled_minterm right = m_;
-        std::string attr = spirit::utree::visit(*(++i), utree_to_string());
-        std::string value = spirit::utree::visit(*(++i), utree_to_string());
-        right.add(compiled_predicate(attr, op, value, schema_));
-        e.insert(right);
-        break;
-      }
-      case and_or::OR: {
-        compiled_expression left = spirit::utree::visit(*(++i), *this);
-        compiled_expression right = spirit::utree::visit(*(++i), *this);
-        std::set_union(left.begin(), left.end(), right.begin(), right.end(),
-                       std::inserter(e, e.end()));
-        break;
-      }
-      case and_or::AND: {
-        compiled_expression lor = spirit::utree::visit(*(++i), *this);
-        auto r = *(++i);
-        for (auto &lor_m : lor) {
-          result_type tmp = spirit::utree::visit(
-              r, utree_expand_conjunction(lor_m, schema_));
-          std::set_union(e.begin(), e.end(), tmp.begin(), tmp.end(),
-                         std::inserter(e, e.end()));
-        }
-        break;
-      }
-      default: {
-        throw parse_exception("Unexpected op:" + std::to_string(op));
-      }
-    }
-    return e;
-  }
+  const compiled_node *root() const;
+
+  /**
+   * Gets the number of nodes in the factored tree
+   *
+   * @return The number of nodes, or zero if there is no tree
+   */
+  size_t num_nodes() const;
+
+  /**
+   * Gets the minterms of the expression, expanding them on first access
+   *
+   * @return The minterms
+   */
+  std::set<compiled_minterm> const &minterms() const;
+
+  /**
+   * Gets an iterator to the first minterm
+   *
+   * @return The iterator
+   */
+  const_iterator begin() const;
+
+  /**
+   * Gets an iterator past the last minterm
+   *
+   * @return The iterator
+   */
+  const_iterator end() const;
+
+  /**
+   * Gets the number of minterms
+   *
+   * @return The number of minterms
+   */
+  size_t size() const;
+
+  /**
+   * Checks if the expression is empty
+   *
+   * @return True if the expression has no predicates, false otherwise
+   */
+  bool empty() const;
+
+  /**
+   * Tests the expression against a record
+   *
+   * @param r The record to test against
+   *
+   * @return True if the record satisfies the expression, false otherwise
+   */
+  bool test(const record_t &r) const;
+
+  /**
+   * Tests the expression against the data from the schema snapshot
+   *
+   * @param snap The snapshot of the schema
+   * @param data The data that is tested
+   *
+   * @return True if the data satisfies the expression, false otherwise
+   */
+  bool test(const schema_snapshot &snap, void *data) const;
+
+  /**
+   * Gets a string representation of the compiled expression
+   *
+   * @return The contents of the compiled expression in string form
+   */
+  std::string to_string() const;
 
  private:
-  const compiled_minterm &m_;
-  const schema_t &schema_;
+  std::shared_ptr<const compiled_node> root_;
+  size_t num_nodes_;
+  mutable std::set<compiled_minterm> minterms_;
+  mutable atomic::type<bool> expanded_;
+  mutable std::mutex expand_mtx_;
 };
 
 /**
@@ -284,8 +486,8 @@ class utree_expand_conjunction {
  */
 class utree_compile_expression {
  public:
-  /** The evaluated compiled expression */
-  typedef compiled_expression result_type;
+  /** The factored tree of the compiled expression */
+  typedef compiled_node result_type;
 
   /**
    * Constructs a compiled expression from the given schema
@@ -323,7 +525,6 @@ class utree_compile_expression {
   template<typename Iterator>
   result_type operator()(boost::iterator_range<Iterator> const &range) const {
     typedef typename boost::iterator_range<Iterator>::const_iterator iterator;
-    result_type e;
     iterator i = range.begin();
     int op = spirit::utree::visit(*i, utree_to_op());
     switch (op) {
@@ -333,36 +534,22 @@ class utree_compile_expression {
       case reational_op_id::GT:
       case reational_op_id::LE:
       case reational_op_id::GE: {
-        compiled_minterm m;
         std::string attr = spirit::utree::visit(*(++i), utree_to_string());
         std::string value = spirit::utree::visit(*(++i), utree_to_string());
-        m.add(compiled_predicate(attr, op, value, schema_));
-        e.insert(m);
-        break;
-      }
-      case and_or::OR: {
-        result_type left = spirit::utree::visit(*(++i), *this);
-        result_type right = spirit::utree::visit(*(++i), *this);
-        std::set_union(left.begin(), left.end(), right.begin(), right.end(),
-                       std::inserter(e, e.end()));
-        break;
+        return compiled_node(compiled_predicate(attr, op, value, schema_));
       }
+      case and_or::OR:
       case and_or::AND: {
-        result_type left = spirit::utree::visit(*(++i), *this);
-        auto r = *(++i);
-        for (auto &m : left) {
-          result_type tmp = spirit::utree::visit(
-              r, utree_expand_conjunction(m, schema_));
-          std::set_union(e.begin(), e.end(), tmp.begin(), tmp.end(),
-                         std::inserter(e, e.end()));
-        }
-        break;
+        std::vector<compiled_node> children;
+        children.push_back(spirit::utree::visit(*(++i), *this));
+        children.push_back(spirit::utree::visit(*(++i), *this));
+        auto type = op == and_or::AND ? compiled_node::AND : compiled_node::OR;
+        return compiled_node(type, std::move(children));
       }
       default: {
         throw parse_exception("Unexpected op:" + std::to_string(op));
       }
     }
-    return e;
   }
 
  private:
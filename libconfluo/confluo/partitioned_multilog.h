@@ -0,0 +1,314 @@
+#ifndef CONFLUO_PARTITIONED_MULTILOG_H_
+#define CONFLUO_PARTITIONED_MULTILOG_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "atomic.h"
+#include "atomic_multilog.h"
+#include "container/cursor/concat_cursor.h"
+#include "logger.h"
+
+namespace confluo {
+
+/**
+ * A logical multilog sharded across several atomic multilogs. Each
+ * partition has its own data log, read tail, indexes, filters and
+ * triggers, so that appends to different partitions do not contend.
+ * Records are routed to partitions by the hash of a key column, or
+ * round-robin if no key is given. Management operations are applied to
+ * every partition, and rolled back on all of them if any partition fails;
+ * queries are evaluated on each partition and their results are combined.
+ *
+ * Offsets returned by append() encode both the partition and the offset
+ * within the partition, and are only meaningful to read().
+ */
+class partitioned_multilog {
+ public:
+  /**
+   * Constructs a partitioned multilog
+   *
+   * @param name The name of the multilog
+   * @param schema The schema of the multilog
+   * @param num_partitions The number of partitions
+   * @param partition_key The column whose value picks the partition;
+   * empty for round-robin partitioning
+   * @param path The path of the multilog; partition i is stored under
+   * path/i
+   * @param s_mode The storage mode
+   * @param a_mode The archival mode
+   * @param pool The pool of management tasks
+   * @throw invalid_operation_exception If there are no partitions or the
+   * partition key is not a fixed-length column
+   */
+  partitioned_multilog(const std::string &name, const std::vector<column_t> &schema, size_t num_partitions,
+                       const std::string &partition_key, const std::string &path,
+                       const storage::storage_mode &s_mode, const archival_mode &a_mode, task_pool &pool);
+
+  // Management ops
+  /**
+   * Adds an index to every partition
+   * @param field_name The name of the field to index
+   * @param bucket_size The bucket size of the index
+   * @throw management_exception
+   */
+  void add_index(const std::string &field_name,
+                 double bucket_size = configuration_params::INDEX_BUCKET_SIZE());
+
+  /**
+   * Removes an index from every partition
+   * @param field_name The name of the indexed field
+   * @throw management_exception
+   */
+  void remove_index(const std::string &field_name);
+
+  /**
+   * Adds a filter to every partition
+   * @param name The name of the filter
+   * @param expr The filter expression
+   * @throw management_exception
+   */
+  void add_filter(const std::string &name, const std::string &expr);
+
+  /**
+   * Removes a filter from every partition
+   * @param name The name of the filter
+   * @throw management_exception
+   */
+  void remove_filter(const std::string &name);
+
+  /**
+   * Adds an aggregate to every partition
+   * @param name The name of the aggregate
+   * @param filter_name The name of the filter
+   * @param expr The aggregate expression
+   * @throw management_exception
+   */
+  void add_aggregate(const std::string &name, const std::string &filter_name, const std::string &expr);
+
+  /**
+   * Removes an aggregate from every partition
+   * @param name The name of the aggregate
+   * @throw management_exception
+   */
+  void remove_aggregate(const std::string &name);
+
+  /**
+   * Installs a trigger on every partition; the trigger is evaluated on the
+   * partial aggregate of each partition
+   * @param name The name of the trigger
+   * @param expr The trigger expression
+   * @param periodicity_ms The periodicity in milliseconds
+   * @param mode When the trigger is evaluated
+   * @throw management_exception
+   */
+  void install_trigger(const std::string &name,
+                       const std::string &expr,
+                       uint64_t periodicity_ms = configuration_params::MONITOR_PERIODICITY_MS(),
+                       trigger_mode_t mode = POLLED_TRIGGER);
+
+  /**
+   * Removes a trigger from every partition
+   * @param name The name of the trigger
+   * @throw management_exception
+   */
+  void remove_trigger(const std::string &name);
+
+  // Query ops
+  /**
+   * Get a record batch builder.
+   * @return The record batch builder
+   */
+  record_batch_builder get_batch_builder() const;
+
+  /**
+   * Appends a batch of records, routing each record to its partition
+   * @param batch The record batch to be added
+   */
+  void append_batch(record_batch &batch);
+
+  /**
+   * Appends a record to its partition
+   * @param data The (inline) record data
+   * @return The offset of the record
+   */
+  uint64_t append(void *data);
+
+  /**
+   * Appends a record to its partition
+   * @param record The record to be stored
+   * @return The offset of the record
+   */
+  uint64_t append(const std::vector<std::string> &record);
+
+  /**
+   * Reads a record
+   * @param offset The offset returned by append()
+   * @return The record
+   */
+  std::vector<std::string> read(uint64_t offset) const;
+
+  /**
+   * Executes a filter expression on every partition
+   * @param expr The filter expression
+   * @return The matching records, one partition after the other
+   */
+  std::unique_ptr<record_cursor> execute_filter(const std::string &expr) const;
+
+  /**
+   * Queries records in a time-range on every partition
+   * @param begin_ts The beginning of the range (inclusive)
+   * @param end_ts The end of the range (inclusive)
+   * @return The records, one partition after the other
+   */
+  std::unique_ptr<record_cursor> query_time_range(uint64_t begin_ts, uint64_t end_ts) const;
+
+  /**
+   * Queries a filter on every partition
+   * @param filter_name The name of the filter
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @return The records, one partition after the other
+   */
+  std::unique_ptr<record_cursor> query_filter(const std::string &filter_name, uint64_t begin_ms,
+                                              uint64_t end_ms) const;
+
+  /**
+   * Executes an aggregate on every partition and combines the partial
+   * aggregates
+   * @param aggregate_expr The aggregate expression
+   * @param filter_expr The filter expression
+   * @return The aggregate
+   */
+  numeric execute_aggregate(const std::string &aggregate_expr, const std::string &filter_expr);
+
+  /**
+   * Gets a stored aggregate, combining the partial aggregates of every
+   * partition
+   * @param aggregate_name The name of the aggregate
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @return The aggregate
+   * @throw invalid_operation_exception If the aggregate does not exist
+   */
+  numeric get_aggregate(const std::string &aggregate_name, uint64_t begin_ms, uint64_t end_ms);
+
+  /**
+   * Gets a stored aggregate over consecutive intervals, combining the
+   * partial aggregates of every partition
+   * @param aggregate_name The name of the aggregate
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @param interval_ms The width of each interval
+   * @return The aggregate of each interval
+   * @throw invalid_operation_exception If the aggregate does not exist
+   */
+  std::vector<numeric> get_aggregate_series(const std::string &aggregate_name, uint64_t begin_ms, uint64_t end_ms,
+                                            uint64_t interval_ms);
+
+  /**
+   * Gets the alerts of every partition
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @param trigger_name The name of the trigger; empty for all triggers
+   * @return The alerts, one partition after the other
+   */
+  std::unique_ptr<alert_cursor> get_alerts(uint64_t begin_ms, uint64_t end_ms,
+                                           const std::string &trigger_name = "") const;
+
+  /**
+   * Gets the name of the multilog
+   * @return The name
+   */
+  const std::string &get_name() const;
+
+  /**
+   * Gets the schema of the multilog
+   * @return The schema
+   */
+  const schema_t &get_schema() const;
+
+  /**
+   * Gets the number of partitions
+   * @return The number of partitions
+   */
+  size_t num_partitions() const;
+
+  /**
+   * Gets a partition
+   * @param i The index of the partition
+   * @return The partition
+   */
+  atomic_multilog *partition(size_t i);
+
+  /**
+   * Gets the number of records in all partitions
+   * @return The number of records
+   */
+  size_t num_records() const;
+
+ private:
+  /**
+   * Picks the partition of a record
+   * @param data The record data
+   * @return The index of the partition
+   */
+  size_t partition_of(const void *data);
+
+  /**
+   * Gets the aggregator of a stored aggregate
+   * @param aggregate_name The name of the aggregate
+   * @return The aggregator
+   * @throw invalid_operation_exception If the aggregate does not exist
+   */
+  aggregator get_aggregator(const std::string &aggregate_name) const;
+
+  /**
+   * Applies a management operation to every partition in order. The first
+   * partition validates the operation; if a later partition fails, the
+   * operation is undone on the partitions it was applied to, and the
+   * exception is rethrown.
+   * @tparam APPLY The type of the operation
+   * @tparam UNDO The type of the undo operation
+   * @param apply Applies the operation to a partition
+   * @param undo Undoes the operation on a partition
+   */
+  template<typename APPLY, typename UNDO>
+  void for_each_partition(APPLY apply, UNDO undo) {
+    size_t i = 0;
+    try {
+      for (; i < partitions_.size(); i++)
+        apply(*partitions_[i]);
+    } catch (...) {
+      while (i > 0) {
+        try {
+          undo(*partitions_[--i]);
+        } catch (std::exception &e) {
+          LOG_ERROR << name_ << ": Could not roll back partition " << i << ": " << e.what();
+        }
+      }
+      throw;
+    }
+  }
+
+  std::string name_;
+  std::vector<std::unique_ptr<atomic_multilog>> partitions_;
+  int32_t key_offset_;
+  size_t key_size_;
+  atomic::type<uint64_t> next_partition_;
+
+  /** Serializes management operations, so that rollbacks do not interleave */
+  std::mutex mgmt_mtx_;
+  std::map<std::string, filter_metadata> filters_;
+  std::map<std::string, std::pair<trigger_metadata, trigger_mode_t>> triggers_;
+
+  mutable std::mutex aggregates_mtx_;
+  std::map<std::string, std::pair<aggregate_metadata, aggregator>> aggregates_;
+};
+
+}
+
+#endif /* CONFLUO_PARTITIONED_MULTILOG_H_ */
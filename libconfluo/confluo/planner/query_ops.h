@@ -2,6 +2,7 @@
 #define CONFLUO_PLANNER_QUERY_OPS_H_
 
 #include "container/data_log.h"
+#include "container/hash_index.h"
 #include "container/lazy/stream.h"
 #include "container/radix_tree.h"
 #include "container/record_offset_range.h"
@@ -22,7 +23,9 @@ enum query_op_type {
   /** Operation that is invalid */
       D_NO_VALID_INDEX_OP = 2,
   /** Index operation */
-      D_INDEX_OP = 3
+      D_INDEX_OP = 3,
+  /** Hash index operation */
+      D_HASH_INDEX_OP = 4
 };
 
 /**
@@ -186,6 +189,48 @@ class index_op : public query_op {
   key_range range_;
 };
 
+/**
+ * Hash index operation class. A specific implementation of a query
+ * operation that looks up a single key in a hash index.
+ */
+class hash_index_op : public query_op {
+ public:
+  /**
+   * Initializes the hash index operation
+   *
+   * @param index The hash index
+   * @param refs The reflog for the key; must be non-null
+   * @param key The key to lookup
+   */
+  hash_index_op(const index::hash_index *index, const reflog *refs, const byte_string &key);
+
+  /**
+   * Gets a string representation of the hash index operation
+   *
+   * @return Information about the hash index operation in a string
+   */
+  virtual std::string to_string() const override;
+
+  /**
+   * Gets the cost of the hash index operation
+   *
+   * @return The cost of the hash index operation
+   */
+  virtual uint64_t cost() const override;
+
+  /**
+   * The query hash index operation
+   *
+   * @return The reflog for the key
+   */
+  const reflog *query_index();
+
+ private:
+  const index::hash_index *index_;
+  const reflog *refs_;
+  byte_string key_;
+};
+
 }
 }
 
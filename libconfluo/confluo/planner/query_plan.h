@@ -75,6 +75,14 @@ class query_plan : public std::vector<std::shared_ptr<query_op>> {
    */
   std::unique_ptr<record_cursor> using_indexes(uint64_t version);
 
+  /**
+   * Gets a cursor over the offsets returned by an index lookup
+   * @param i The position of the index operation in the plan
+   * @param version Version limit for execution
+   * @return An offset cursor over the index lookup result
+   */
+  std::unique_ptr<offset_cursor> index_cursor(size_t i, uint64_t version);
+
   const data_log *dlog_;
   const schema_t *schema_;
   const parser::compiled_expression &expr_;
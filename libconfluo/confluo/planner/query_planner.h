@@ -23,6 +23,8 @@ class query_planner {
   typedef std::pair<byte_string, byte_string> key_range;
   /** Maps an id to a key range */
   typedef std::map<uint32_t, key_range> key_range_map;
+  /** Maps a hash index id to a key */
+  typedef std::map<uint32_t, byte_string> key_map;
   /** List of index operation that can be performed */
   typedef std::vector<index_op> index_ops;
   /** Iterator through the index operations */
@@ -32,12 +34,18 @@ class query_planner {
 
   /**
    * Initializes query_planner with given references to a data_log,
-   * index_log, and schema
+   * index_log, hash_index_log, composite_index_log and schema
    * @param dlog A pointer to a data_log
    * @param idx_list A pointer to an index_log
+   * @param hash_idx_list A pointer to a hash_index_log
+   * @param composite_idx_list A pointer to a composite_index_log
    * @param schema A pointer to the schema
    */
-  query_planner(const data_log *dlog, const index_log *idx_list, const schema_t *schema);
+  query_planner(const data_log *dlog,
+                const index_log *idx_list,
+                const hash_index_log *hash_idx_list,
+                const composite_index_log *composite_idx_list,
+                const schema_t *schema);
 
   /**
    * Converts a compiled_expression to a list of query_ops
@@ -69,6 +77,31 @@ class query_planner {
    */
   bool add_range(key_range_map &ranges, uint32_t id, const key_range &r) const;
 
+  /**
+   * Gets the key range matched by a predicate
+   *
+   * @param p The predicate
+   * @param col The column the predicate is on
+   * @param bucket_size The bucket size of the index on the column
+   *
+   * @return The key range matched by the predicate
+   */
+  key_range predicate_range(const parser::compiled_predicate &p, const column_t &col, double bucket_size) const;
+
+  /**
+   * Gets the key range of a composite index matched by a minterm, using
+   * the equality predicates on a prefix of the indexed columns and the
+   * predicates on the column following the prefix
+   *
+   * @param m The minterm
+   * @param c The composite index
+   * @param r The matched key range; empty if the minterm matches nothing
+   *
+   * @return True if the minterm constrains the first indexed column, false
+   * otherwise
+   */
+  bool composite_range(const parser::compiled_minterm &m, const composite_index_t &c, key_range &r) const;
+
   /**
    * Optimizes the compiled minterm expression using the key ranges
    *
@@ -80,6 +113,8 @@ class query_planner {
 
   const data_log *dlog_;
   const index_log *idx_list_;
+  const hash_index_log *hash_idx_list_;
+  const composite_index_log *composite_idx_list_;
   const schema_t *schema_;
 };
 
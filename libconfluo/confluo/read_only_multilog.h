@@ -0,0 +1,175 @@
+#ifndef CONFLUO_READ_ONLY_MULTILOG_H_
+#define CONFLUO_READ_ONLY_MULTILOG_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "atomic.h"
+#include "container/data_log.h"
+#include "container/cursor/record_cursors.h"
+#include "parser/expression_compiler.h"
+#include "schema/schema.h"
+
+namespace confluo {
+
+class read_only_multilog;
+
+/**
+ * A record cursor over a range of a read-only multilog, optionally
+ * filtered by an expression
+ */
+class read_only_record_cursor : public record_cursor {
+ public:
+  /**
+   * Constructs a cursor over the records in [begin, end)
+   *
+   * @param mlog The read-only multilog
+   * @param begin The data log offset of the first record
+   * @param end The data log offset past the last record
+   * @param cexpr The filter expression, or nullptr to return all records
+   * @param batch_size The number of records in the batch
+   */
+  read_only_record_cursor(const read_only_multilog *mlog, uint64_t begin, uint64_t end,
+                          std::unique_ptr<parser::compiled_expression> cexpr,
+                          size_t batch_size = 64);
+
+  /**
+   * Loads the next batch from the cursor
+   *
+   * @return The size of the batch
+   */
+  virtual size_t load_next_batch() override;
+
+ private:
+  const read_only_multilog *mlog_;
+  uint64_t cur_;
+  uint64_t end_;
+  std::unique_ptr<parser::compiled_expression> cexpr_;
+};
+
+/**
+ * A read-only view of a durable atomic multilog that may be written to
+ * concurrently by another process. The schema is read from the multilog's
+ * metadata file, and the read tail and data log buckets are mapped
+ * read-only from their backing files; buckets are mapped lazily as the
+ * read tail moves into them, so new data becomes visible as soon as the
+ * writer publishes it. Nothing is ever written, so the writer is
+ * unaffected. Filters are evaluated by scanning the data log; the
+ * writer's indexes and filters are not used.
+ */
+class read_only_multilog {
+ public:
+  /**
+   * Attaches to the atomic multilog stored at the given path
+   *
+   * @param path The data path of the atomic multilog
+   * @throw invalid_operation_exception If the multilog is not durable
+   * @throw unsupported_exception If the schema has variable-length columns
+   */
+  explicit read_only_multilog(const std::string &path);
+
+  read_only_multilog(const read_only_multilog &) = delete;
+  read_only_multilog &operator=(const read_only_multilog &) = delete;
+
+  /**
+   * Unmaps the read tail and all mapped buckets
+   */
+  ~read_only_multilog();
+
+  /**
+   * Gets the name of the atomic multilog
+   *
+   * @return The name
+   */
+  std::string const &get_name() const;
+
+  /**
+   * Gets the schema of the atomic multilog
+   *
+   * @return The schema
+   */
+  schema_t const &get_schema() const;
+
+  /**
+   * Gets the size of each record
+   *
+   * @return The record size in bytes
+   */
+  size_t record_size() const;
+
+  /**
+   * Gets the current read tail of the writer
+   *
+   * @return The read tail
+   */
+  uint64_t read_tail() const;
+
+  /**
+   * Gets the number of records visible to readers
+   *
+   * @return The number of records
+   */
+  size_t num_records() const;
+
+  /**
+   * Reads the record at the given offset without copying
+   *
+   * @param offset The data log offset of the record
+   * @param ptr Set to a read-only pointer to the record, or to null if the
+   * offset is not below the read tail
+   */
+  void read(uint64_t offset, read_only_data_log_ptr &ptr) const;
+
+  /**
+   * Reads the record at the given offset
+   *
+   * @param offset The data log offset of the record
+   * @return The record fields as strings, or an empty vector if the
+   * offset is not below the read tail
+   */
+  std::vector<std::string> read(uint64_t offset) const;
+
+  /**
+   * Scans all records currently visible to readers
+   *
+   * @return A cursor over the records
+   */
+  std::unique_ptr<record_cursor> scan() const;
+
+  /**
+   * Scans all records currently visible to readers that satisfy a filter
+   * expression
+   *
+   * @param expr The filter expression
+   * @return A cursor over the matching records
+   */
+  std::unique_ptr<record_cursor> execute_filter(const std::string &expr) const;
+
+ private:
+  friend class read_only_record_cursor;
+
+  /**
+   * Gets the start of a data log bucket, mapping it if necessary
+   *
+   * @param idx The bucket index
+   * @return Pointer to the bucket data
+   */
+  uint8_t *bucket(size_t idx) const;
+
+  std::string name_;
+  std::string path_;
+  schema_t schema_;
+  atomic::type<uint64_t> *read_tail_;
+
+  monolog::bucket_geometry geometry_;
+
+  mutable std::mutex map_mtx_;
+  mutable monolog::bucket_directory<atomic::type<uint8_t *>> buckets_;
+  mutable std::vector<std::pair<void *, size_t>> mappings_;
+};
+
+}
+
+#endif /* CONFLUO_READ_ONLY_MULTILOG_H_ */
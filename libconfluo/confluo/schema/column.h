@@ -83,12 +83,32 @@ class column_t {
    */
   double index_bucket_size() const;
 
+  /**
+   * Gets the type of the column index
+   * @return The index type
+   */
+  index_type_t index_type() const;
+
   /**
    * Whether the column is indexed
    * @return True if the column is indexed, false otherwise
    */
   bool is_indexed() const;
 
+  /**
+   * Whether the column index covers all records and can serve queries
+   * @return True if the column index is queryable, false otherwise
+   */
+  bool is_queryable() const;
+
+  /**
+   * Whether the writer of a record must add it to the column index
+   * @param offset The data log offset of the record
+   * @return True if the record must be indexed on write, false if it is
+   * left to the backfill
+   */
+  bool index_on_write(uint64_t offset) const;
+
   /**
    * Index the column
    * @return True if the column was successfully indexed, false otherwise
@@ -99,8 +119,29 @@ class column_t {
    * Sets index
    * @param index_id The id of the index
    * @param bucket_size The size of the bucket
+   * @param type The type of the index
    */
-  void set_indexed(uint16_t index_id, double bucket_size);
+  void set_indexed(uint16_t index_id, double bucket_size, index_type_t type = RADIX_INDEX);
+
+  /**
+   * Sets index, with existing records yet to be backfilled
+   * @param index_id The id of the index
+   * @param bucket_size The size of the bucket
+   * @param type The type of the index
+   */
+  void set_backfilling(uint16_t index_id, double bucket_size, index_type_t type = RADIX_INDEX);
+
+  /**
+   * Sets the data log offset below which records are backfilled
+   * @param boundary The backfill boundary
+   */
+  void set_backfill_boundary(uint64_t boundary);
+
+  /**
+   * Marks the backfill of the column index as complete
+   * @return True if the index became queryable, false otherwise
+   */
+  bool finish_backfill();
 
   /**
    * Unindexes the column
@@ -120,6 +161,14 @@ class column_t {
    */
   field_t apply(void *data) const;
 
+  /**
+   * Creates field from a resolved variable-length value
+   * @param value Pointer to the value
+   * @param length The length of the value
+   * @return The new field
+   */
+  field_t apply_var(void *value, size_t length) const;
+
   /**
    * Takes a snapshot of the column data
    *
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 
+#include "schema/index_state.h"
 #include "types/data_type.h"
 
 namespace confluo {
@@ -21,6 +22,8 @@ struct column_snapshot {
   uint32_t index_id;
   /** The bucket size for the index */
   double index_bucket_size;
+  /** The type of the index */
+  index_type_t index_type;
 };
 
 }
@@ -0,0 +1,151 @@
+#ifndef CONFLUO_SCHEMA_COMPOSITE_INDEX_H_
+#define CONFLUO_SCHEMA_COMPOSITE_INDEX_H_
+
+#include <string>
+#include <vector>
+
+#include "index_state.h"
+#include "record.h"
+#include "types/byte_string.h"
+
+namespace confluo {
+
+/**
+ * Composite index class. Describes an index over an ordered list of
+ * columns, whose key is the concatenation of the (bucketed) keys of each
+ * column. Since each column key preserves the order of its values, the
+ * composite key orders records by the first column, then the second, and
+ * so on.
+ */
+class composite_index_t {
+ public:
+  /** Composite keys up to this size are built without heap allocation */
+  static const size_t MAX_STACK_KEY_SIZE = 128;
+
+  /**
+   * Constructs a composite index over the specified columns
+   * @param name The name of the composite index
+   * @param fields The indexes of the columns, in key order
+   * @param key_sizes The key size of each column
+   * @param bucket_sizes The bucket size of each column
+   */
+  composite_index_t(const std::string &name,
+                    const std::vector<uint16_t> &fields,
+                    const std::vector<size_t> &key_sizes,
+                    const std::vector<double> &bucket_sizes);
+
+  /**
+   * Gets the name of the composite index
+   * @return The name of the composite index
+   */
+  const std::string &name() const;
+
+  /**
+   * Gets the indexes of the columns in the composite index
+   * @return The column indexes, in key order
+   */
+  const std::vector<uint16_t> &fields() const;
+
+  /**
+   * Gets the key size of each column in the composite index
+   * @return The column key sizes, in key order
+   */
+  const std::vector<size_t> &key_sizes() const;
+
+  /**
+   * Gets the bucket size of each column in the composite index
+   * @return The column bucket sizes, in key order
+   */
+  const std::vector<double> &bucket_sizes() const;
+
+  /**
+   * Gets the size of the composite key
+   * @return The composite key size
+   */
+  size_t key_size() const;
+
+  /**
+   * Builds the composite key for a record
+   * @param r The record
+   * @return The composite key
+   */
+  byte_string get_key(const record_t &r) const;
+
+  /**
+   * Concatenates per-column keys into a composite key; each key is
+   * truncated or zero-padded to the column key size
+   * @param keys The per-column keys, in key order
+   * @return The composite key
+   */
+  byte_string concat(const std::vector<byte_string> &keys) const;
+
+  /**
+   * Gets the id of the underlying index
+   * @return The index id
+   */
+  uint16_t index_id() const;
+
+  /**
+   * Whether writers must update the composite index
+   * @return True if the composite index is indexed, false otherwise
+   */
+  bool is_indexed() const;
+
+  /**
+   * Whether the composite index covers all records and can serve queries
+   * @return True if the composite index is queryable, false otherwise
+   */
+  bool is_queryable() const;
+
+  /**
+   * Whether the writer of a record must add it to the composite index
+   * @param offset The data log offset of the record
+   * @return True if the record must be indexed on write, false if it is
+   * left to the backfill
+   */
+  bool index_on_write(uint64_t offset) const;
+
+  /**
+   * Sets the composite index state to indexing
+   * @return True if the state was set, false otherwise
+   */
+  bool set_indexing();
+
+  /**
+   * Sets the composite index, with existing records yet to be backfilled
+   * @param index_id The id of the underlying index
+   */
+  void set_backfilling(uint16_t index_id);
+
+  /**
+   * Sets the data log offset below which records are backfilled
+   * @param boundary The backfill boundary
+   */
+  void set_backfill_boundary(uint64_t boundary);
+
+  /**
+   * Marks the backfill of the composite index as complete
+   * @return True if the index became queryable, false otherwise
+   */
+  bool finish_backfill();
+
+  /**
+   * Disables the composite index
+   * @return True if the index was disabled, false otherwise
+   */
+  bool disable_indexing();
+
+ private:
+  static void copy_key(uint8_t *dst, const byte_string &key, size_t key_size);
+
+  std::string name_;
+  std::vector<uint16_t> fields_;
+  std::vector<size_t> key_sizes_;
+  std::vector<double> bucket_sizes_;
+  size_t key_size_;
+  index_state_t idx_state_;
+};
+
+}
+
+#endif /* CONFLUO_SCHEMA_COMPOSITE_INDEX_H_ */
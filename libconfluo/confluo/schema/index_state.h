@@ -6,6 +6,16 @@
 
 namespace confluo {
 
+/**
+ * Types of index on a column
+ */
+enum index_type_t {
+  /** Radix tree index; serves equality and range predicates */
+      RADIX_INDEX = 0,
+  /** Hash index; serves equality predicates only */
+      HASH_INDEX = 1
+};
+
 /**
  * Possible index stages
  */
@@ -16,6 +26,11 @@ struct index_state_t {
   static const uint8_t INDEXING = 1;
   /** Already indexed */
   static const uint8_t INDEXED = 2;
+  /** Indexed on writes, but existing records are still being backfilled */
+  static const uint8_t BACKFILLING = 3;
+
+  /** Backfill boundary while it is yet to be determined */
+  static const uint64_t UNSET_BOUNDARY = UINT64_MAX;
 
   /**
    * Constructs a default index state, which is to be unindexed
@@ -43,6 +58,13 @@ struct index_state_t {
    */
   double bucket_size() const;
 
+  /**
+   * Gets the type of the index of this index state
+   *
+   * @return The index type of this index state
+   */
+  index_type_t type() const;
+
   /**
    * Assigns the other index state to this index state
    *
@@ -54,12 +76,40 @@ struct index_state_t {
   index_state_t &operator=(const index_state_t &other);
 
   /**
-   * Checks whether this index state is in the indexed stage
+   * Checks whether this index state is in the indexed or backfilling stage,
+   * i.e., whether new records are added to the index
    *
    * @return True if this index state is indexed, false otherwise
    */
   bool is_indexed() const;
 
+  /**
+   * Checks whether the index covers all records and can be used to
+   * answer queries
+   *
+   * @return True if this index state is indexed and not backfilling,
+   * false otherwise
+   */
+  bool is_queryable() const;
+
+  /**
+   * Checks whether a record at the given data log offset must be indexed
+   * on the write path; records below the backfill boundary are indexed by
+   * the backfill instead.
+   *
+   * @param offset The data log offset of the record
+   *
+   * @return True if the writer must index the record, false otherwise
+   */
+  bool index_on_write(uint64_t offset) const;
+
+  /**
+   * Gets the data log offset below which records are backfilled
+   *
+   * @return The backfill boundary
+   */
+  uint64_t backfill_boundary() const;
+
   /**
    * Sets this index stage to be indexing
    *
@@ -72,8 +122,33 @@ struct index_state_t {
    *
    * @param index_id The identifier for the index
    * @param bucket_size The bucket size for lookup
+   * @param type The type of the index
+   */
+  void set_indexed(uint16_t index_id, double bucket_size, index_type_t type = RADIX_INDEX);
+
+  /**
+   * Sets the index stage to be backfilling, with the backfill boundary yet
+   * to be determined
+   *
+   * @param index_id The identifier for the index
+   * @param bucket_size The bucket size for lookup
+   * @param type The type of the index
+   */
+  void set_backfilling(uint16_t index_id, double bucket_size, index_type_t type = RADIX_INDEX);
+
+  /**
+   * Sets the data log offset below which records are backfilled
+   *
+   * @param boundary The backfill boundary
+   */
+  void set_backfill_boundary(uint64_t boundary);
+
+  /**
+   * If the index stage is backfilling, sets the stage to be indexed
+   *
+   * @return True if the backfill was marked complete, false otherwise
    */
-  void set_indexed(uint16_t index_id, double bucket_size);
+  bool finish_backfill();
 
   /**
    * Sets the index stage to be not indexed
@@ -81,7 +156,8 @@ struct index_state_t {
   void set_unindexed();
 
   /**
-   * If the index stage is indexed, sets the stage to be not indexed
+   * If the index stage is indexed or backfilling, sets the stage to be not
+   * indexed
    *
    * @return True if this index stage is unindexed, false otherwise
    */
@@ -91,6 +167,8 @@ struct index_state_t {
   atomic::type<uint8_t> state_;
   uint16_t id_;
   double bucket_size_;
+  index_type_t type_;
+  atomic::type<uint64_t> backfill_boundary_;
 };
 
 }
@@ -1,6 +1,7 @@
 #ifndef CONFLUO_SCHEMA_RECORD_H_
 #define CONFLUO_SCHEMA_RECORD_H_
 
+#include <memory>
 #include <vector>
 #include <cstdint>
 
@@ -48,6 +49,16 @@ struct record_t {
    */
   void reserve(size_t n);
 
+  /**
+   * Allocates a buffer owned by the record, that holds the values of
+   * variable-length fields; the buffer is shared by copies of the record
+   *
+   * @param size The size of the buffer in bytes
+   *
+   * @return Pointer to the buffer
+   */
+  uint8_t *alloc_var_data(size_t size);
+
   /**
    * Adds a value to the record
    *
@@ -168,6 +179,8 @@ struct record_t {
   size_t size_;
   uint64_t version_;
   std::vector<field_t> fields_;
+  std::shared_ptr<std::vector<uint8_t>> var_data_;
+  std::shared_ptr<std::vector<uint8_t>> decoded_data_;
 };
 
 }
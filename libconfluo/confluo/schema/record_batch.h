@@ -62,7 +62,7 @@ class record_batch_builder {
 
   /**
    * Adds record data to the batch
-   * @param data The record data to be added
+   * @param data The (inline) record data to be added
    */
   void add_record(const void *data);
 
@@ -78,8 +78,21 @@ class record_batch_builder {
    */
   record_batch get_batch();
 
+  /**
+   * Builds a batch directly from contiguous fixed-length records, without
+   * an intermediate copy per record; consecutive records in the same time
+   * block share a record block
+   *
+   * @param records Pointer to nrecords contiguous records
+   * @param nrecords The number of records
+   * @param record_size The size of each record
+   * @return The batch
+   */
+  static record_batch from_records(const void *records, size_t nrecords, size_t record_size);
+
  private:
   std::map<int64_t, size_t> batch_sizes_;
+  std::map<int64_t, size_t> batch_nrecords_;
   std::map<int64_t, std::stringstream> batch_;
   const schema_t &schema_;
 };
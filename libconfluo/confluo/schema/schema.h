@@ -26,6 +26,8 @@ using namespace utils;
 
 namespace confluo {
 
+class var_heap;
+
 /**
  * The schema for the atomic multilog. Contains operations applied to
  * data that it contains.
@@ -110,6 +112,48 @@ class schema_t {
    */
   size_t size() const;
 
+  /**
+   * Sets the heap holding the values of variable-length columns. Records
+   * are resolved against the heap when the schema is applied; without a
+   * heap, records are assumed to be inline.
+   *
+   * @param heap The heap for variable-length values
+   */
+  void set_var_heap(const var_heap *heap);
+
+  /**
+   * Checks whether the schema has variable-length columns
+   *
+   * @return True if the schema has variable-length columns, false
+   * otherwise
+   */
+  bool has_var_columns() const;
+
+  /**
+   * Gets the indexes of the variable-length columns
+   *
+   * @return The indexes of the variable-length columns
+   */
+  const std::vector<uint16_t> &var_columns() const;
+
+  /**
+   * Gets the size of an inline record, i.e., the fixed-size record
+   * followed by its variable-length values
+   *
+   * @param data The inline record data
+   *
+   * @return The size of the inline record in bytes
+   */
+  size_t inline_record_size(const void *data) const;
+
+  /**
+   * Appends the inline representation of a record to a string
+   *
+   * @param out The string to append to
+   * @param r The record
+   */
+  void inline_record(std::string &out, const record_t &r) const;
+
   /**
    * Applies the schema on raw data to get a record
    *
@@ -161,7 +205,7 @@ class schema_t {
   std::string to_string() const;
 
   /**
-   * Converts the records into a pointer to the record data
+   * Converts the records into a pointer to the (inline) record data
    *
    * @param record The records used for conversion
    *
@@ -170,7 +214,7 @@ class schema_t {
   void *record_vector_to_data(const std::vector<std::string> &record) const;
 
   /**
-   * Converts the records into a string
+   * Converts the records into a string holding the inline record
    *
    * @param out The string containing the data of the records
    * @param record The records used for conversion
@@ -178,7 +222,7 @@ class schema_t {
   void record_vector_to_data(std::string &out, const std::vector<std::string> &record) const;
 
   /**
-   * Converts the pointer to record data to a vector of records
+   * Converts the pointer to (inline) record data to a vector of records
    *
    * @param ret The vector of string records that is filled up
    * @param data The pointer to the record data
@@ -199,9 +243,13 @@ class schema_t {
   }
 
  private:
+  void apply_fields(record_t &r) const;
+
   size_t record_size_;  // TODO: Switch to dynamically sized records at some point
   std::vector<column_t> columns_;
   std::map<std::string, uint16_t> name_map_;
+  std::vector<uint16_t> var_columns_;
+  const var_heap *var_heap_;
 };
 
 /**
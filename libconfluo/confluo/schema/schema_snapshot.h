@@ -8,6 +8,8 @@
 
 namespace confluo {
 
+class var_heap;
+
 /**
  * Snapshot of the schema for backups
  */
@@ -42,6 +44,33 @@ class schema_snapshot {
    */
   immutable_value get(void *data, uint32_t i) const;
 
+  /**
+   * Sets the heap holding the values of variable-length columns; without
+   * a heap, data is assumed to be inline
+   *
+   * @param heap The heap for variable-length values
+   */
+  void set_var_heap(const var_heap *heap);
+
+  /**
+   * Checks whether a column is variable-length
+   *
+   * @param i The index of the column
+   *
+   * @return True if the column is variable-length, false otherwise
+   */
+  bool is_var_length(size_t i) const;
+
+  /**
+   * Gets the value of a variable-length column
+   *
+   * @param data The record data
+   * @param i The index of the column
+   *
+   * @return The value of the column
+   */
+  std::string get_var(void *data, uint32_t i) const;
+
   /**
    * Gets the time key of the schema snapshot
    *
@@ -98,6 +127,15 @@ class schema_snapshot {
    */
   double index_bucket_size(size_t i) const;
 
+  /**
+   * Gets the index type of a column snapshot
+   *
+   * @param i The index of the column snapshot
+   *
+   * @return The index type of the specified column snapshot
+   */
+  index_type_t index_type(size_t i) const;
+
   /**
    * Gets the number of columns in the schema snapshot
    *
@@ -107,6 +145,7 @@ class schema_snapshot {
 
  private:
   std::vector<column_snapshot> snapshot_;
+  const var_heap *var_heap_ = nullptr;
 };
 
 }
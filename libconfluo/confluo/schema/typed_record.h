@@ -0,0 +1,207 @@
+#ifndef CONFLUO_SCHEMA_TYPED_RECORD_H_
+#define CONFLUO_SCHEMA_TYPED_RECORD_H_
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <tuple>
+
+#include "exceptions.h"
+#include "schema/schema.h"
+#include "types/primitive_types.h"
+
+namespace confluo {
+
+/**
+ * Maps a C++ field type to the Confluo types it can be bound to. Fields
+ * are stored as-is in the record, so each type must have the same size
+ * and representation as the column type.
+ */
+template<typename T>
+struct field_traits;
+
+/** Declares the primitive type a C++ type binds to */
+#define DEFINE_FIELD_TRAITS(cpp_type, type_id)\
+template<>\
+struct field_traits<cpp_type> {\
+  static bool matches(const data_type &type) {\
+    return type.id == type_id && type.size == sizeof(cpp_type);\
+  }\
+};
+
+DEFINE_FIELD_TRAITS(bool, primitive_type::D_BOOL)
+DEFINE_FIELD_TRAITS(int8_t, primitive_type::D_CHAR)
+DEFINE_FIELD_TRAITS(uint8_t, primitive_type::D_UCHAR)
+DEFINE_FIELD_TRAITS(int16_t, primitive_type::D_SHORT)
+DEFINE_FIELD_TRAITS(uint16_t, primitive_type::D_USHORT)
+DEFINE_FIELD_TRAITS(int32_t, primitive_type::D_INT)
+DEFINE_FIELD_TRAITS(uint32_t, primitive_type::D_UINT)
+DEFINE_FIELD_TRAITS(int64_t, primitive_type::D_LONG)
+DEFINE_FIELD_TRAITS(uint64_t, primitive_type::D_ULONG)
+DEFINE_FIELD_TRAITS(float, primitive_type::D_FLOAT)
+DEFINE_FIELD_TRAITS(double, primitive_type::D_DOUBLE)
+
+#undef DEFINE_FIELD_TRAITS
+
+/**
+ * Fixed-width strings bind to STRING columns of the same width
+ */
+template<size_t N>
+struct field_traits<std::array<char, N>> {
+  static bool matches(const data_type &type) {
+    return type.id == primitive_type::D_STRING && type.size == N;
+  }
+};
+
+/**
+ * Packs, unpacks and type-checks the fields of a tuple laid out as a
+ * Confluo record, one field at a time
+ */
+template<size_t I, size_t N, typename Tuple>
+struct tuple_record_io {
+  /** The type of field I */
+  typedef typename std::tuple_element<I, Tuple>::type field_type;
+  /** The size of fields I onwards in the record */
+  static const size_t SIZE = sizeof(field_type) + tuple_record_io<I + 1, N, Tuple>::SIZE;
+
+  /**
+   * Checks fields I onwards against the corresponding columns
+   *
+   * @param schema The schema
+   * @throw invalid_cast_exception If a field does not match its column
+   */
+  static void check(const schema_t &schema) {
+    const column_t &col = schema[I];
+    // Timestamps may be bound as signed or unsigned
+    bool matches = field_traits<field_type>::matches(col.type())
+        || (I == 0 && field_traits<field_type>::matches(primitive_types::LONG_TYPE()));
+    if (!matches) {
+      THROW(invalid_cast_exception, "Field " + std::to_string(I) + " does not match column " + col.name()
+          + " of type " + col.type().name());
+    }
+    tuple_record_io<I + 1, N, Tuple>::check(schema);
+  }
+
+  /**
+   * Copies fields I onwards into a record
+   *
+   * @param t The tuple
+   * @param out The position of field I in the record
+   */
+  static void pack(const Tuple &t, uint8_t *out) {
+    memcpy(out, &std::get<I>(t), sizeof(field_type));
+    tuple_record_io<I + 1, N, Tuple>::pack(t, out + sizeof(field_type));
+  }
+
+  /**
+   * Copies fields I onwards out of a record
+   *
+   * @param in The position of field I in the record
+   * @param t The tuple
+   */
+  static void unpack(const uint8_t *in, Tuple &t) {
+    memcpy(&std::get<I>(t), in, sizeof(field_type));
+    tuple_record_io<I + 1, N, Tuple>::unpack(in + sizeof(field_type), t);
+  }
+};
+
+/**
+ * Terminates the recursion over tuple fields
+ */
+template<size_t N, typename Tuple>
+struct tuple_record_io<N, N, Tuple> {
+  /** No fields remain */
+  static const size_t SIZE = 0;
+
+  static void check(const schema_t &schema) {
+  }
+
+  static void pack(const Tuple &t, uint8_t *out) {
+  }
+
+  static void unpack(const uint8_t *in, Tuple &t) {
+  }
+};
+
+/**
+ * A record type known at compile time, given by the types of its fields
+ * in column order, starting with the timestamp. Records are exchanged
+ * either as tuples of the field types, or as packed structs with the
+ * same fields, which are copied as-is.
+ *
+ * @tparam Fields The field types
+ */
+template<typename... Fields>
+class typed_record {
+ public:
+  /** The tuple representation of a record */
+  typedef std::tuple<Fields...> tuple_type;
+  /** The number of fields */
+  static const size_t NUM_FIELDS = sizeof...(Fields);
+  /** The size of the packed record */
+  static const size_t SIZE = tuple_record_io<0, NUM_FIELDS, tuple_type>::SIZE;
+
+  /**
+   * Checks that a schema has exactly these fields
+   *
+   * @param schema The schema
+   * @throw invalid_cast_exception If the schema does not match
+   */
+  static void check(const schema_t &schema) {
+    if (schema.has_var_columns()) {
+      THROW(invalid_cast_exception, "Typed records do not support variable-length columns");
+    }
+    if (schema.size() != NUM_FIELDS) {
+      THROW(invalid_cast_exception, "Schema has " + std::to_string(schema.size()) + " columns, but record has "
+          + std::to_string(NUM_FIELDS) + " fields");
+    }
+    tuple_record_io<0, NUM_FIELDS, tuple_type>::check(schema);
+  }
+
+  /**
+   * Packs a tuple into a record
+   *
+   * @param t The tuple
+   * @param out The record, at least SIZE bytes
+   */
+  static void pack(const tuple_type &t, uint8_t *out) {
+    tuple_record_io<0, NUM_FIELDS, tuple_type>::pack(t, out);
+  }
+
+  /**
+   * Unpacks a record into a tuple
+   *
+   * @param in The record
+   * @param t The tuple
+   */
+  static void unpack(const uint8_t *in, tuple_type &t) {
+    tuple_record_io<0, NUM_FIELDS, tuple_type>::unpack(in, t);
+  }
+
+  /**
+   * Checks at compile time that a struct can stand in for the packed record
+   *
+   * @tparam T The struct type
+   */
+  template<typename T>
+  static void check_struct() {
+    static_assert(sizeof(T) == SIZE, "Struct size does not match the record size; is it packed?");
+    static_assert(std::is_trivially_copyable<T>::value, "Struct must be trivially copyable");
+  }
+};
+
+template<size_t I, size_t N, typename Tuple>
+const size_t tuple_record_io<I, N, Tuple>::SIZE;
+
+template<size_t N, typename Tuple>
+const size_t tuple_record_io<N, N, Tuple>::SIZE;
+
+template<typename... Fields>
+const size_t typed_record<Fields...>::NUM_FIELDS;
+
+template<typename... Fields>
+const size_t typed_record<Fields...>::SIZE;
+
+}
+
+#endif /* CONFLUO_SCHEMA_TYPED_RECORD_H_ */
@@ -0,0 +1,100 @@
+#ifndef CONFLUO_STORAGE_ARCHIVE_MAPPER_H_
+#define CONFLUO_STORAGE_ARCHIVE_MAPPER_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace confluo {
+namespace storage {
+
+/**
+ * Shares memory mappings of archive files. Each file is mapped in large,
+ * page-aligned extents the first time a range inside an extent is requested,
+ * and later ranges in the same extent are served as interior pointers, so
+ * archiving or loading many small buckets costs one open/mmap per extent
+ * rather than one per bucket. Extents are reference counted by the pointers
+ * handed out, and unmapped once all of them have been released.
+ */
+class archive_mapper {
+ public:
+  /**
+   * Creates a mapper
+   *
+   * @param extent_size The size of each mapped extent, rounded up to a
+   * multiple of the page size; 0 disables sharing
+   */
+  explicit archive_mapper(size_t extent_size);
+
+  archive_mapper(const archive_mapper &) = delete;
+  archive_mapper &operator=(const archive_mapper &) = delete;
+
+  /**
+   * Unmaps all extents
+   */
+  ~archive_mapper();
+
+  /**
+   * Gets a pointer to a range of an archive file, mapping the extent that
+   * contains it if necessary. The range must already be written to the file.
+   *
+   * @param path The path of the file
+   * @param offset The offset of the range in the file
+   * @param size The size of the range
+   * @return A pointer to the range, or nullptr if the range spans extents
+   * or sharing is disabled
+   */
+  uint8_t *acquire(const std::string &path, size_t offset, size_t size);
+
+  /**
+   * Releases a pointer returned by acquire, unmapping its extent if no
+   * other pointers into it remain
+   *
+   * @param ptr The pointer
+   */
+  void release(const void *ptr);
+
+  /**
+   * Stops handing out pointers into the current extents of a file, e.g.,
+   * when the file is recreated; existing pointers stay valid until released
+   *
+   * @param path The path of the file
+   */
+  void invalidate(const std::string &path);
+
+  /**
+   * Gets the number of mapped extents
+   *
+   * @return The number of mapped extents
+   */
+  size_t num_extents() const;
+
+  /**
+   * Gets the number of bytes mapped across all extents
+   *
+   * @return The number of mapped bytes
+   */
+  size_t mapped_bytes() const;
+
+ private:
+  struct extent {
+    std::string path;
+    size_t idx;
+    uint8_t *base;
+    size_t refs;
+    bool valid;
+  };
+
+  void unmap(extent *e);
+
+  size_t extent_size_;
+  mutable std::mutex mutex_;
+  std::map<std::pair<std::string, size_t>, extent *> files_;
+  std::map<uintptr_t, extent *> extents_;
+};
+
+}
+}
+
+#endif /* CONFLUO_STORAGE_ARCHIVE_MAPPER_H_ */
@@ -155,6 +155,35 @@ class encoded_ptr {
     return std::unique_ptr<T>(decoded);
   }
 
+  /**
+   * Decode a range of the pointer without decoding the rest of it.
+   * Unencoded data is returned in place; encoded data is decoded into
+   * the buffer if one is provided, or into a newly allocated buffer.
+   * @param start_idx index to start at
+   * @param len number of elements
+   * @param buffer buffer of at least len elements, or nullptr
+   * @return pointer to decoded range
+   */
+  decoded_ptr<T> decode_range(size_t start_idx, size_t len, T *buffer = nullptr) const {
+    if (!is_encoded()) {
+      return decoded_ptr<T>(this->ptr_as<T>() + start_idx, detail::no_op_delete<T>);
+    }
+    if (buffer != nullptr) {
+      decode(buffer, start_idx, len);
+      return decoded_ptr<T>(buffer, detail::no_op_delete<T>);
+    }
+    T *decoded = new T[len];
+    decode(decoded, start_idx, len);
+    return decoded_ptr<T>(decoded, detail::array_delete<T>);
+  }
+
+  /**
+   * @return true if the pointed to data is encoded, false otherwise
+   */
+  bool is_encoded() const {
+    return ptr_aux_block::get(ptr_metadata::get(ptr_)).encoding_ != encoding_type::D_UNENCODED;
+  }
+
   /**
    * Decode pointer, starting at an index.
    * @param start_idx index to start decoding at
@@ -15,6 +15,8 @@ struct alloc_type {
   static const uint8_t D_DEFAULT = 0;
   /** Memory mapped allocation */
   static const uint8_t D_MMAP = 1;
+  /** Interior pointer into a shared mapping of an archive file */
+  static const uint8_t D_ARCHIVE_MAP = 2;
 };
 
 /**
@@ -25,8 +27,8 @@ struct ptr_metadata {
   // Do NOT re-order.
   uint32_t data_size_ : 32; // size of data
   uint16_t offset_: 16; // data offset from allocated pointer location
-  uint16_t thread_id_ : 11; // allocating thread id
-  uint8_t alloc_type_ : 1; // allocation type
+  uint16_t thread_id_ : 10; // allocating thread id
+  uint8_t alloc_type_ : 2; // allocation type
   uint8_t aux_ : 4; // data-related state information
 
   ptr_metadata() = default;
@@ -4,6 +4,7 @@
 #include <functional>
 #include <unistd.h>
 
+#include "archive_mapper.h"
 #include "conf/configuration_params.h"
 #include "exceptions.h"
 #include "memory_stat.h"
@@ -63,6 +64,19 @@ class storage_allocator {
    */
   void* mmap(std::string path, off_t offset, size_t size, ptr_aux_block aux = ptr_aux_block());
 
+  /**
+   * Memory-maps part of an archive file through the shared archive
+   * mappings, so that buckets in the same file extent share one mapping.
+   * Falls back to a separate mapping if the part spans extents.
+   *
+   * @param path path of file
+   * @param offset file offset of the pointer metadata
+   * @param size size to map, exclusive of metadata
+   * @param state pointer state (bit field, constrained to storage::state_type)
+   * @return pointer to memory
+   */
+  void* map_archived(const std::string &path, size_t offset, size_t size, ptr_aux_block aux = ptr_aux_block());
+
   /**
    * Deallocate or unmap pointer returned by this allocator.
    * @param ptr pointer to memory
@@ -76,9 +90,17 @@ class storage_allocator {
    */
   size_t memory_utilization();
 
+  /**
+   * Gets the shared mappings of archive files
+   *
+   * @return The archive mapper
+   */
+  archive_mapper &archive_map();
+
  private:
   memory_stat mem_stat_;
   memory_stat mmap_stat_;
+  archive_mapper archive_map_;
   callback_fn mem_cleanup_callback_;
 
   static const int MAX_CLEANUP_RETRIES = 10;
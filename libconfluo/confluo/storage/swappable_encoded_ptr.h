@@ -163,6 +163,18 @@ class read_only_encoded_ptr {
     return enc_ptr_.decode(idx + offset_, len);
   }
 
+  /**
+   * Decodes length elements of pointer from index onwards, in place if
+   * the pointer is unencoded.
+   * @param idx start index
+   * @param len length of decoded data
+   * @param buffer buffer to decode into, or nullptr to allocate one
+   * @return decoded pointer
+   */
+  decoded_ptr<T> decode_range(size_t idx, size_t len, T *buffer = nullptr) const {
+    return enc_ptr_.decode_range(idx + offset_, len, buffer);
+  }
+
   T operator[](size_t idx) {
     return decode_at(idx);
   }
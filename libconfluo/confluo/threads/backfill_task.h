@@ -0,0 +1,130 @@
+#ifndef CONFLUO_THREADS_BACKFILL_TASK_H_
+#define CONFLUO_THREADS_BACKFILL_TASK_H_
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "atomic.h"
+#include "logger.h"
+
+namespace confluo {
+
+/**
+ * Snapshot of the progress of a backfill
+ */
+struct backfill_status {
+  /** The number of records that existed when the backfill started */
+  uint64_t total_records;
+  /** The number of records backfilled so far */
+  uint64_t backfilled_records;
+  /** Time elapsed since the backfill started, in milliseconds */
+  uint64_t elapsed_ms;
+  /** Whether the backfill has completed */
+  bool done;
+  /** Whether the backfill was cancelled or could not complete */
+  bool failed;
+
+  /**
+   * Gets the fraction of records backfilled so far
+   *
+   * @return The progress, between 0 and 1
+   */
+  double progress() const;
+
+  /**
+   * Gets the backfill throughput
+   *
+   * @return The number of records backfilled per second
+   */
+  double throughput() const;
+};
+
+/**
+ * Scans a prefix of the data log in parallel partitions on a set of
+ * dedicated threads, which claim partitions in increasing offset order.
+ */
+class backfill_task {
+ public:
+  /** Scans records in the data log range [begin, end) */
+  typedef std::function<void(uint64_t begin, uint64_t end)> scan_fn;
+  /**
+   * Invoked once, by the last worker, when all partitions are scanned;
+   * never invoked once the task is cancelled
+   */
+  typedef std::function<void(void)> done_fn;
+
+  /**
+   * Constructs a backfill task over the data log range [0, end_offset)
+   *
+   * @param name The name of the task
+   * @param end_offset The data log offset up to which records are scanned
+   * @param record_size The size of each record
+   */
+  backfill_task(const std::string &name, uint64_t end_offset, size_t record_size);
+
+  /**
+   * Cancels the backfill and waits for the workers to exit
+   */
+  ~backfill_task();
+
+  /**
+   * Starts the backfill workers
+   *
+   * @param scan The scan function invoked for each partition
+   * @param on_done The function invoked when the backfill completes
+   * @param num_workers The number of worker threads
+   * @param chunk_records The number of records per partition
+   */
+  void start(scan_fn scan, done_fn on_done, int num_workers, uint64_t chunk_records);
+
+  /**
+   * Stops the workers from claiming further partitions; does not wait
+   * for partitions already being scanned. Once cancel returns, the done
+   * function has either completed or will never be invoked.
+   */
+  void cancel();
+
+  /**
+   * Waits for all workers to exit
+   */
+  void wait();
+
+  /**
+   * Gets the progress of the backfill
+   *
+   * @return The backfill status
+   */
+  backfill_status status() const;
+
+ private:
+  void work();
+  void finish_worker();
+  uint64_t now_ms() const;
+
+  std::string name_;
+  uint64_t end_offset_;
+  size_t record_size_;
+  uint64_t chunk_bytes_;
+  scan_fn scan_;
+  done_fn on_done_;
+
+  atomic::type<uint64_t> next_offset_;
+  atomic::type<uint64_t> backfilled_bytes_;
+  atomic::type<int> active_workers_;
+  atomic::type<bool> cancelled_;
+  std::mutex done_mtx_;  // Orders cancellation against the done function
+  atomic::type<bool> done_;
+  atomic::type<bool> failed_;
+  uint64_t start_ms_;
+  atomic::type<uint64_t> end_ms_;
+  std::vector<std::thread> workers_;
+};
+
+}
+
+#endif /* CONFLUO_THREADS_BACKFILL_TASK_H_ */
@@ -45,6 +45,8 @@ class periodic_task {
   std::string name_;
   atomic::type<bool> enabled_;
   std::thread executor_;
+  std::mutex wait_mtx_;
+  std::condition_variable wait_cv_;
 };
 
 #endif /* CONFLUO_THREADS_PERIODIC_TASK_H_ */
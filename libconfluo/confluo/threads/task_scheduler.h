@@ -0,0 +1,211 @@
+#ifndef CONFLUO_THREADS_TASK_SCHEDULER_H_
+#define CONFLUO_THREADS_TASK_SCHEDULER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "atomic.h"
+#include "logger.h"
+#include "threads/task_pool.h"
+
+namespace confluo {
+
+/**
+ * Runs periodic tasks on a small, fixed pool of workers. Expiry times
+ * are kept in a hierarchical timer wheel driven by a single timer
+ * thread, which sleeps until the next expiry instead of waking per task.
+ * A task is re-armed only after its previous run completes, so runs of
+ * the same task never overlap. A task with nothing to do can park itself,
+ * so that it is not run again until it is woken.
+ */
+class task_scheduler {
+ public:
+  /** Identifies a scheduled task */
+  typedef uint64_t task_id;
+
+  /**
+   * Constructs a scheduler and starts its timer thread and workers
+   *
+   * @param num_workers The number of threads tasks are run on
+   * @param tick_ms The resolution of the timer wheel in milliseconds
+   */
+  task_scheduler(size_t num_workers, uint64_t tick_ms = 1);
+
+  /**
+   * Stops the timer thread and the workers; tasks that have not
+   * started running are dropped
+   */
+  ~task_scheduler();
+
+  /**
+   * Schedules a task to run periodically, starting on the next tick
+   *
+   * @param name The name of the task
+   * @param task The function that represents the work to do
+   * @param interval_ms The time between the starts of consecutive runs
+   * @return The identifier of the task
+   */
+  task_id schedule(const std::string &name, std::function<void(void)> task, uint64_t interval_ms);
+
+  /**
+   * Cancels a task, waiting for a run in progress to complete. Must not
+   * be called from the task itself.
+   *
+   * @param id The identifier of the task
+   * @return True if the task was cancelled, false if it did not exist
+   */
+  bool cancel(task_id id);
+
+  /**
+   * Parks a task: once its current run completes, the task is not run
+   * again until it is woken. Meant to be called from the task itself.
+   *
+   * @param id The identifier of the task
+   * @return True if the task was parked, false if it did not exist
+   */
+  bool park(task_id id);
+
+  /**
+   * Wakes a parked task, which runs again on the next tick; a task woken
+   * before its parking run completes is re-armed as usual
+   *
+   * @param id The identifier of the task
+   * @return True if the task was parked, false otherwise
+   */
+  bool wake(task_id id);
+
+  /**
+   * Gets the number of scheduled tasks
+   *
+   * @return The number of scheduled tasks
+   */
+  size_t num_tasks() const;
+
+  /**
+   * Gets the scheduler that runs the monitor tasks of all atomic
+   * multilogs, creating it on first use
+   *
+   * @return The shared scheduler
+   */
+  static task_scheduler &shared();
+
+  /**
+   * Gets the scheduler that runs the archival tasks of all atomic
+   * multilogs, creating it on first use; kept apart from shared() so that
+   * long archival runs never delay monitor tasks
+   *
+   * @return The archival scheduler
+   */
+  static task_scheduler &archival();
+
+ private:
+  /** A scheduled task */
+  struct entry {
+    task_id id;
+    std::string name;
+    std::function<void(void)> task;
+    uint64_t interval_ticks;
+    uint64_t expires;
+    bool cancelled;
+    bool running;
+    bool parked;
+  };
+  typedef std::shared_ptr<entry> entry_ptr;
+
+  static const size_t LEVELS = 4;
+  static const size_t SLOT_BITS = 6;
+  static const size_t SLOTS = 1 << SLOT_BITS;
+
+  uint64_t cur_tick() const;
+  uint64_t next_event_tick() const;
+  void insert(const entry_ptr &e);
+  void advance(std::vector<entry_ptr> &due);
+  void arm(const entry_ptr &e, uint64_t expires);
+  void run(entry_ptr e);
+  void timer_loop();
+
+  uint64_t tick_ms_;
+  std::chrono::steady_clock::time_point epoch_;
+
+  mutable std::mutex mtx_;
+  std::condition_variable timer_cv_;
+  std::condition_variable done_cv_;
+  bool stop_;
+  uint64_t now_tick_;
+  uint64_t wake_tick_;
+  task_id next_id_;
+  size_t wheel_size_;
+  std::map<task_id, entry_ptr> tasks_;
+  std::vector<entry_ptr> wheel_[LEVELS][SLOTS];
+  std::thread timer_;
+
+  // Declared last so that workers exit before the state they use is destroyed
+  task_pool workers_;
+};
+
+/**
+ * A periodic task run on a task scheduler; mirrors periodic_task
+ * without dedicating a thread to the task.
+ */
+class scheduled_task {
+ public:
+  /**
+   * Constructs a scheduled task
+   *
+   * @param name The name of the task
+   * @param scheduler The scheduler the task runs on
+   */
+  scheduled_task(const std::string &name, task_scheduler &scheduler = task_scheduler::shared());
+
+  /**
+   * Stops the task
+   */
+  ~scheduled_task();
+
+  /**
+   * Starts running the task periodically
+   *
+   * @param task The function that represents the work to do
+   * @param interval_ms The time in between executions of the task
+   * @return True if the task was started, false if it was already running
+   */
+  bool start(std::function<void(void)> task, uint64_t interval_ms = 1);
+
+  /**
+   * Stops the task, waiting for a run in progress to complete
+   *
+   * @return True if the task was stopped, false if it was not running
+   */
+  bool stop();
+
+  /**
+   * Parks the task until wake() is called; see task_scheduler::park
+   *
+   * @return True if the task was parked, false if it was not running
+   */
+  bool park();
+
+  /**
+   * Wakes the task if it is parked; see task_scheduler::wake
+   *
+   * @return True if the task was parked, false otherwise
+   */
+  bool wake();
+
+ private:
+  std::string name_;
+  task_scheduler *scheduler_;
+  atomic::type<bool> enabled_;
+  task_scheduler::task_id id_;
+};
+
+}
+
+#endif /* CONFLUO_THREADS_TASK_SCHEDULER_H_ */
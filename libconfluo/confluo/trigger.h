@@ -8,6 +8,16 @@
 namespace confluo {
 namespace monitor {
 
+/**
+ * When a trigger is evaluated
+ */
+enum trigger_mode_t {
+  /** Evaluated periodically by the monitor task */
+      POLLED_TRIGGER = 0,
+  /** Evaluated on the ingest path whenever its aggregate is updated */
+      EAGER_TRIGGER = 1
+};
+
 /**
  * A trigger structure. Contains trigger properties including the
  * periodicity, name, and aggregate
@@ -23,9 +33,10 @@ struct trigger {
    * @param op Trigger's relational operator
    * @param threshold Trigger's threshold
    * @param periodicity_ms Trigger's periodicity in milliseconds
+   * @param mode When the trigger is evaluated
    */
   trigger(const std::string &name, const std::string &aggregate_name, reational_op_id op, const numeric &threshold,
-          uint64_t periodicity_ms);
+          uint64_t periodicity_ms, trigger_mode_t mode = POLLED_TRIGGER);
 
   /**
    * Gets the trigger name
@@ -63,6 +74,34 @@ struct trigger {
    */
   uint64_t periodicity_ms() const;
 
+  /**
+   * Gets when the trigger is evaluated
+   * @return The trigger mode
+   */
+  trigger_mode_t mode() const;
+
+  /**
+   * Checks whether an update of the aggregate from one value to another
+   * makes the trigger condition true
+   * @param before The aggregate value before the update
+   * @param after The aggregate value after the update
+   * @return True if the condition holds after the update but not before
+   */
+  bool crossed(const numeric &before, const numeric &after) const;
+
+  /**
+   * Gets the identifier of the trigger in the alert index
+   * @return The alert identifier
+   */
+  uint32_t alert_id() const;
+
+  /**
+   * Sets the identifier of the trigger in the alert index; must be called
+   * before the trigger is installed
+   * @param alert_id The alert identifier
+   */
+  void set_alert_id(uint32_t alert_id);
+
   /**
    * Invalidates the trigger
    * @return Whether trigger was successfully invalidated
@@ -88,6 +127,8 @@ struct trigger {
   numeric threshold_;
 
   uint64_t periodicity_ms_;
+  trigger_mode_t mode_;
+  uint32_t alert_id_;
   atomic::type<bool> is_valid_;
 };
 
@@ -0,0 +1,269 @@
+#ifndef CONFLUO_TYPED_MULTILOG_H_
+#define CONFLUO_TYPED_MULTILOG_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "atomic_multilog.h"
+#include "schema/typed_record.h"
+
+namespace confluo {
+
+/**
+ * A cursor over records of a known type. Wraps a record cursor and copies
+ * each record's bytes into a tuple, without converting fields to strings.
+ *
+ * @tparam Fields The field types, starting with the timestamp
+ */
+template<typename... Fields>
+class typed_cursor {
+ public:
+  /** The record type */
+  typedef typed_record<Fields...> record_type;
+  /** The tuple representation of a record */
+  typedef typename record_type::tuple_type tuple_type;
+
+  /**
+   * Wraps a record cursor
+   *
+   * @param cursor The record cursor
+   */
+  explicit typed_cursor(std::unique_ptr<record_cursor> cursor)
+      : cursor_(std::move(cursor)) {
+  }
+
+  /**
+   * Checks if there are records left
+   *
+   * @return True if the cursor points to a record, false otherwise
+   */
+  bool has_more() const {
+    return cursor_->has_more();
+  }
+
+  /**
+   * Advances the cursor to the next record
+   */
+  void advance() {
+    cursor_->advance();
+  }
+
+  /**
+   * Gets the current record
+   *
+   * @return The current record as a tuple
+   */
+  tuple_type get() const {
+    tuple_type t;
+    record_type::unpack(cursor_->get().data(), t);
+    return t;
+  }
+
+  /**
+   * Gets the current record as a packed struct with the same fields
+   *
+   * @tparam T The struct type
+   * @return The current record
+   */
+  template<typename T>
+  T get_as() const {
+    record_type::template check_struct<T>();
+    T rec;
+    memcpy(&rec, cursor_->get().data(), sizeof(T));
+    return rec;
+  }
+
+  /**
+   * Gets the data log offset of the current record
+   *
+   * @return The offset
+   */
+  uint64_t offset() const {
+    return cursor_->get().log_offset();
+  }
+
+ private:
+  std::unique_ptr<record_cursor> cursor_;
+};
+
+/**
+ * A view of an atomic multilog with records of a known type. The field
+ * types are checked against the schema once, when the view is created;
+ * after that, records are appended and read by copying their bytes, with
+ * no parsing or string formatting.
+ *
+ * @tparam Fields The field types, in column order starting with the
+ * timestamp; STRING(N) columns are bound as std::array<char, N>
+ */
+template<typename... Fields>
+class typed_multilog {
+ public:
+  /** The record type */
+  typedef typed_record<Fields...> record_type;
+  /** The tuple representation of a record */
+  typedef typename record_type::tuple_type tuple_type;
+  /** The cursor type */
+  typedef typed_cursor<Fields...> cursor_type;
+
+  /**
+   * Binds to an atomic multilog
+   *
+   * @param mlog The atomic multilog
+   * @throw invalid_cast_exception If the field types do not match the
+   * schema
+   */
+  explicit typed_multilog(atomic_multilog *mlog)
+      : mlog_(mlog) {
+    record_type::check(mlog_->get_schema());
+  }
+
+  /**
+   * Appends a record
+   *
+   * @param rec The record
+   * @return The offset of the record in the data log
+   */
+  size_t append(const tuple_type &rec) {
+    uint8_t data[record_type::SIZE];
+    record_type::pack(rec, data);
+    return mlog_->append(data);
+  }
+
+  /**
+   * Appends a record given as a packed struct with the same fields
+   *
+   * @tparam T The struct type
+   * @param rec The record
+   * @return The offset of the record in the data log
+   */
+  template<typename T>
+  size_t append_struct(const T &rec) {
+    record_type::template check_struct<T>();
+    return mlog_->append(const_cast<T *>(&rec));
+  }
+
+  /**
+   * Appends a batch of records
+   *
+   * @param recs Pointer to nrecords records
+   * @param nrecords The number of records
+   * @return The offset of the first record in the data log
+   */
+  size_t append_batch(const tuple_type *recs, size_t nrecords) {
+    std::string data(nrecords * record_type::SIZE, '\0');
+    uint8_t *out = reinterpret_cast<uint8_t *>(&data[0]);
+    for (size_t i = 0; i < nrecords; i++)
+      record_type::pack(recs[i], out + i * record_type::SIZE);
+    record_batch batch = record_batch_builder::from_records(data.data(), nrecords, record_type::SIZE);
+    return mlog_->append_batch(batch);
+  }
+
+  /**
+   * Appends a batch of records
+   *
+   * @param recs The records
+   * @return The offset of the first record in the data log
+   */
+  size_t append_batch(const std::vector<tuple_type> &recs) {
+    return append_batch(recs.data(), recs.size());
+  }
+
+  /**
+   * Appends a batch of records given as packed structs with the same
+   * fields, copied into the data log as-is
+   *
+   * @tparam T The struct type
+   * @param recs Pointer to nrecords records
+   * @param nrecords The number of records
+   * @return The offset of the first record in the data log
+   */
+  template<typename T>
+  size_t append_batch_struct(const T *recs, size_t nrecords) {
+    record_type::template check_struct<T>();
+    record_batch batch = record_batch_builder::from_records(recs, nrecords, sizeof(T));
+    return mlog_->append_batch(batch);
+  }
+
+  /**
+   * Reads the record at an offset
+   *
+   * @param offset The offset of the record in the data log
+   * @param rec Set to the record
+   * @return True if the record was read, false if the offset is not
+   * below the read tail
+   */
+  bool read(uint64_t offset, tuple_type &rec) const {
+    uint8_t data[record_type::SIZE];
+    if (!mlog_->read_raw(offset, data))
+      return false;
+    record_type::unpack(data, rec);
+    return true;
+  }
+
+  /**
+   * Reads the record at an offset into a packed struct with the same
+   * fields
+   *
+   * @tparam T The struct type
+   * @param offset The offset of the record in the data log
+   * @param rec Set to the record
+   * @return True if the record was read, false if the offset is not
+   * below the read tail
+   */
+  template<typename T>
+  bool read_struct(uint64_t offset, T &rec) const {
+    record_type::template check_struct<T>();
+    return mlog_->read_raw(offset, reinterpret_cast<uint8_t *>(&rec));
+  }
+
+  /**
+   * Evaluates a filter expression over the atomic multilog
+   *
+   * @param expr The filter expression
+   * @return A cursor over the matching records
+   */
+  cursor_type execute_filter(const std::string &expr) const {
+    return cursor_type(mlog_->execute_filter(expr));
+  }
+
+  /**
+   * Queries records in a time range
+   *
+   * @param begin_ts The beginning of the time range
+   * @param end_ts The end of the time range
+   * @param reverse Whether to return the most recent records first
+   * @return A cursor over the records
+   */
+  cursor_type query_time_range(uint64_t begin_ts, uint64_t end_ts, bool reverse = false) const {
+    return cursor_type(mlog_->query_time_range(begin_ts, end_ts, reverse));
+  }
+
+  /**
+   * Queries records matched by a filter in a time range
+   *
+   * @param filter_name The name of the filter
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @return A cursor over the records
+   */
+  cursor_type query_filter(const std::string &filter_name, uint64_t begin_ms, uint64_t end_ms) const {
+    return cursor_type(mlog_->query_filter(filter_name, begin_ms, end_ms));
+  }
+
+  /**
+   * Gets the underlying atomic multilog
+   *
+   * @return The atomic multilog
+   */
+  atomic_multilog *multilog() const {
+    return mlog_;
+  }
+
+ private:
+  atomic_multilog *mlog_;
+};
+
+}
+
+#endif /* CONFLUO_TYPED_MULTILOG_H_ */
@@ -450,7 +450,9 @@ class byte_string {
 
   uint8_t *data();
 
-  size_t size();
+  const uint8_t *data() const;
+
+  size_t size() const;
 
   /**
    * Formats the data into a readable form
@@ -196,6 +196,14 @@ struct data_type {
    */
   bool is_numeric() const;
 
+  /**
+   * Determines whether values of this data type are variable-length, i.e.,
+   * stored outside the fixed-size record
+   *
+   * @return True if this data type is variable-length, false otherwise
+   */
+  bool is_var_length() const;
+
   /**
    * Gets the name of this data type
    *
@@ -1,10 +1,12 @@
 #ifndef CONFLUO_TYPES_KEY_OPS_H_
 #define CONFLUO_TYPES_KEY_OPS_H_
 
+#include <algorithm>
 #include <type_traits>
 
 #include "raw_data.h"
 #include "byte_string.h"
+#include "var_ref.h"
 
 namespace confluo {
 
@@ -83,6 +85,23 @@ inline byte_string key_transform<std::string>(const immutable_raw_data &v, doubl
   return byte_string(v.as<std::string>());
 }
 
+/**
+ * Transforms raw immutable data into a byte string for lookup for
+ * variable-length string types. The key is the (zero-padded) prefix of the
+ * value, which preserves ordering but is not unique; index lookups on
+ * such keys must be refined by the predicate itself.
+ *
+ * @param v The raw immutable data to transform
+ * @param bucket_size The bucket_size used for indexing
+ *
+ * @return The byte string holding the prefix of the value
+ */
+inline byte_string varchar_key_transform(const immutable_raw_data &v, double) {
+  std::string prefix(var_ref::SIZE, '\0');
+  memcpy(&prefix[0], v.ptr, std::min(v.size, var_ref::SIZE));
+  return byte_string(prefix, var_ref::SIZE);
+}
+
 /**
  * Key transformation for void types
  *
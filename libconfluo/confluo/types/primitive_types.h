@@ -23,7 +23,12 @@ enum primitive_type
   D_ULONG = 9, /** Identifier for the unsigned long type */
   D_FLOAT = 10, /** Identifier for the float type */
   D_DOUBLE = 11, /** Identifier for the double type */
-  D_STRING = 12 /** Identifier for the string type */
+  D_STRING = 12, /** Identifier for the string type */
+  /**
+   * Identifier for the variable-length string type; kept apart from the
+   * ids handed out to registered types, which follow D_STRING
+   */
+  D_VARCHAR = 10000
 };
 
 class limits {
@@ -126,6 +131,11 @@ class limits {
   static double double_one;
   /** The max double value */
   static double double_max;
+
+  /** The minimum variable-length string reference */
+  static uint64_t varchar_min;
+  /** The maximum variable-length string reference */
+  static uint64_t varchar_max;
 };
 
 }
@@ -1,6 +1,7 @@
 #ifndef CONFLUO_TYPES_STRING_OPS_H_
 #define CONFLUO_TYPES_STRING_OPS_H_
 
+#include <cstring>
 #include <string>
 
 #include "exceptions.h"
@@ -60,6 +61,18 @@ inline void parse<std::string>(const std::string &str, void *out) {
   *(reinterpret_cast<char *>(out) + str.length()) = '\0';
 }
 
+/**
+ * Parses the given string and sets the specified pointer to the contents
+ * of the string, for the variable-length string type; the output must
+ * have room for exactly the length of the string
+ *
+ * @param str The string that is parsed
+ * @param out The pointer that is set
+ */
+inline void varchar_parse(const std::string &str, void *out) {
+  memcpy(out, str.data(), str.length());
+}
+
 /**
  * Gets the string representation for the specified raw immutable data 
  *
@@ -124,7 +137,21 @@ inline std::string to_string<void>(const immutable_raw_data &data) {
  */
 template<>
 inline std::string to_string<std::string>(const immutable_raw_data &data) {
-  return std::string(reinterpret_cast<const char *>(data.ptr));
+  // Values that fill the whole column are not null-terminated
+  const char *str = reinterpret_cast<const char *>(data.ptr);
+  return std::string(str, strnlen(str, data.size));
+}
+
+/**
+ * Gets the string representation for the specified raw immutable data,
+ * for the variable-length string type
+ *
+ * @param data The raw immutable data to get the string representation of
+ *
+ * @return String representation of the immutable data
+ */
+inline std::string varchar_to_string(const immutable_raw_data &data) {
+  return std::string(reinterpret_cast<const char *>(data.ptr), data.size);
 }
 
 }
@@ -4,6 +4,7 @@
 #include "exceptions.h"
 #include "type_properties.h"
 #include "data_type.h"
+#include "var_ref.h"
 
 namespace confluo {
 
@@ -118,6 +119,15 @@ class primitive_types {
   static data_type STRING_TYPE(size_t size) {
     return data_type(primitive_type::D_STRING, size);
   }
+
+  /**
+   * The variable-length string data type. Columns of this type hold a
+   * reference to the value, while materialized values carry their length
+   * as the type size.
+   */
+  static data_type VARCHAR_TYPE(size_t size = var_ref::SIZE) {
+    return data_type(primitive_type::D_VARCHAR, size);
+  }
 };
 
 }
@@ -123,6 +123,13 @@ namespace detail {
  */
 std::vector<type_properties> init_primitives();
 
+/**
+ * Initializes the variable-length string type properties
+ *
+ * @return The properties for the variable-length string type
+ */
+type_properties init_varchar();
+
 }
 
 class data_type_properties {
@@ -136,11 +143,21 @@ class data_type_properties {
   }
 
   type_properties const &at(size_t i) const {
-    return type_properties_.at(i);
+    return i == primitive_type::D_VARCHAR ? varchar_ : type_properties_.at(i);
   }
 
   type_properties &operator[](size_t i) {
-    return type_properties_[i];
+    return i == primitive_type::D_VARCHAR ? varchar_ : type_properties_[i];
+  }
+
+  /**
+   * Checks if a type id refers to a known type
+   *
+   * @param i The type id
+   * @return True if the id is that of a primitive or registered type
+   */
+  bool contains(size_t i) const {
+    return i < type_properties_.size() || i == primitive_type::D_VARCHAR;
   }
 
   void push_back(type_properties &&properties) {
@@ -172,9 +189,12 @@ class data_type_properties {
   }
 
  private:
-  data_type_properties() : type_properties_(detail::init_primitives()) {}
+  data_type_properties()
+      : type_properties_(detail::init_primitives()),
+        varchar_(detail::init_varchar()) {}
 
   std::vector<type_properties> type_properties_;
+  type_properties varchar_;
 };
 
 /**
@@ -0,0 +1,91 @@
+#ifndef CONFLUO_TYPES_VAR_REF_H_
+#define CONFLUO_TYPES_VAR_REF_H_
+
+#include <cstdint>
+#include <cstring>
+
+namespace confluo {
+
+/**
+ * Reference to a variable-length value, stored in the fixed-size portion
+ * of a record in place of the value itself. A reference packs the offset
+ * of the value (high 40 bits) with its length (low 24 bits).
+ *
+ * In records stored in an atomic multilog, the offset points into the
+ * multilog's variable-length heap. In inline records, i.e., records
+ * exchanged with clients, the variable-length values follow the
+ * fixed-size portion of the record, and the offset is relative to the
+ * start of the record.
+ */
+class var_ref {
+ public:
+  /** The size of a reference in bytes */
+  static const size_t SIZE = sizeof(uint64_t);
+  /** The number of bits used to store the length */
+  static const size_t LENGTH_BITS = 24;
+  /** The maximum length of a variable-length value */
+  static const size_t MAX_LENGTH = (UINT64_C(1) << LENGTH_BITS) - 1;
+  /** The maximum offset of a variable-length value */
+  static const uint64_t MAX_OFFSET = (UINT64_C(1) << (64 - LENGTH_BITS)) - 1;
+
+  /**
+   * Packs an offset and length into a reference
+   *
+   * @param offset The offset of the value
+   * @param length The length of the value
+   *
+   * @return The packed reference
+   */
+  static inline uint64_t pack(uint64_t offset, size_t length) {
+    return (offset << LENGTH_BITS) | static_cast<uint64_t>(length);
+  }
+
+  /**
+   * Gets the offset from a packed reference
+   *
+   * @param ref The packed reference
+   *
+   * @return The offset of the value
+   */
+  static inline uint64_t offset(uint64_t ref) {
+    return ref >> LENGTH_BITS;
+  }
+
+  /**
+   * Gets the length from a packed reference
+   *
+   * @param ref The packed reference
+   *
+   * @return The length of the value
+   */
+  static inline size_t length(uint64_t ref) {
+    return static_cast<size_t>(ref & MAX_LENGTH);
+  }
+
+  /**
+   * Reads a packed reference from a (possibly unaligned) slot
+   *
+   * @param slot Pointer to the slot
+   *
+   * @return The packed reference
+   */
+  static inline uint64_t load(const void *slot) {
+    uint64_t ref;
+    memcpy(&ref, slot, SIZE);
+    return ref;
+  }
+
+  /**
+   * Writes a packed reference to a (possibly unaligned) slot
+   *
+   * @param slot Pointer to the slot
+   * @param ref The packed reference
+   */
+  static inline void store(void *slot, uint64_t ref) {
+    memcpy(slot, &ref, SIZE);
+  }
+};
+
+}
+
+#endif /* CONFLUO_TYPES_VAR_REF_H_ */
@@ -83,6 +83,13 @@ numeric aggregate_list::get(uint64_t version) const {
   return agg_.zero;
 }
 
+numeric aggregate_list::latest() const {
+  aggregate_node *cur_head = atomic::load(&head_);
+  if (cur_head != nullptr)
+    return cur_head->value();
+  return agg_.zero;
+}
+
 void aggregate_list::comb_update(const numeric &value, uint64_t version) {
   aggregate_node *cur_head = atomic::load(&head_);
   aggregate_node *req = get_node(cur_head, version);
@@ -122,77 +129,129 @@ aggregate_node *aggregate_list::get_node(aggregate_node *head, uint64_t version)
   return ret;
 }
 
+aggregate_slot::aggregate_slot(int thread_id, const data_type &type, const aggregator &agg, aggregate_slot *next)
+    : thread_id(thread_id),
+      list(type, agg),
+      next(next) {
+}
+
 aggregate::aggregate()
     : type_(primitive_types::NONE_TYPE()),
       agg_(aggregators::invalid_aggregator()),
-      aggs_(nullptr),
-      concurrency_(0) {
+      slots_(nullptr) {
 }
 
-aggregate::aggregate(const data_type &type, aggregator agg, int concurrency)
+aggregate::aggregate(const data_type &type, aggregator agg)
     : type_(type),
       agg_(std::move(agg)),
-      aggs_(new aggregate_list[concurrency]),
-      concurrency_(concurrency) {
-  for (int i = 0; i < concurrency_; i++)
-    aggs_[i].init(type, agg_);
+      slots_(nullptr) {
 }
 
 aggregate::aggregate(const aggregate &other)
     : type_(other.type_),
       agg_(other.agg_),
-      aggs_(new aggregate_list[other.concurrency_]),
-      concurrency_(other.concurrency_) {
-  for (int i = 0; i < other.concurrency_; i++) {
-    aggs_[i] = other.aggs_[i];
-  }
+      slots_(nullptr) {
+  copy_slots(other);
 }
 
 aggregate::~aggregate() {
-  delete[] aggs_;
+  free_slots();
 }
 
 aggregate &aggregate::operator=(const aggregate &other) {
+  if (this == &other)
+    return *this;
+  free_slots();
   type_ = other.type_;
   agg_ = other.agg_;
-  aggs_ = new aggregate_list[other.concurrency_];
-  concurrency_ = other.concurrency_;
-  for (int i = 0; i < other.concurrency_; i++) {
-    aggs_[i] = other.aggs_[i];
-  }
+  copy_slots(other);
   return *this;
 }
 
-aggregate::aggregate(aggregate &&other) noexcept {
-  type_ = other.type_;
-  agg_ = std::move(other.agg_);
-  aggs_ = other.aggs_;
-  concurrency_ = other.concurrency_;
-  other.aggs_ = nullptr;
+aggregate::aggregate(aggregate &&other) noexcept
+    : type_(other.type_),
+      agg_(std::move(other.agg_)),
+      slots_(atomic::load(&other.slots_)) {
+  atomic::store(&other.slots_, static_cast<aggregate_slot *>(nullptr));
 }
 
 aggregate &aggregate::operator=(aggregate &&other) noexcept {
+  if (this == &other)
+    return *this;
+  free_slots();
   type_ = other.type_;
   agg_ = std::move(other.agg_);
-  aggs_ = other.aggs_;
-  concurrency_ = other.concurrency_;
-  other.aggs_ = nullptr;
+  atomic::store(&slots_, atomic::load(&other.slots_));
+  atomic::store(&other.slots_, static_cast<aggregate_slot *>(nullptr));
   return *this;
 }
 
 void aggregate::seq_update(int thread_id, const numeric &value, uint64_t version) {
-  aggs_[thread_id].seq_update(value, version);
+  slot(thread_id).seq_update(value, version);
 }
 
 void aggregate::comb_update(int thread_id, const numeric &value, uint64_t version) {
-  aggs_[thread_id].comb_update(value, version);
+  slot(thread_id).comb_update(value, version);
 }
 
 numeric aggregate::get(uint64_t version) const {
   numeric val = agg_.zero;
-  for (int i = 0; i < concurrency_; i++)
-    val = agg_.comb_op(val, aggs_[i].get(version));
+  for (aggregate_slot *s = atomic::load(&slots_); s != nullptr; s = s->next)
+    val = agg_.comb_op(val, s->list.get(version));
   return val;
 }
 
-}
\ No newline at end of file
+numeric aggregate::latest() const {
+  numeric val = agg_.zero;
+  for (aggregate_slot *s = atomic::load(&slots_); s != nullptr; s = s->next)
+    val = agg_.comb_op(val, s->list.latest());
+  return val;
+}
+
+size_t aggregate::num_slots() const {
+  size_t n = 0;
+  for (aggregate_slot *s = atomic::load(&slots_); s != nullptr; s = s->next)
+    n++;
+  return n;
+}
+
+aggregate_list &aggregate::slot(int thread_id) {
+  aggregate_slot *head = atomic::load(&slots_);
+  for (aggregate_slot *s = head; s != nullptr; s = s->next) {
+    if (s->thread_id == thread_id)
+      return s->list;
+  }
+  // Only a thread adds its own slot, so concurrent additions are for other threads
+  void *raw = allocator::instance().alloc(sizeof(aggregate_slot));
+  aggregate_slot *s = new(raw) aggregate_slot(thread_id, type_, agg_, head);
+  while (!atomic::strong::cas(&slots_, &head, s))
+    s->next = head;
+  return s->list;
+}
+
+void aggregate::copy_slots(const aggregate &other) {
+  aggregate_slot *tail = nullptr;
+  for (aggregate_slot *s = atomic::load(&other.slots_); s != nullptr; s = s->next) {
+    void *raw = allocator::instance().alloc(sizeof(aggregate_slot));
+    aggregate_slot *copy = new(raw) aggregate_slot(s->thread_id, type_, agg_, nullptr);
+    copy->list = s->list;
+    if (tail == nullptr)
+      atomic::store(&slots_, copy);
+    else
+      tail->next = copy;
+    tail = copy;
+  }
+}
+
+void aggregate::free_slots() {
+  aggregate_slot *s = atomic::load(&slots_);
+  while (s != nullptr) {
+    aggregate_slot *next = s->next;
+    s->~aggregate_slot();
+    allocator::instance().dealloc(s);
+    s = next;
+  }
+  atomic::store(&slots_, static_cast<aggregate_slot *>(nullptr));
+}
+
+}
@@ -6,6 +6,20 @@ aggregate_info::aggregate_info(std::string name, aggregator agg, uint16_t field_
     : name_(std::move(name)),
       agg_(std::move(agg)),
       field_idx_(field_idx),
+      num_eager_triggers_(0),
+      is_valid_(true) {
+}
+
+aggregate_info::aggregate_info(std::string name,
+                               aggregator agg,
+                               uint16_t field_idx,
+                               const data_type &field_type,
+                               size_t field_offset)
+    : name_(std::move(name)),
+      agg_(std::move(agg)),
+      field_idx_(field_idx),
+      kernel_(make_aggregate_kernel(agg_, field_type, field_offset)),
+      num_eager_triggers_(0),
       is_valid_(true) {
 }
 
@@ -17,6 +31,10 @@ data_type aggregate_info::result_type() const {
   return agg_.result_type;
 }
 
+const aggregator &aggregate_info::get_aggregator() const {
+  return agg_;
+}
+
 uint16_t aggregate_info::field_idx() const {
   return field_idx_;
 }
@@ -43,6 +61,15 @@ numeric aggregate_info::seq_op(const numeric &a, const numeric &b) {
   return agg_.seq_op(a.is_valid() ? a : zero(), b);
 }
 
+numeric aggregate_info::batch_op(const schema_snapshot &s, uint8_t *const *records, size_t n) {
+  if (kernel_ != nullptr)
+    return kernel_->apply(records, n);
+  numeric acc = zero();
+  for (size_t i = 0; i < n; i++)
+    acc = seq_op(acc, s, records[i]);
+  return acc;
+}
+
 numeric aggregate_info::zero() {
   return agg_.zero;
 }
@@ -61,11 +88,19 @@ bool aggregate_info::is_valid() const {
 }
 
 size_t aggregate_info::add_trigger(trigger *t) {
-  return triggers_.push_back(t);
+  size_t id = triggers_.push_back(t);
+  if (t->mode() == EAGER_TRIGGER)
+    atomic::faa(&num_eager_triggers_, static_cast<size_t>(1));
+  return id;
 }
 
 bool aggregate_info::remove_trigger(size_t id) {
-  return triggers_.at(id)->invalidate();
+  trigger *t = triggers_.at(id);
+  if (!t->invalidate())
+    return false;
+  if (t->mode() == EAGER_TRIGGER)
+    atomic::fas(&num_eager_triggers_, static_cast<size_t>(1));
+  return true;
 }
 
 trigger *aggregate_info::get_trigger(size_t id) {
@@ -76,4 +111,8 @@ size_t aggregate_info::num_triggers() const {
   return triggers_.size();
 }
 
+bool aggregate_info::has_eager_triggers() const {
+  return atomic::load(&num_eager_triggers_) != 0;
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "aggregate/aggregate_kernel.h"
+
+namespace confluo {
+
+generic_kernel::generic_kernel(const aggregator &agg, const data_type &type, size_t offset)
+    : agg_(agg),
+      type_(type),
+      offset_(offset) {
+}
+
+numeric generic_kernel::apply(uint8_t *const *records, size_t n) const {
+  numeric acc = agg_.zero;
+  for (size_t i = 0; i < n; i++)
+    acc = agg_.seq_op(acc, numeric(type_, records[i] + offset_));
+  return acc;
+}
+
+/**
+ * Creates a typed kernel for a field type
+ *
+ * @tparam kernel_t The kernel template
+ * @param agg The aggregator
+ * @param type The type of the field
+ * @param offset The offset of the field in the record
+ *
+ * @return The kernel
+ */
+template<template<typename> class kernel_t>
+static std::unique_ptr<aggregate_kernel> make_typed_kernel(const aggregator &agg,
+                                                           const data_type &type,
+                                                           size_t offset) {
+  switch (type.id) {
+    case primitive_type::D_INT:
+      return std::unique_ptr<aggregate_kernel>(new kernel_t<int32_t>(offset));
+    case primitive_type::D_LONG:
+      return std::unique_ptr<aggregate_kernel>(new kernel_t<int64_t>(offset));
+    case primitive_type::D_DOUBLE:
+      return std::unique_ptr<aggregate_kernel>(new kernel_t<double>(offset));
+    default:
+      return std::unique_ptr<aggregate_kernel>(new generic_kernel(agg, type, offset));
+  }
+}
+
+std::unique_ptr<aggregate_kernel> make_aggregate_kernel(const aggregator &agg, const data_type &type, size_t offset) {
+  if (agg.name == aggregators::sum_aggregator().name)
+    return make_typed_kernel<sum_kernel>(agg, type, offset);
+  if (agg.name == aggregators::min_aggregator().name)
+    return make_typed_kernel<min_kernel>(agg, type, offset);
+  if (agg.name == aggregators::max_aggregator().name)
+    return make_typed_kernel<max_kernel>(agg, type, offset);
+  if (agg.name == aggregators::count_aggregator().name)
+    return std::unique_ptr<aggregate_kernel>(new count_kernel());
+  return std::unique_ptr<aggregate_kernel>(new generic_kernel(agg, type, offset));
+}
+
+}
@@ -30,6 +30,10 @@ numeric aggregated_reflog::get_aggregate(size_t aid, uint64_t version) const {
   return copy.get()[aid].get(version);
 }
 
+numeric aggregated_reflog::latest_aggregate(size_t aid) const {
+  return aggregates_.atomic_load()[aid].latest();
+}
+
 void aggregated_reflog::seq_update_aggregate(int thread_id, size_t aid, const numeric &value, uint64_t version) {
   aggregates_.atomic_load()[aid].seq_update(thread_id, value, version);
 }
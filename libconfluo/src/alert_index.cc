@@ -2,40 +2,115 @@
 
 namespace confluo {
 
+monitor::alert_index::trigger_alerts::trigger_alerts(const std::string &name, const std::string &expr)
+    : name(name),
+      expr(expr),
+      idx(8, 256) {
+}
+
 monitor::alert_index::alert_index()
-    : idx_(8, 256) {
+    : idx_(8, 256),
+      queue_(nullptr) {
+}
+
+monitor::alert_index::~alert_index() {
+  queued_alert *q = atomic::load(&queue_);
+  while (q != nullptr) {
+    queued_alert *next = q->next;
+    delete q;
+    q = next;
+  }
+  size_t n_triggers = triggers_.size();
+  for (size_t i = 0; i < n_triggers; i++) {
+    delete triggers_.at(i);
+  }
+}
+
+uint32_t monitor::alert_index::add_trigger(const std::string &trigger_name, const std::string &trigger_expr) {
+  size_t n_triggers = triggers_.size();
+  for (size_t i = 0; i < n_triggers; i++) {
+    const trigger_alerts *t = triggers_.at(i);
+    if (t->name == trigger_name && t->expr == trigger_expr)
+      return static_cast<uint32_t>(i);
+  }
+  return static_cast<uint32_t>(triggers_.push_back(new trigger_alerts(trigger_name, trigger_expr)));
 }
 
 void monitor::alert_index::add_alert(uint64_t time_bucket,
-                                     const std::string &trigger_name,
-                                     const std::string &trigger_expr,
+                                     uint32_t trigger_id,
                                      const numeric &value,
                                      uint64_t version) {
-  auto log = idx_.get_or_create(make_key(time_bucket));
-  if (find_alert(log, trigger_name, value) == -1)
-    log->push_back(
-        alert(time_bucket, trigger_name, trigger_expr, value, version));
+  byte_string key = make_key(time_bucket);
+  // Only alerts of this trigger in this bucket are candidate duplicates
+  alert_log *trigger_log = triggers_.at(trigger_id)->idx.get_or_create(key);
+  size_t n_alerts = trigger_log->size();
+  for (size_t i = 0; i < n_alerts; i++) {
+    if (trigger_log->at(i).value == value)
+      return;
+  }
+  alert_entry entry{trigger_id, value, version, time_bucket};
+  trigger_log->push_back(entry);
+  idx_.get_or_create(key)->push_back(entry);
+}
+
+void monitor::alert_index::enqueue_alert(uint64_t time_bucket,
+                                         uint32_t trigger_id,
+                                         const numeric &value,
+                                         uint64_t version) {
+  queued_alert *q = new queued_alert{alert_entry{trigger_id, value, version, time_bucket}, atomic::load(&queue_)};
+  while (!atomic::weak::cas(&queue_, &q->next, q));
+}
+
+size_t monitor::alert_index::drain() {
+  queued_alert *q = atomic::exchange(&queue_, static_cast<queued_alert *>(nullptr));
+  // The queue is a stack; reverse it to add alerts in the order they were raised
+  queued_alert *ordered = nullptr;
+  size_t n_alerts = 0;
+  while (q != nullptr) {
+    queued_alert *next = q->next;
+    q->next = ordered;
+    ordered = q;
+    q = next;
+    n_alerts++;
+  }
+  while (ordered != nullptr) {
+    const alert_entry &e = ordered->entry;
+    add_alert(e.time_bucket, e.trigger_id, e.value, e.version);
+    queued_alert *next = ordered->next;
+    delete ordered;
+    ordered = next;
+  }
+  return n_alerts;
+}
+
+bool monitor::alert_index::has_queued() const {
+  return atomic::load(&queue_) != nullptr;
 }
 
 monitor::alert_index::alert_list monitor::alert_index::get_alerts(uint64_t t1, uint64_t t2) const {
   return idx_.range_lookup(make_key(t1), make_key(t2));
 }
 
+std::vector<monitor::alert_index::alert_list> monitor::alert_index::get_alerts(uint64_t t1,
+                                                                             uint64_t t2,
+                                                                             const std::string &trigger_name) const {
+  std::vector<alert_list> lists;
+  size_t n_triggers = triggers_.size();
+  for (size_t i = 0; i < n_triggers; i++) {
+    const trigger_alerts *t = triggers_.at(i);
+    if (t->name == trigger_name)
+      lists.push_back(t->idx.range_lookup(make_key(t1), make_key(t2)));
+  }
+  return lists;
+}
+
+monitor::alert monitor::alert_index::to_alert(const alert_entry &entry) const {
+  const trigger_alerts *t = triggers_.at(entry.trigger_id);
+  return alert(entry.time_bucket, t->name, t->expr, entry.value, entry.version);
+}
+
 byte_string monitor::alert_index::make_key(uint64_t time_bucket) const {
   return byte_string(time_bucket);
 }
 
-int64_t monitor::alert_index::find_alert(monitor::alert_index::alert_log *log,
-                                         const std::string &trigger_name,
-                                         const numeric &value) const {
-  size_t n_alerts = log->size();
-  for (size_t i = 0; i < n_alerts; i++) {
-    const alert &a = log->at(i);
-    if (a.trigger_name == trigger_name && a.value == value) {
-      return static_cast<int64_t>(i);
-    }
-  }
-  return -1;
 }
-
-}
\ No newline at end of file
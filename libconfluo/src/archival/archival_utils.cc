@@ -1,5 +1,8 @@
 #include "archival/archival_utils.h"
 
+#include "compression/confluo_encoder.h"
+#include "storage/allocator.h"
+
 namespace confluo {
 namespace archival {
 
@@ -17,6 +20,14 @@ void archival_utils::swap_bucket_ptr(reflog &refs, size_t idx, encoded_reflog_pt
   atomic::load(&refs.data()[container_idx])[bucket_idx].swap_ptr(encoded_bucket);
 }
 
+void *archival_utils::encode_in_memory(void *bucket, size_t size, uint8_t encoding) {
+  auto encoded = compression::confluo_encoder::encode(bucket, size, encoding);
+  storage::ptr_aux_block aux(storage::state_type::D_ARCHIVED, encoding);
+  void *encoded_bucket = allocator::instance().alloc(encoded.size(), aux);
+  memcpy(encoded_bucket, encoded.get(), encoded.size());
+  return encoded_bucket;
+}
+
 uint64_t archival_utils::max_in_reflog_bucket(uint64_t *bucket) {
   uint64_t max = 0;
   for (size_t i = 0; i < reflog_constants::BUCKET_SIZE && bucket[i] != limits::ulong_max; i++)
@@ -13,18 +13,27 @@ atomic_multilog_archiver::atomic_multilog_archiver(const std::string &path,
                                                    filter_log *filters,
                                                    index_log *indexes,
                                                    schema_t *schema,
-                                                   bool clear)
+                                                   bool clear,
+                                                   bool in_memory)
     : path_(path),
       rt_(rt),
-      record_size_(schema->record_size()) {
+      record_size_(schema->record_size()),
+      in_memory_(in_memory),
+      heap_(nullptr) {
   if (clear) {
     file_utils::clear_dir(data_log_path());
+    file_utils::clear_dir(var_heap_path());
     file_utils::clear_dir(filter_log_path());
     file_utils::clear_dir(index_log_path());
   }
-  data_log_archiver_ = data_log_archiver(data_log_path(), log);
-  filter_log_archiver_ = filter_log_archiver(filter_log_path(), filters);
-  index_log_archiver_ = index_log_archiver(index_log_path(), indexes, schema);
+  data_log_archiver_ = data_log_archiver(data_log_path(), log, in_memory);
+  filter_log_archiver_ = filter_log_archiver(filter_log_path(), filters, in_memory);
+  index_log_archiver_ = index_log_archiver(index_log_path(), indexes, schema, in_memory);
+}
+
+void atomic_multilog_archiver::set_var_heap(var_heap *heap) {
+  heap_ = heap;
+  var_heap_archiver_ = data_log_archiver(var_heap_path(), &heap->log(), in_memory_);
 }
 
 void atomic_multilog_archiver::archive(size_t offset) {
@@ -34,6 +43,8 @@ void atomic_multilog_archiver::archive(size_t offset) {
     filter_log_archiver_.archive(offset);
     index_log_archiver_.archive(offset);
   }
+  if (heap_ != nullptr && heap_->size() > var_heap_archiver_.tail())
+    var_heap_archiver_.archive(heap_->size());
 }
 
 size_t atomic_multilog_archiver::tail() {
@@ -44,6 +55,10 @@ std::string atomic_multilog_archiver::data_log_path() {
   return path_ + "/archives/data_log/";
 }
 
+std::string atomic_multilog_archiver::var_heap_path() {
+  return path_ + "/archives/var_heap/";
+}
+
 std::string atomic_multilog_archiver::filter_log_path() {
   return path_ + "/archives/filters/";
 }
@@ -3,20 +3,23 @@
 namespace confluo {
 namespace archival {
 
-filter_archiver::filter_archiver(const std::string &path, monitor::filter *filter)
+filter_archiver::filter_archiver(const std::string &path, monitor::filter *filter, bool in_memory)
     : filter_(filter),
       refs_writer_(path, "filter_data", archival_configuration_params::MAX_FILE_SIZE()),
       aggs_writer_(path, "filter_aggs", archival_configuration_params::MAX_FILE_SIZE()),
       refs_tail_(0),
-      ts_tail_(0) {
+      ts_tail_(0),
+      in_memory_(in_memory) {
   refs_writer_.close();
   aggs_writer_.close();
 }
 
 void filter_archiver::archive(size_t offset) {
   auto reflogs = filter_->lookup_range_reflogs(ts_tail_, static_cast<uint64_t>(limits::long_max));
-  refs_writer_.open();
-  aggs_writer_.open();
+  if (!in_memory_) {
+    refs_writer_.open();
+    aggs_writer_.open();
+  }
   for (auto it = reflogs.begin(); it != reflogs.end(); ++it) {
     auto &refs = *it;
     byte_string key = it.key();
@@ -32,8 +35,10 @@ void filter_archiver::archive(size_t offset) {
     archive_reflog_aggregates(key, refs, data_log_archival_tail);
     refs_tail_ = 0;
   }
-  refs_writer_.close();
-  aggs_writer_.close();
+  if (!in_memory_) {
+    refs_writer_.close();
+    aggs_writer_.close();
+  }
 }
 
 size_t filter_archiver::archive_reflog(byte_string key, reflog &refs, size_t offset) {
@@ -60,6 +65,12 @@ size_t filter_archiver::archive_reflog(byte_string key, reflog &refs, size_t off
 void filter_archiver::archive_bucket(byte_string key, reflog &refs, uint64_t *bucket, size_t offset) {
   auto* metadata = ptr_metadata::get(bucket);
   size_t bucket_size = std::min(reflog_constants::BUCKET_SIZE, refs.size() - refs_tail_);
+  if (in_memory_) {
+    void *encoded_bucket = archival_utils::encode_in_memory(bucket, bucket_size * sizeof(uint64_t),
+                                                            archival_configuration_params::REFLOG_ENCODING_TYPE());
+    archival_utils::swap_bucket_ptr(refs, refs_tail_, encoded_reflog_ptr(encoded_bucket));
+    return;
+  }
   auto encoded_bucket = confluo_encoder::encode(bucket, bucket_size * sizeof(uint64_t),
                                                 archival_configuration_params::REFLOG_ENCODING_TYPE());
   size_t enc_size = encoded_bucket.size();
@@ -72,14 +83,15 @@ void filter_archiver::archive_bucket(byte_string key, reflog &refs, uint64_t *bu
   refs_writer_.commit(action.to_string());
 
   ptr_aux_block aux(state_type::D_ARCHIVED, archival_configuration_params::REFLOG_ENCODING_TYPE());
-  void *archived_bucket = allocator::instance().mmap(off.path(), static_cast<off_t>(off.offset()), enc_size, aux);
+  void *archived_bucket = allocator::instance().map_archived(off.path(), off.offset(), enc_size, aux);
   archival_utils::swap_bucket_ptr(refs, refs_tail_, encoded_reflog_ptr(archived_bucket));
 }
 
 void filter_archiver::archive_reflog_aggregates(byte_string key, aggregated_reflog &reflog, size_t version) {
   size_t num_aggs = reflog.num_aggregates();
   auto metadata = filter_aggregates_archival_metadata(key, version, num_aggs);
-  filter_aggregates_archival_metadata::append(metadata, aggs_writer_);
+  if (!in_memory_)
+    filter_aggregates_archival_metadata::append(metadata, aggs_writer_);
 
   if (num_aggs > 0) {
     size_t alloc_size = sizeof(aggregate) * num_aggs;
@@ -87,14 +99,17 @@ void filter_archiver::archive_reflog_aggregates(byte_string key, aggregated_refl
     aggregate *archived_aggs = static_cast<aggregate *>(allocator::instance().alloc(alloc_size, aux));
     for (size_t i = 0; i < num_aggs; i++) {
       numeric collapsed_aggregate = reflog.get_aggregate(i, version);
-      aggs_writer_.append<data_type>(collapsed_aggregate.type());
-      aggs_writer_.append<uint8_t>(collapsed_aggregate.data(), collapsed_aggregate.type().size);
-      new(archived_aggs + i) aggregate(collapsed_aggregate.type(), aggregators::sum_aggregator(), 1);
+      if (!in_memory_) {
+        aggs_writer_.append<data_type>(collapsed_aggregate.type());
+        aggs_writer_.append<uint8_t>(collapsed_aggregate.data(), collapsed_aggregate.type().size);
+      }
+      new(archived_aggs + i) aggregate(collapsed_aggregate.type(), aggregators::sum_aggregator());
       archived_aggs[i].seq_update(0, collapsed_aggregate, version);
     }
     reflog.aggregates().swap_ptr(archived_aggs);
   }
-  aggs_writer_.commit(filter_aggregates_archival_action(key).to_string());
+  if (!in_memory_)
+    aggs_writer_.commit(filter_aggregates_archival_action(key).to_string());
 }
 
 size_t filter_load_utils::load_reflogs(const std::string &path, filter::idx_t &filter) {
@@ -114,7 +129,7 @@ size_t filter_load_utils::load_reflogs(const std::string &path, filter::idx_t &f
 
     auto *&refs = filter.get_or_create(cur_key);
     ptr_aux_block aux(state_type::D_ARCHIVED, archival_configuration_params::REFLOG_ENCODING_TYPE());
-    void *encoded_bucket = allocator::instance().mmap(off.path(), static_cast<off_t>(off.offset()), bucket_size, aux);
+    void *encoded_bucket = allocator::instance().map_archived(off.path(), off.offset(), bucket_size, aux);
     init_bucket_ptr(refs, reflog_idx, encoded_reflog_ptr(encoded_bucket));
     refs->reserve(archival_metadata.bucket_size());
     reader.advance<uint8_t>(bucket_size);
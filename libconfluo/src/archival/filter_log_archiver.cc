@@ -7,10 +7,11 @@ filter_log_archiver::filter_log_archiver()
     : filter_log_archiver("", nullptr) {
 }
 
-filter_log_archiver::filter_log_archiver(const std::string &path, filter_log *filters)
+filter_log_archiver::filter_log_archiver(const std::string &path, filter_log *filters, bool in_memory)
     : path_(path),
       filter_archivers_(),
-      filters_(filters) {
+      filters_(filters),
+      in_memory_(in_memory) {
 }
 
 filter_log_archiver::~filter_log_archiver() {
@@ -21,7 +22,7 @@ filter_log_archiver::~filter_log_archiver() {
 void filter_log_archiver::archive(size_t offset) {
   init_new_archivers();
   for (size_t i = 0; i < filters_->size(); i++) {
-    if (filters_->at(i)->is_valid())
+    if (filters_->at(i)->is_valid() && !filters_->at(i)->is_backfilling())
       filter_archivers_.at(i)->archive(offset);
   }
 }
@@ -30,7 +31,7 @@ void filter_log_archiver::init_new_archivers() {
   for (size_t i = filter_archivers_.size(); i < filters_->size(); i++) {
     std::string filter_path = archival_utils::filter_archival_path(path_, i);
     file_utils::create_dir(filter_path);
-    filter_archivers_.push_back(new filter_archiver(filter_path, filters_->at(i)));
+    filter_archivers_.push_back(new filter_archiver(filter_path, filters_->at(i), in_memory_));
   }
 }
 
@@ -3,16 +3,21 @@
 namespace confluo {
 namespace archival {
 
-index_archiver::index_archiver(const std::string &path, index::radix_index *index, const column_t column)
+index_archiver::index_archiver(const std::string &path,
+                               index::radix_index *index,
+                               const column_t column,
+                               bool in_memory)
     : index_(index),
       reflog_tails_(),
       column_(column),
-      writer_(path, "index_data", archival_configuration_params::MAX_FILE_SIZE()) {
+      writer_(path, "index_data", archival_configuration_params::MAX_FILE_SIZE()),
+      in_memory_(in_memory) {
   writer_.close();
 }
 
 void index_archiver::archive(size_t offset) {
-  writer_.open();
+  if (!in_memory_)
+    writer_.open();
   byte_string min = column_.min().to_key(column_.index_bucket_size());
   byte_string max = column_.max().to_key(column_.index_bucket_size());
   auto reflogs = index_->range_lookup_reflogs(min, max);
@@ -20,7 +25,8 @@ void index_archiver::archive(size_t offset) {
     auto &refs = *it;
     archive_reflog(it.key(), refs, offset);
   }
-  writer_.close();
+  if (!in_memory_)
+    writer_.close();
 }
 
 void index_archiver::archive_reflog(byte_string key, reflog &refs, size_t offset) {
@@ -37,6 +43,10 @@ void index_archiver::archive_reflog(byte_string key, reflog &refs, size_t offset
       reflog_idx += reflog_constants::BUCKET_SIZE;
       continue;
     }
+    // Buckets are only compressed in memory once full, since partial buckets still receive appends
+    if (in_memory_ && refs.size() - reflog_idx < reflog_constants::BUCKET_SIZE) {
+      break;
+    }
     if ((data_log_off = archival_utils::max_in_reflog_bucket(data)) < offset) {
       reflog_idx = archive_bucket(key, refs, reflog_idx, data, data_log_off);
     }
@@ -45,6 +55,12 @@ void index_archiver::archive_reflog(byte_string key, reflog &refs, size_t offset
 }
 
 size_t index_archiver::archive_bucket(byte_string key, reflog &refs, size_t idx, uint64_t *bucket, size_t offset) {
+  if (in_memory_) {
+    void *enc_bucket = archival_utils::encode_in_memory(bucket, reflog_constants::BUCKET_SIZE * sizeof(uint64_t),
+                                                        archival_configuration_params::REFLOG_ENCODING_TYPE());
+    archival_utils::swap_bucket_ptr(refs, idx, encoded_reflog_ptr(enc_bucket));
+    return idx + reflog_constants::BUCKET_SIZE;
+  }
   auto metadata_copy = *(ptr_metadata::get(bucket));
   size_t bucket_size = std::min(reflog_constants::BUCKET_SIZE, refs.size() - idx);
   auto raw_encoded_bucket = confluo_encoder::encode(bucket, bucket_size * sizeof(uint64_t),
@@ -62,7 +78,7 @@ size_t index_archiver::archive_bucket(byte_string key, reflog &refs, size_t idx,
   // Only swap pointer for full buckets.
   if (bucket_size == reflog_constants::BUCKET_SIZE) {
     ptr_aux_block aux(state_type::D_ARCHIVED, archival_configuration_params::REFLOG_ENCODING_TYPE());
-    void *enc_bucket = allocator::instance().mmap(off.path(), static_cast<off_t>(off.offset()), enc_size, aux);
+    void *enc_bucket = allocator::instance().map_archived(off.path(), off.offset(), enc_size, aux);
     archival_utils::swap_bucket_ptr(refs, idx, encoded_reflog_ptr(enc_bucket));
   }
   return idx + bucket_size;
@@ -86,7 +102,7 @@ size_t index_load_utils::load(const std::string &path, index::radix_index *index
 
     auto *&refs = index->get_or_create(cur_key);
     ptr_aux_block aux(state_type::D_ARCHIVED, archival_configuration_params::REFLOG_ENCODING_TYPE());
-    void *encoded_bucket = allocator::instance().mmap(off.path(), static_cast<off_t>(off.offset()), bucket_size, aux);
+    void *encoded_bucket = allocator::instance().map_archived(off.path(), off.offset(), bucket_size, aux);
     init_bucket_ptr(refs, reflog_idx, encoded_reflog_ptr(encoded_bucket));
     reader.advance<uint8_t>(bucket_size);
     reflog_idx += archival_metadata.bucket_size();
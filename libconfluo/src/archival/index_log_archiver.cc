@@ -7,11 +7,12 @@ index_log_archiver::index_log_archiver()
     : index_log_archiver("", nullptr, nullptr) {
 }
 
-index_log_archiver::index_log_archiver(const std::string &path, index_log *indexes, schema_t *schema)
+index_log_archiver::index_log_archiver(const std::string &path, index_log *indexes, schema_t *schema, bool in_memory)
     : path_(path),
       index_archivers_(),
       indexes_(indexes),
-      schema_(schema) {
+      schema_(schema),
+      in_memory_(in_memory) {
 }
 
 index_log_archiver::~index_log_archiver() {
@@ -23,7 +24,9 @@ void index_log_archiver::archive(size_t offset) {
   init_new_archivers();
   for (size_t i = 0; i < schema_->size(); i++) {
     auto &col = (*schema_)[i];
-    if (col.is_indexed()) {
+    // Indexes still being backfilled may receive entries below the offset;
+    // hash indexes are not archived, and are rebuilt from the data log on load
+    if (col.is_queryable() && col.index_type() == RADIX_INDEX) {
       index_archivers_.at(col.index_id())->archive(offset);
     }
   }
@@ -32,7 +35,7 @@ void index_log_archiver::archive(size_t offset) {
 void index_log_archiver::init_new_archivers() {
   for (size_t i = 0; i < schema_->size(); i++) {
     auto &col = (*schema_)[i];
-    if (col.is_indexed()) {
+    if (col.is_indexed() && col.index_type() == RADIX_INDEX) {
       auto id = col.index_id();
       if (index_archivers_.size() <= id) {
         index_archivers_.resize(id + 1);
@@ -40,7 +43,7 @@ void index_log_archiver::init_new_archivers() {
       if (index_archivers_[id] == nullptr) {
         std::string index_path = path_ + "/index_" + std::to_string(id) + "/";
         file_utils::create_dir(index_path);
-        index_archivers_[id] = new index_archiver(index_path, indexes_->at(id), col);
+        index_archivers_[id] = new index_archiver(index_path, indexes_->at(id), col, in_memory_);
       }
     }
   }
@@ -1,29 +1,63 @@
 #include "archival/io/incremental_file_writer.h"
 
+#include <unistd.h>
+
+#include "conf/configuration_params.h"
+#include "exceptions.h"
+#include "logger.h"
+#include "storage/allocator.h"
+
 namespace confluo {
 namespace archival {
 
 incremental_file_writer::incremental_file_writer(const std::string &path,
                                                  const std::string &file_prefix,
                                                  size_t max_file_size)
-    : incremental_file_stream(path, file_prefix) {
-  max_file_size_ = max_file_size;
+    : incremental_file_writer(path, file_prefix, max_file_size,
+                              archival_configuration_params::MAX_PENDING_COMMITS()) {
+}
+
+incremental_file_writer::incremental_file_writer(const std::string &path,
+                                                 const std::string &file_prefix,
+                                                 size_t max_file_size,
+                                                 size_t max_pending_commits)
+    : incremental_file_stream(path, file_prefix),
+      cur_fd_(-1),
+      cur_off_(0),
+      transaction_log_fd_(-1),
+      transaction_log_off_(0),
+      pending_commits_(0),
+      max_file_size_(max_file_size),
+      buffer_size_(archival_configuration_params::WRITE_BUFFER_SIZE()),
+      sync_on_commit_(archival_configuration_params::SYNC_ON_COMMIT()),
+      max_pending_commits_(max_pending_commits) {
   init();
 }
 
 incremental_file_writer::incremental_file_writer(const incremental_file_writer &other)
-    : incremental_file_stream() {
-  close();
+    : incremental_file_stream(),
+      cur_fd_(-1),
+      cur_off_(0),
+      transaction_log_fd_(-1),
+      transaction_log_off_(0),
+      pending_commits_(0),
+      max_file_size_(other.max_file_size_),
+      buffer_size_(other.buffer_size_),
+      sync_on_commit_(other.sync_on_commit_),
+      max_pending_commits_(other.max_pending_commits_) {
   file_num_ = other.file_num_;
   dir_path_ = other.dir_path_;
   file_prefix_ = other.file_prefix_;
-  max_file_size_ = other.max_file_size_;
-  cur_ofs_ = open_new(cur_path());
-  transaction_log_ofs_ = open_new(transaction_log_path());
+  cur_fd_ = open_new(cur_path());
+  transaction_log_fd_ = open_new(transaction_log_path());
 }
 
 incremental_file_writer::~incremental_file_writer() {
-  close();
+  try {
+    close();
+  } catch (std::exception &e) {
+    LOG_ERROR << "Could not close archive " << cur_path() << ": " << e.what();
+  }
 }
 
 incremental_file_writer &incremental_file_writer::operator=(const incremental_file_writer &other) {
@@ -32,74 +66,155 @@ incremental_file_writer &incremental_file_writer::operator=(const incremental_fi
   dir_path_ = other.dir_path_;
   file_prefix_ = other.file_prefix_;
   max_file_size_ = other.max_file_size_;
-  cur_ofs_ = open_new(cur_path());
-  transaction_log_ofs_ = open_new(transaction_log_path());
+  buffer_size_ = other.buffer_size_;
+  sync_on_commit_ = other.sync_on_commit_;
+  max_pending_commits_ = other.max_pending_commits_;
+  cur_fd_ = open_new(cur_path());
+  cur_off_ = 0;
+  transaction_log_fd_ = open_new(transaction_log_path());
+  transaction_log_off_ = 0;
   return *this;
 }
 
 void incremental_file_writer::init() {
   if (file_utils::exists_file(transaction_log_path())) {
-    std::ifstream transaction_log_ifs(transaction_log_path());
     while (file_utils::exists_file(cur_path())) {
       file_num_++;
     }
     file_num_--;
     open();
   } else {
-    cur_ofs_ = open_new(cur_path());
-    transaction_log_ofs_ = open_new(transaction_log_path());
+    cur_fd_ = open_new(cur_path());
+    cur_off_ = 0;
+    transaction_log_fd_ = open_new(transaction_log_path());
+    transaction_log_off_ = 0;
   }
 }
 
 incremental_file_offset incremental_file_writer::tell() {
-  return incremental_file_offset(cur_path(), static_cast<size_t>(cur_ofs_->tellp()));
+  return incremental_file_offset(cur_path(), cur_off_ + buffer_.size());
 }
 
 void incremental_file_writer::flush() {
-  cur_ofs_->flush();
-  transaction_log_ofs_->flush();
+  write_buffered();
+}
+
+void incremental_file_writer::sync() {
+  if (committed_.empty())
+    return;
+  write_buffered();
+  if (sync_on_commit_)
+    sync_file(cur_fd_);
+  write_at(transaction_log_fd_, committed_.data(), committed_.size(), transaction_log_off_);
+  transaction_log_off_ += committed_.size();
+  committed_.clear();
+  pending_commits_ = 0;
+  if (sync_on_commit_)
+    sync_file(transaction_log_fd_);
 }
 
 void incremental_file_writer::open() {
-  cur_ofs_ = open_existing(cur_path());
-  transaction_log_ofs_ = open_existing(transaction_log_path());
+  cur_fd_ = open_existing(cur_path());
+  cur_off_ = file_utils::file_size(cur_path());
+  transaction_log_fd_ = open_existing(transaction_log_path());
+  transaction_log_off_ = file_utils::file_size(transaction_log_path());
 }
 
 void incremental_file_writer::close() {
-  if (cur_ofs_) {
-    close(cur_ofs_);
+  try {
+    if (cur_fd_ != -1) {
+      sync();
+      write_buffered();
+    }
+  } catch (...) {
+    // Unsynced state is dropped, as on a crash
+    buffer_.clear();
+    committed_.clear();
+    pending_commits_ = 0;
+    close_files();
+    throw;
   }
-  if (transaction_log_ofs_)
-    close(transaction_log_ofs_);
+  close_files();
+}
+
+void incremental_file_writer::close_files() {
+  if (cur_fd_ != -1)
+    close(cur_fd_);
+  if (transaction_log_fd_ != -1)
+    close(transaction_log_fd_);
 }
 
 bool incremental_file_writer::fits_in_cur_file(size_t append_size) {
-  size_t off = static_cast<size_t>(cur_ofs_->tellp());
-  return off + append_size < max_file_size_;
+  return cur_off_ + buffer_.size() + append_size < max_file_size_;
 }
 
 incremental_file_offset incremental_file_writer::open_new_next() {
-  close(cur_ofs_);
+  write_buffered();
+  // Committed actions may refer to data in this file
+  if (sync_on_commit_ && !committed_.empty())
+    sync_file(cur_fd_);
+  close(cur_fd_);
   file_num_++;
-  cur_ofs_ = open_new(cur_path());
+  cur_fd_ = open_new(cur_path());
+  cur_off_ = 0;
   return tell();
 }
 
-std::ofstream *incremental_file_writer::open_new(const std::string &path) {
-  return new std::ofstream(path, std::ios::out | std::ios::trunc);
+void incremental_file_writer::buffer(const void *data, size_t size) {
+  buffer_.append(static_cast<const char *>(data), size);
+  if (buffer_.size() >= buffer_size_)
+    write_buffered();
 }
 
-std::ofstream *incremental_file_writer::open_existing(const std::string &path) {
-  // std::ios::in required to prevent truncation, caused by lack of std::ios::app
-  return new std::ofstream(path, std::ios::in | std::ios::out | std::ios::ate);
+void incremental_file_writer::write_buffered() {
+  if (buffer_.empty())
+    return;
+  write_at(cur_fd_, buffer_.data(), buffer_.size(), cur_off_);
+  cur_off_ += buffer_.size();
+  buffer_.clear();
 }
 
-void incremental_file_writer::close(std::ofstream *&ofs) {
-  if (ofs->is_open())
-    ofs->close();
-  delete ofs;
-  ofs = nullptr;
+void incremental_file_writer::commit_record(const std::string &record) {
+  write_buffered();
+  committed_.append(record);
+  if (max_pending_commits_ > 0 && ++pending_commits_ >= max_pending_commits_)
+    sync();
 }
 
+int incremental_file_writer::open_new(const std::string &path) {
+  // Mappings of an earlier file at this path must not be reused
+  allocator::instance().archive_map().invalidate(path);
+  return file_utils::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+}
+
+int incremental_file_writer::open_existing(const std::string &path) {
+  return file_utils::open_file(path, O_WRONLY | O_CREAT);
+}
+
+void incremental_file_writer::close(int &fd) {
+  file_utils::close_file(fd);
+  fd = -1;
+}
+
+void incremental_file_writer::write_at(int fd, const char *data, size_t size, size_t offset) {
+  while (size > 0) {
+    ssize_t ret = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+    if (ret == -1) {
+      if (errno == EINTR)
+        continue;
+      THROW(archival_exception, "pwrite failed: " + std::string(strerror(errno)));
+    }
+    data += ret;
+    size -= static_cast<size_t>(ret);
+    offset += static_cast<size_t>(ret);
+  }
+}
+
+void incremental_file_writer::sync_file(int fd) {
+  if (::fdatasync(fd) == -1) {
+    THROW(archival_exception, "fdatasync failed: " + std::string(strerror(errno)));
+  }
+}
+
+}
 }
-}
\ No newline at end of file
@@ -5,23 +5,21 @@ namespace archival {
 
 void load_utils::load_data_log(const std::string &path, const storage_mode mode, data_log &log) {
   monolog_linear_load_utils::load<uint8_t,
-                                  data_log_constants::MAX_BUCKETS,
                                   data_log_constants::BUCKET_SIZE,
                                   data_log_constants::BUFFER_SIZE>(path, log);
   if (mode != storage_mode::IN_MEMORY) {
-    size_t start = (log.size() + data_log_constants::BUCKET_SIZE - 1) / data_log_constants::BUCKET_SIZE;
-    load_data_log_storage(log, start);
+    // The loaded archives end on a bucket boundary
+    load_data_log_storage(log, log.geometry().bucket_idx(log.size()));
   }
 }
 
 void load_utils::load_data_log_storage(data_log &log, size_t start_bucket_idx) {
-  auto &buckets = log.data();
   std::string bucket_path = log.bucket_data_path(start_bucket_idx);
   size_t bucket_idx = start_bucket_idx;
   while (file_utils::exists_file(bucket_path)) {
     ptr_aux_block aux(state_type::D_IN_MEMORY, encoding_type::D_UNENCODED);
-    void *bucket = allocator::instance().mmap(bucket_path, 0, log.bucket_size(), aux);
-    buckets[bucket_idx].init_ptr(encoded_ptr<uint8_t>(bucket));
+    void *bucket = allocator::instance().mmap(bucket_path, 0, log.bucket_size(bucket_idx), aux);
+    log.bucket(bucket_idx).init_ptr(encoded_ptr<uint8_t>(bucket));
     bucket_idx++;
     bucket_path = log.bucket_data_path(bucket_idx);
   }
@@ -40,7 +38,7 @@ void load_utils::load_replay_filter_log(const std::string &path, filter_log &fil
 void load_utils::load_replay_index_log(const std::string &path, index_log &indexes, data_log &log, schema_t &schema) {
   for (size_t i = 0; i < schema.size(); i++) {
     auto &col = schema[i];
-    if (col.is_indexed()) {
+    if (col.is_indexed() && col.index_type() == RADIX_INDEX) {
       size_t id = col.index_id();
       auto *index = indexes[id];
       size_t data_log_archival_tail = load_index(archival_utils::index_archival_path(path, id), index);
@@ -49,6 +47,57 @@ void load_utils::load_replay_index_log(const std::string &path, index_log &index
   }
 }
 
+void load_utils::load_replay_hash_index_log(hash_index_log &indexes, data_log &log, schema_t &schema) {
+  bool has_hash_index = false;
+  for (size_t i = 0; i < schema.size(); i++)
+    has_hash_index |= (schema[i].is_indexed() && schema[i].index_type() == HASH_INDEX);
+  if (!has_hash_index)
+    return;
+  rebuild_indexes("hash_index", log, schema, [&indexes, &schema](const record_t &r) {
+    for (const field_t &f : r)
+      if (f.is_indexed() && schema[f.idx()].index_type() == HASH_INDEX)
+        indexes[f.index_id()]->insert(f.get_key(), r.log_offset());
+  });
+}
+
+void load_utils::load_replay_composite_index_log(composite_index_log &composites,
+                                                 index_log &indexes,
+                                                 data_log &log,
+                                                 schema_t &schema) {
+  if (composites.size() == 0)
+    return;
+  rebuild_indexes("composite_index", log, schema, [&composites, &indexes](const record_t &r) {
+    for (size_t j = 0; j < composites.size(); j++) {
+      composite_index_t *c = composites[j];
+      if (c->is_indexed())
+        indexes[c->index_id()]->insert(c->get_key(r), r.log_offset());
+    }
+  });
+}
+
+void load_utils::rebuild_indexes(const std::string &name,
+                                 data_log &log,
+                                 schema_t &schema,
+                                 const std::function<void(const record_t &)> &update) {
+  size_t record_size = schema.record_size();
+  uint64_t end = log.size() - log.size() % record_size;
+  if (end == 0)
+    return;
+  // The indexes support concurrent inserts, so partitions of the log are
+  // read in bulk and replayed in parallel, as for a backfill.
+  backfill_task task(name, end, record_size);
+  task.start([&log, &schema, &update, record_size](uint64_t begin, uint64_t end) {
+               std::unique_ptr<uint8_t[]> buf(new uint8_t[end - begin]);
+               log.read(begin, buf.get(), end - begin);
+               for (uint64_t off = begin; off < end; off += record_size)
+                 update(schema.apply_unsafe(off, buf.get() + (off - begin)));
+             },
+             [] {},
+             configuration_params::BACKFILL_CONCURRENCY(),
+             configuration_params::BACKFILL_CHUNK_RECORDS());
+  task.wait();
+}
+
 size_t load_utils::load_filter(const std::string &path, monitor::filter *filter) {
   filter::idx_t &tree = filter->data();
   size_t archival_tail = filter_load_utils::load_reflogs(path, tree);
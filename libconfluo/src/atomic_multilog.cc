@@ -7,24 +7,28 @@ atomic_multilog::atomic_multilog(const std::string &name,
                                  const std::string &path,
                                  const storage::storage_mode &s_mode,
                                  const archival_mode &a_mode,
-                                 task_pool &pool)
+                                 task_pool &pool,
+                                 const monolog::bucket_geometry &geometry)
     : name_(name),
       schema_(schema),
-      data_log_("data_log", path, s_mode),
+      data_log_("data_log", path, s_mode, geometry.at_least(schema_.record_size())),
       rt_(path, s_mode),
       metadata_(path),
-      planner_(&data_log_, &indexes_, &schema_),
-      archiver_(path, rt_, &data_log_, &filters_, &indexes_, &schema_),
-      archival_task_("archival"),
-      archival_pool_(),
+      planner_(&data_log_, &indexes_, &hash_indexes_, &composite_indexes_, &schema_),
+      archiver_(path, rt_, &data_log_, &filters_, &indexes_, &schema_, true, a_mode == archival_mode::COMPRESS),
+      num_monitored_(0),
+      monitor_horizon_ms_(0),
       mgmt_pool_(pool),
-      monitor_task_("monitor") {
+      monitor_task_("monitor"),
+      archival_task_("archival", task_scheduler::archival()) {
+  init_var_heap(path, s_mode);
   data_log_.pre_alloc();
   metadata_.write_schema(schema_);
   metadata_.write_storage_mode(s_mode);
+  metadata_.write_data_log_geometry(data_log_.geometry());
   metadata_.write_archival_mode(a_mode);
   monitor_task_.start(std::bind(&atomic_multilog::monitor_task, this), configuration_params::MONITOR_PERIODICITY_MS());
-  if (a_mode == archival_mode::ON) {
+  if (a_mode != archival_mode::OFF) {
     archival_task_.start(std::bind(&atomic_multilog::archival_task, this),
                          archival_configuration_params::PERIODICITY_MS());
   }
@@ -35,28 +39,38 @@ atomic_multilog::atomic_multilog(const std::string &name,
                                  const std::string &path,
                                  const storage::storage_mode &storage_mode,
                                  const archival_mode &a_mode,
-                                 task_pool &pool)
-    : atomic_multilog(name, parser::parse_schema(schema), path, storage_mode, a_mode, pool) {
+                                 task_pool &pool,
+                                 const monolog::bucket_geometry &geometry)
+    : atomic_multilog(name, parser::parse_schema(schema), path, storage_mode, a_mode, pool, geometry) {
 }
 
 atomic_multilog::atomic_multilog(const std::string &name, const std::string &path, task_pool &pool)
     : name_(name),
       schema_(),
       metadata_(path),
-      planner_(&data_log_, &indexes_, &schema_),
+      planner_(&data_log_, &indexes_, &hash_indexes_, &composite_indexes_, &schema_),
       archiver_(path, rt_, &data_log_, &filters_, &indexes_, &schema_, false),
-      archival_task_("archival"),
-      archival_pool_(),
+      num_monitored_(0),
+      monitor_horizon_ms_(0),
       mgmt_pool_(pool),
-      monitor_task_("monitor") {
+      monitor_task_("monitor"),
+      archival_task_("archival", task_scheduler::archival()) {
   storage_mode s_mode;
   archival_mode a_mode;
-  load_metadata(path, s_mode, a_mode);
-  data_log_ = data_log_type("data_log", path, s_mode);
+  // Multilogs that do not record their geometry use fixed-size buckets
+  auto geometry = monolog::bucket_geometry::fixed(data_log_constants::BUCKET_SIZE);
+  load_metadata(path, s_mode, a_mode, geometry);
+  data_log_ = data_log_type("data_log", path, s_mode, geometry);
+  init_var_heap(path, s_mode);
   rt_ = read_tail_type(path, s_mode);
+  if (a_mode == archival_mode::COMPRESS) {
+    archiver_ = atomic_multilog_archiver(path, rt_, &data_log_, &filters_, &indexes_, &schema_, false, true);
+    if (schema_.has_var_columns())
+      archiver_.set_var_heap(&var_heap_);
+  }
   load(s_mode);
   monitor_task_.start(std::bind(&atomic_multilog::monitor_task, this), configuration_params::MONITOR_PERIODICITY_MS());
-  if (a_mode == archival_mode::ON) {
+  if (a_mode != archival_mode::OFF) {
     archival_task_.start(std::bind(&atomic_multilog::archival_task, this),
                          archival_configuration_params::PERIODICITY_MS());
   }
@@ -67,26 +81,38 @@ void atomic_multilog::archive() {
 }
 
 void atomic_multilog::archive(size_t offset) {
+  std::lock_guard<std::mutex> lk(archival_mtx_);
+  archiver_.archive(offset);
+  archived_tail_ = std::max(archived_tail_, static_cast<uint64_t>(offset));
+}
+
+void atomic_multilog::add_index(const std::string &field_name, double bucket_size, index_type_t type) {
   optional<management_exception> ex;
-  std::future<void> ret = archival_pool_.submit([this, offset] {
-    archiver_.archive(offset);
-  });
+  std::future<void> ret = mgmt_pool_.submit(
+      [field_name, bucket_size, type, &ex, this] {
+        add_index_task(field_name, bucket_size, type, ex);
+      });
   ret.wait();
   if (ex.has_value())
     throw ex.value();
 }
 
-void atomic_multilog::add_index(const std::string &field_name, double bucket_size) {
+void atomic_multilog::add_index(const std::vector<std::string> &field_names, const std::vector<double> &bucket_sizes) {
   optional<management_exception> ex;
   std::future<void> ret = mgmt_pool_.submit(
-      [field_name, bucket_size, &ex, this] {
-        add_index_task(field_name, bucket_size, ex);
+      [field_names, bucket_sizes, &ex, this] {
+        add_composite_index_task(field_names, bucket_sizes, ex);
       });
   ret.wait();
   if (ex.has_value())
     throw ex.value();
 }
 
+void atomic_multilog::add_index(std::initializer_list<std::string> field_names,
+                                const std::vector<double> &bucket_sizes) {
+  add_index(std::vector<std::string>(field_names), bucket_sizes);
+}
+
 void atomic_multilog::remove_index(const std::string &field_name) {
   optional<management_exception> ex;
   std::future<void> ret = mgmt_pool_.submit([field_name, &ex, this] {
@@ -97,6 +123,16 @@ void atomic_multilog::remove_index(const std::string &field_name) {
     throw ex.value();
 }
 
+void atomic_multilog::remove_index(const std::vector<std::string> &field_names) {
+  optional<management_exception> ex;
+  std::future<void> ret = mgmt_pool_.submit([field_names, &ex, this] {
+    remove_composite_index_task(field_names, ex);
+  });
+  ret.wait();
+  if (ex.has_value())
+    throw ex.value();
+}
+
 bool atomic_multilog::is_indexed(const std::string &field_name) {
   optional<management_exception> ex;
   size_t idx;
@@ -109,6 +145,38 @@ bool atomic_multilog::is_indexed(const std::string &field_name) {
   return col.is_indexed();
 }
 
+backfill_status atomic_multilog::index_backfill_status(const std::string &field_name) const {
+  size_t idx;
+  try {
+    idx = schema_.get_field_index(field_name);
+  } catch (std::exception &e) {
+    THROW(management_exception, "Field name does not exist");
+  }
+  const column_t &col = schema_[idx];
+  if (!col.is_indexed()) {
+    THROW(management_exception, "Field " + field_name + " is not indexed");
+  }
+  std::lock_guard<std::mutex> lock(backfill_mtx_);
+  auto it = index_backfills_.find(col.name());
+  if (it == index_backfills_.end()) {
+    return backfill_status{0, 0, 0, true, false};
+  }
+  return it->second->status();
+}
+
+backfill_status atomic_multilog::index_backfill_status(const std::vector<std::string> &field_names) const {
+  std::string name = composite_index_name(field_names);
+  if (find_composite_index(name) == nullptr) {
+    THROW(management_exception, "Fields " + name + " are not indexed");
+  }
+  std::lock_guard<std::mutex> lock(backfill_mtx_);
+  auto it = index_backfills_.find(name);
+  if (it == index_backfills_.end()) {
+    return backfill_status{0, 0, 0, true, false};
+  }
+  return it->second->status();
+}
+
 void atomic_multilog::add_filter(const std::string &name, const std::string &expr) {
   optional<management_exception> ex;
   std::future<void> ret = mgmt_pool_.submit([name, expr, &ex, this] {
@@ -129,6 +197,19 @@ void atomic_multilog::remove_filter(const std::string &name) {
     throw ex.value();
 }
 
+backfill_status atomic_multilog::filter_backfill_status(const std::string &name) const {
+  filter_id_t filter_id;
+  if (filter_map_.get(name, filter_id) == -1) {
+    THROW(management_exception, "Filter " + name + " does not exist.");
+  }
+  std::lock_guard<std::mutex> lock(backfill_mtx_);
+  auto it = filter_backfills_.find(name);
+  if (it == filter_backfills_.end()) {
+    return backfill_status{0, 0, 0, true, false};
+  }
+  return it->second->status();
+}
+
 void atomic_multilog::add_aggregate(const std::string &name, const std::string &filter_name, const std::string &expr) {
   optional<management_exception> ex;
   std::future<void> ret = mgmt_pool_.submit(
@@ -150,7 +231,10 @@ void atomic_multilog::remove_aggregate(const std::string &name) {
     throw ex.value();
 }
 
-void atomic_multilog::install_trigger(const std::string &name, const std::string &expr, const uint64_t periodicity_ms) {
+void atomic_multilog::install_trigger(const std::string &name,
+                                      const std::string &expr,
+                                      const uint64_t periodicity_ms,
+                                      trigger_mode_t mode) {
   if (periodicity_ms < configuration_params::MONITOR_PERIODICITY_MS()) {
     throw management_exception(
         "Trigger periodicity (" + std::to_string(periodicity_ms)
@@ -169,8 +253,8 @@ void atomic_multilog::install_trigger(const std::string &name, const std::string
 
   optional<management_exception> ex;
   std::future<void> ret = mgmt_pool_.submit(
-      [name, expr, periodicity_ms, &ex, this] {
-        add_trigger_task(name, expr, periodicity_ms, ex);
+      [name, expr, periodicity_ms, mode, &ex, this] {
+        add_trigger_task(name, expr, periodicity_ms, mode, ex);
       });
   ret.wait();
   if (ex.has_value())
@@ -187,6 +271,32 @@ void atomic_multilog::remove_trigger(const std::string &name) {
     throw ex.value();
 }
 
+void atomic_multilog::add_materialized_view(const std::string &name,
+                                            const std::string &filter_name,
+                                            const std::string &group_by,
+                                            const std::vector<std::string> &aggregate_exprs,
+                                            uint64_t window_ms,
+                                            atomic_multilog *target) {
+  optional<management_exception> ex;
+  std::future<void> ret = mgmt_pool_.submit(
+      [name, filter_name, group_by, aggregate_exprs, window_ms, target, &ex, this] {
+        add_view_task(name, filter_name, group_by, aggregate_exprs, window_ms, target, ex);
+      });
+  ret.wait();
+  if (ex.has_value())
+    throw ex.value();
+}
+
+void atomic_multilog::remove_materialized_view(const std::string &name) {
+  optional<management_exception> ex;
+  std::future<void> ret = mgmt_pool_.submit([name, &ex, this] {
+    remove_view_task(name, ex);
+  });
+  ret.wait();
+  if (ex.has_value())
+    throw ex.value();
+}
+
 record_batch_builder atomic_multilog::get_batch_builder() const {
   return record_batch_builder(schema_);
 }
@@ -194,6 +304,14 @@ record_batch_builder atomic_multilog::get_batch_builder() const {
 size_t atomic_multilog::append_batch(record_batch &batch) {
   size_t record_size = schema_.record_size();
   size_t batch_bytes = batch.nrecords * record_size;
+  if (schema_.has_var_columns()) {
+    for (record_block &block : batch.blocks) {
+      std::string stored(block.nrecords * record_size, '\0');
+      store_inline_records(reinterpret_cast<const uint8_t *>(block.data.data()), block.data.length(),
+                           block.nrecords, reinterpret_cast<uint8_t *>(&stored[0]));
+      block.data.swap(stored);
+    }
+  }
   size_t log_offset = data_log_.reserve(batch_bytes);
   size_t cur_offset = log_offset;
   for (record_block &block : batch.blocks) {
@@ -205,12 +323,20 @@ size_t atomic_multilog::append_batch(record_batch &batch) {
   }
 
   data_log_.flush(log_offset, batch_bytes);
+  update_time_order(log_offset, batch_bytes);
   rt_.advance(log_offset, static_cast<uint32_t>(batch_bytes));
+  notify_monitor();
   return log_offset;
 }
 
 size_t atomic_multilog::append(void *data) {
   size_t record_size = schema_.record_size();
+  std::unique_ptr<uint8_t[]> stored;
+  if (schema_.has_var_columns()) {
+    stored.reset(new uint8_t[record_size]);
+    store_inline_records(reinterpret_cast<const uint8_t *>(data), schema_.inline_record_size(data), 1, stored.get());
+    data = stored.get();
+  }
   size_t offset = data_log_.append((const uint8_t *) data, record_size);
   record_t r = schema_.apply_unsafe(offset, data);
 
@@ -219,12 +345,29 @@ size_t atomic_multilog::append(void *data) {
     if (filters_.at(i)->is_valid())
       filters_.at(i)->update(r);
 
-  for (const field_t &f : r)
-    if (f.is_indexed())
-      indexes_.at(f.index_id())->insert(f.get_key(), offset);
+  size_t ncomposites = composite_indexes_.size();
+  for (size_t i = 0; i < ncomposites; i++) {
+    composite_index_t *c = composite_indexes_.at(i);
+    if (c->is_indexed() && c->index_on_write(offset))
+      indexes_.at(c->index_id())->insert(c->get_key(r), offset);
+  }
+
+  for (const field_t &f : r) {
+    if (f.is_indexed()) {
+      const column_t &col = schema_[f.idx()];
+      if (!col.index_on_write(offset))
+        continue;
+      if (col.index_type() == HASH_INDEX)
+        hash_indexes_.at(f.index_id())->insert(f.get_key(), offset);
+      else
+        indexes_.at(f.index_id())->insert(f.get_key(), offset);
+    }
+  }
 
   data_log_.flush(offset, record_size);
+  update_time_order(offset, record_size);
   rt_.advance(offset, static_cast<uint32_t>(record_size));
+  notify_monitor();
   return offset;
 }
 
@@ -246,6 +389,16 @@ std::unique_ptr<uint8_t> atomic_multilog::read_raw(uint64_t offset, uint64_t &ve
   return rptr.decode(0, schema_.record_size());
 }
 
+bool atomic_multilog::read_raw(uint64_t offset, uint8_t *buffer) const {
+  read_only_data_log_ptr rptr;
+  uint64_t version;
+  read(offset, version, rptr);
+  if (rptr.get().ptr() == nullptr)
+    return false;
+  rptr.decode(buffer, 0, schema_.record_size());
+  return true;
+}
+
 void atomic_multilog::read(uint64_t offset, read_only_data_log_ptr &ptr) const {
   uint64_t version;
   read(offset, version, ptr);
@@ -263,7 +416,12 @@ void atomic_multilog::read(uint64_t offset, uint64_t &version, read_only_data_lo
 std::vector<std::string> atomic_multilog::read(uint64_t offset, uint64_t &version) const {
   read_only_data_log_ptr rptr;
   read(offset, version, rptr);
-  data_ptr dptr = rptr.decode();
+  if (schema_.has_var_columns()) {
+    std::string rec;
+    schema_.inline_record(rec, schema_.apply(offset, rptr));
+    return schema_.data_to_record_vector(rec.data());
+  }
+  data_ptr dptr = rptr.decode_range(0, schema_.record_size());
   return schema_.data_to_record_vector(dptr.get());
 }
 
@@ -280,6 +438,27 @@ std::unique_ptr<record_cursor> atomic_multilog::execute_filter(const std::string
   return plan.execute(version);
 }
 
+std::unique_ptr<record_cursor> atomic_multilog::query_time_range(uint64_t begin_ts,
+                                                                 uint64_t end_ts,
+                                                                 bool reverse) const {
+  uint64_t version = rt_.get();
+  std::unique_ptr<offset_cursor> o_cursor;
+  const column_t &ts_col = schema_[0];
+  if (begin_ts > end_ts) {
+    o_cursor.reset(new data_log_range_cursor(0, 0, record_size(), reverse));
+  } else if (is_time_ordered()) {
+    uint64_t begin = time_bound(begin_ts, true, version);
+    uint64_t end = time_bound(end_ts, false, version);
+    o_cursor.reset(new data_log_range_cursor(begin, std::max(begin, end), record_size(), reverse));
+  } else if (ts_col.is_queryable() && ts_col.index_type() == RADIX_INDEX) {
+    o_cursor.reset(new time_index_cursor(indexes_.at(ts_col.index_id()), ts_col.index_bucket_size(), &data_log_,
+                                         begin_ts, end_ts, version, reverse));
+  } else {
+    o_cursor.reset(new time_scan_cursor(&data_log_, record_size(), begin_ts, end_ts, version, reverse));
+  }
+  return std::unique_ptr<record_cursor>(new offset_record_cursor(std::move(o_cursor), &data_log_, &schema_));
+}
+
 numeric atomic_multilog::execute_aggregate(const std::string &aggregate_expr, const std::string &filter_expr) {
   auto pa = parser::parse_aggregate(aggregate_expr);
   aggregator agg = aggregate_manager::get_aggregator(pa.agg);
@@ -341,16 +520,84 @@ numeric atomic_multilog::get_aggregate(const std::string &aggregate_name, uint64
   size_t aid = aggregate_id.aggregate_idx;
   aggregate_info *a = filters_.at(fid)->get_aggregate_info(aid);
   numeric agg = a->zero();
-  for (uint64_t t = begin_ms; t <= end_ms; t++) {
-    aggregated_reflog const *refs;
-    if ((refs = filters_.at(fid)->lookup(t)) == nullptr)
-      continue;
-    numeric t_agg = refs->get_aggregate(aid, version);
-    agg = a->comb_op(agg, t_agg);
+  // Only visit the time-blocks that hold records, rather than every ms in the range
+  filter::reflog_result res = filters_.at(fid)->lookup_range_reflogs(begin_ms, end_ms);
+  for (auto it = res.begin(); it != res.end(); ++it) {
+    agg = a->comb_op(agg, it->get_aggregate(aid, version));
   }
   return agg;
 }
 
+aggregator atomic_multilog::get_aggregator(const std::string &aggregate_name) {
+  aggregate_id_t aggregate_id;
+  if (aggregate_map_.get(aggregate_name, aggregate_id) == -1) {
+    throw invalid_operation_exception("Aggregate " + aggregate_name + " does not exist.");
+  }
+  return filters_.at(aggregate_id.filter_idx)->get_aggregate_info(aggregate_id.aggregate_idx)->get_aggregator();
+}
+
+std::vector<numeric> atomic_multilog::get_aggregate_series(const std::string &aggregate_name,
+                                                           uint64_t begin_ms,
+                                                           uint64_t end_ms,
+                                                           uint64_t interval_ms) {
+  aggregate_id_t aggregate_id;
+  if (aggregate_map_.get(aggregate_name, aggregate_id) == -1) {
+    throw invalid_operation_exception("Aggregate " + aggregate_name + " does not exist.");
+  }
+  if (interval_ms == 0) {
+    throw invalid_operation_exception("Interval must be non-zero.");
+  }
+  if (begin_ms > end_ms) {
+    return std::vector<numeric>();
+  }
+  uint64_t version = rt_.get();
+  size_t fid = aggregate_id.filter_idx;
+  size_t aid = aggregate_id.aggregate_idx;
+  aggregate_info *a = filters_.at(fid)->get_aggregate_info(aid);
+  std::vector<numeric> series(num_series_points(begin_ms, end_ms, interval_ms), a->zero());
+  filter::reflog_result res = filters_.at(fid)->lookup_range_reflogs(begin_ms, end_ms);
+  for (auto it = res.begin(); it != res.end(); ++it) {
+    // Time-block keys are stored big-endian
+    uint64_t t = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); i++)
+      t = (t << 8) | it.key()[i];
+    if (t < begin_ms || t > end_ms)
+      continue;
+    numeric &bucket = series[(t - begin_ms) / interval_ms];
+    bucket = a->comb_op(bucket, it->get_aggregate(aid, version));
+  }
+  return series;
+}
+
+std::vector<numeric> atomic_multilog::execute_aggregate_series(const std::string &aggregate_expr,
+                                                               const std::string &filter_expr,
+                                                               uint64_t begin_ts,
+                                                               uint64_t end_ts,
+                                                               uint64_t interval) {
+  if (interval == 0) {
+    throw invalid_operation_exception("Interval must be non-zero.");
+  }
+  auto pa = parser::parse_aggregate(aggregate_expr);
+  aggregator agg = aggregate_manager::get_aggregator(pa.agg);
+  uint16_t field_idx = schema_[pa.field_name].idx();
+  parser::compiled_expression cexpr;
+  if (!filter_expr.empty()) {
+    cexpr = parser::compile_expression(parser::parse_expression(filter_expr), schema_);
+  }
+  if (begin_ts > end_ts) {
+    return std::vector<numeric>();
+  }
+  std::vector<numeric> series(num_series_points(begin_ts, end_ts, interval), agg.zero);
+  for (auto c = query_time_range(begin_ts, end_ts); c->has_more(); c->advance()) {
+    record_t r = c->get();
+    if (!cexpr.test(r))
+      continue;
+    numeric &bucket = series[(r.timestamp() - begin_ts) / interval];
+    bucket = agg.seq_op(bucket, numeric(r[field_idx].value()));
+  }
+  return series;
+}
+
 std::unique_ptr<alert_cursor> atomic_multilog::get_alerts(uint64_t begin_ms, uint64_t end_ms) const {
   return get_alerts(begin_ms, end_ms, "");
 }
@@ -358,7 +605,14 @@ std::unique_ptr<alert_cursor> atomic_multilog::get_alerts(uint64_t begin_ms, uin
 std::unique_ptr<alert_cursor> atomic_multilog::get_alerts(uint64_t begin_ms,
                                                           uint64_t end_ms,
                                                           const std::string &trigger_name) const {
-  return std::unique_ptr<alert_cursor>(new trigger_alert_cursor(alerts_.get_alerts(begin_ms, end_ms), trigger_name));
+  drain_alerts();
+  std::vector<monitor::alert_index::alert_list> alerts;
+  if (trigger_name.empty()) {
+    alerts.push_back(alerts_.get_alerts(begin_ms, end_ms));
+  } else {
+    alerts = alerts_.get_alerts(begin_ms, end_ms, trigger_name);
+  }
+  return std::unique_ptr<alert_cursor>(new trigger_alert_cursor(&alerts_, std::move(alerts)));
 }
 
 const std::string &atomic_multilog::get_name() const {
@@ -373,18 +627,30 @@ size_t atomic_multilog::num_records() const {
   return rt_.get() / schema_.record_size();
 }
 
+size_t atomic_multilog::num_monitored() const {
+  return atomic::load(&num_monitored_);
+}
+
 size_t atomic_multilog::record_size() const {
   return schema_.record_size();
 }
 
 void atomic_multilog::load(const storage::storage_mode &mode) {
   load_utils::load_data_log(archiver_.data_log_path(), mode, data_log_);
+  if (schema_.has_var_columns()) {
+    load_utils::load_data_log(archiver_.var_heap_path(), mode, var_heap_.log());
+    var_heap_.recover();
+  }
   load_utils::load_replay_filter_log(archiver_.filter_log_path(), filters_, data_log_, schema_);
   load_utils::load_replay_index_log(archiver_.index_log_path(), indexes_, data_log_, schema_);
+  load_utils::load_replay_hash_index_log(hash_indexes_, data_log_, schema_);
+  load_utils::load_replay_composite_index_log(composite_indexes_, indexes_, data_log_, schema_);
+  update_time_order(0, data_log_.size());
   rt_.advance(0, static_cast<uint32_t>(data_log_.size()));
 }
 
-void atomic_multilog::load_metadata(const std::string &path, storage_mode &s_mode, archival_mode &a_mode) {
+void atomic_multilog::load_metadata(const std::string &path, storage_mode &s_mode, archival_mode &a_mode,
+                                    monolog::bucket_geometry &geometry) {
   metadata_reader reader(path);
   metadata_writer temp = metadata_;
   metadata_ = metadata_writer(); // metadata shouldn't be written while loading
@@ -404,6 +670,16 @@ void atomic_multilog::load_metadata(const std::string &path, storage_mode &s_mod
         add_index(index_metadata.field_name(), index_metadata.bucket_size());
         break;
       }
+      case D_HASH_INDEX_METADATA: {
+        auto index_metadata = reader.next_index_metadata();
+        add_index(index_metadata.field_name(), index_metadata.bucket_size(), HASH_INDEX);
+        break;
+      }
+      case D_COMPOSITE_INDEX_METADATA: {
+        auto index_metadata = reader.next_composite_index_metadata();
+        add_index(index_metadata.field_names(), index_metadata.bucket_sizes());
+        break;
+      }
       case D_AGGREGATE_METADATA: {
         auto agg_metadata = reader.next_aggregate_metadata();
         add_aggregate(agg_metadata.aggregate_name(), agg_metadata.filter_name(), agg_metadata.aggregate_expression());
@@ -413,7 +689,14 @@ void atomic_multilog::load_metadata(const std::string &path, storage_mode &s_mod
         auto trigger_metadata = reader.next_trigger_metadata();
         optional<management_exception> ex;
         add_trigger_task(trigger_metadata.trigger_name(), trigger_metadata.trigger_expression(),
-                         trigger_metadata.periodicity_ms(), ex);
+                         trigger_metadata.periodicity_ms(), POLLED_TRIGGER, ex);
+        break;
+      }
+      case D_EAGER_TRIGGER_METADATA: {
+        auto trigger_metadata = reader.next_trigger_metadata();
+        optional<management_exception> ex;
+        add_trigger_task(trigger_metadata.trigger_name(), trigger_metadata.trigger_expression(),
+                         trigger_metadata.periodicity_ms(), EAGER_TRIGGER, ex);
         break;
       }
       case D_STORAGE_MODE_METADATA: {
@@ -424,6 +707,10 @@ void atomic_multilog::load_metadata(const std::string &path, storage_mode &s_mod
         a_mode = reader.next_archival_mode();
         break;
       }
+      case D_DATA_LOG_METADATA: {
+        geometry = reader.next_data_log_geometry();
+        break;
+      }
     }
   }
   metadata_ = temp;
@@ -438,7 +725,16 @@ void atomic_multilog::update_aux_record_block(uint64_t log_offset, record_block
   }
 
   for (size_t i = 0; i < schema_.size(); i++) {
-    if (snap.is_indexed(i)) {
+    if (!snap.is_indexed(i) || !schema_[i].index_on_write(log_offset))
+      continue;
+    if (snap.index_type(i) == HASH_INDEX) {
+      hash_index *idx = hash_indexes_.at(snap.index_id(i));
+      for (size_t j = 0; j < block.nrecords; j++) {
+        size_t block_offset = j * record_size;
+        void *rec_ptr = reinterpret_cast<uint8_t *>(&block.data[0]) + block_offset;
+        idx->insert(snap.get_key(rec_ptr, static_cast<uint32_t>(i)), log_offset + block_offset);
+      }
+    } else {
       radix_index *idx = indexes_.at(snap.index_id(i));
       // Handle timestamp differently
       // TODO: What if indexing requested for finer granularity?
@@ -459,10 +755,127 @@ void atomic_multilog::update_aux_record_block(uint64_t log_offset, record_block
       }
     }
   }
+
+  size_t ncomposites = composite_indexes_.size();
+  for (size_t i = 0; i < ncomposites; i++) {
+    composite_index_t *c = composite_indexes_.at(i);
+    if (!c->is_indexed() || !c->index_on_write(log_offset))
+      continue;
+    radix_index *idx = indexes_.at(c->index_id());
+    for (size_t j = 0; j < block.nrecords; j++) {
+      size_t block_offset = j * record_size;
+      void *rec_ptr = reinterpret_cast<uint8_t *>(&block.data[0]) + block_offset;
+      record_t r = schema_.apply_unsafe(log_offset + block_offset, rec_ptr);
+      idx->insert(c->get_key(r), log_offset + block_offset);
+    }
+  }
+}
+
+size_t atomic_multilog::num_series_points(uint64_t begin, uint64_t end, uint64_t interval) {
+  uint64_t last = (end - begin) / interval;
+  size_t max_points = configuration_params::MAX_AGGREGATE_SERIES_POINTS();
+  if (last >= max_points) {
+    throw invalid_operation_exception(
+        "Aggregate series exceeds " + std::to_string(max_points) + " intervals; use a larger interval.");
+  }
+  return static_cast<size_t>(last + 1);
+}
+
+bool atomic_multilog::is_time_ordered() const {
+  return atomic::load(&time_ordered_);
+}
+
+void atomic_multilog::update_time_order(uint64_t offset, size_t bytes) {
+  if (!atomic::load(&time_ordered_))
+    return;
+  // The read tail reaches offset once the preceding record is written; the
+  // append would wait for it in rt_.advance() anyway
+  while (rt_.get() < offset)
+    std::this_thread::yield();
+  size_t rsize = record_size();
+  uint64_t o = offset == 0 ? 0 : offset - rsize;
+  uint64_t prev = record_timestamp(&data_log_, o);
+  for (; o < offset + bytes; o += rsize) {
+    uint64_t ts = record_timestamp(&data_log_, o);
+    if (ts < prev) {
+      atomic::store(&time_ordered_, false);
+      return;
+    }
+    prev = ts;
+  }
+}
+
+uint64_t atomic_multilog::time_bound(uint64_t ts, bool inclusive, uint64_t version) const {
+  size_t rsize = record_size();
+  uint64_t lo = 0, hi = version / rsize;
+  while (lo < hi) {
+    uint64_t mid = lo + (hi - lo) / 2;
+    uint64_t mid_ts = record_timestamp(&data_log_, mid * rsize);
+    if (inclusive ? mid_ts < ts : mid_ts <= ts)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo * rsize;
+}
+
+void atomic_multilog::init_var_heap(const std::string &path, const storage::storage_mode &mode) {
+  if (!schema_.has_var_columns())
+    return;
+  var_heap_.init(path, mode, data_log_.geometry());
+  schema_.set_var_heap(&var_heap_);
+  archiver_.set_var_heap(&var_heap_);
+}
+
+void atomic_multilog::store_inline_records(const uint8_t *in, size_t in_size, size_t nrecords, uint8_t *out) {
+  // Validate all records before reserving heap space, since reserved
+  // space must always be committed
+  size_t record_size = schema_.record_size();
+  size_t in_offset = 0;
+  for (size_t i = 0; i < nrecords; i++) {
+    if (in_size - in_offset < record_size)
+      THROW(invalid_operation_exception, "Malformed inline record");
+    const uint8_t *rec = in + in_offset;
+    size_t rec_size = schema_.inline_record_size(rec);
+    for (uint16_t idx : schema_.var_columns()) {
+      uint64_t ref = var_ref::load(rec + schema_[idx].offset());
+      if (var_ref::offset(ref) < record_size || var_ref::offset(ref) + var_ref::length(ref) > rec_size)
+        THROW(invalid_operation_exception, "Malformed inline record");
+    }
+    in_offset += rec_size;
+    if (in_offset > in_size)
+      THROW(invalid_operation_exception, "Malformed inline record");
+  }
+  if (in_offset != in_size)
+    THROW(invalid_operation_exception, "Malformed inline record");
+
+  size_t var_bytes = in_size - nrecords * record_size;
+  uint64_t heap_offset = var_heap_.reserve(var_bytes);
+  if (heap_offset + var_bytes > var_ref::MAX_OFFSET) {
+    var_heap_.commit(heap_offset, var_bytes);
+    THROW(invalid_operation_exception, "Variable-length heap is full");
+  }
+  in_offset = 0;
+  for (size_t i = 0; i < nrecords; i++) {
+    const uint8_t *rec = in + in_offset;
+    size_t rec_var_bytes = schema_.inline_record_size(rec) - record_size;
+    uint8_t *out_rec = out + i * record_size;
+    memcpy(out_rec, rec, record_size);
+    var_heap_.write(heap_offset, rec + record_size, rec_var_bytes);
+    for (uint16_t idx : schema_.var_columns()) {
+      uint8_t *slot = out_rec + schema_[idx].offset();
+      uint64_t ref = var_ref::load(slot);
+      var_ref::store(slot, var_ref::pack(heap_offset + var_ref::offset(ref) - record_size, var_ref::length(ref)));
+    }
+    heap_offset += rec_var_bytes;
+    in_offset += record_size + rec_var_bytes;
+  }
+  var_heap_.commit(heap_offset - var_bytes, var_bytes);
 }
 
 void atomic_multilog::add_index_task(const std::string &field_name,
                                      double bucket_size,
+                                     index_type_t type,
                                      optional<management_exception> &ex) {
   size_t idx;
   try {
@@ -477,12 +890,50 @@ void atomic_multilog::add_index_task(const std::string &field_name,
   if (success) {
     uint16_t index_id = UINT16_MAX;
     if (col.type().is_valid()) {
-      index_id = static_cast<uint16_t>(indexes_.push_back(new radix_index(col.type().size, 256)));
+      if (type == HASH_INDEX) {
+        size_t num_buckets = configuration_params::HASH_INDEX_NUM_BUCKETS();
+        index_id = static_cast<uint16_t>(hash_indexes_.push_back(new hash_index(col.type().size, num_buckets)));
+      } else {
+        index_id = static_cast<uint16_t>(indexes_.push_back(new radix_index(col.type().size, 256)));
+      }
+      col.set_backfilling(index_id, bucket_size, type);
+      // Writers that reserve log space after the fence see the index and
+      // add their own records; all records before the tail are backfilled.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      uint64_t boundary = data_log_.size();
+      col.set_backfill_boundary(boundary);
+      if (boundary == 0) {
+        col.finish_backfill();
+      } else {
+        uint16_t field_idx = col.idx();
+        std::function<void(const record_t &)> update;
+        if (type == HASH_INDEX) {
+          hash_index *index = hash_indexes_.at(index_id);
+          update = [index, field_idx](const record_t &r) {
+            index->insert(r[field_idx].get_key(), r.log_offset());
+          };
+        } else {
+          radix_index *index = indexes_.at(index_id);
+          update = [index, field_idx](const record_t &r) {
+            index->insert(r[field_idx].get_key(), r.log_offset());
+          };
+        }
+        backfill_task *task = start_backfill(
+            name_ + "/index/" + col.name(), boundary, update,
+            [this, field_idx, index_id, type] {
+              // Only complete the index instance this backfill populated
+              column_t &c = schema_[field_idx];
+              if (c.index_id() == index_id && c.index_type() == type)
+                c.finish_backfill();
+            });
+        std::lock_guard<std::mutex> lock(backfill_mtx_);
+        index_backfills_[col.name()].reset(task);
+      }
     } else {
       ex = management_exception("Index not supported for field type");
+      col.set_indexed(index_id, bucket_size, type);
     }
-    col.set_indexed(index_id, bucket_size);
-    metadata_.write_index_metadata(field_name, bucket_size);
+    metadata_.write_index_metadata(field_name, bucket_size, type);
   } else {
     ex = management_exception("Could not index " + field_name + ": already indexed/indexing");
     return;
@@ -502,6 +953,122 @@ void atomic_multilog::remove_index_task(const std::string &field_name, optional<
     ex = management_exception("Could not remove index for " + field_name + ": No index exists");
     return;
   }
+
+  std::lock_guard<std::mutex> lock(backfill_mtx_);
+  auto it = index_backfills_.find(schema_[idx].name());
+  if (it != index_backfills_.end())
+    it->second->cancel();
+}
+
+void atomic_multilog::add_composite_index_task(const std::vector<std::string> &field_names,
+                                               const std::vector<double> &bucket_sizes,
+                                               optional<management_exception> &ex) {
+  std::string name;
+  try {
+    name = composite_index_name(field_names);
+  } catch (management_exception &e) {
+    ex = management_exception("Could not add composite index: " + std::string(e.what()));
+    return;
+  }
+
+  if (field_names.size() < 2) {
+    ex = management_exception("Could not index " + name + ": composite index requires at least two fields");
+    return;
+  }
+  if (!bucket_sizes.empty() && bucket_sizes.size() != field_names.size()) {
+    ex = management_exception("Could not index " + name + ": expected one bucket size per field");
+    return;
+  }
+  if (find_composite_index(name) != nullptr) {
+    ex = management_exception("Could not index " + name + ": already indexed/indexing");
+    return;
+  }
+
+  std::vector<uint16_t> fields;
+  std::vector<size_t> key_sizes;
+  std::vector<double> buckets;
+  for (size_t i = 0; i < field_names.size(); i++) {
+    const column_t &col = schema_[schema_.get_field_index(field_names[i])];
+    if (!col.type().is_valid()) {
+      ex = management_exception("Index not supported for field type");
+      return;
+    }
+    fields.push_back(col.idx());
+    key_sizes.push_back(col.type().size);
+    buckets.push_back(bucket_sizes.empty() ? configuration_params::INDEX_BUCKET_SIZE() : bucket_sizes[i]);
+  }
+
+  composite_index_t *c = new composite_index_t(name, fields, key_sizes, buckets);
+  c->set_indexing();
+  uint16_t index_id = static_cast<uint16_t>(indexes_.push_back(new radix_index(c->key_size(), 256)));
+  c->set_backfilling(index_id);
+  composite_indexes_.push_back(c);
+  // Same protocol as single-column indexes; see add_index_task
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  uint64_t boundary = data_log_.size();
+  c->set_backfill_boundary(boundary);
+  if (boundary == 0) {
+    c->finish_backfill();
+  } else {
+    radix_index *index = indexes_.at(index_id);
+    backfill_task *task = start_backfill(
+        name_ + "/index/" + name, boundary,
+        [index, c](const record_t &r) {
+          index->insert(c->get_key(r), r.log_offset());
+        },
+        [c] {
+          c->finish_backfill();
+        });
+    std::lock_guard<std::mutex> lock(backfill_mtx_);
+    index_backfills_[name].reset(task);
+  }
+  metadata_.write_composite_index_metadata(field_names, buckets);
+}
+
+void atomic_multilog::remove_composite_index_task(const std::vector<std::string> &field_names,
+                                                  optional<management_exception> &ex) {
+  std::string name;
+  try {
+    name = composite_index_name(field_names);
+  } catch (management_exception &e) {
+    ex = management_exception("Could not remove composite index: " + std::string(e.what()));
+    return;
+  }
+
+  composite_index_t *c = find_composite_index(name);
+  if (c == nullptr || !c->disable_indexing()) {
+    ex = management_exception("Could not remove index for " + name + ": No index exists");
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(backfill_mtx_);
+  auto it = index_backfills_.find(name);
+  if (it != index_backfills_.end())
+    it->second->cancel();
+}
+
+std::string atomic_multilog::composite_index_name(const std::vector<std::string> &field_names) const {
+  std::string name;
+  for (size_t i = 0; i < field_names.size(); i++) {
+    size_t idx;
+    try {
+      idx = schema_.get_field_index(field_names[i]);
+    } catch (std::exception &e) {
+      THROW(management_exception, "Field " + field_names[i] + " does not exist");
+    }
+    name += (i == 0 ? "" : ",") + schema_[idx].name();
+  }
+  return name;
+}
+
+composite_index_t *atomic_multilog::find_composite_index(const std::string &name) const {
+  size_t ncomposites = composite_indexes_.size();
+  for (size_t i = 0; i < ncomposites; i++) {
+    composite_index_t *c = composite_indexes_.at(i);
+    if (c->is_indexed() && c->name() == name)
+      return c;
+  }
+  return nullptr;
 }
 
 void atomic_multilog::add_filter_task(const std::string &name,
@@ -514,7 +1081,29 @@ void atomic_multilog::add_filter_task(const std::string &name,
   }
   auto t = parser::parse_expression(expr);
   auto cexpr = parser::compile_expression(t, schema_);
-  filter_id = filters_.push_back(new filter(cexpr, default_filter));
+  filter *f = new filter(cexpr, default_filter);
+  f->set_alert_index(&alerts_);
+  f->begin_backfill();
+  filter_id = filters_.push_back(f);
+  // Writers that reserve log space after the fence see the filter and
+  // add their own records; all records before the tail are backfilled.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  uint64_t boundary = data_log_.size();
+  f->set_backfill_boundary(boundary);
+  if (boundary == 0) {
+    f->finish_backfill();
+  } else {
+    backfill_task *task = start_backfill(
+        name_ + "/filter/" + name, boundary,
+        [f](const record_t &r) {
+          f->backfill(r);
+        },
+        [f] {
+          f->finish_backfill();
+        });
+    std::lock_guard<std::mutex> lock(backfill_mtx_);
+    filter_backfills_[name].reset(task);
+  }
   metadata_.write_filter_metadata(name, expr);
   if (filter_map_.put(name, filter_id) == -1) {
     ex = management_exception("Could not add filter " + name + " to filter map.");
@@ -528,12 +1117,34 @@ void atomic_multilog::remove_filter_task(const std::string &name, optional<manag
     ex = management_exception("Filter " + name + " does not exist.");
     return;
   }
-  bool success = filters_.at(filter_id)->invalidate();
+  filter *f = filters_.at(filter_id);
+  bool success = f->invalidate();
   if (!success) {
     ex = management_exception("Filter already invalidated.");
     return;
   }
   filter_map_.remove(name, filter_id);
+
+  // Polled triggers and views on the filter can no longer be evaluated
+  size_t unmonitored = 0;
+  size_t naggs = f->num_aggregates();
+  for (size_t aid = 0; aid < naggs; aid++) {
+    aggregate_info *a = f->get_aggregate_info(aid);
+    if (a->is_valid())
+      unmonitored += num_polled_triggers(a);
+  }
+  size_t nviews = views_.size();
+  for (size_t i = 0; i < nviews; i++) {
+    materialized_view *v = views_.at(i);
+    if (v->is_valid() && v->filter_id() == filter_id)
+      unmonitored++;
+  }
+  atomic::fas(&num_monitored_, unmonitored);
+
+  std::lock_guard<std::mutex> lock(backfill_mtx_);
+  auto it = filter_backfills_.find(name);
+  if (it != filter_backfills_.end())
+    it->second->cancel();
 }
 
 void atomic_multilog::add_aggregate_task(const std::string &name,
@@ -553,7 +1164,8 @@ void atomic_multilog::add_aggregate_task(const std::string &name,
   aggregate_id.filter_idx = filter_id;
   auto pa = parser::parse_aggregate(expr);
   const column_t &col = schema_[pa.field_name];
-  aggregate_info *a = new aggregate_info(name, aggregate_manager::get_aggregator(pa.agg), col.idx());
+  aggregate_info *a = new aggregate_info(name, aggregate_manager::get_aggregator(pa.agg), col.idx(), col.type(),
+                                         col.offset());
   aggregate_id.aggregate_idx = filters_.at(filter_id)->add_aggregate(a);
   if (aggregate_map_.put(name, aggregate_id) == -1) {
     ex = management_exception("Could not add trigger " + filter_name + " to trigger map.");
@@ -568,17 +1180,33 @@ void atomic_multilog::remove_aggregate_task(const std::string &name, optional<ma
     ex = management_exception("Aggregate " + name + " does not exist.");
     return;
   }
-  bool success = filters_.at(aggregate_id.filter_idx)->remove_aggregate(aggregate_id.aggregate_idx);
+  filter *f = filters_.at(aggregate_id.filter_idx);
+  bool success = f->remove_aggregate(aggregate_id.aggregate_idx);
   if (!success) {
     ex = management_exception("Aggregate already invalidated.");
     return;
   }
   aggregate_map_.remove(name, aggregate_id);
+  // Polled triggers on the aggregate can no longer be evaluated
+  if (f->is_valid())
+    atomic::fas(&num_monitored_, num_polled_triggers(f->get_aggregate_info(aggregate_id.aggregate_idx)));
+}
+
+size_t atomic_multilog::num_polled_triggers(aggregate_info *a) {
+  size_t n = 0;
+  size_t ntriggers = a->num_triggers();
+  for (size_t tid = 0; tid < ntriggers; tid++) {
+    trigger *t = a->get_trigger(tid);
+    if (t->is_valid() && t->mode() == POLLED_TRIGGER)
+      n++;
+  }
+  return n;
 }
 
 void atomic_multilog::add_trigger_task(const std::string &name,
                                        const std::string &expr,
                                        uint64_t periodicity_ms,
+                                       trigger_mode_t mode,
                                        optional<management_exception> &ex) {
   trigger_id_t trigger_id;
   if (trigger_map_.get(name, trigger_id) != -1) {
@@ -595,14 +1223,17 @@ void atomic_multilog::add_trigger_task(const std::string &name,
   }
   trigger_id.aggregate_id = aggregate_id;
   aggregate_info *a = filters_.at(aggregate_id.filter_idx)->get_aggregate_info(aggregate_id.aggregate_idx);
-  trigger *t =
-      new trigger(name, aggregate_name, relop_utils::str_to_op(pt.relop), a->value(pt.threshold), periodicity_ms);
+  trigger *t = new trigger(name, aggregate_name, relop_utils::str_to_op(pt.relop), a->value(pt.threshold),
+                           periodicity_ms, mode);
+  t->set_alert_id(alerts_.add_trigger(t->name(), t->expr()));
   trigger_id.trigger_idx = a->add_trigger(t);
   if (trigger_map_.put(name, trigger_id) == -1) {
     ex = management_exception("Could not add trigger " + name + " to trigger map.");
     return;
   }
-  metadata_.write_trigger_metadata(name, expr, periodicity_ms);
+  if (mode == POLLED_TRIGGER)
+    add_monitored(periodicity_ms);
+  metadata_.write_trigger_metadata(name, expr, periodicity_ms, mode);
 }
 
 void atomic_multilog::remove_trigger_task(const std::string &name, optional<management_exception> &ex) {
@@ -614,28 +1245,108 @@ void atomic_multilog::remove_trigger_task(const std::string &name, optional<mana
   size_t fid = trigger_id.aggregate_id.filter_idx;
   size_t aid = trigger_id.aggregate_id.aggregate_idx;
   size_t tid = trigger_id.trigger_idx;
-  bool success = filters_.at(fid)->get_aggregate_info(aid)->remove_trigger(tid);
+  aggregate_info *a = filters_.at(fid)->get_aggregate_info(aid);
+  bool success = a->remove_trigger(tid);
   if (!success) {
     ex = management_exception("Trigger already invalidated.");
     return;
   }
   trigger_map_.remove(name, trigger_id);
+  // Triggers on a removed filter or aggregate were unregistered with it
+  if (a->get_trigger(tid)->mode() == POLLED_TRIGGER && filters_.at(fid)->is_valid() && a->is_valid())
+    atomic::fas(&num_monitored_, static_cast<size_t>(1));
+}
+
+void atomic_multilog::add_view_task(const std::string &name,
+                                    const std::string &filter_name,
+                                    const std::string &group_by,
+                                    const std::vector<std::string> &aggregate_exprs,
+                                    uint64_t window_ms,
+                                    atomic_multilog *target,
+                                    optional<management_exception> &ex) {
+  size_t view_id;
+  if (view_map_.get(name, view_id) != -1) {
+    ex = management_exception("View " + name + " already exists.");
+    return;
+  }
+  filter_id_t filter_id;
+  if (filter_map_.get(filter_name, filter_id) == -1) {
+    ex = management_exception("Filter " + filter_name + " does not exist.");
+    return;
+  }
+  if (target == nullptr || target == this) {
+    ex = management_exception("View " + name + " must target a different atomic multilog.");
+    return;
+  }
+  if (window_ms == 0) {
+    ex = management_exception("View window must be non-zero.");
+    return;
+  }
+  // Materialization starts at the window the view is added in
+  uint64_t begin_ms = (time_utils::cur_ms() / window_ms) * window_ms;
+  materialized_view *v;
+  try {
+    v = new materialized_view(name, filter_id, schema_, group_by, aggregate_exprs, window_ms, begin_ms, target);
+  } catch (std::exception &e) {
+    ex = management_exception("Could not add view " + name + ": " + e.what());
+    return;
+  }
+  view_id = views_.push_back(v);
+  if (view_map_.put(name, view_id) == -1) {
+    ex = management_exception("Could not add view " + name + " to view map.");
+    return;
+  }
+  add_monitored(window_ms);
+}
+
+void atomic_multilog::remove_view_task(const std::string &name, optional<management_exception> &ex) {
+  size_t view_id;
+  if (view_map_.get(name, view_id) == -1) {
+    ex = management_exception("View " + name + " does not exist.");
+    return;
+  }
+  materialized_view *v = views_.at(view_id);
+  bool success = v->invalidate();
+  if (!success) {
+    ex = management_exception("View already invalidated.");
+    return;
+  }
+  view_map_.remove(name, view_id);
+  // Views on a removed filter were unregistered with it
+  if (filters_.at(v->filter_id())->is_valid())
+    atomic::fas(&num_monitored_, static_cast<size_t>(1));
 }
 
 void atomic_multilog::archival_task() {
-  optional<management_exception> ex;
-  std::future<void> ret = archival_pool_.submit([this] {
-    if (rt_.get() > archival_configuration_params::IN_MEMORY_DATALOG_WINDOW_BYTES())
-      archiver_.archive(rt_.get() - archival_configuration_params::IN_MEMORY_DATALOG_WINDOW_BYTES());
-  });
-  ret.wait();
-  if (ex.has_value())
-    throw ex.value();
+  uint64_t tail = rt_.get();
+  uint64_t window = archival_configuration_params::IN_MEMORY_DATALOG_WINDOW_BYTES();
+  if (tail <= window)
+    return;
+  std::lock_guard<std::mutex> lk(archival_mtx_);
+  if (tail - window <= archived_tail_)
+    return;
+  archiver_.archive(tail - window);
+  archived_tail_ = tail - window;
 }
 
 void atomic_multilog::monitor_task() {
-  uint64_t cur_ms = time_utils::cur_ms();
   uint64_t version = rt_.get();
+  size_t num_monitored = atomic::load(&num_monitored_);
+  drain_alerts();
+  if (num_monitored == 0) {
+    park_monitor(version, num_monitored);
+    return;
+  }
+  uint64_t cur_ms = time_utils::cur_ms();
+  if (version != monitored_tail_) {
+    monitored_tail_ = version;
+    monitored_tail_ms_ = cur_ms;
+  } else if (cur_ms > monitored_tail_ms_ + atomic::load(&monitor_horizon_ms_)
+      + configuration_params::MONITOR_WINDOW_MS()) {
+    // Every window that can hold the last records has been evaluated
+    park_monitor(version, num_monitored);
+    return;
+  }
   size_t nfilters = filters_.size();
   for (size_t i = 0; i < nfilters; i++) {
     filter *f = filters_.at(i);
@@ -647,7 +1358,7 @@ void atomic_multilog::monitor_task() {
           size_t ntriggers = a->num_triggers();
           for (size_t tid = 0; tid < ntriggers; tid++) {
             trigger *t = a->get_trigger(tid);
-            if (t->is_valid()) {
+            if (t->is_valid() && t->mode() == POLLED_TRIGGER) {
               for (uint64_t ms = cur_ms - configuration_params::MONITOR_WINDOW_MS(); ms <= cur_ms; ms++) {
                 if (ms % t->periodicity_ms() == 0) {
                   check_time_bucket(f, t, tid, ms, version);
@@ -659,6 +1370,41 @@ void atomic_multilog::monitor_task() {
       }
     }
   }
+  materialize_views(cur_ms, version);
+}
+
+void atomic_multilog::park_monitor(uint64_t version, size_t num_monitored) {
+  // Park before publishing the flag, so that a wake issued once the flag
+  // is seen always finds the task parked
+  monitor_task_.park();
+  atomic::store(&monitor_parked_, true);
+  // Appends and management tasks change their state before they check
+  // the flag, so a change missed by both sides shows up here; the fence
+  // orders the loads below after the store of the flag
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (rt_.get() != version || atomic::load(&num_monitored_) != num_monitored || alerts_.has_queued())
+    wake_monitor();
+}
+
+void atomic_multilog::wake_monitor() {
+  bool expected = true;
+  if (atomic::strong::cas(&monitor_parked_, &expected, false))
+    monitor_task_.wake();
+}
+
+void atomic_multilog::add_monitored(uint64_t window_ms) {
+  if (window_ms > atomic::load(&monitor_horizon_ms_))
+    atomic::store(&monitor_horizon_ms_, window_ms);
+  atomic::faa(&num_monitored_, static_cast<size_t>(1));
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  wake_monitor();
+}
+
+void atomic_multilog::drain_alerts() const {
+  if (!alerts_.has_queued())
+    return;
+  std::lock_guard<std::mutex> lk(alerts_mtx_);
+  alerts_.drain();
 }
 
 void atomic_multilog::check_time_bucket(filter *f, trigger *t, size_t tid, uint64_t time_bucket, uint64_t version) {
@@ -668,10 +1414,71 @@ void atomic_multilog::check_time_bucket(filter *f, trigger *t, size_t tid, uint6
     if (ar != nullptr) {
       numeric agg = ar->get_aggregate(tid, version);
       if (numeric::relop(t->op(), agg, t->threshold())) {
-        alerts_.add_alert(ms, t->name(), t->expr(), agg, version);
+        std::lock_guard<std::mutex> lk(alerts_mtx_);
+        alerts_.add_alert(ms, t->alert_id(), agg, version);
       }
     }
   }
 }
 
-}
\ No newline at end of file
+void atomic_multilog::materialize_views(uint64_t cur_ms, uint64_t version) {
+  // Records may be stamped slightly in the past, so windows are only
+  // materialized once they are older than the monitor window
+  size_t nviews = views_.size();
+  bool registered = false;
+  for (size_t i = 0; i < nviews; i++) {
+    materialized_view *v = views_.at(i);
+    if (!v->is_valid())
+      continue;
+    filter *f = filters_.at(v->filter_id());
+    if (!f->is_valid())
+      continue;
+    while (v->next_window_ms() + v->window_ms() + configuration_params::MONITOR_WINDOW_MS() <= cur_ms) {
+      // Appends to the target update its filters, which need a thread id
+      if (!registered && thread_manager::get_id() == -1) {
+        thread_manager::register_thread();
+        registered = true;
+      }
+      uint64_t begin = v->next_window_ms();
+      auto res = f->lookup_range(begin, begin + v->window_ms() - 1);
+      std::unique_ptr<offset_cursor> o_cursor(
+          new offset_iterator_cursor<filter::range_result::iterator>(res.begin(), res.end(), version));
+      filter_record_cursor r_cursor(std::move(o_cursor), &data_log_, &schema_, parser::compiled_expression());
+      v->materialize(r_cursor);
+    }
+  }
+  if (registered)
+    thread_manager::deregister_thread();
+}
+
+backfill_task *atomic_multilog::start_backfill(const std::string &name,
+                                               uint64_t boundary,
+                                               std::function<void(const record_t &)> update,
+                                               backfill_task::done_fn on_done) {
+  backfill_task *task = new backfill_task(name, boundary, schema_.record_size());
+  task->start([this, update](uint64_t begin, uint64_t end) {
+                backfill_records(begin, end, update);
+              },
+              on_done,
+              configuration_params::BACKFILL_CONCURRENCY(),
+              configuration_params::BACKFILL_CHUNK_RECORDS());
+  return task;
+}
+
+void atomic_multilog::backfill_records(uint64_t begin,
+                                       uint64_t end,
+                                       const std::function<void(const record_t &)> &update) const {
+  // Records below the boundary may still be in the middle of being written
+  while (rt_.get() < end) {
+    std::this_thread::yield();
+  }
+
+  size_t record_size = schema_.record_size();
+  std::unique_ptr<uint8_t[]> buf(new uint8_t[end - begin]);
+  data_log_.read(begin, buf.get(), end - begin);
+  for (uint64_t off = begin; off < end; off += record_size) {
+    update(schema_.apply_unsafe(off, buf.get() + (off - begin)));
+  }
+}
+
+}
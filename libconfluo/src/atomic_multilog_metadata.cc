@@ -12,6 +12,17 @@ std::string index_metadata::field_name() const {
 double index_metadata::bucket_size() const {
   return bucket_size_;
 }
+composite_index_metadata::composite_index_metadata(const std::vector<std::string> &field_names,
+                                                   const std::vector<double> &bucket_sizes)
+    : field_names_(field_names),
+      bucket_sizes_(bucket_sizes) {
+}
+const std::vector<std::string> &composite_index_metadata::field_names() const {
+  return field_names_;
+}
+const std::vector<double> &composite_index_metadata::bucket_sizes() const {
+  return bucket_sizes_;
+}
 filter_metadata::filter_metadata(const std::string &filter_name, const std::string &expr)
     : filter_name_(filter_name),
       expr_(expr) {
@@ -91,6 +102,15 @@ void metadata_writer::write_archival_mode(const archival::archival_mode mode) {
     io_utils::flush(out_);
   }
 }
+void metadata_writer::write_data_log_geometry(const monolog::bucket_geometry &geometry) {
+  if (state_) {
+    metadata_type type = metadata_type::D_DATA_LOG_METADATA;
+    io_utils::write(out_, type);
+    io_utils::write(out_, geometry.first_bucket_size());
+    io_utils::write(out_, geometry.max_bucket_size());
+    io_utils::flush(out_);
+  }
+}
 void metadata_writer::write_schema(const schema_t &schema) {
   if (state_) {
     metadata_type type = metadata_type::D_SCHEMA_METADATA;
@@ -103,15 +123,29 @@ void metadata_writer::write_schema(const schema_t &schema) {
     io_utils::flush(out_);
   }
 }
-void metadata_writer::write_index_metadata(const std::string &name, double bucket_size) {
+void metadata_writer::write_index_metadata(const std::string &name, double bucket_size, index_type_t index_type) {
   if (state_) {
-    metadata_type type = metadata_type::D_INDEX_METADATA;
+    metadata_type type = index_type == HASH_INDEX ? metadata_type::D_HASH_INDEX_METADATA
+                                                  : metadata_type::D_INDEX_METADATA;
     io_utils::write(out_, type);
     io_utils::write(out_, name);
     io_utils::write(out_, bucket_size);
     io_utils::flush(out_);
   }
 }
+void metadata_writer::write_composite_index_metadata(const std::vector<std::string> &field_names,
+                                                     const std::vector<double> &bucket_sizes) {
+  if (state_) {
+    metadata_type type = metadata_type::D_COMPOSITE_INDEX_METADATA;
+    io_utils::write(out_, type);
+    io_utils::write(out_, field_names.size());
+    for (size_t i = 0; i < field_names.size(); i++) {
+      io_utils::write(out_, field_names[i]);
+      io_utils::write(out_, bucket_sizes[i]);
+    }
+    io_utils::flush(out_);
+  }
+}
 void metadata_writer::write_filter_metadata(const std::string &name, const std::string &expr) {
   if (state_) {
     metadata_type type = metadata_type::D_FILTER_METADATA;
@@ -135,9 +169,11 @@ void metadata_writer::write_aggregate_metadata(const std::string &name,
 }
 void metadata_writer::write_trigger_metadata(const std::string &trigger_name,
                                              const std::string &trigger_expr,
-                                             const uint64_t periodicity_ms) {
+                                             const uint64_t periodicity_ms,
+                                             monitor::trigger_mode_t mode) {
   if (filename_ != "/metadata") {
-    metadata_type type = metadata_type::D_TRIGGER_METADATA;
+    metadata_type type = mode == monitor::EAGER_TRIGGER ? metadata_type::D_EAGER_TRIGGER_METADATA
+                                                        : metadata_type::D_TRIGGER_METADATA;
     io_utils::write(out_, type);
     io_utils::write(out_, trigger_name);
     io_utils::write(out_, trigger_expr);
@@ -170,6 +206,16 @@ index_metadata metadata_reader::next_index_metadata() {
   double bucket_size = io_utils::read<double>(in_);
   return index_metadata(field_name, bucket_size);
 }
+composite_index_metadata metadata_reader::next_composite_index_metadata() {
+  size_t nfields = io_utils::read<size_t>(in_);
+  std::vector<std::string> field_names;
+  std::vector<double> bucket_sizes;
+  for (size_t i = 0; i < nfields; i++) {
+    field_names.push_back(io_utils::read<std::string>(in_));
+    bucket_sizes.push_back(io_utils::read<double>(in_));
+  }
+  return composite_index_metadata(field_names, bucket_sizes);
+}
 filter_metadata metadata_reader::next_filter_metadata() {
   std::string filter_name = io_utils::read<std::string>(in_);
   std::string expr = io_utils::read<std::string>(in_);
@@ -193,4 +239,9 @@ storage::storage_mode metadata_reader::next_storage_mode() {
 archival::archival_mode metadata_reader::next_archival_mode() {
   return io_utils::read<archival::archival_mode>(in_);
 }
+monolog::bucket_geometry metadata_reader::next_data_log_geometry() {
+  size_t first_bucket_size = io_utils::read<size_t>(in_);
+  size_t max_bucket_size = io_utils::read<size_t>(in_);
+  return monolog::bucket_geometry(first_bucket_size, max_bucket_size);
+}
 }
\ No newline at end of file
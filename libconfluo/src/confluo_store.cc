@@ -3,7 +3,8 @@
 namespace confluo {
 
 confluo_store::confluo_store(const std::string &data_path)
-    : data_path_(utils::file_utils::full_path(data_path)) {
+    : data_path_(utils::file_utils::full_path(data_path)),
+      shm_ingest_capacity_(ingest::shm_ingest::DEFAULT_CAPACITY) {
   utils::file_utils::create_dir(data_path_);
   // Note that this assumes a one-to-one relationship between the confluo_store and allocator
   allocator::instance().register_cleanup_callback(std::bind(&confluo_store::memory_management_callback, this));
@@ -75,6 +76,10 @@ int64_t confluo_store::remove_atomic_multilog(const std::string &name) {
   if (multilog_map_.get(name, id) == -1) {
     throw management_exception("No such atomic multilog " + name);
   }
+  {
+    std::lock_guard<std::mutex> lock(shm_ingest_mtx_);
+    shm_ingests_.erase(name);
+  }
   return multilog_map_.remove(name, id);
 }
 
@@ -82,6 +87,68 @@ int64_t confluo_store::remove_atomic_multilog(int64_t id) {
   return remove_atomic_multilog(get_atomic_multilog(id)->get_name());
 }
 
+int64_t confluo_store::create_materialized_view(const std::string &name,
+                                                const std::string &source,
+                                                const std::string &filter_name,
+                                                const std::string &group_by,
+                                                const std::vector<std::string> &aggregate_exprs,
+                                                uint64_t window_ms,
+                                                const storage::storage_mode mode) {
+  atomic_multilog *src = get_atomic_multilog(source);
+  std::vector<column_t> schema;
+  try {
+    schema = materialized_view::output_schema(src->get_schema(), group_by, aggregate_exprs);
+  } catch (std::exception &e) {
+    throw management_exception("Could not create view " + name + ": " + e.what());
+  }
+  int64_t id = create_atomic_multilog(name, schema, mode, archival_mode::OFF);
+  try {
+    src->add_materialized_view(name, filter_name, group_by, aggregate_exprs, window_ms, get_atomic_multilog(id));
+  } catch (management_exception &e) {
+    remove_atomic_multilog(name);
+    throw;
+  }
+  return id;
+}
+
+void confluo_store::enable_shm_ingest(const std::string &dir, size_t capacity) {
+  utils::file_utils::create_dir(dir);
+  {
+    std::lock_guard<std::mutex> lock(shm_ingest_mtx_);
+    shm_ingest_dir_ = utils::file_utils::full_path(dir);
+    shm_ingest_capacity_ = capacity;
+  }
+  for (size_t id = 0; id < atomic_multilogs_.size(); id++) {
+    atomic_multilog *mlog = atomic_multilogs_.get(id);
+    size_t mapped_id;
+    if (multilog_map_.get(mlog->get_name(), mapped_id) != -1 && mapped_id == id)
+      start_shm_ingest(mlog);
+  }
+}
+
+std::string confluo_store::get_shm_ingest_path(const std::string &name) const {
+  std::lock_guard<std::mutex> lock(shm_ingest_mtx_);
+  auto it = shm_ingests_.find(name);
+  if (it == shm_ingests_.end()) {
+    throw management_exception("No shared-memory ring for atomic multilog " + name);
+  }
+  return it->second->path();
+}
+
+void confluo_store::start_shm_ingest(atomic_multilog *mlog) {
+  std::lock_guard<std::mutex> lock(shm_ingest_mtx_);
+  if (shm_ingest_dir_.empty() || shm_ingests_.find(mlog->get_name()) != shm_ingests_.end())
+    return;
+  if (mlog->get_schema().has_var_columns()) {
+    LOG_WARN << "Not creating shared-memory ring for " << mlog->get_name() << ": schema has variable-length columns";
+    return;
+  }
+  std::unique_ptr<ingest::shm_ingest> in(new ingest::shm_ingest(mlog, shm_ingest_dir_ + "/" + mlog->get_name(),
+                                                                shm_ingest_capacity_));
+  in->start();
+  shm_ingests_[mlog->get_name()] = std::move(in);
+}
+
 void confluo_store::memory_management_task() {
   if (allocator::instance().memory_utilization() >= configuration_params::MAX_MEMORY()) {
     for (size_t id = 0; id < atomic_multilogs_.size(); id++) {
@@ -117,6 +184,7 @@ int64_t confluo_store::create_atomic_multilog_task(const std::string &name,
     ex = management_exception("Could not add atomic multilog " + name + " to atomic multilog map");
     return INT64_C(-1);
   }
+  start_shm_ingest(t);
   return static_cast<int64_t>(id);
 }
 
@@ -138,6 +206,7 @@ int64_t confluo_store::create_atomic_multilog_task(const std::string &name,
     ex = management_exception("Could not add atomic multilog " + name + " to atomic multilog map");
     return INT64_C(-1);
   }
+  start_shm_ingest(t);
   return static_cast<int64_t>(id);
 }
 
@@ -153,6 +222,7 @@ int64_t confluo_store::load_atomic_multilog_task(const std::string &name, option
     ex = management_exception("Could not add atomic multilog " + name + " to atomic multilog map");
     return INT64_C(-1);
   }
+  start_shm_ingest(t);
   return static_cast<int64_t>(id);
 }
 
@@ -2,25 +2,34 @@
 
 namespace confluo {
 
-trigger_alert_cursor::trigger_alert_cursor(const trigger_alert_cursor::alert_list &alerts,
-                                           const std::string &trigger_name,
+trigger_alert_cursor::trigger_alert_cursor(const monitor::alert_index *index,
+                                           std::vector<trigger_alert_cursor::alert_list> &&alerts,
                                            size_t batch_size)
     : alert_cursor(batch_size),
-      cur_(alerts.begin()),
-      end_(alerts.end()),
-      trigger_name_(trigger_name) {
+      index_(index),
+      alerts_(std::move(alerts)),
+      cur_list_(0) {
+  if (!alerts_.empty()) {
+    cur_ = alerts_[0].begin();
+    end_ = alerts_[0].end();
+  }
   init();
 }
 
 size_t trigger_alert_cursor::load_next_batch() {
   size_t i = 0;
-  for (; i < current_batch_.size() && cur_ != end_; ++i, ++cur_) {
-    current_batch_[i] = *cur_;
-    if (trigger_name_ != "" && trigger_name_ != current_batch_[i].trigger_name) {
-      --i;
+  while (i < current_batch_.size() && cur_list_ < alerts_.size()) {
+    if (cur_ == end_) {
+      if (++cur_list_ < alerts_.size()) {
+        cur_ = alerts_[cur_list_].begin();
+        end_ = alerts_[cur_list_].end();
+      }
+      continue;
     }
+    current_batch_[i++] = index_->to_alert(*cur_);
+    ++cur_;
   }
   return i;
 }
 
-}
\ No newline at end of file
+}
@@ -18,4 +18,26 @@ size_t data_log_cursor::load_next_batch() {
   return i;
 }
 
-}
\ No newline at end of file
+union_offset_cursor::union_offset_cursor(std::vector<std::unique_ptr<offset_cursor>> &&cursors,
+                                         size_t batch_size)
+    : offset_cursor(batch_size),
+      cursors_(std::move(cursors)),
+      cur_(0) {
+  init();
+}
+
+size_t union_offset_cursor::load_next_batch() {
+  size_t i = 0;
+  while (i < current_batch_.size() && cur_ < cursors_.size()) {
+    offset_cursor &cursor = *cursors_[cur_];
+    if (!cursor.has_more()) {
+      cur_++;
+      continue;
+    }
+    current_batch_[i++] = cursor.get();
+    cursor.advance();
+  }
+  return i;
+}
+
+}
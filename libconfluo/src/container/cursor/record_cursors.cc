@@ -26,6 +26,28 @@ std::unique_ptr<record_cursor> make_distinct(std::unique_ptr<record_cursor> r_cu
   return std::unique_ptr<record_cursor>(new distinct_record_cursor(std::move(r_cursor), batch_size));
 }
 
+offset_record_cursor::offset_record_cursor(std::unique_ptr<offset_cursor> o_cursor,
+                                           const data_log *dlog,
+                                           const schema_t *schema,
+                                           size_t batch_size)
+    : record_cursor(batch_size),
+      o_cursor_(std::move(o_cursor)),
+      dlog_(dlog),
+      schema_(schema) {
+  init();
+}
+
+size_t offset_record_cursor::load_next_batch() {
+  size_t i = 0;
+  for (; i < current_batch_.size() && o_cursor_->has_more(); ++i, o_cursor_->advance()) {
+    uint64_t o = o_cursor_->get();
+    read_only_data_log_ptr ptr;
+    dlog_->cptr(o, ptr);
+    current_batch_[i] = schema_->apply(o, ptr);
+  }
+  return i;
+}
+
 filter_record_cursor::filter_record_cursor(std::unique_ptr<offset_cursor> o_cursor,
                                            const data_log *dlog,
                                            const schema_t *schema,
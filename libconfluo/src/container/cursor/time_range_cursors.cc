@@ -0,0 +1,171 @@
+#include "container/cursor/time_range_cursors.h"
+
+#include <algorithm>
+
+#include "types/mutable_value.h"
+
+namespace confluo {
+
+uint64_t record_timestamp(const data_log *dlog, uint64_t offset) {
+  // The timestamp is always the first column of the record
+  uint64_t ts;
+  dlog->read(offset, reinterpret_cast<uint8_t *>(&ts), sizeof(uint64_t));
+  return ts;
+}
+
+data_log_range_cursor::data_log_range_cursor(uint64_t begin,
+                                             uint64_t end,
+                                             uint64_t record_size,
+                                             bool reverse,
+                                             size_t batch_size)
+    : offset_cursor(batch_size),
+      begin_(begin),
+      end_(end),
+      record_size_(record_size),
+      reverse_(reverse) {
+  init();
+}
+
+size_t data_log_range_cursor::load_next_batch() {
+  size_t i = 0;
+  if (reverse_) {
+    for (; i < current_batch_.size() && end_ > begin_; i++) {
+      end_ -= record_size_;
+      current_batch_[i] = end_;
+    }
+  } else {
+    for (; i < current_batch_.size() && begin_ < end_; i++, begin_ += record_size_) {
+      current_batch_[i] = begin_;
+    }
+  }
+  return i;
+}
+
+time_scan_cursor::time_scan_cursor(const data_log *dlog,
+                                   uint64_t record_size,
+                                   uint64_t begin_ts,
+                                   uint64_t end_ts,
+                                   uint64_t version,
+                                   bool reverse,
+                                   size_t batch_size)
+    : offset_cursor(batch_size),
+      dlog_(dlog),
+      record_size_(record_size),
+      begin_ts_(begin_ts),
+      end_ts_(end_ts),
+      version_(version),
+      reverse_(reverse),
+      started_(false),
+      done_(false),
+      last_(0, 0) {
+  heap_.reserve(batch_size);
+  init();
+}
+
+bool time_scan_cursor::before(const entry_t &a, const entry_t &b) const {
+  return reverse_ ? a > b : a < b;
+}
+
+size_t time_scan_cursor::load_next_batch() {
+  if (done_)
+    return 0;
+
+  // Keep the batch_size earliest entries past the previous batch in a heap
+  // whose top is the latest of them
+  size_t limit = current_batch_.size();
+  auto cmp = [this](const entry_t &a, const entry_t &b) {
+    return before(a, b);
+  };
+  heap_.clear();
+  for (uint64_t o = 0; o < version_; o += record_size_) {
+    uint64_t ts = record_timestamp(dlog_, o);
+    if (ts < begin_ts_ || ts > end_ts_)
+      continue;
+    entry_t e(ts, o);
+    if (started_ && !before(last_, e))
+      continue;
+    if (heap_.size() < limit) {
+      heap_.push_back(e);
+      std::push_heap(heap_.begin(), heap_.end(), cmp);
+    } else if (before(e, heap_.front())) {
+      std::pop_heap(heap_.begin(), heap_.end(), cmp);
+      heap_.back() = e;
+      std::push_heap(heap_.begin(), heap_.end(), cmp);
+    }
+  }
+
+  // A short batch means no entries remain past it
+  done_ = heap_.size() < limit;
+  std::sort_heap(heap_.begin(), heap_.end(), cmp);
+  for (size_t i = 0; i < heap_.size(); i++)
+    current_batch_[i] = heap_[i].second;
+  if (!heap_.empty()) {
+    last_ = heap_.back();
+    started_ = true;
+  }
+  return heap_.size();
+}
+
+time_index_cursor::time_index_cursor(const index::radix_index *idx,
+                                     double bucket_size,
+                                     const data_log *dlog,
+                                     uint64_t begin_ts,
+                                     uint64_t end_ts,
+                                     uint64_t version,
+                                     bool reverse,
+                                     size_t batch_size)
+    : offset_cursor(batch_size),
+      dlog_(dlog),
+      begin_ts_(begin_ts),
+      end_ts_(end_ts),
+      version_(version),
+      reverse_(reverse),
+      begin_key_(mutable_value(primitive_types::ULONG_TYPE(), &begin_ts).to_key(bucket_size)),
+      end_key_(mutable_value(primitive_types::ULONG_TYPE(), &end_ts).to_key(bucket_size)),
+      it_(reverse ? idx->lower_bound(end_key_) : idx->upper_bound(begin_key_)),
+      bucket_pos_(0) {
+  init();
+}
+
+size_t time_index_cursor::load_next_batch() {
+  size_t i = 0;
+  while (i < current_batch_.size()) {
+    if (bucket_pos_ == bucket_.size() && !load_next_bucket())
+      break;
+    current_batch_[i++] = bucket_[bucket_pos_++].second;
+  }
+  return i;
+}
+
+bool time_index_cursor::load_next_bucket() {
+  bucket_.clear();
+  bucket_pos_ = 0;
+  while (bucket_.empty()) {
+    if (it_.node() == nullptr)
+      return false;
+    if (reverse_ ? it_.key() < begin_key_ : it_.key() > end_key_) {
+      it_.set_node(nullptr);
+      return false;
+    }
+    const reflog &refs = *it_;
+    size_t n = refs.size();
+    for (size_t j = 0; j < n; j++) {
+      uint64_t offset = refs.at(j);
+      if (offset >= version_)
+        continue;
+      uint64_t ts = record_timestamp(dlog_, offset);
+      if (ts >= begin_ts_ && ts <= end_ts_)
+        bucket_.push_back(std::make_pair(ts, offset));
+    }
+    if (reverse_) {
+      std::sort(bucket_.begin(), bucket_.end(), std::greater<std::pair<uint64_t, uint64_t>>());
+      --it_;
+    } else {
+      std::sort(bucket_.begin(), bucket_.end());
+      ++it_;
+    }
+  }
+  return true;
+}
+
+}
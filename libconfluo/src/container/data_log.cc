@@ -2,7 +2,6 @@
 
 namespace confluo {
 
-const size_t data_log_constants::MAX_BUCKETS;
 const size_t data_log_constants::BUCKET_SIZE;
 const size_t data_log_constants::BUFFER_SIZE;
 
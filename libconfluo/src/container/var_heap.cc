@@ -0,0 +1,73 @@
+#include "container/var_heap.h"
+
+namespace confluo {
+
+var_heap::var_heap()
+    : tail_(0) {
+}
+
+var_heap::var_heap(const std::string &path, const storage::storage_mode &mode,
+                   const monolog::bucket_geometry &geometry)
+    : tail_(0) {
+  init(path, mode, geometry);
+}
+
+void var_heap::init(const std::string &path, const storage::storage_mode &mode,
+                    const monolog::bucket_geometry &geometry) {
+  log_.reset(new log_type("var_heap", path, mode, geometry));
+  atomic::store(&tail_, UINT64_C(0));
+  pending_.clear();
+}
+
+uint64_t var_heap::reserve(size_t len) {
+  return log_->reserve(len);
+}
+
+void var_heap::write(uint64_t offset, const uint8_t *data, size_t len) {
+  log_->write(offset, data, len);
+}
+
+void var_heap::commit(uint64_t offset, size_t len) {
+  if (len == 0)
+    return;
+  log_->flush(offset, len);
+  // Ranges committed ahead of the tail are parked until the ranges before
+  // them are committed, so that a slow writer never stalls the others.
+  std::lock_guard<std::mutex> lock(commit_mtx_);
+  if (offset != atomic::load(&tail_)) {
+    pending_[offset] = offset + len;
+    return;
+  }
+  uint64_t tail = offset + len;
+  auto it = pending_.begin();
+  while (it != pending_.end() && it->first == tail) {
+    tail = it->second;
+    it = pending_.erase(it);
+  }
+  atomic::store(&tail_, tail);
+}
+
+uint64_t var_heap::append(const uint8_t *data, size_t len) {
+  uint64_t offset = reserve(len);
+  write(offset, data, len);
+  commit(offset, len);
+  return offset;
+}
+
+void var_heap::read(uint64_t offset, uint8_t *data, size_t len) const {
+  log_->read(offset, data, len);
+}
+
+size_t var_heap::size() const {
+  return atomic::load(&tail_);
+}
+
+void var_heap::recover() {
+  atomic::store(&tail_, static_cast<uint64_t>(log_->size()));
+}
+
+var_heap::log_type &var_heap::log() {
+  return *log_;
+}
+
+}
@@ -1,19 +1,27 @@
 #include "filter.h"
 
+#include <thread>
+
 namespace confluo {
 
 filter::filter(const compiled_expression &exp, filter_fn fn)
     : exp_(exp),
       fn_(fn),
       idx_(8, 256),
-      is_valid_(true) {
+      alerts_(nullptr),
+      is_valid_(true),
+      backfilling_(false),
+      backfill_boundary_(0) {
 }
 
 filter::filter(filter_fn fn)
     : exp_(),
       fn_(fn),
       idx_(8, 256),
-      is_valid_(true) {
+      alerts_(nullptr),
+      is_valid_(true),
+      backfilling_(false),
+      backfill_boundary_(0) {
 }
 
 size_t filter::add_aggregate(aggregate_info *a) {
@@ -32,49 +40,85 @@ size_t filter::num_aggregates() const {
   return aggregates_.size();
 }
 
+void filter::set_alert_index(alert_index *alerts) {
+  alerts_ = alerts;
+}
+
 void filter::update(const record_t &r) {
+  if (!update_on_write(r.log_offset()))
+    return;
+
   if (exp_.test(r) && fn_(r)) {
-    aggregated_reflog *refs = idx_.insert(
-        byte_string(r.timestamp() / configuration_params::TIME_RESOLUTION_NS()),
-        r.log_offset(), aggregates_);
+    uint64_t time_block = r.timestamp() / configuration_params::TIME_RESOLUTION_NS();
+    aggregated_reflog *refs = idx_.insert(byte_string(time_block), r.log_offset(), aggregates_);
     int tid = thread_manager::get_id();
     for (size_t i = 0; i < refs->num_aggregates(); i++) {
-      if (aggregates_.at(i)->is_valid()) {
-        size_t field_idx = aggregates_.at(i)->field_idx();
-        numeric val(r[field_idx].value());
-        refs->seq_update_aggregate(tid, i, val, r.version());
+      aggregate_info *a = aggregates_.at(i);
+      if (a->is_valid()) {
+        numeric val(r[a->field_idx()].value());
+        if (has_eager_triggers(a)) {
+          numeric before = refs->latest_aggregate(i);
+          refs->seq_update_aggregate(tid, i, val, r.version());
+          raise_eager_alerts(a, time_block, before, refs->latest_aggregate(i), r.version());
+        } else {
+          refs->seq_update_aggregate(tid, i, val, r.version());
+        }
       }
     }
   }
 }
 
+void filter::backfill(const record_t &r) {
+  if (exp_.test(r) && fn_(r)) {
+    idx_.insert(byte_string(r.timestamp() / configuration_params::TIME_RESOLUTION_NS()), r.log_offset(),
+                aggregates_);
+  }
+}
+
 void filter::update(size_t log_offset, const schema_snapshot &snap, record_block &block, size_t record_size) {
-  int tid = thread_manager::get_id();
+  // Batches are reserved atomically, so they lie entirely on one side of
+  // the backfill boundary.
+  if (!update_on_write(log_offset))
+    return;
+
   aggregated_reflog *refs = nullptr;
-  std::vector<numeric> local_aggs;
+  std::vector<uint8_t *> matches;
+  matches.reserve(block.nrecords);
 
   for (size_t i = 0; i < block.nrecords; i++) {
-    void *cur_rec = reinterpret_cast<uint8_t *>(&block.data[i * record_size]);
+    uint8_t *cur_rec = reinterpret_cast<uint8_t *>(&block.data[i * record_size]);
     uint64_t rec_off = log_offset + i * record_size;
     if (exp_.test(snap, cur_rec)) {
       if (refs == nullptr) {
         refs = idx_.get_or_create(
             byte_string(static_cast<uint64_t>(block.time_block)),
             aggregates_);
-        local_aggs.resize(refs->num_aggregates());
       }
       refs->push_back(rec_off);
-      for (size_t j = 0; j < local_aggs.size(); j++)
-        if (aggregates_.at(j)->is_valid())
-          local_aggs[j] = aggregates_.at(j)->seq_op(local_aggs[j], snap,
-                                                    cur_rec);
+      matches.push_back(cur_rec);
     }
   }
 
+  if (matches.empty())
+    return;
+
+  // Each aggregate is computed over all matching records at once, and
+  // published with a single versioned update
+  int tid = thread_manager::get_id();
   size_t version = log_offset + block.nrecords * record_size;
-  for (size_t j = 0; j < local_aggs.size(); j++)
-    if (aggregates_.at(j)->is_valid() && !local_aggs[j].type().is_none())
-      refs->comb_update_aggregate(tid, j, local_aggs[j], version);
+  for (size_t j = 0; j < refs->num_aggregates(); j++) {
+    aggregate_info *a = aggregates_.at(j);
+    if (a->is_valid()) {
+      numeric agg = a->batch_op(snap, matches.data(), matches.size());
+      if (has_eager_triggers(a)) {
+        numeric before = refs->latest_aggregate(j);
+        refs->comb_update_aggregate(tid, j, agg, version);
+        raise_eager_alerts(a, block.time_block, before, refs->latest_aggregate(j), version);
+      } else {
+        refs->comb_update_aggregate(tid, j, agg, version);
+      }
+    }
+  }
 }
 
 aggregated_reflog *filter::lookup_unsafe(uint64_t ts_block) const {
@@ -95,6 +139,54 @@ filter::reflog_result filter::lookup_range_reflogs(uint64_t ts_block_begin, uint
                                    byte_string(ts_block_end));
 }
 
+const uint64_t filter::UNSET_BOUNDARY;
+
+void filter::begin_backfill() {
+  atomic::store(&backfill_boundary_, UNSET_BOUNDARY);
+  atomic::store(&backfilling_, true);
+}
+
+void filter::set_backfill_boundary(uint64_t boundary) {
+  atomic::store(&backfill_boundary_, boundary);
+}
+
+void filter::finish_backfill() {
+  atomic::store(&backfilling_, false);
+}
+
+bool filter::is_backfilling() const {
+  return atomic::load(&backfilling_);
+}
+
+bool filter::update_on_write(uint64_t offset) const {
+  uint64_t boundary;
+  // The boundary is only unset for the brief window between the filter
+  // being published and the management thread reading the data log tail.
+  while ((boundary = atomic::load(&backfill_boundary_)) == UNSET_BOUNDARY) {
+    std::this_thread::yield();
+  }
+  return offset >= boundary;
+}
+
+bool filter::has_eager_triggers(const aggregate_info *a) const {
+  return alerts_ != nullptr && a->has_eager_triggers();
+}
+
+void filter::raise_eager_alerts(aggregate_info *a,
+                                uint64_t time_block,
+                                const numeric &before,
+                                const numeric &after,
+                                uint64_t version) {
+  // Only the update that makes the condition true raises an alert, so a
+  // bucket that stays above the threshold does not flood the queue
+  size_t ntriggers = a->num_triggers();
+  for (size_t i = 0; i < ntriggers; i++) {
+    trigger *t = a->get_trigger(i);
+    if (t->mode() == EAGER_TRIGGER && t->is_valid() && t->crossed(before, after))
+      alerts_->enqueue_alert(time_block, t->alert_id(), after, version);
+  }
+}
+
 bool filter::invalidate() {
   bool expected = true;
   return atomic::strong::cas(&is_valid_, &expected, false);
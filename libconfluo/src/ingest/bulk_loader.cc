@@ -0,0 +1,432 @@
+#include "ingest/bulk_loader.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "atomic.h"
+#include "exceptions.h"
+#include "file_utils.h"
+#include "logger.h"
+#include "mmap_utils.h"
+#include "string_utils.h"
+#include "time_utils.h"
+#include "threads/thread_manager.h"
+
+namespace confluo {
+namespace ingest {
+
+const size_t bulk_loader::DEFAULT_BATCH_SIZE;
+const size_t bulk_loader::DEFAULT_CHUNK_SIZE;
+
+double bulk_load_stats::records_per_s() const {
+  return elapsed_s > 0 ? static_cast<double>(num_records) / elapsed_s : 0.0;
+}
+
+double bulk_load_stats::mb_per_s() const {
+  return elapsed_s > 0 ? static_cast<double>(num_bytes) / (1024.0 * 1024.0) / elapsed_s : 0.0;
+}
+
+bulk_loader::bulk_loader(atomic_multilog *mlog, size_t num_threads, size_t batch_size, size_t chunk_size)
+    : mlog_(mlog),
+      num_threads_(num_threads == 0 ? std::max(std::thread::hardware_concurrency(), 1U) : num_threads),
+      batch_size_(std::max(batch_size, static_cast<size_t>(1))),
+      chunk_size_(std::max(chunk_size, static_cast<size_t>(1))) {
+}
+
+bulk_load_stats bulk_loader::load(const std::string &path, bulk_format format, bool skip_header) {
+  if (!utils::file_utils::exists_file(path)) {
+    THROW(invalid_operation_exception, "No such file " + path);
+  }
+  size_t size = utils::file_utils::file_size(path);
+  if (size == 0)
+    return load(nullptr, 0, format, skip_header);
+
+  int fd = utils::file_utils::open_file(path, O_RDONLY);
+  void *data = utils::mmap_utils::map(fd, nullptr, 0, size, PROT_READ, MAP_PRIVATE);
+  utils::file_utils::close_file(fd);
+  madvise(data, size, MADV_SEQUENTIAL);
+  try {
+    bulk_load_stats stats = load(static_cast<const char *>(data), size, format, skip_header);
+    utils::mmap_utils::unmap(data, size);
+    return stats;
+  } catch (...) {
+    utils::mmap_utils::unmap(data, size);
+    throw;
+  }
+}
+
+bulk_load_stats bulk_loader::load(const char *data, size_t size, bulk_format format, bool skip_header) {
+  if (format == bulk_format::BINARY && mlog_->get_schema().has_var_columns()) {
+    THROW(unsupported_exception, "Binary bulk loads require a schema without variable-length columns");
+  }
+  std::vector<chunk> chunks = format == bulk_format::BINARY ? split_binary(data, size)
+                                                            : split_text(data, size, format, skip_header);
+  size_t nthreads = std::min(num_threads_, std::max(chunks.size(), static_cast<size_t>(1)));
+
+  uint64_t start = utils::time_utils::cur_ns();
+  atomic::type<size_t> next_chunk(0);
+  atomic::type<uint64_t> nrecords(0);
+  atomic::type<size_t> nworkers(0);
+  atomic::type<bool> failed(false);
+  std::mutex error_mutex;
+  std::string error;
+
+  // The calling thread takes part in the load; helper threads that cannot
+  // register with the thread manager leave the chunks to the others
+  auto work = [&]() {
+    atomic::faa(&nworkers, static_cast<size_t>(1));
+    uint64_t appended = 0;
+    size_t i;
+    while (!atomic::load(&failed) && (i = atomic::faa(&next_chunk, static_cast<size_t>(1))) < chunks.size()) {
+      try {
+        if (format == bulk_format::BINARY)
+          load_binary_chunk(chunks[i], appended);
+        else
+          load_text_chunk(chunks[i], data, format, appended);
+      } catch (std::exception &e) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!atomic::load(&failed))
+          error = e.what();
+        atomic::store(&failed, true);
+      }
+    }
+    atomic::faa(&nrecords, appended);
+  };
+
+  std::vector<std::thread> helpers;
+  for (size_t t = 1; t < nthreads; t++) {
+    helpers.push_back(std::thread([&]() {
+      if (thread_manager::register_thread() >= 0)
+        work();
+      thread_manager::deregister_thread();
+    }));
+  }
+  work();
+  for (auto &helper : helpers)
+    helper.join();
+
+  if (atomic::load(&failed)) {
+    THROW(parse_exception, error);
+  }
+
+  bulk_load_stats stats;
+  stats.num_records = atomic::load(&nrecords);
+  stats.num_bytes = size;
+  stats.num_threads = atomic::load(&nworkers);
+  stats.elapsed_s = static_cast<double>(utils::time_utils::cur_ns() - start) / 1e9;
+  LOG_INFO << "Bulk loaded " << stats.num_records << " records into " << mlog_->get_name() << " with "
+           << stats.num_threads << " threads: " << stats.records_per_s() << " records/s, " << stats.mb_per_s()
+           << " MB/s";
+  return stats;
+}
+
+bulk_format bulk_loader::parse_format(const std::string &name) {
+  std::string f = utils::string_utils::to_lower(name);
+  if (f == "csv")
+    return bulk_format::CSV;
+  if (f == "json" || f == "jsonl")
+    return bulk_format::JSON;
+  if (f == "binary" || f == "bin")
+    return bulk_format::BINARY;
+  THROW(parse_exception, "Unknown bulk load format " + name);
+}
+
+void bulk_loader::split_csv(const char *begin, const char *end, std::vector<std::string> &out) {
+  out.clear();
+  const char *p = begin;
+  while (true) {
+    std::string value;
+    if (p < end && *p == '"') {
+      p++;
+      while (true) {
+        if (p == end) {
+          THROW(parse_exception, "Unterminated quoted value");
+        }
+        if (*p == '"') {
+          if (p + 1 < end && p[1] == '"') {
+            value.push_back('"');
+            p += 2;
+            continue;
+          }
+          p++;
+          break;
+        }
+        value.push_back(*p++);
+      }
+      while (p < end && *p != ',')
+        p++;
+    } else {
+      const char *q = std::find(p, end, ',');
+      value.assign(p, q);
+      p = q;
+    }
+    out.push_back(std::move(value));
+    if (p == end)
+      break;
+    p++;
+  }
+}
+
+static void skip_ws(const char *&p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    p++;
+}
+
+static void append_utf8(std::string &out, uint32_t cp) {
+  if (cp < 0x80) {
+    out.push_back(static_cast<char>(cp));
+  } else if (cp < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  }
+}
+
+static std::string parse_json_string(const char *&p, const char *end) {
+  std::string out;
+  p++;  // Opening quote
+  while (p < end && *p != '"') {
+    if (*p != '\\') {
+      out.push_back(*p++);
+      continue;
+    }
+    if (++p == end)
+      break;
+    char c = *p++;
+    switch (c) {
+      case 'b': out.push_back('\b'); break;
+      case 'f': out.push_back('\f'); break;
+      case 'n': out.push_back('\n'); break;
+      case 'r': out.push_back('\r'); break;
+      case 't': out.push_back('\t'); break;
+      case 'u': {
+        if (end - p < 4) {
+          THROW(parse_exception, "Truncated unicode escape");
+        }
+        append_utf8(out, static_cast<uint32_t>(std::stoul(std::string(p, p + 4), nullptr, 16)));
+        p += 4;
+        break;
+      }
+      default: out.push_back(c);
+    }
+  }
+  if (p == end) {
+    THROW(parse_exception, "Unterminated string");
+  }
+  p++;  // Closing quote
+  return out;
+}
+
+void bulk_loader::split_json(const schema_t &schema, const char *begin, const char *end,
+                             std::vector<std::string> &out) {
+  size_t ncols = schema.size();
+  out.assign(ncols, "");
+  std::vector<bool> present(ncols, false);
+
+  const char *p = begin;
+  skip_ws(p, end);
+  if (p == end || *p != '{') {
+    THROW(parse_exception, "Expected a JSON object");
+  }
+  p++;
+  skip_ws(p, end);
+  while (p < end && *p != '}') {
+    if (*p != '"') {
+      THROW(parse_exception, "Expected an attribute name");
+    }
+    std::string key = parse_json_string(p, end);
+    skip_ws(p, end);
+    if (p == end || *p != ':') {
+      THROW(parse_exception, "Expected ':' after " + key);
+    }
+    p++;
+    skip_ws(p, end);
+    if (p == end) {
+      THROW(parse_exception, "Expected a value for " + key);
+    }
+
+    std::string value;
+    bool is_null = false;
+    if (*p == '"') {
+      value = parse_json_string(p, end);
+    } else if (*p == '{' || *p == '[') {
+      THROW(parse_exception, "Nested value for " + key + " is not supported");
+    } else {
+      const char *q = p;
+      while (q < end && *q != ',' && *q != '}' && *q != ' ' && *q != '\t' && *q != '\r')
+        q++;
+      value.assign(p, q);
+      is_null = value == "null";
+      p = q;
+    }
+
+    size_t idx;
+    try {
+      idx = schema.get_field_index(key);
+    } catch (std::out_of_range &) {
+      idx = ncols;  // Unknown attributes are ignored
+    }
+    if (idx < ncols && !is_null) {
+      out[idx] = std::move(value);
+      present[idx] = true;
+    }
+
+    skip_ws(p, end);
+    if (p < end && *p == ',') {
+      p++;
+      skip_ws(p, end);
+    }
+  }
+  if (p == end) {
+    THROW(parse_exception, "Unterminated JSON object");
+  }
+
+  for (size_t i = 1; i < ncols; i++) {
+    if (!present[i]) {
+      THROW(parse_exception, "Missing attribute " + schema[i].name());
+    }
+  }
+  if (!present[0])
+    out.erase(out.begin());
+}
+
+const char *bulk_loader::find_record_end(const char *p, const char *end, bulk_format format) {
+  if (format != bulk_format::CSV)
+    return std::find(p, end, '\n');
+  // Newlines inside quoted values belong to the record; as in split_csv,
+  // a value is quoted only if it starts with a quote
+  bool field_start = true;
+  while (p < end) {
+    char c = *p;
+    if (c == '\n')
+      return p;
+    if (c == '"' && field_start) {
+      for (p++; p < end; p++) {
+        if (*p == '"') {
+          if (p + 1 < end && p[1] == '"') {
+            p++;
+            continue;
+          }
+          break;
+        }
+      }
+      if (p == end)
+        return end;
+      field_start = false;
+    } else {
+      field_start = c == ',';
+    }
+    p++;
+  }
+  return end;
+}
+
+std::vector<bulk_loader::chunk> bulk_loader::split_text(const char *data, size_t size, bulk_format format,
+                                                        bool skip_header) const {
+  std::vector<chunk> chunks;
+  const char *p = data;
+  const char *end = data + size;
+  if (skip_header && p < end) {
+    p = find_record_end(p, end, format);
+    if (p < end)
+      p++;
+  }
+  while (p < end) {
+    const char *q = end - p > static_cast<ptrdiff_t>(chunk_size_) ? p + chunk_size_ : end;
+    if (q < end) {
+      // Boundaries must be found by walking records from a known record
+      // start; without quotes in between, the last newline before q is one
+      const char *r = p;
+      if (format != bulk_format::CSV || std::find(p, q, '"') == q) {
+        const char *nl = static_cast<const char *>(memrchr(p, '\n', static_cast<size_t>(q - p)));
+        if (nl != nullptr)
+          r = nl + 1;
+      }
+      while (r < q) {
+        r = find_record_end(r, end, format);
+        if (r < end)
+          r++;
+      }
+      q = r;
+    }
+    chunks.push_back({p, q});
+    p = q;
+  }
+  return chunks;
+}
+
+std::vector<bulk_loader::chunk> bulk_loader::split_binary(const char *data, size_t size) const {
+  size_t record_size = mlog_->record_size();
+  if (size % record_size != 0) {
+    THROW(parse_exception, "Input size " + std::to_string(size) + " is not a multiple of the record size "
+        + std::to_string(record_size));
+  }
+  size_t step = std::max(chunk_size_ / record_size, static_cast<size_t>(1)) * record_size;
+  std::vector<chunk> chunks;
+  for (size_t off = 0; off < size; off += step)
+    chunks.push_back({data + off, data + std::min(off + step, size)});
+  return chunks;
+}
+
+void bulk_loader::load_text_chunk(const chunk &c, const char *base, bulk_format format, uint64_t &nrecords) {
+  const schema_t &schema = mlog_->get_schema();
+  std::unique_ptr<record_batch_builder> builder(new record_batch_builder(schema));
+  size_t nbuffered = 0;
+  std::vector<std::string> values;
+  std::string record;
+  const char *p = c.begin;
+  while (p < c.end) {
+    const char *eol = find_record_end(p, c.end, format);
+    const char *line_end = eol;
+    if (line_end > p && line_end[-1] == '\r')
+      line_end--;
+    if (line_end > p) {
+      try {
+        if (format == bulk_format::CSV)
+          split_csv(p, line_end, values);
+        else
+          split_json(schema, p, line_end, values);
+        schema.record_vector_to_data(record, values);
+      } catch (std::exception &e) {
+        THROW(parse_exception, "Malformed record at byte " + std::to_string(p - base) + ": " + e.what());
+      }
+      builder->add_record(record.data());
+      if (++nbuffered == batch_size_)
+        append(builder, nbuffered, nrecords);
+    }
+    p = eol < c.end ? eol + 1 : c.end;
+  }
+  if (nbuffered > 0)
+    append(builder, nbuffered, nrecords);
+}
+
+void bulk_loader::load_binary_chunk(const chunk &c, uint64_t &nrecords) {
+  // Binary records are already in the data log format, so batches are
+  // built over the mapped input directly
+  size_t record_size = mlog_->record_size();
+  size_t total = static_cast<size_t>(c.end - c.begin) / record_size;
+  for (size_t i = 0; i < total; i += batch_size_) {
+    size_t n = std::min(batch_size_, total - i);
+    record_batch batch = record_batch_builder::from_records(c.begin + i * record_size, n, record_size);
+    mlog_->append_batch(batch);
+    nrecords += n;
+  }
+}
+
+void bulk_loader::append(std::unique_ptr<record_batch_builder> &builder, size_t &nbuffered, uint64_t &nrecords) {
+  record_batch batch = builder->get_batch();
+  mlog_->append_batch(batch);
+  nrecords += nbuffered;
+  nbuffered = 0;
+  builder.reset(new record_batch_builder(mlog_->get_schema()));
+}
+
+}
+}
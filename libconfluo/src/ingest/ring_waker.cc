@@ -0,0 +1,98 @@
+#include "ingest/ring_waker.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "exceptions.h"
+#include "logger.h"
+
+namespace confluo {
+namespace ingest {
+
+ring_waker::ring_waker()
+    : epoll_fd_(::epoll_create1(EPOLL_CLOEXEC)),
+      stop_fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+  if (epoll_fd_ == -1 || stop_fd_ == -1) {
+    THROW(invalid_operation_exception, "Could not create ring waker: " + std::string(strerror(errno)));
+  }
+  epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = stop_fd_;
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &ev);
+  waiter_ = std::thread([this] { wait_loop(); });
+}
+
+ring_waker::~ring_waker() {
+  uint64_t one = 1;
+  if (::write(stop_fd_, &one, sizeof(one)) == -1)
+    LOG_ERROR << "Could not stop ring waker: " << strerror(errno);
+  if (waiter_.joinable())
+    waiter_.join();
+  ::close(stop_fd_);
+  ::close(epoll_fd_);
+}
+
+void ring_waker::add(int fd, std::function<void(void)> callback) {
+  std::lock_guard<std::mutex> lk(mtx_);
+  epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = fd;
+  if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) == -1) {
+    THROW(invalid_operation_exception, "Could not watch ring bell: " + std::string(strerror(errno)));
+  }
+  callbacks_[fd] = callback;
+}
+
+bool ring_waker::remove(int fd) {
+  // Callbacks run under the lock, so none is in progress once it is held
+  std::lock_guard<std::mutex> lk(mtx_);
+  auto it = callbacks_.find(fd);
+  if (it == callbacks_.end())
+    return false;
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  callbacks_.erase(it);
+  return true;
+}
+
+ring_waker &ring_waker::shared() {
+  // Never destroyed, like the task scheduler its callbacks wake
+  static ring_waker *waker = new ring_waker();
+  return *waker;
+}
+
+void ring_waker::wait_loop() {
+  const int max_events = 64;
+  epoll_event events[max_events];
+  while (true) {
+    int n = ::epoll_wait(epoll_fd_, events, max_events, -1);
+    if (n == -1) {
+      if (errno == EINTR)
+        continue;
+      LOG_ERROR << "Ring waker stopped: " << strerror(errno);
+      return;
+    }
+    for (int i = 0; i < n; i++) {
+      if (events[i].data.fd == stop_fd_)
+        return;
+      std::lock_guard<std::mutex> lk(mtx_);
+      auto it = callbacks_.find(events[i].data.fd);
+      if (it == callbacks_.end())
+        continue;
+      try {
+        it->second();
+      } catch (std::exception &e) {
+        LOG_ERROR << "Could not wake ring consumer: " << e.what();
+      }
+    }
+  }
+}
+
+}
+}
@@ -0,0 +1,114 @@
+#include "ingest/shm_ingest.h"
+
+#include <algorithm>
+
+#include "exceptions.h"
+#include "file_utils.h"
+#include "ingest/ring_waker.h"
+#include "logger.h"
+#include "threads/thread_manager.h"
+
+namespace confluo {
+namespace ingest {
+
+const size_t shm_ingest::DEFAULT_CAPACITY;
+const size_t shm_ingest::DEFAULT_BATCH_SIZE;
+
+static shm_ring create_ring(atomic_multilog *mlog, const std::string &path, size_t capacity) {
+  if (mlog->get_schema().has_var_columns()) {
+    THROW(unsupported_exception, "Shared-memory ingest requires a schema without variable-length columns");
+  }
+  return shm_ring::create(path, mlog->record_size(), capacity);
+}
+
+shm_ingest::shm_ingest(atomic_multilog *mlog, const std::string &path, size_t capacity, size_t batch_size)
+    : mlog_(mlog),
+      ring_(create_ring(mlog, path, capacity)),
+      batch_size_(batch_size),
+      ingested_(UINT64_C(0)),
+      dropped_(UINT64_C(0)),
+      drain_task_("shm_ingest") {
+}
+
+shm_ingest::~shm_ingest() {
+  stop();
+  utils::file_utils::delete_file(ring_.path());
+  utils::file_utils::delete_file(shm_ring::bell_path(ring_.path()));
+}
+
+bool shm_ingest::start() {
+  if (!drain_task_.start(std::bind(&shm_ingest::drain_task, this), 1))
+    return false;
+  ring_waker::shared().add(ring_.bell_fd(), [this]() {
+    ring_.clear_bell();
+    drain_task_.wake();
+  });
+  LOG_INFO << "Draining shared-memory ring " << ring_.path() << " into " << mlog_->get_name();
+  return true;
+}
+
+bool shm_ingest::stop() {
+  ring_waker::shared().remove(ring_.bell_fd());
+  if (!drain_task_.stop())
+    return false;
+  drain_all();
+  return true;
+}
+
+size_t shm_ingest::drain() {
+  size_t nrecords;
+  const uint8_t *data = ring_.peek(batch_size_, nrecords);
+  if (nrecords == 0)
+    return 0;
+
+  record_batch batch = record_batch_builder::from_records(data, nrecords, ring_.record_size());
+  try {
+    mlog_->append_batch(batch);
+    atomic::faa(&ingested_, static_cast<uint64_t>(nrecords));
+  } catch (std::exception &e) {
+    // Retrying would stall the ring on the same batch forever
+    LOG_ERROR << "Dropped " << nrecords << " records from " << ring_.path() << ": " << e.what();
+    atomic::faa(&dropped_, static_cast<uint64_t>(nrecords));
+  }
+  ring_.consume(nrecords);
+  return nrecords;
+}
+
+uint64_t shm_ingest::num_ingested() const {
+  return atomic::load(&ingested_);
+}
+
+uint64_t shm_ingest::num_dropped() const {
+  return atomic::load(&dropped_);
+}
+
+std::string const &shm_ingest::path() const {
+  return ring_.path();
+}
+
+void shm_ingest::drain_task() {
+  if (ring_.size() == 0) {
+    // Park before the ring can ring the bell, so that the wake finds the
+    // task parked
+    drain_task_.park();
+    if (!ring_.park())
+      drain_task_.wake();
+    return;
+  }
+  drain_all();
+}
+
+void shm_ingest::drain_all() {
+  // Appends update filters, which need a thread id
+  bool registered = thread_manager::get_id() == -1 && thread_manager::register_thread() >= 0;
+  // Bounded, so that a busy ring does not hold a scheduler worker forever
+  size_t budget = ring_.capacity();
+  size_t n;
+  while (budget > 0 && (n = drain()) > 0)
+    budget -= std::min(n, budget);
+  if (registered)
+    thread_manager::deregister_thread();
+}
+
+}
+}
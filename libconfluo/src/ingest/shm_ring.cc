@@ -0,0 +1,307 @@
+#include "ingest/shm_ring.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include <sys/file.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "exceptions.h"
+#include "file_utils.h"
+#include "mmap_utils.h"
+
+namespace confluo {
+namespace ingest {
+
+const uint64_t shm_ring::MAGIC;
+
+static sockaddr_un bell_address(const std::string &path) {
+  sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    THROW(invalid_operation_exception, "Ring bell path " + path + " is too long");
+  }
+  memcpy(addr.sun_path, path.c_str(), path.size());
+  return addr;
+}
+
+// Opens the bell socket, and either binds it (consumer) or connects it
+// to the bound socket (producer)
+static int open_bell(const std::string &path, bool bind_bell) {
+  sockaddr_un addr = bell_address(path);
+  int fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd == -1) {
+    THROW(invalid_operation_exception, "Could not create ring bell: " + std::string(strerror(errno)));
+  }
+  int ret;
+  if (bind_bell) {
+    ::unlink(path.c_str());
+    ret = ::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+  } else {
+    ret = ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+  }
+  if (ret == -1) {
+    int bell_errno = errno;
+    ::close(fd);
+    THROW(invalid_operation_exception, "Could not open ring bell " + path + ": " + strerror(bell_errno));
+  }
+  return fd;
+}
+
+shm_ring shm_ring::create(const std::string &path, size_t record_size, size_t capacity) {
+  if (record_size == 0) {
+    THROW(invalid_operation_exception, "Ring record size must be non-zero");
+  }
+  uint64_t slots = 1;
+  while (slots < capacity)
+    slots <<= 1;
+  size_t map_size = sizeof(shm_ring_header) + slots * record_size;
+
+  int bell_fd = open_bell(bell_path(path), true);
+  int fd = utils::file_utils::open_file(path, O_CREAT | O_TRUNC | O_RDWR);
+  utils::file_utils::truncate_file(fd, map_size);
+  void *map = utils::mmap_utils::map(fd, nullptr, 0, map_size);
+  utils::file_utils::close_file(fd);
+
+  shm_ring_header *header = static_cast<shm_ring_header *>(map);
+  header->record_size = record_size;
+  header->capacity = slots;
+  atomic::init(&header->head, UINT64_C(0));
+  atomic::init(&header->tail, UINT64_C(0));
+  atomic::init(&header->consumer_parked, UINT64_C(0));
+  // Attachers check the magic first, so publish it last
+  atomic::store(&header->magic, MAGIC);
+  return shm_ring(path, map, map_size, -1, bell_fd);
+}
+
+shm_ring shm_ring::attach(const std::string &path, size_t record_size) {
+  if (!utils::file_utils::exists_file(path)) {
+    THROW(invalid_operation_exception, "No ring at " + path);
+  }
+  size_t map_size = utils::file_utils::file_size(path);
+  if (map_size < sizeof(shm_ring_header)) {
+    THROW(invalid_operation_exception, path + " is not a ring");
+  }
+  int fd = utils::file_utils::open_file(path, O_RDWR);
+  if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+    int lock_errno = errno;
+    utils::file_utils::close_file(fd);
+    if (lock_errno == EWOULDBLOCK) {
+      THROW(invalid_operation_exception, "Ring at " + path + " already has a producer");
+    }
+    THROW(invalid_operation_exception, "Could not lock ring at " + path + ": " + strerror(lock_errno));
+  }
+  void *map = utils::mmap_utils::map(fd, nullptr, 0, map_size);
+
+  // The acquire-load of the magic orders the reads of the other fields
+  // after the creator's stores
+  shm_ring_header *header = static_cast<shm_ring_header *>(map);
+  uint64_t capacity = 0;
+  std::string err;
+  if (atomic::load(&header->magic) != MAGIC) {
+    err = path + " is not a ring";
+  } else if (header->record_size != record_size || record_size == 0) {
+    err = "Ring record size " + std::to_string(header->record_size) + " does not match "
+        + std::to_string(record_size);
+  } else if ((capacity = header->capacity) == 0 || (capacity & (capacity - 1)) != 0) {
+    err = "Ring capacity " + std::to_string(capacity) + " is not a power of two";
+  } else if (capacity > (map_size - sizeof(shm_ring_header)) / record_size) {
+    err = path + " is truncated";
+  }
+  int bell_fd = -1;
+  if (err.empty()) {
+    try {
+      bell_fd = open_bell(bell_path(path), false);
+    } catch (invalid_operation_exception &) {
+      err = "Ring at " + path + " has no consumer";
+    }
+  }
+  if (!err.empty()) {
+    utils::mmap_utils::unmap(map, map_size);
+    utils::file_utils::close_file(fd);
+    THROW(invalid_operation_exception, err);
+  }
+  return shm_ring(path, map, map_size, fd, bell_fd);
+}
+
+shm_ring::shm_ring(const std::string &path, void *map, size_t map_size, int lock_fd, int bell_fd)
+    : path_(path),
+      map_(map),
+      map_size_(map_size),
+      lock_fd_(lock_fd),
+      bell_fd_(bell_fd),
+      header_(static_cast<shm_ring_header *>(map)),
+      data_(static_cast<uint8_t *>(map) + sizeof(shm_ring_header)),
+      record_size_(header_->record_size),
+      mask_(header_->capacity - 1),
+      cached_head_(atomic::load(&header_->head)),
+      cached_tail_(atomic::load(&header_->tail)) {
+}
+
+shm_ring::shm_ring(shm_ring &&other) noexcept
+    : path_(std::move(other.path_)),
+      map_(other.map_),
+      map_size_(other.map_size_),
+      lock_fd_(other.lock_fd_),
+      bell_fd_(other.bell_fd_),
+      header_(other.header_),
+      data_(other.data_),
+      record_size_(other.record_size_),
+      mask_(other.mask_),
+      cached_head_(other.cached_head_),
+      cached_tail_(other.cached_tail_) {
+  other.map_ = nullptr;
+  other.lock_fd_ = -1;
+  other.bell_fd_ = -1;
+}
+
+shm_ring &shm_ring::operator=(shm_ring &&other) noexcept {
+  if (this != &other) {
+    release();
+    path_ = std::move(other.path_);
+    map_ = other.map_;
+    map_size_ = other.map_size_;
+    lock_fd_ = other.lock_fd_;
+    bell_fd_ = other.bell_fd_;
+    header_ = other.header_;
+    data_ = other.data_;
+    record_size_ = other.record_size_;
+    mask_ = other.mask_;
+    cached_head_ = other.cached_head_;
+    cached_tail_ = other.cached_tail_;
+    other.map_ = nullptr;
+    other.lock_fd_ = -1;
+    other.bell_fd_ = -1;
+  }
+  return *this;
+}
+
+shm_ring::~shm_ring() {
+  release();
+}
+
+void shm_ring::release() {
+  if (map_ != nullptr)
+    utils::mmap_utils::unmap(map_, map_size_);
+  map_ = nullptr;
+  // Closing the descriptor releases the producer lock
+  if (lock_fd_ >= 0)
+    utils::file_utils::close_file(lock_fd_);
+  lock_fd_ = -1;
+  if (bell_fd_ >= 0)
+    ::close(bell_fd_);
+  bell_fd_ = -1;
+}
+
+size_t shm_ring::try_write(const void *records, size_t nrecords) {
+  uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+  uint64_t capacity = mask_ + 1;
+  if (capacity - (tail - cached_head_) < nrecords)
+    cached_head_ = atomic::load(&header_->head);
+  size_t n = std::min(static_cast<size_t>(capacity - (tail - cached_head_)), nrecords);
+  if (n == 0)
+    return 0;
+
+  const uint8_t *src = static_cast<const uint8_t *>(records);
+  size_t first = std::min(n, static_cast<size_t>(capacity - (tail & mask_)));
+  memcpy(slot(tail), src, first * record_size_);
+  if (first < n)
+    memcpy(data_, src + first * record_size_, (n - first) * record_size_);
+  atomic::store(&header_->tail, tail + n);
+  // Orders the load of the parked flag after the store of the tail; see park()
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (atomic::load(&header_->consumer_parked) != 0)
+    ring_bell();
+  return n;
+}
+
+void shm_ring::write(const void *records, size_t nrecords) {
+  const uint8_t *src = static_cast<const uint8_t *>(records);
+  while (nrecords > 0) {
+    size_t n = try_write(src, nrecords);
+    if (n == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    src += n * record_size_;
+    nrecords -= n;
+  }
+}
+
+const uint8_t *shm_ring::peek(size_t max_records, size_t &nrecords) {
+  uint64_t head = header_->head.load(std::memory_order_relaxed);
+  if (cached_tail_ == head)
+    cached_tail_ = atomic::load(&header_->tail);
+  uint64_t capacity = mask_ + 1;
+  nrecords = std::min({static_cast<size_t>(cached_tail_ - head),
+                       static_cast<size_t>(capacity - (head & mask_)),
+                       max_records});
+  return slot(head);
+}
+
+void shm_ring::consume(size_t nrecords) {
+  uint64_t head = header_->head.load(std::memory_order_relaxed);
+  atomic::store(&header_->head, head + nrecords);
+}
+
+bool shm_ring::park() {
+  atomic::store(&header_->consumer_parked, UINT64_C(1));
+  // Either this load sees the producer's last tail, or the producer sees
+  // the flag and rings the bell
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (atomic::load(&header_->tail) == header_->head.load(std::memory_order_relaxed))
+    return true;
+  atomic::store(&header_->consumer_parked, UINT64_C(0));
+  return false;
+}
+
+int shm_ring::bell_fd() const {
+  return bell_fd_;
+}
+
+void shm_ring::clear_bell() {
+  char buf[64];
+  while (::recv(bell_fd_, buf, sizeof(buf), MSG_DONTWAIT) > 0);
+}
+
+void shm_ring::ring_bell() {
+  uint64_t expected = 1;
+  if (!atomic::strong::cas(&header_->consumer_parked, &expected, UINT64_C(0)))
+    return;
+  // A full socket buffer already holds a ring, and a consumer that is
+  // gone does not need one
+  char b = 1;
+  ::send(bell_fd_, &b, 1, MSG_DONTWAIT | MSG_NOSIGNAL);
+}
+
+size_t shm_ring::size() const {
+  return atomic::load(&header_->tail) - atomic::load(&header_->head);
+}
+
+size_t shm_ring::record_size() const {
+  return record_size_;
+}
+
+size_t shm_ring::capacity() const {
+  return mask_ + 1;
+}
+
+std::string const &shm_ring::path() const {
+  return path_;
+}
+
+std::string shm_ring::bell_path(const std::string &path) {
+  return path + ".bell";
+}
+
+uint8_t *shm_ring::slot(uint64_t idx) const {
+  return data_ + (idx & mask_) * record_size_;
+}
+
+}
+}
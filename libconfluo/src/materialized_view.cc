@@ -0,0 +1,145 @@
+#include "materialized_view.h"
+
+#include <map>
+
+#include "aggregate/aggregate_manager.h"
+#include "atomic_multilog.h"
+#include "parser/aggregate_parser.h"
+#include "string_utils.h"
+
+namespace confluo {
+
+materialized_view::materialized_view(const std::string &name,
+                                     size_t filter_id,
+                                     const schema_t &schema,
+                                     const std::string &group_by,
+                                     const std::vector<std::string> &aggregate_exprs,
+                                     uint64_t window_ms,
+                                     uint64_t begin_ms,
+                                     atomic_multilog *target)
+    : name_(name),
+      filter_id_(filter_id),
+      group_by_idx_(-1),
+      group_by_size_(0),
+      window_ms_(window_ms),
+      next_window_ms_(begin_ms),
+      target_(target),
+      target_record_size_(target->record_size()),
+      is_valid_(true) {
+  if (window_ms == 0) {
+    THROW(invalid_operation_exception, "Window must be non-zero");
+  }
+  std::vector<column_t> expected = output_schema(schema, group_by, aggregate_exprs);
+  const std::vector<column_t> &actual = target->get_schema().columns();
+  bool match = expected.size() == actual.size();
+  for (size_t i = 0; match && i < expected.size(); i++) {
+    match = expected[i].type() == actual[i].type();
+  }
+  if (!match) {
+    THROW(invalid_operation_exception, "Schema of " + target->get_name() + " does not match view " + name);
+  }
+  if (!group_by.empty()) {
+    const column_t &col = schema[group_by];
+    group_by_idx_ = col.idx();
+    group_by_size_ = col.type().size;
+  }
+  for (const std::string &expr : aggregate_exprs) {
+    auto pa = parser::parse_aggregate(expr);
+    aggregates_.push_back(view_aggregate{aggregate_manager::get_aggregator(pa.agg), schema[pa.field_name].idx()});
+  }
+}
+
+std::vector<column_t> materialized_view::output_schema(const schema_t &schema,
+                                                       const std::string &group_by,
+                                                       const std::vector<std::string> &aggregate_exprs) {
+  schema_builder builder;
+  if (!group_by.empty()) {
+    const column_t &col = schema[group_by];
+    if (col.idx() == 0 || col.type().is_var_length()) {
+      THROW(invalid_operation_exception, "Cannot group by " + group_by);
+    }
+    builder.add_column(col.type(), col.name());
+  }
+  if (aggregate_exprs.empty()) {
+    THROW(invalid_operation_exception, "View must have at least one aggregate");
+  }
+  for (const std::string &expr : aggregate_exprs) {
+    auto pa = parser::parse_aggregate(expr);
+    aggregator agg = aggregate_manager::get_aggregator(pa.agg);
+    const column_t &col = schema[pa.field_name];
+    if (!col.type().is_numeric()) {
+      THROW(invalid_operation_exception, "Cannot aggregate non-numeric column " + pa.field_name);
+    }
+    builder.add_column(agg.result_type, utils::string_utils::to_upper(agg.name) + "_" + col.name());
+  }
+  return builder.get_columns();
+}
+
+const std::string &materialized_view::name() const {
+  return name_;
+}
+
+size_t materialized_view::filter_id() const {
+  return filter_id_;
+}
+
+uint64_t materialized_view::window_ms() const {
+  return window_ms_;
+}
+
+uint64_t materialized_view::next_window_ms() const {
+  return next_window_ms_;
+}
+
+void materialized_view::materialize(record_cursor &records) {
+  // Groups are keyed by the raw bytes of the group-by column
+  std::map<std::string, std::vector<numeric>> groups;
+  for (; records.has_more(); records.advance()) {
+    const record_t &r = records.get();
+    std::string key;
+    if (group_by_idx_ >= 0) {
+      key.assign(reinterpret_cast<const char *>(r[static_cast<uint16_t>(group_by_idx_)].value().ptr()),
+                 group_by_size_);
+    }
+    auto it = groups.find(key);
+    if (it == groups.end()) {
+      std::vector<numeric> init;
+      for (const view_aggregate &a : aggregates_)
+        init.push_back(a.agg.zero);
+      it = groups.insert(std::make_pair(key, std::move(init))).first;
+    }
+    for (size_t i = 0; i < aggregates_.size(); i++) {
+      const view_aggregate &a = aggregates_[i];
+      it->second[i] = a.agg.seq_op(it->second[i], numeric(r[a.field_idx].value()));
+    }
+  }
+
+  uint64_t ts = next_window_ms_ * configuration_params::TIME_RESOLUTION_NS();
+  std::vector<uint8_t> buf(target_record_size_);
+  for (const auto &g : groups) {
+    size_t off = 0;
+    memcpy(&buf[off], &ts, sizeof(uint64_t));
+    off += sizeof(uint64_t);
+    memcpy(&buf[off], g.first.data(), g.first.size());
+    off += g.first.size();
+    for (size_t i = 0; i < aggregates_.size(); i++) {
+      const data_type &type = aggregates_[i].agg.result_type;
+      numeric val = cast(g.second[i], type);
+      memcpy(&buf[off], val.to_data().ptr, type.size);
+      off += type.size;
+    }
+    target_->append(buf.data());
+  }
+  next_window_ms_ += window_ms_;
+}
+
+bool materialized_view::invalidate() {
+  bool expected = true;
+  return atomic::strong::cas(&is_valid_, &expected, false);
+}
+
+bool materialized_view::is_valid() const {
+  return atomic::load(&is_valid_);
+}
+
+}
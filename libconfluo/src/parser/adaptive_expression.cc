@@ -0,0 +1,130 @@
+#include "parser/adaptive_expression.h"
+
+#include <algorithm>
+
+namespace confluo {
+namespace parser {
+
+adaptive_expression::adaptive_expression()
+    : adaptive_expression(compiled_expression()) {
+}
+
+adaptive_expression::adaptive_expression(const compiled_expression &expr,
+                                         uint32_t sample_shift,
+                                         uint64_t reorder_interval,
+                                         size_t max_trees)
+    : expr_(expr),
+      sample_mask_((UINT64_C(1) << sample_shift) - 1),
+      reorder_interval_(reorder_interval),
+      max_trees_(std::max(max_trees, static_cast<size_t>(1))),
+      current_(nullptr),
+      trees_(),
+      num_trees_(0),
+      passes_(),
+      samples_(0),
+      reordering_(false),
+      num_reorders_(0) {
+  if (expr_.root() != nullptr) {
+    trees_.emplace_back(new compiled_node(*expr_.root()));
+    passes_.reset(new atomic::type<uint64_t>[expr_.num_nodes()]);
+    for (size_t i = 0; i < expr_.num_nodes(); i++)
+      atomic::init(&passes_[i], UINT64_C(0));
+    atomic::init(&current_, static_cast<const compiled_node *>(trees_.back().get()));
+    atomic::init(&num_trees_, trees_.size());
+  }
+}
+
+adaptive_expression::~adaptive_expression() = default;
+
+bool adaptive_expression::test(const record_t &r) {
+  const compiled_node *root = atomic::load(&current_);
+  if (root == nullptr)
+    return expr_.test(r);
+  if (!should_sample())
+    return root->test(r);
+  bool pass = root->sample(r, passes_.get());
+  end_sample();
+  return pass;
+}
+
+bool adaptive_expression::test(const schema_snapshot &snap, void *data) {
+  const compiled_node *root = atomic::load(&current_);
+  if (root == nullptr)
+    return expr_.test(snap, data);
+  if (!should_sample())
+    return root->test(snap, data);
+  bool pass = root->sample(snap, data, passes_.get());
+  end_sample();
+  return pass;
+}
+
+compiled_expression const &adaptive_expression::expression() const {
+  return expr_;
+}
+
+const compiled_node *adaptive_expression::current() const {
+  return atomic::load(&current_);
+}
+
+size_t adaptive_expression::num_reorders() const {
+  return atomic::load(&num_reorders_);
+}
+
+size_t adaptive_expression::num_trees() const {
+  return atomic::load(&num_trees_);
+}
+
+bool adaptive_expression::should_sample() const {
+  // A per-thread xorshift generator keeps sampling off shared cache lines
+  static thread_local uint64_t state = reinterpret_cast<uintptr_t>(&state) | 1;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return (state & sample_mask_) == 0;
+}
+
+void adaptive_expression::end_sample() {
+  uint64_t n = atomic::faa(&samples_, UINT64_C(1)) + 1;
+  if (n < reorder_interval_)
+    return;
+  bool expected = false;
+  if (atomic::strong::cas(&reordering_, &expected, true)) {
+    if (atomic::load(&samples_) >= reorder_interval_)
+      reorder();
+    atomic::store(&reordering_, false);
+  }
+}
+
+void adaptive_expression::reorder() {
+  uint64_t n = atomic::exchange(&samples_, UINT64_C(0));
+  std::vector<double> selectivity(expr_.num_nodes());
+  for (size_t i = 0; i < selectivity.size(); i++) {
+    uint64_t p = atomic::exchange(&passes_[i], UINT64_C(0));
+    selectivity[i] = std::min(static_cast<double>(p) / static_cast<double>(n), 1.0);
+  }
+  const compiled_node *cur = atomic::load(&current_);
+  compiled_node next = cur->reordered(selectivity);
+  // Near-ties in selectivity do not flip the order back and forth
+  if (next.same_order(*cur) || next.cost() > (1.0 - MIN_REORDER_GAIN) * cur->expected_cost(selectivity))
+    return;
+
+  const compiled_node *install = nullptr;
+  for (auto &t : trees_) {
+    if (t->same_order(next)) {
+      install = t.get();
+      break;
+    }
+  }
+  if (install == nullptr) {
+    if (trees_.size() >= max_trees_)
+      return;
+    trees_.emplace_back(new compiled_node(std::move(next)));
+    install = trees_.back().get();
+    atomic::store(&num_trees_, trees_.size());
+  }
+  atomic::store(&current_, install);
+  atomic::faa(&num_reorders_, static_cast<size_t>(1));
+}
+
+}
+}
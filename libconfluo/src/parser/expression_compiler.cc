@@ -1,5 +1,7 @@
 #include "parser/expression_compiler.h"
 
+#include <algorithm>
+
 namespace confluo {
 namespace parser {
 
@@ -31,9 +33,33 @@ bool compiled_predicate::test(const record_t &r) const {
 }
 
 bool compiled_predicate::test(const schema_snapshot &snap, void *data) const {
+  if (snap.is_var_length(field_idx_)) {
+    std::string value = snap.get_var(data, field_idx_);
+    return immutable_value::relop(op_, immutable_value(primitive_types::VARCHAR_TYPE(value.length()), &value[0]), val_);
+  }
   return immutable_value::relop(op_, snap.get(data, field_idx_), val_);
 }
 
+double compiled_predicate::cost() const {
+  const data_type &type = val_.type();
+  if (type.is_var_length())
+    return 4.0;
+  if (type.is_numeric())
+    return 1.0;
+  return 1.0 + static_cast<double>(type.size) / 16.0;
+}
+
+double compiled_predicate::selectivity() const {
+  switch (op_) {
+    case reational_op_id::EQ:
+      return 0.1;
+    case reational_op_id::NEQ:
+      return 0.9;
+    default:
+      return 0.33;
+  }
+}
+
 std::string compiled_predicate::to_string() const {
   return field_name_ + relop_utils::op_to_str(op_) + val_.to_string();
 }
@@ -79,11 +105,338 @@ bool compiled_minterm::operator<(const compiled_minterm &other) const {
   return to_string() < other.to_string();
 }
 
+compiled_node::compiled_node(const compiled_predicate &p)
+    : id_(0),
+      type_(node_type::PREDICATE),
+      pred_(std::make_shared<compiled_predicate>(p)),
+      children_(),
+      cost_(p.cost()),
+      selectivity_(p.selectivity()) {
+}
+
+compiled_node::compiled_node(node_type type, std::vector<compiled_node> &&children)
+    : id_(0),
+      type_(type),
+      pred_(),
+      children_(),
+      cost_(0.0),
+      selectivity_(0.0) {
+  for (auto &child : children)
+    add_child(std::move(child));
+  order_children();
+}
+
+compiled_node::node_type compiled_node::type() const {
+  return type_;
+}
+
+compiled_predicate const &compiled_node::predicate() const {
+  return *pred_;
+}
+
+std::vector<compiled_node> const &compiled_node::children() const {
+  return children_;
+}
+
+double compiled_node::cost() const {
+  return cost_;
+}
+
+double compiled_node::selectivity() const {
+  return selectivity_;
+}
+
+bool compiled_node::test(const record_t &r) const {
+  switch (type_) {
+    case node_type::PREDICATE:
+      return pred_->test(r);
+    case node_type::AND:
+      for (auto &c : children_)
+        if (!c.test(r))
+          return false;
+      return true;
+    default:
+      for (auto &c : children_)
+        if (c.test(r))
+          return true;
+      return false;
+  }
+}
+
+bool compiled_node::test(const schema_snapshot &snap, void *data) const {
+  switch (type_) {
+    case node_type::PREDICATE:
+      return pred_->test(snap, data);
+    case node_type::AND:
+      for (auto &c : children_)
+        if (!c.test(snap, data))
+          return false;
+      return true;
+    default:
+      for (auto &c : children_)
+        if (c.test(snap, data))
+          return true;
+      return false;
+  }
+}
+
+size_t compiled_node::id() const {
+  return id_;
+}
+
+void compiled_node::assign_ids(size_t &next) {
+  id_ = next++;
+  for (auto &c : children_)
+    c.assign_ids(next);
+}
+
+bool compiled_node::sample(const record_t &r, atomic::type<uint64_t> *passes) const {
+  bool pass;
+  switch (type_) {
+    case node_type::PREDICATE:
+      pass = pred_->test(r);
+      break;
+    case node_type::AND:
+      pass = true;
+      for (auto &c : children_)
+        pass = c.sample(r, passes) && pass;
+      break;
+    default:
+      pass = false;
+      for (auto &c : children_)
+        pass = c.sample(r, passes) || pass;
+      break;
+  }
+  if (pass)
+    atomic::faa(&passes[id_], UINT64_C(1));
+  return pass;
+}
+
+bool compiled_node::sample(const schema_snapshot &snap, void *data, atomic::type<uint64_t> *passes) const {
+  bool pass;
+  switch (type_) {
+    case node_type::PREDICATE:
+      pass = pred_->test(snap, data);
+      break;
+    case node_type::AND:
+      pass = true;
+      for (auto &c : children_)
+        pass = c.sample(snap, data, passes) && pass;
+      break;
+    default:
+      pass = false;
+      for (auto &c : children_)
+        pass = c.sample(snap, data, passes) || pass;
+      break;
+  }
+  if (pass)
+    atomic::faa(&passes[id_], UINT64_C(1));
+  return pass;
+}
+
+compiled_node compiled_node::reordered(const std::vector<double> &selectivity) const {
+  compiled_node n = *this;
+  if (type_ != node_type::PREDICATE) {
+    for (auto &c : n.children_)
+      c = c.reordered(selectivity);
+    n.order_children();
+  }
+  n.selectivity_ = selectivity.at(id_);
+  return n;
+}
+
+double compiled_node::expected_cost(const std::vector<double> &selectivity) const {
+  if (type_ == node_type::PREDICATE)
+    return cost_;
+  bool is_and = type_ == node_type::AND;
+  double reach = 1.0;
+  double cost = 0.0;
+  for (auto &c : children_) {
+    cost += reach * c.expected_cost(selectivity);
+    double sel = selectivity.at(c.id_);
+    reach *= is_and ? sel : 1.0 - sel;
+  }
+  return cost;
+}
+
+bool compiled_node::same_order(const compiled_node &other) const {
+  if (id_ != other.id_ || children_.size() != other.children_.size())
+    return false;
+  for (size_t i = 0; i < children_.size(); i++)
+    if (!children_[i].same_order(other.children_[i]))
+      return false;
+  return true;
+}
+
+std::set<compiled_minterm> compiled_node::expand() const {
+  std::set<compiled_minterm> e;
+  switch (type_) {
+    case node_type::PREDICATE: {
+      compiled_minterm m;
+      m.add(*pred_);
+      e.insert(m);
+      break;
+    }
+    case node_type::OR: {
+      for (auto &c : children_) {
+        std::set<compiled_minterm> tmp = c.expand();
+        e.insert(tmp.begin(), tmp.end());
+      }
+      break;
+    }
+    case node_type::AND: {
+      e.insert(compiled_minterm());
+      for (auto &c : children_) {
+        std::set<compiled_minterm> rhs = c.expand();
+        std::set<compiled_minterm> product;
+        for (auto &l : e) {
+          for (auto &r : rhs) {
+            compiled_minterm m = l;
+            m.insert(r.begin(), r.end());
+            product.insert(m);
+          }
+        }
+        e = std::move(product);
+      }
+      break;
+    }
+  }
+  return e;
+}
+
+std::string compiled_node::to_string() const {
+  if (type_ == node_type::PREDICATE)
+    return pred_->to_string();
+  std::string sep = type_ == node_type::AND ? " and " : " or ";
+  std::string s = "(";
+  for (size_t i = 0; i < children_.size(); i++) {
+    if (i > 0)
+      s += sep;
+    s += children_[i].to_string();
+  }
+  return s + ")";
+}
+
+void compiled_node::add_child(compiled_node &&child) {
+  if (child.type_ == type_) {
+    for (auto &c : child.children_)
+      children_.push_back(std::move(c));
+  } else {
+    children_.push_back(std::move(child));
+  }
+}
+
+void compiled_node::order_children() {
+  // An AND short-circuits on the first child that fails, and an OR on the
+  // first that passes; evaluating children in increasing order of cost per
+  // unit probability of short-circuiting minimizes the expected cost.
+  bool is_and = type_ == node_type::AND;
+  auto rank = [is_and](const compiled_node &n) {
+    double p = is_and ? 1.0 - n.selectivity_ : n.selectivity_;
+    return n.cost_ / std::max(p, 1e-6);
+  };
+  std::stable_sort(children_.begin(), children_.end(), [&rank](const compiled_node &a, const compiled_node &b) {
+    return rank(a) < rank(b);
+  });
+
+  double reach = 1.0;
+  double sel = is_and ? 1.0 : 0.0;
+  cost_ = 0.0;
+  for (auto &c : children_) {
+    cost_ += reach * c.cost_;
+    if (is_and) {
+      sel *= c.selectivity_;
+      reach *= c.selectivity_;
+    } else {
+      sel = 1.0 - (1.0 - sel) * (1.0 - c.selectivity_);
+      reach *= 1.0 - c.selectivity_;
+    }
+  }
+  selectivity_ = sel;
+}
+
+compiled_expression::compiled_expression()
+    : root_(),
+      num_nodes_(0),
+      minterms_(),
+      expanded_(true) {
+}
+
+compiled_expression::compiled_expression(compiled_node &&root)
+    : root_(),
+      num_nodes_(0),
+      minterms_(),
+      expanded_(false) {
+  root.assign_ids(num_nodes_);
+  root_ = std::make_shared<compiled_node>(std::move(root));
+}
+
+compiled_expression::compiled_expression(const compiled_expression &other)
+    : compiled_expression() {
+  *this = other;
+}
+
+compiled_expression &compiled_expression::operator=(const compiled_expression &other) {
+  if (this == &other)
+    return *this;
+  std::lock_guard<std::mutex> guard(other.expand_mtx_);
+  root_ = other.root_;
+  num_nodes_ = other.num_nodes_;
+  minterms_ = other.minterms_;
+  atomic::store(&expanded_, atomic::load(&other.expanded_));
+  return *this;
+}
+
+void compiled_expression::insert(const compiled_minterm &m) {
+  minterms();
+  root_.reset();
+  num_nodes_ = 0;
+  minterms_.insert(m);
+}
+
+const compiled_node *compiled_expression::root() const {
+  return root_.get();
+}
+
+std::set<compiled_minterm> const &compiled_expression::minterms() const {
+  if (!atomic::load(&expanded_)) {
+    std::lock_guard<std::mutex> guard(expand_mtx_);
+    if (!atomic::load(&expanded_)) {
+      minterms_ = root_->expand();
+      atomic::store(&expanded_, true);
+    }
+  }
+  return minterms_;
+}
+
+size_t compiled_expression::num_nodes() const {
+  return num_nodes_;
+}
+
+compiled_expression::const_iterator compiled_expression::begin() const {
+  return minterms().begin();
+}
+
+compiled_expression::const_iterator compiled_expression::end() const {
+  return minterms().end();
+}
+
+size_t compiled_expression::size() const {
+  return minterms().size();
+}
+
+bool compiled_expression::empty() const {
+  return root_ == nullptr && minterms_.empty();
+}
+
 bool compiled_expression::test(const record_t &r) const {
-  if (empty())
+  if (root_ != nullptr)
+    return root_->test(r);
+
+  if (minterms_.empty())
     return true;
 
-  for (auto &p : *this)
+  for (auto &p : minterms_)
     if (p.test(r))
       return true;
 
@@ -91,10 +444,13 @@ bool compiled_expression::test(const record_t &r) const {
 }
 
 bool compiled_expression::test(const schema_snapshot &snap, void *data) const {
-  if (empty())
+  if (root_ != nullptr)
+    return root_->test(snap, data);
+
+  if (minterms_.empty())
     return true;
 
-  for (auto &p : *this)
+  for (auto &p : minterms_)
     if (p.test(snap, data))
       return true;
 
@@ -113,15 +469,6 @@ std::string compiled_expression::to_string() const {
   return ret;
 }
 
-utree_expand_conjunction::utree_expand_conjunction(const compiled_minterm &m, const schema_t &schema)
-    : m_(m),
-      schema_(schema) {
-}
-
-utree_expand_conjunction::result_type utree_expand_conjunction::operator()(spirit::function_base const &) const {
-  throw parse_exception("Functions not supported");
-}
-
 utree_compile_expression::utree_compile_expression(const schema_t &schema)
     : schema_(schema) {
 }
@@ -131,7 +478,7 @@ utree_compile_expression::result_type utree_compile_expression::operator()(spiri
 }
 
 compiled_expression compile_expression(const spirit::utree &e, const schema_t &schema) {
-  return spirit::utree::visit(e, utree_compile_expression(schema));
+  return compiled_expression(spirit::utree::visit(e, utree_compile_expression(schema)));
 }
 }
 }
\ No newline at end of file
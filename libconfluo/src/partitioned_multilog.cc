@@ -0,0 +1,303 @@
+#include "partitioned_multilog.h"
+
+#include "aggregate/aggregate_manager.h"
+#include "parser/aggregate_parser.h"
+#include "string_utils.h"
+
+namespace confluo {
+
+partitioned_multilog::partitioned_multilog(const std::string &name,
+                                           const std::vector<column_t> &schema,
+                                           size_t num_partitions,
+                                           const std::string &partition_key,
+                                           const std::string &path,
+                                           const storage::storage_mode &s_mode,
+                                           const archival_mode &a_mode,
+                                           task_pool &pool)
+    : name_(name),
+      key_offset_(-1),
+      key_size_(0),
+      next_partition_(0) {
+  if (num_partitions == 0) {
+    THROW(invalid_operation_exception, "Multilog must have at least one partition");
+  }
+  for (size_t i = 0; i < num_partitions; i++) {
+    std::string partition_path = path + "/" + std::to_string(i);
+    utils::file_utils::create_dir(partition_path);
+    partitions_.emplace_back(new atomic_multilog(name + "/" + std::to_string(i), schema, partition_path, s_mode,
+                                                 a_mode, pool));
+  }
+  if (!partition_key.empty()) {
+    const column_t &col = get_schema()[partition_key];
+    if (col.type().is_var_length()) {
+      THROW(invalid_operation_exception, "Cannot partition by variable-length column " + partition_key);
+    }
+    key_offset_ = col.offset();
+    key_size_ = col.type().size;
+  }
+}
+
+void partitioned_multilog::add_index(const std::string &field_name, double bucket_size) {
+  std::lock_guard<std::mutex> lock(mgmt_mtx_);
+  for_each_partition([&](atomic_multilog &p) {
+    p.add_index(field_name, bucket_size);
+  }, [&](atomic_multilog &p) {
+    p.remove_index(field_name);
+  });
+}
+
+void partitioned_multilog::remove_index(const std::string &field_name) {
+  std::lock_guard<std::mutex> lock(mgmt_mtx_);
+  double bucket_size = configuration_params::INDEX_BUCKET_SIZE();
+  index_type_t type = RADIX_INDEX;
+  for (const column_t &col : get_schema().columns()) {
+    if (col.name() == utils::string_utils::to_upper(field_name) && col.is_indexed()) {
+      bucket_size = col.index_bucket_size();
+      type = col.index_type();
+    }
+  }
+  for_each_partition([&](atomic_multilog &p) {
+    p.remove_index(field_name);
+  }, [&](atomic_multilog &p) {
+    p.add_index(field_name, bucket_size, type);
+  });
+}
+
+void partitioned_multilog::add_filter(const std::string &name, const std::string &expr) {
+  std::lock_guard<std::mutex> lock(mgmt_mtx_);
+  for_each_partition([&](atomic_multilog &p) {
+    p.add_filter(name, expr);
+  }, [&](atomic_multilog &p) {
+    p.remove_filter(name);
+  });
+  filters_.insert(std::make_pair(name, filter_metadata(name, expr)));
+}
+
+void partitioned_multilog::remove_filter(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mgmt_mtx_);
+  auto it = filters_.find(name);
+  for_each_partition([&](atomic_multilog &p) {
+    p.remove_filter(name);
+  }, [&](atomic_multilog &p) {
+    if (it != filters_.end())
+      p.add_filter(name, it->second.expr());
+  });
+  if (it != filters_.end())
+    filters_.erase(it);
+}
+
+void partitioned_multilog::add_aggregate(const std::string &name,
+                                         const std::string &filter_name,
+                                         const std::string &expr) {
+  std::lock_guard<std::mutex> lock(mgmt_mtx_);
+  for_each_partition([&](atomic_multilog &p) {
+    p.add_aggregate(name, filter_name, expr);
+  }, [&](atomic_multilog &p) {
+    p.remove_aggregate(name);
+  });
+  aggregator agg = aggregate_manager::get_aggregator(parser::parse_aggregate(expr).agg);
+  std::lock_guard<std::mutex> agg_lock(aggregates_mtx_);
+  aggregates_.erase(name);
+  aggregates_.insert(std::make_pair(name, std::make_pair(aggregate_metadata(name, filter_name, expr), agg)));
+}
+
+void partitioned_multilog::remove_aggregate(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mgmt_mtx_);
+  std::unique_lock<std::mutex> agg_lock(aggregates_mtx_);
+  auto it = aggregates_.find(name);
+  agg_lock.unlock();
+  for_each_partition([&](atomic_multilog &p) {
+    p.remove_aggregate(name);
+  }, [&](atomic_multilog &p) {
+    if (it != aggregates_.end())
+      p.add_aggregate(name, it->second.first.filter_name(), it->second.first.aggregate_expression());
+  });
+  agg_lock.lock();
+  if (it != aggregates_.end())
+    aggregates_.erase(it);
+}
+
+void partitioned_multilog::install_trigger(const std::string &name,
+                                           const std::string &expr,
+                                           uint64_t periodicity_ms,
+                                           trigger_mode_t mode) {
+  std::lock_guard<std::mutex> lock(mgmt_mtx_);
+  for_each_partition([&](atomic_multilog &p) {
+    p.install_trigger(name, expr, periodicity_ms, mode);
+  }, [&](atomic_multilog &p) {
+    p.remove_trigger(name);
+  });
+  triggers_.insert(std::make_pair(name, std::make_pair(trigger_metadata(name, expr, periodicity_ms), mode)));
+}
+
+void partitioned_multilog::remove_trigger(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mgmt_mtx_);
+  auto it = triggers_.find(name);
+  for_each_partition([&](atomic_multilog &p) {
+    p.remove_trigger(name);
+  }, [&](atomic_multilog &p) {
+    if (it == triggers_.end())
+      return;
+    const trigger_metadata &t = it->second.first;
+    p.install_trigger(name, t.trigger_expression(), t.periodicity_ms(), it->second.second);
+  });
+  if (it != triggers_.end())
+    triggers_.erase(it);
+}
+
+record_batch_builder partitioned_multilog::get_batch_builder() const {
+  return partitions_[0]->get_batch_builder();
+}
+
+void partitioned_multilog::append_batch(record_batch &batch) {
+  if (partitions_.size() == 1) {
+    partitions_[0]->append_batch(batch);
+    return;
+  }
+  const schema_t &schema = get_schema();
+  std::vector<record_batch_builder> builders;
+  builders.reserve(partitions_.size());
+  for (size_t i = 0; i < partitions_.size(); i++)
+    builders.emplace_back(schema);
+  for (const record_block &block : batch.blocks) {
+    const uint8_t *cur = reinterpret_cast<const uint8_t *>(block.data.data());
+    for (size_t i = 0; i < block.nrecords; i++) {
+      builders[partition_of(cur)].add_record(cur);
+      cur += schema.inline_record_size(cur);
+    }
+  }
+  for (size_t i = 0; i < partitions_.size(); i++) {
+    record_batch part = builders[i].get_batch();
+    if (part.nrecords > 0)
+      partitions_[i]->append_batch(part);
+  }
+}
+
+uint64_t partitioned_multilog::append(void *data) {
+  size_t p = partition_of(data);
+  return partitions_[p]->append(data) * partitions_.size() + p;
+}
+
+uint64_t partitioned_multilog::append(const std::vector<std::string> &record) {
+  void *data = get_schema().record_vector_to_data(record);
+  uint64_t offset = append(data);
+  delete[] reinterpret_cast<uint8_t *>(data);
+  return offset;
+}
+
+std::vector<std::string> partitioned_multilog::read(uint64_t offset) const {
+  size_t n = partitions_.size();
+  return partitions_[offset % n]->read(offset / n);
+}
+
+std::unique_ptr<record_cursor> partitioned_multilog::execute_filter(const std::string &expr) const {
+  std::vector<std::unique_ptr<record_cursor>> cursors;
+  for (const auto &p : partitions_)
+    cursors.push_back(p->execute_filter(expr));
+  return std::unique_ptr<record_cursor>(new concat_cursor<record_t>(std::move(cursors)));
+}
+
+std::unique_ptr<record_cursor> partitioned_multilog::query_time_range(uint64_t begin_ts, uint64_t end_ts) const {
+  std::vector<std::unique_ptr<record_cursor>> cursors;
+  for (const auto &p : partitions_)
+    cursors.push_back(p->query_time_range(begin_ts, end_ts));
+  return std::unique_ptr<record_cursor>(new concat_cursor<record_t>(std::move(cursors)));
+}
+
+std::unique_ptr<record_cursor> partitioned_multilog::query_filter(const std::string &filter_name,
+                                                                  uint64_t begin_ms,
+                                                                  uint64_t end_ms) const {
+  std::vector<std::unique_ptr<record_cursor>> cursors;
+  for (const auto &p : partitions_)
+    cursors.push_back(p->query_filter(filter_name, begin_ms, end_ms));
+  return std::unique_ptr<record_cursor>(new concat_cursor<record_t>(std::move(cursors)));
+}
+
+numeric partitioned_multilog::execute_aggregate(const std::string &aggregate_expr, const std::string &filter_expr) {
+  aggregator agg = aggregate_manager::get_aggregator(parser::parse_aggregate(aggregate_expr).agg);
+  numeric result = agg.zero;
+  for (auto &p : partitions_)
+    result = agg.comb_op(result, p->execute_aggregate(aggregate_expr, filter_expr));
+  return result;
+}
+
+numeric partitioned_multilog::get_aggregate(const std::string &aggregate_name, uint64_t begin_ms, uint64_t end_ms) {
+  aggregator agg = get_aggregator(aggregate_name);
+  numeric result = agg.zero;
+  for (auto &p : partitions_)
+    result = agg.comb_op(result, p->get_aggregate(aggregate_name, begin_ms, end_ms));
+  return result;
+}
+
+std::vector<numeric> partitioned_multilog::get_aggregate_series(const std::string &aggregate_name,
+                                                                uint64_t begin_ms,
+                                                                uint64_t end_ms,
+                                                                uint64_t interval_ms) {
+  aggregator agg = get_aggregator(aggregate_name);
+  std::vector<numeric> series = partitions_[0]->get_aggregate_series(aggregate_name, begin_ms, end_ms, interval_ms);
+  for (size_t i = 1; i < partitions_.size(); i++) {
+    std::vector<numeric> part = partitions_[i]->get_aggregate_series(aggregate_name, begin_ms, end_ms, interval_ms);
+    for (size_t j = 0; j < series.size(); j++)
+      series[j] = agg.comb_op(series[j], part[j]);
+  }
+  return series;
+}
+
+std::unique_ptr<alert_cursor> partitioned_multilog::get_alerts(uint64_t begin_ms,
+                                                               uint64_t end_ms,
+                                                               const std::string &trigger_name) const {
+  std::vector<std::unique_ptr<alert_cursor>> cursors;
+  for (const auto &p : partitions_)
+    cursors.push_back(p->get_alerts(begin_ms, end_ms, trigger_name));
+  return std::unique_ptr<alert_cursor>(new concat_cursor<monitor::alert>(std::move(cursors)));
+}
+
+const std::string &partitioned_multilog::get_name() const {
+  return name_;
+}
+
+const schema_t &partitioned_multilog::get_schema() const {
+  return partitions_[0]->get_schema();
+}
+
+size_t partitioned_multilog::num_partitions() const {
+  return partitions_.size();
+}
+
+atomic_multilog *partitioned_multilog::partition(size_t i) {
+  return partitions_.at(i).get();
+}
+
+size_t partitioned_multilog::num_records() const {
+  size_t n = 0;
+  for (const auto &p : partitions_)
+    n += p->num_records();
+  return n;
+}
+
+size_t partitioned_multilog::partition_of(const void *data) {
+  if (key_offset_ < 0)
+    return atomic::faa(&next_partition_, UINT64_C(1)) % partitions_.size();
+  // FNV-1a over the key, followed by a 64-bit finalizer
+  const uint8_t *key = reinterpret_cast<const uint8_t *>(data) + key_offset_;
+  uint64_t h = UINT64_C(14695981039346656037);
+  for (size_t i = 0; i < key_size_; i++) {
+    h ^= key[i];
+    h *= UINT64_C(1099511628211);
+  }
+  h ^= h >> 33;
+  h *= UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+  return h % partitions_.size();
+}
+
+aggregator partitioned_multilog::get_aggregator(const std::string &aggregate_name) const {
+  std::lock_guard<std::mutex> lock(aggregates_mtx_);
+  auto it = aggregates_.find(aggregate_name);
+  if (it == aggregates_.end()) {
+    THROW(invalid_operation_exception, "Aggregate " + aggregate_name + " does not exist.");
+  }
+  return it->second.second;
+}
+
+}
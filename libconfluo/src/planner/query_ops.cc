@@ -68,5 +68,24 @@ index::radix_index::rt_result index_op::query_index() {
   return index_->range_lookup(range_.first, range_.second);
 }
 
+hash_index_op::hash_index_op(const index::hash_index *index, const reflog *refs, const byte_string &key)
+    : query_op(query_op_type::D_HASH_INDEX_OP),
+      index_(index),
+      refs_(refs),
+      key_(key) {
+}
+
+std::string hash_index_op::to_string() const {
+  return "lookup(" + key_.to_string() + ")" + " on hash_index=" + index_->to_string();
+}
+
+uint64_t hash_index_op::cost() const {
+  return refs_->size();
+}
+
+const reflog *hash_index_op::query_index() {
+  return refs_;
+}
+
 }
 }
\ No newline at end of file
@@ -32,7 +32,7 @@ std::unique_ptr<record_cursor> query_plan::execute(uint64_t version) {
 numeric query_plan::aggregate(uint64_t version, uint16_t field_idx, const aggregator &agg) {
   std::unique_ptr<record_cursor> cursor = execute(version);
   numeric accum = agg.zero;
-  while (cursor->has_more()) {
+  for (; cursor->has_more(); cursor->advance()) {
     accum = agg.seq_op(accum, numeric(cursor->get()[field_idx].value()));
   }
   return accum;
@@ -45,20 +45,26 @@ std::unique_ptr<record_cursor> query_plan::using_full_scan(uint64_t version) {
 
 std::unique_ptr<record_cursor> query_plan::using_indexes(uint64_t version) {
   if (size() == 1) {
-    index::radix_index::rt_result ret = std::dynamic_pointer_cast<index_op>(at(0))->query_index();
-    std::unique_ptr<offset_cursor>
-        o_cursor(new offset_iterator_cursor<index::radix_index::rt_result::iterator>(ret.begin(), ret.end(), version));
-    return std::unique_ptr<record_cursor>(new filter_record_cursor(std::move(o_cursor), dlog_, schema_, expr_));
+    return std::unique_ptr<record_cursor>(new filter_record_cursor(index_cursor(0, version), dlog_, schema_, expr_));
   }
-  std::vector<index::radix_index::rt_result> res;
+  std::vector<std::unique_ptr<offset_cursor>> cursors;
   for (size_t i = 0; i < size(); i++) {
-    res.push_back(std::dynamic_pointer_cast<index_op>(at(i))->query_index());
+    cursors.push_back(index_cursor(i, version));
   }
-  flattened_container<std::vector<index::radix_index::rt_result>> c(res);
-  typedef flattened_container<std::vector<index::radix_index::rt_result>>::iterator iterator_t;
-  std::unique_ptr<offset_cursor> o(new offset_iterator_cursor<iterator_t>(c.begin(), c.end(), version));
+  std::unique_ptr<offset_cursor> o(new union_offset_cursor(std::move(cursors)));
   return make_distinct(std::unique_ptr<record_cursor>(new filter_record_cursor(std::move(o), dlog_, schema_, expr_)));
 }
 
+std::unique_ptr<offset_cursor> query_plan::index_cursor(size_t i, uint64_t version) {
+  if (at(i)->op_type() == query_op_type::D_HASH_INDEX_OP) {
+    const reflog *refs = std::dynamic_pointer_cast<hash_index_op>(at(i))->query_index();
+    return std::unique_ptr<offset_cursor>(
+        new offset_iterator_cursor<reflog::const_iterator>(refs->begin(), refs->end(), version));
+  }
+  index::radix_index::rt_result ret = std::dynamic_pointer_cast<index_op>(at(i))->query_index();
+  return std::unique_ptr<offset_cursor>(
+      new offset_iterator_cursor<index::radix_index::rt_result::iterator>(ret.begin(), ret.end(), version));
+}
+
 }
 }
\ No newline at end of file
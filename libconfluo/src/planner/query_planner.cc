@@ -3,9 +3,15 @@
 namespace confluo {
 namespace planner {
 
-query_planner::query_planner(const data_log *dlog, const index_log *idx_list, const schema_t *schema)
+query_planner::query_planner(const data_log *dlog,
+                             const index_log *idx_list,
+                             const hash_index_log *hash_idx_list,
+                             const composite_index_log *composite_idx_list,
+                             const schema_t *schema)
     : dlog_(dlog),
       idx_list_(idx_list),
+      hash_idx_list_(hash_idx_list),
+      composite_idx_list_(composite_idx_list),
       schema_(schema) {
 }
 
@@ -22,7 +28,8 @@ query_plan query_planner::plan(const parser::compiled_expression &expr) const {
         qp.push_back(std::make_shared<full_scan_op>());
         return qp;
       }
-      case query_op_type::D_INDEX_OP: {
+      case query_op_type::D_INDEX_OP:
+      case query_op_type::D_HASH_INDEX_OP: {
         qp.push_back(op);
         break;
       }
@@ -57,51 +64,129 @@ bool query_planner::add_range(query_planner::key_range_map &ranges,
   return false;  // Invalid key-range
 }
 
+query_planner::key_range query_planner::predicate_range(const parser::compiled_predicate &p,
+                                                       const column_t &col,
+                                                       double bucket_size) const {
+  reational_op_id op = p.op();
+  if (col.type().is_var_length()) {
+    // Keys are prefixes of variable-length values, so values greater (or
+    // less) than a value may still share its key
+    if (op == reational_op_id::GT)
+      op = reational_op_id::GE;
+    else if (op == reational_op_id::LT)
+      op = reational_op_id::LE;
+  }
+  switch (op) {
+    case reational_op_id::EQ: {
+      return std::make_pair(p.value().to_key(bucket_size), p.value().to_key(bucket_size));
+    }
+    case reational_op_id::GE: {
+      return std::make_pair(p.value().to_key(bucket_size), col.max().to_key(bucket_size));
+    }
+    case reational_op_id::LE: {
+      return std::make_pair(col.min().to_key(bucket_size), p.value().to_key(bucket_size));
+    }
+    case reational_op_id::GT: {
+      return std::make_pair(++p.value().to_key(bucket_size), col.max().to_key(bucket_size));
+    }
+    case reational_op_id::LT: {
+      return std::make_pair(col.min().to_key(bucket_size), --p.value().to_key(bucket_size));
+    }
+    default: {
+      throw invalid_operation_exception("Invalid operator in predicate");
+    }
+  }
+}
+
+bool query_planner::composite_range(const parser::compiled_minterm &m,
+                                    const composite_index_t &c,
+                                    key_range &r) const {
+  std::vector<byte_string> lo, hi;
+  bool prefix = true;
+  for (size_t j = 0; j < c.fields().size(); j++) {
+    const column_t &col = (*schema_)[c.fields()[j]];
+    double bucket_size = c.bucket_sizes()[j];
+    key_range col_range = std::make_pair(col.min().to_key(bucket_size), col.max().to_key(bucket_size));
+    if (prefix) {
+      bool constrained = false;
+      for (const auto &p : m) {
+        if (p.field_idx() == c.fields()[j] && p.op() != reational_op_id::NEQ) {
+          col_range = merge_range(col_range, predicate_range(p, col, bucket_size));
+          constrained = true;
+        }
+      }
+      if (j == 0 && !constrained)
+        return false;
+      // Columns after a range (or unconstrained) column span their full domain
+      prefix = constrained && col_range.first == col_range.second;
+    }
+    lo.push_back(col_range.first);
+    hi.push_back(col_range.second);
+  }
+  r = std::make_pair(c.concat(lo), c.concat(hi));
+  return true;
+}
+
 std::shared_ptr<query_op> query_planner::optimize_minterm(const parser::compiled_minterm &m) const {
   // Get valid, condensed key-ranges for indexed attributes
   key_range_map m_key_ranges;
+  key_map m_hash_keys;
   for (const auto &p : m) {
     uint32_t idx = p.field_idx();
     const auto &col = (*schema_)[idx];
-    if (col.is_indexed() && p.op() != reational_op_id::NEQ) {
-      double bucket_size = col.index_bucket_size();
-      key_range r;
-      switch (p.op()) {
-        case reational_op_id::EQ: {
-          r = std::make_pair(p.value().to_key(bucket_size), p.value().to_key(bucket_size));
-          break;
-        }
-        case reational_op_id::GE: {
-          r = std::make_pair(p.value().to_key(bucket_size), col.max().to_key(bucket_size));
-          break;
-        }
-        case reational_op_id::LE: {
-          r = std::make_pair(col.min().to_key(bucket_size), p.value().to_key(bucket_size));
-          break;
-        }
-        case reational_op_id::GT: {
-          r = std::make_pair(++p.value().to_key(bucket_size), col.max().to_key(bucket_size));
-          break;
-        }
-        case reational_op_id::LT: {
-          r = std::make_pair(col.min().to_key(bucket_size), --p.value().to_key(bucket_size));
-          break;
-        }
-        default: {
-          throw invalid_operation_exception("Invalid operator in predicate");
-        }
+    if (col.is_queryable() && col.index_type() == HASH_INDEX) {
+      // Hash indexes can only serve equality predicates
+      if (p.op() != reational_op_id::EQ)
+        continue;
+      byte_string key = p.value().to_key(col.index_bucket_size());
+      auto it = m_hash_keys.find(col.index_id());
+      if (it == m_hash_keys.end()) {
+        m_hash_keys.insert(std::make_pair(col.index_id(), key));
+      } else if (it->second != key) {
+        return std::make_shared<no_op>();
       }
-
+    } else if (col.is_queryable() && p.op() != reational_op_id::NEQ) {
+      key_range r = predicate_range(p, col, col.index_bucket_size());
       if (!add_range(m_key_ranges, col.index_id(), r)) {
         return std::make_shared<no_op>();
       }
     }
   }
 
-  if (m_key_ranges.empty()) {  // None of the fields are indexed
+  size_t ncomposites = composite_idx_list_->size();
+  for (size_t i = 0; i < ncomposites; i++) {
+    const composite_index_t *c = composite_idx_list_->at(i);
+    key_range r;
+    if (c->is_queryable() && composite_range(m, *c, r)) {
+      if (r.first > r.second) {
+        return std::make_shared<no_op>();
+      }
+      m_key_ranges[c->index_id()] = r;
+    }
+  }
+
+  if (m_key_ranges.empty() && m_hash_keys.empty()) {  // None of the fields are indexed
     return std::make_shared<no_valid_index_op>();
   }
 
+  // A key absent from a hash index matches no records; since reflogs are
+  // never removed, a key present now is present at execution.
+  const reflog *min_refs = nullptr;
+  uint32_t min_hash_id = 0;
+  size_t min_hash_cost = UINT64_MAX;
+  for (const auto &m_entry : m_hash_keys) {
+    const reflog *refs = hash_idx_list_->at(m_entry.first)->get(m_entry.second);
+    if (refs == nullptr) {
+      return std::make_shared<no_op>();
+    }
+    size_t cost;
+    if ((cost = refs->size()) < min_hash_cost) {
+      min_hash_cost = cost;
+      min_hash_id = m_entry.first;
+      min_refs = refs;
+    }
+  }
+
   // If we've reached here, we only have non-zero valid, indexed key-ranges.
   // Now we only need to return the minimum cost index lookup
   uint32_t min_id;
@@ -116,6 +201,9 @@ std::shared_ptr<query_op> query_planner::optimize_minterm(const parser::compiled
     }
   }
 
+  if (min_refs != nullptr && min_hash_cost <= min_cost) {
+    return std::make_shared<hash_index_op>(hash_idx_list_->at(min_hash_id), min_refs, m_hash_keys[min_hash_id]);
+  }
   return std::make_shared<index_op>(idx_list_->at(min_id), m_key_ranges[min_id]);
 }
 
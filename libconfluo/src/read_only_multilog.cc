@@ -0,0 +1,170 @@
+#include "read_only_multilog.h"
+
+#include "atomic_multilog_metadata.h"
+#include "exceptions.h"
+#include "file_utils.h"
+#include "mmap_utils.h"
+#include "parser/expression_parser.h"
+
+namespace confluo {
+
+read_only_record_cursor::read_only_record_cursor(const read_only_multilog *mlog, uint64_t begin, uint64_t end,
+                                                 std::unique_ptr<parser::compiled_expression> cexpr,
+                                                 size_t batch_size)
+    : record_cursor(batch_size),
+      mlog_(mlog),
+      cur_(begin),
+      end_(end),
+      cexpr_(std::move(cexpr)) {
+  init();
+}
+
+size_t read_only_record_cursor::load_next_batch() {
+  size_t record_size = mlog_->record_size();
+  size_t i = 0;
+  while (i < current_batch_.size() && cur_ < end_) {
+    read_only_data_log_ptr ptr;
+    mlog_->read(cur_, ptr);
+    current_batch_[i] = mlog_->schema_.apply(cur_, ptr);
+    cur_ += record_size;
+    if (cexpr_ == nullptr || cexpr_->test(current_batch_[i]))
+      i++;
+  }
+  return i;
+}
+
+read_only_multilog::read_only_multilog(const std::string &path)
+    : path_(utils::file_utils::full_path(path)),
+      read_tail_(nullptr),
+      geometry_(monolog::bucket_geometry::fixed(data_log_constants::BUCKET_SIZE)) {
+  name_ = path_.substr(path_.find_last_of('/') + 1);
+  if (!utils::file_utils::exists_file(path_ + "/metadata")) {
+    THROW(invalid_operation_exception, "No atomic multilog at " + path_);
+  }
+
+  // Only the schema, storage mode and data log geometry are needed; all are
+  // written first. Multilogs that do not record their geometry use
+  // fixed-size buckets.
+  bool has_schema = false, has_mode = false;
+  storage::storage_mode mode = storage::IN_MEMORY;
+  metadata_reader reader(path_);
+  while (reader.has_next()) {
+    metadata_type type = reader.next_type();
+    if (type == D_SCHEMA_METADATA) {
+      schema_ = reader.next_schema();
+      has_schema = true;
+    } else if (type == D_STORAGE_MODE_METADATA) {
+      mode = reader.next_storage_mode();
+      has_mode = true;
+    } else if (type == D_DATA_LOG_METADATA) {
+      geometry_ = reader.next_data_log_geometry();
+    } else {
+      break;
+    }
+  }
+  if (!has_schema || !has_mode) {
+    THROW(invalid_operation_exception, "Could not read metadata for " + path_);
+  }
+  if (mode == storage::IN_MEMORY) {
+    THROW(invalid_operation_exception, "Atomic multilog " + name_ + " is not durable");
+  }
+  if (schema_.has_var_columns()) {
+    THROW(unsupported_exception, "Read-only attach does not support variable-length columns");
+  }
+
+  std::string rt_path = path_ + "/read_tail";
+  int fd = utils::file_utils::open_file(rt_path, O_RDONLY);
+  read_tail_ = static_cast<atomic::type<uint64_t> *>(
+      utils::mmap_utils::map(fd, nullptr, 0, sizeof(uint64_t), PROT_READ));
+  utils::file_utils::close_file(fd);
+}
+
+read_only_multilog::~read_only_multilog() {
+  if (read_tail_ != nullptr)
+    utils::mmap_utils::unmap(read_tail_, sizeof(uint64_t));
+  for (auto &m : mappings_)
+    utils::mmap_utils::unmap(m.first, m.second);
+}
+
+std::string const &read_only_multilog::get_name() const {
+  return name_;
+}
+
+schema_t const &read_only_multilog::get_schema() const {
+  return schema_;
+}
+
+size_t read_only_multilog::record_size() const {
+  return schema_.record_size();
+}
+
+uint64_t read_only_multilog::read_tail() const {
+  return atomic::load(read_tail_);
+}
+
+size_t read_only_multilog::num_records() const {
+  return read_tail() / record_size();
+}
+
+void read_only_multilog::read(uint64_t offset, read_only_data_log_ptr &ptr) const {
+  if (offset >= read_tail()) {
+    ptr.init(nullptr);
+    return;
+  }
+  size_t idx = geometry_.bucket_idx(offset);
+  uint8_t *data = bucket(idx);
+  ptr.init(storage::encoded_ptr<uint8_t>(data), offset - geometry_.bucket_start(idx), nullptr);
+}
+
+std::vector<std::string> read_only_multilog::read(uint64_t offset) const {
+  read_only_data_log_ptr rptr;
+  read(offset, rptr);
+  if (rptr.get().ptr() == nullptr)
+    return std::vector<std::string>();
+  data_ptr dptr = rptr.decode_range(0, record_size());
+  return schema_.data_to_record_vector(dptr.get());
+}
+
+std::unique_ptr<record_cursor> read_only_multilog::scan() const {
+  return std::unique_ptr<record_cursor>(new read_only_record_cursor(this, 0, read_tail(), nullptr));
+}
+
+std::unique_ptr<record_cursor> read_only_multilog::execute_filter(const std::string &expr) const {
+  uint64_t version = read_tail();
+  auto t = parser::parse_expression(expr);
+  std::unique_ptr<parser::compiled_expression> cexpr(
+      new parser::compiled_expression(parser::compile_expression(t, schema_)));
+  return std::unique_ptr<record_cursor>(new read_only_record_cursor(this, 0, version, std::move(cexpr)));
+}
+
+uint8_t *read_only_multilog::bucket(size_t idx) const {
+  atomic::type<uint8_t *> &ref = buckets_.at(idx, [](size_t, atomic::type<uint8_t *> &b) {
+    atomic::init(&b, static_cast<uint8_t *>(nullptr));
+  });
+  uint8_t *data = atomic::load(&ref);
+  if (data != nullptr)
+    return data;
+
+  std::lock_guard<std::mutex> lock(map_mtx_);
+  data = atomic::load(&ref);
+  if (data != nullptr)
+    return data;
+
+  // Buckets are laid out as allocated by storage_allocator::mmap: the
+  // pointer metadata followed by the bucket data
+  std::string bucket_path = path_ + "/data_log_" + std::to_string(idx) + ".dat";
+  size_t map_size = sizeof(storage::ptr_metadata) + data_log::bucket_type::alloc_size(geometry_.bucket_size(idx));
+  if (!utils::file_utils::exists_file(bucket_path) || utils::file_utils::file_size(bucket_path) < map_size) {
+    THROW(illegal_state_exception, "Data log bucket " + bucket_path + " is missing or incomplete");
+  }
+  int fd = utils::file_utils::open_file(bucket_path, O_RDONLY);
+  void *map = utils::mmap_utils::map(fd, nullptr, 0, map_size, PROT_READ);
+  utils::file_utils::close_file(fd);
+  mappings_.push_back(std::make_pair(map, map_size));
+
+  data = static_cast<uint8_t *>(map) + sizeof(storage::ptr_metadata);
+  atomic::store(&ref, data);
+  return data;
+}
+
+}
@@ -55,16 +55,40 @@ double column_t::index_bucket_size() const {
   return idx_state_.bucket_size();
 }
 
+index_type_t column_t::index_type() const {
+  return idx_state_.type();
+}
+
 bool column_t::is_indexed() const {
   return idx_state_.is_indexed();
 }
 
+bool column_t::is_queryable() const {
+  return idx_state_.is_queryable();
+}
+
+bool column_t::index_on_write(uint64_t offset) const {
+  return idx_state_.index_on_write(offset);
+}
+
 bool column_t::set_indexing() {
   return idx_state_.set_indexing();
 }
 
-void column_t::set_indexed(uint16_t index_id, double bucket_size) {
-  idx_state_.set_indexed(index_id, bucket_size);
+void column_t::set_indexed(uint16_t index_id, double bucket_size, index_type_t type) {
+  idx_state_.set_indexed(index_id, bucket_size, type);
+}
+
+void column_t::set_backfilling(uint16_t index_id, double bucket_size, index_type_t type) {
+  idx_state_.set_backfilling(index_id, bucket_size, type);
+}
+
+void column_t::set_backfill_boundary(uint64_t boundary) {
+  idx_state_.set_backfill_boundary(boundary);
+}
+
+bool column_t::finish_backfill() {
+  return idx_state_.finish_backfill();
 }
 
 void column_t::set_unindexed() {
@@ -81,7 +105,12 @@ field_t column_t::apply(void *data) const {
                  is_indexed(), idx_state_.id(), idx_state_.bucket_size());
 }
 
+field_t column_t::apply_var(void *value, size_t length) const {
+  return field_t(idx_, data_type(type_.id, length), value,
+                 is_indexed(), idx_state_.id(), idx_state_.bucket_size());
+}
+
 column_snapshot column_t::snapshot() const {
-  return {type_, offset_, is_indexed(), index_id(), index_bucket_size()};
+  return {type_, offset_, is_indexed(), index_id(), index_bucket_size(), index_type()};
 }
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "schema/composite_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+namespace confluo {
+
+const size_t composite_index_t::MAX_STACK_KEY_SIZE;
+
+composite_index_t::composite_index_t(const std::string &name,
+                                     const std::vector<uint16_t> &fields,
+                                     const std::vector<size_t> &key_sizes,
+                                     const std::vector<double> &bucket_sizes)
+    : name_(name),
+      fields_(fields),
+      key_sizes_(key_sizes),
+      bucket_sizes_(bucket_sizes),
+      key_size_(0) {
+  for (size_t key_size : key_sizes_)
+    key_size_ += key_size;
+}
+
+const std::string &composite_index_t::name() const {
+  return name_;
+}
+
+const std::vector<uint16_t> &composite_index_t::fields() const {
+  return fields_;
+}
+
+const std::vector<size_t> &composite_index_t::key_sizes() const {
+  return key_sizes_;
+}
+
+const std::vector<double> &composite_index_t::bucket_sizes() const {
+  return bucket_sizes_;
+}
+
+size_t composite_index_t::key_size() const {
+  return key_size_;
+}
+
+byte_string composite_index_t::get_key(const record_t &r) const {
+  // Keys are built in place on the write path; only unusually wide keys
+  // need a heap buffer.
+  uint8_t stack_buf[MAX_STACK_KEY_SIZE];
+  std::unique_ptr<uint8_t[]> heap_buf;
+  uint8_t *buf = stack_buf;
+  if (key_size_ > MAX_STACK_KEY_SIZE) {
+    heap_buf.reset(new uint8_t[key_size_]);
+    buf = heap_buf.get();
+  }
+  size_t off = 0;
+  for (size_t i = 0; i < fields_.size(); i++) {
+    copy_key(buf + off, r[fields_[i]].value().to_key(bucket_sizes_[i]), key_sizes_[i]);
+    off += key_sizes_[i];
+  }
+  return byte_string(immutable_byte_string(buf, key_size_));
+}
+
+byte_string composite_index_t::concat(const std::vector<byte_string> &keys) const {
+  std::unique_ptr<uint8_t[]> buf(new uint8_t[key_size_]);
+  size_t off = 0;
+  for (size_t i = 0; i < key_sizes_.size(); i++) {
+    copy_key(buf.get() + off, keys[i], key_sizes_[i]);
+    off += key_sizes_[i];
+  }
+  return byte_string(immutable_byte_string(buf.get(), key_size_));
+}
+
+void composite_index_t::copy_key(uint8_t *dst, const byte_string &key, size_t key_size) {
+  size_t len = std::min(key.size(), key_size);
+  memcpy(dst, key.data(), len);
+  memset(dst + len, 0, key_size - len);
+}
+
+uint16_t composite_index_t::index_id() const {
+  return idx_state_.id();
+}
+
+bool composite_index_t::is_indexed() const {
+  return idx_state_.is_indexed();
+}
+
+bool composite_index_t::is_queryable() const {
+  return idx_state_.is_queryable();
+}
+
+bool composite_index_t::index_on_write(uint64_t offset) const {
+  return idx_state_.index_on_write(offset);
+}
+
+bool composite_index_t::set_indexing() {
+  return idx_state_.set_indexing();
+}
+
+void composite_index_t::set_backfilling(uint16_t index_id) {
+  idx_state_.set_backfilling(index_id, 1.0);
+}
+
+void composite_index_t::set_backfill_boundary(uint64_t boundary) {
+  idx_state_.set_backfill_boundary(boundary);
+}
+
+bool composite_index_t::finish_backfill() {
+  return idx_state_.finish_backfill();
+}
+
+bool composite_index_t::disable_indexing() {
+  return idx_state_.disable_indexing();
+}
+
+}
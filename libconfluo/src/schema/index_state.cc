@@ -1,20 +1,28 @@
 #include "schema/index_state.h"
 
+#include <thread>
+
 namespace confluo {
 
 const uint8_t index_state_t::UNINDEXED;
 const uint8_t index_state_t::INDEXING;
 const uint8_t index_state_t::INDEXED;
+const uint8_t index_state_t::BACKFILLING;
+const uint64_t index_state_t::UNSET_BOUNDARY;
 
 index_state_t::index_state_t()
     : state_(UNINDEXED),
       id_(UINT16_MAX),
-      bucket_size_(1) {}
+      bucket_size_(1),
+      type_(RADIX_INDEX),
+      backfill_boundary_(0) {}
 
 index_state_t::index_state_t(const index_state_t &other)
     : state_(atomic::load(&other.state_)),
       id_(other.id_),
-      bucket_size_(other.bucket_size_) {}
+      bucket_size_(other.bucket_size_),
+      type_(other.type_),
+      backfill_boundary_(atomic::load(&other.backfill_boundary_)) {}
 
 uint16_t index_state_t::id() const {
   return id_;
@@ -24,33 +32,80 @@ double index_state_t::bucket_size() const {
   return bucket_size_;
 }
 
+index_type_t index_state_t::type() const {
+  return type_;
+}
+
 index_state_t &index_state_t::operator=(const index_state_t &other) {
   atomic::init(&state_, atomic::load(&other.state_));
   id_ = other.id_;
+  bucket_size_ = other.bucket_size_;
+  type_ = other.type_;
+  atomic::init(&backfill_boundary_, atomic::load(&other.backfill_boundary_));
   return *this;
 }
 
 bool index_state_t::is_indexed() const {
+  uint8_t state = atomic::load(&state_);
+  return state == INDEXED || state == BACKFILLING;
+}
+
+bool index_state_t::is_queryable() const {
   return atomic::load(&state_) == INDEXED;
 }
 
+bool index_state_t::index_on_write(uint64_t offset) const {
+  uint64_t boundary;
+  // The boundary is only unset for the brief window between the transition
+  // to BACKFILLING and the management thread reading the data log tail.
+  while ((boundary = atomic::load(&backfill_boundary_)) == UNSET_BOUNDARY) {
+    std::this_thread::yield();
+  }
+  return offset >= boundary;
+}
+
+uint64_t index_state_t::backfill_boundary() const {
+  return atomic::load(&backfill_boundary_);
+}
+
 bool index_state_t::set_indexing() {
   uint8_t expected = UNINDEXED;
   return atomic::strong::cas(&state_, &expected, INDEXING);
 }
 
-void index_state_t::set_indexed(uint16_t index_id, double bucket_size) {
+void index_state_t::set_indexed(uint16_t index_id, double bucket_size, index_type_t type) {
   id_ = index_id;
   bucket_size_ = bucket_size;
+  type_ = type;
   atomic::store(&state_, INDEXED);
 }
 
+void index_state_t::set_backfilling(uint16_t index_id, double bucket_size, index_type_t type) {
+  id_ = index_id;
+  bucket_size_ = bucket_size;
+  type_ = type;
+  atomic::store(&backfill_boundary_, UNSET_BOUNDARY);
+  atomic::store(&state_, BACKFILLING);
+}
+
+void index_state_t::set_backfill_boundary(uint64_t boundary) {
+  atomic::store(&backfill_boundary_, boundary);
+}
+
+bool index_state_t::finish_backfill() {
+  uint8_t expected = BACKFILLING;
+  return atomic::strong::cas(&state_, &expected, INDEXED);
+}
+
 void index_state_t::set_unindexed() {
   atomic::store(&state_, UNINDEXED);
 }
 
 bool index_state_t::disable_indexing() {
   uint8_t expected = INDEXED;
+  if (atomic::strong::cas(&state_, &expected, UNINDEXED))
+    return true;
+  expected = BACKFILLING;
   return atomic::strong::cas(&state_, &expected, UNINDEXED);
 }
 
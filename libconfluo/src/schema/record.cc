@@ -27,15 +27,25 @@ record_t::record_t(size_t log_offset, storage::read_only_encoded_ptr<uint8_t> da
       ptr_(data),
       size_(size),
       version_(log_offset + size) {
-  storage::decoded_ptr<uint8_t> ptr = data.decode();
-  timestamp_ = *reinterpret_cast<int64_t *>(ptr.get());
-  data_ = ptr.get();
+  if (data.get().is_encoded()) {
+    // Only this record is decoded, into a buffer owned by the record
+    decoded_data_ = std::make_shared<std::vector<uint8_t>>(size);
+    data_ = data.decode_range(0, size, decoded_data_->data()).get();
+  } else {
+    data_ = data.decode_range(0, size).get();
+  }
+  timestamp_ = *reinterpret_cast<int64_t *>(data_);
 }
 
 void record_t::reserve(size_t n) {
   fields_.reserve(n);
 }
 
+uint8_t *record_t::alloc_var_data(size_t size) {
+  var_data_ = std::make_shared<std::vector<uint8_t>>(size);
+  return var_data_->data();
+}
+
 void record_t::push_back(const field_t &val) {
   fields_.push_back(val);
 }
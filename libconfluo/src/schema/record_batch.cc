@@ -17,10 +17,11 @@ record_batch_builder::record_batch_builder(const schema_t &schema)
 }
 
 void record_batch_builder::add_record(const void *data) {
-  size_t record_size = schema_.record_size();
+  size_t record_size = schema_.inline_record_size(data);
   int64_t ts = *reinterpret_cast<const int64_t *>(data);
   int64_t time_block = ts / TIME_BLOCK;
   batch_sizes_[time_block] += record_size;
+  batch_nrecords_[time_block]++;
   batch_[time_block].write(reinterpret_cast<const char *>(data), record_size);
 }
 
@@ -38,12 +39,32 @@ record_batch record_batch_builder::get_batch() {
   for (auto &entry : batch_) {
     batch.blocks[i].time_block = entry.first;
     batch.blocks[i].data = entry.second.str();
-    batch.blocks[i].nrecords = batch.blocks[i].data.size()
-        / schema_.record_size();
+    batch.blocks[i].nrecords = batch_nrecords_[entry.first];
     batch.nrecords += batch.blocks[i].nrecords;
     i++;
   }
   return batch;
 }
 
-}
\ No newline at end of file
+record_batch record_batch_builder::from_records(const void *records, size_t nrecords, size_t record_size) {
+  const uint8_t *data = static_cast<const uint8_t *>(records);
+  record_batch batch;
+  batch.nrecords = nrecords;
+  size_t i = 0;
+  while (i < nrecords) {
+    const uint8_t *begin = data + i * record_size;
+    int64_t time_block = *reinterpret_cast<const int64_t *>(begin) / TIME_BLOCK;
+    size_t j = i + 1;
+    while (j < nrecords && *reinterpret_cast<const int64_t *>(data + j * record_size) / TIME_BLOCK == time_block)
+      j++;
+    record_block block;
+    block.time_block = time_block;
+    block.data.assign(reinterpret_cast<const char *>(begin), (j - i) * record_size);
+    block.nrecords = j - i;
+    batch.blocks.push_back(std::move(block));
+    i = j;
+  }
+  return batch;
+}
+
+}
@@ -1,17 +1,22 @@
 #include "schema/schema.h"
+#include "container/var_heap.h"
 
 namespace confluo {
 
 schema_t::schema_t()
-    : record_size_(0) {
+    : record_size_(0),
+      var_heap_(nullptr) {
 }
 
 schema_t::schema_t(const std::vector<column_t> &columns)
-    : columns_(columns) {
+    : columns_(columns),
+      var_heap_(nullptr) {
   record_size_ = 0;
   for (size_t i = 0; i < columns_.size(); i++) {
     name_map_.insert(std::make_pair(columns_[i].name(), columns_[i].idx()));
     record_size_ += columns_[i].type().size;
+    if (columns_[i].type().is_var_length())
+      var_columns_.push_back(columns_[i].idx());
   }
 }
 
@@ -53,27 +58,86 @@ size_t schema_t::size() const {
   return columns_.size();
 }
 
+void schema_t::set_var_heap(const var_heap *heap) {
+  var_heap_ = heap;
+}
+
+bool schema_t::has_var_columns() const {
+  return !var_columns_.empty();
+}
+
+const std::vector<uint16_t> &schema_t::var_columns() const {
+  return var_columns_;
+}
+
+size_t schema_t::inline_record_size(const void *data) const {
+  size_t size = record_size_;
+  for (uint16_t i : var_columns_)
+    size += var_ref::length(var_ref::load(reinterpret_cast<const uint8_t *>(data) + columns_[i].offset()));
+  return size;
+}
+
+void schema_t::inline_record(std::string &out, const record_t &r) const {
+  size_t start = out.size();
+  out.append(reinterpret_cast<const char *>(r.data()), record_size_);
+  size_t var_offset = record_size_;
+  for (uint16_t i : var_columns_) {
+    const immutable_value &value = r[i].value();
+    var_ref::store(&out[start + columns_[i].offset()], var_ref::pack(var_offset, value.type().size));
+    out.append(reinterpret_cast<const char *>(value.ptr()), value.type().size);
+    var_offset += value.type().size;
+  }
+}
+
 record_t schema_t::apply(size_t offset, storage::read_only_encoded_ptr<uint8_t> &data) const {
   record_t r(offset, data, record_size_);
-  r.reserve(columns_.size());
-  for (uint16_t i = 0; i < columns_.size(); i++)
-    r.push_back(columns_[i].apply(r.data()));
+  apply_fields(r);
   return r;
 }
 
 record_t schema_t::apply_unsafe(size_t offset, void *data) const {
   record_t r(offset, reinterpret_cast<uint8_t *>(data), record_size_);
-  r.reserve(columns_.size());
-  for (uint16_t i = 0; i < columns_.size(); i++)
-    r.push_back(columns_[i].apply(r.data()));
+  apply_fields(r);
   return r;
 }
 
+void schema_t::apply_fields(record_t &r) const {
+  r.reserve(columns_.size());
+  if (var_columns_.empty()) {
+    for (uint16_t i = 0; i < columns_.size(); i++)
+      r.push_back(columns_[i].apply(r.data()));
+    return;
+  }
+
+  // Values in the heap are copied out, since they may span heap buckets;
+  // values in inline records are used in place.
+  uint8_t *var_data = nullptr;
+  if (var_heap_ != nullptr)
+    var_data = r.alloc_var_data(inline_record_size(r.data()) - record_size_);
+  for (uint16_t i = 0; i < columns_.size(); i++) {
+    const column_t &col = columns_[i];
+    if (!col.type().is_var_length()) {
+      r.push_back(col.apply(r.data()));
+      continue;
+    }
+    uint64_t ref = var_ref::load(r.data() + col.offset());
+    size_t len = var_ref::length(ref);
+    if (var_heap_ == nullptr) {
+      r.push_back(col.apply_var(r.data() + var_ref::offset(ref), len));
+    } else {
+      var_heap_->read(var_ref::offset(ref), var_data, len);
+      r.push_back(col.apply_var(var_data, len));
+      var_data += len;
+    }
+  }
+}
+
 schema_snapshot schema_t::snapshot() const {
   schema_snapshot snap;
   for (const column_t &col : columns_) {
     snap.add_column(col.snapshot());
   }
+  snap.set_var_heap(var_heap_);
   return snap;
 }
 
@@ -95,48 +159,44 @@ std::string schema_t::to_string() const {
 }
 
 void *schema_t::record_vector_to_data(const std::vector<std::string> &record) const {
+  std::string out;
+  record_vector_to_data(out, record);
+  void *buf = new uint8_t[out.size()];
+  memcpy(buf, out.data(), out.size());
+  return buf;
+}
+
+void schema_t::record_vector_to_data(std::string &out, const std::vector<std::string> &record) const {
+  size_t first;
   if (record.size() == columns_.size()) {
     // Timestamp is provided
-    void *buf = new uint8_t[record_size_]();
-    for (size_t i = 0; i < columns_.size(); i++) {
-      void *fptr = reinterpret_cast<uint8_t *>(buf) + columns_[i].offset();
-      columns_[i].type().parse_op()(record.at(i), fptr);
-    }
-    return buf;
+    first = 0;
   } else if (record.size() == columns_.size() - 1) {
     // Timestamp is not provided -- generate one
-    void *buf = new uint8_t[record_size_]();
-    uint64_t ts = time_utils::cur_ns();
-    memcpy(buf, &ts, sizeof(uint64_t));
-    for (size_t i = 1; i < columns_.size(); i++) {
-      void *fptr = reinterpret_cast<uint8_t *>(buf) + columns_[i].offset();
-      columns_[i].type().parse_op()(record.at(i - 1), fptr);
-    }
-    return buf;
+    first = 1;
   } else {
     THROW(invalid_operation_exception, "Record does not match schema");
   }
-}
 
-void schema_t::record_vector_to_data(std::string &out, const std::vector<std::string> &record) const {
-  if (record.size() == columns_.size()) {
-    // Timestamp is provided
-    out.resize(record_size_);
-    for (size_t i = 0; i < columns_.size(); i++) {
-      void *fptr = reinterpret_cast<uint8_t *>(&out[0]) + columns_[i].offset();
-      columns_[i].type().parse_op()(record.at(i), fptr);
-    }
-  } else if (record.size() == columns_.size() - 1) {
-    // Timestamp is not provided -- generate one
-    out.resize(record_size_);
+  out.assign(record_size_, '\0');
+  if (first == 1) {
     uint64_t ts = time_utils::cur_ns();
     memcpy(&out[0], &ts, sizeof(uint64_t));
-    for (size_t i = 1; i < columns_.size(); i++) {
+  }
+  for (size_t i = first; i < columns_.size(); i++) {
+    if (!columns_[i].type().is_var_length()) {
       void *fptr = reinterpret_cast<uint8_t *>(&out[0]) + columns_[i].offset();
-      columns_[i].type().parse_op()(record.at(i - 1), fptr);
+      columns_[i].type().parse_op()(record.at(i - first), fptr);
     }
-  } else {
-    THROW(invalid_operation_exception, "Record does not match schema");
+  }
+  // Variable-length values follow the fixed-size record
+  for (uint16_t i : var_columns_) {
+    const std::string &value = record.at(i - first);
+    if (value.length() > var_ref::MAX_LENGTH) {
+      THROW(invalid_operation_exception, "Value too long for " + columns_[i].name());
+    }
+    var_ref::store(&out[columns_[i].offset()], var_ref::pack(out.size(), value.length()));
+    out.append(value);
   }
 }
 
@@ -144,6 +204,11 @@ void schema_t::data_to_record_vector(std::vector<std::string> &ret, const void *
   for (size_t i = 0; i < size(); i++) {
     const void *fptr = reinterpret_cast<const uint8_t *>(data) + columns_[i].offset();
     data_type ftype = columns_[i].type();
+    if (ftype.is_var_length()) {
+      uint64_t ref = var_ref::load(fptr);
+      fptr = reinterpret_cast<const uint8_t *>(data) + var_ref::offset(ref);
+      ftype = data_type(ftype.id, var_ref::length(ref));
+    }
     ret.push_back(ftype.to_string_op()(immutable_raw_data(fptr, ftype.size)));
   }
 }
@@ -171,12 +236,22 @@ schema_builder &schema_builder::add_column(const data_type &type,
     return *this;
   }
 
+  if (type.is_var_length() && type.size != var_ref::SIZE) {
+    THROW(invalid_operation_exception, "VARCHAR columns must be of VARCHAR_TYPE()");
+  }
+
   columns_.push_back(column_t(static_cast<uint16_t>(columns_.size()), offset_, type, name, min, max));
   offset_ += type.size;
   return *this;
 }
 
 schema_builder &schema_builder::add_column(const data_type &type, const std::string &name) {
+  if (type.is_var_length()) {
+    // Variable-length columns only store a reference in the record
+    data_type ref_type = primitive_types::VARCHAR_TYPE();
+    return add_column(ref_type, name, mutable_value(ref_type, ref_type.min()),
+                      mutable_value(ref_type, ref_type.max()));
+  }
   return add_column(type, name, mutable_value(type, type.min()), mutable_value(type, type.max()));
 }
 
@@ -1,4 +1,5 @@
 #include "schema/schema_snapshot.h"
+#include "container/var_heap.h"
 
 namespace confluo {
 
@@ -14,12 +15,36 @@ immutable_value schema_snapshot::get(void *data, uint32_t i) const {
   return immutable_value(snapshot_[i].type, reinterpret_cast<uint8_t *>(data) + snapshot_[i].offset);
 }
 
+void schema_snapshot::set_var_heap(const var_heap *heap) {
+  var_heap_ = heap;
+}
+
+bool schema_snapshot::is_var_length(size_t i) const {
+  return snapshot_[i].type.is_var_length();
+}
+
+std::string schema_snapshot::get_var(void *data, uint32_t i) const {
+  uint64_t ref = var_ref::load(reinterpret_cast<uint8_t *>(data) + snapshot_[i].offset);
+  std::string value(var_ref::length(ref), '\0');
+  if (var_heap_ == nullptr) {
+    memcpy(&value[0], reinterpret_cast<uint8_t *>(data) + var_ref::offset(ref), value.length());
+  } else {
+    var_heap_->read(var_ref::offset(ref), reinterpret_cast<uint8_t *>(&value[0]), value.length());
+  }
+  return value;
+}
+
 byte_string schema_snapshot::time_key(int64_t time_block) const {
   return primitive_types::LONG_TYPE().key_transform()(immutable_raw_data(reinterpret_cast<uint8_t *>(&time_block),
                                                                          primitive_types::LONG_TYPE().size), 1.0);
 }
 
 byte_string schema_snapshot::get_key(void *ptr, uint32_t i) const {
+  if (is_var_length(i)) {
+    std::string value = get_var(ptr, i);
+    return snapshot_[i].type.key_transform()(immutable_raw_data(value.data(), value.length()),
+                                             snapshot_[i].index_bucket_size);
+  }
   return snapshot_[i].type.key_transform()(
       immutable_raw_data(reinterpret_cast<uint8_t *>(ptr) + snapshot_[i].offset, snapshot_[i].type.size),
       snapshot_[i].index_bucket_size);
@@ -41,6 +66,10 @@ double schema_snapshot::index_bucket_size(size_t i) const {
   return snapshot_[i].index_bucket_size;
 }
 
+index_type_t schema_snapshot::index_type(size_t i) const {
+  return snapshot_[i].index_type;
+}
+
 size_t schema_snapshot::num_columns() const {
   return snapshot_.size();
 }
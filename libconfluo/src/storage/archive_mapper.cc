@@ -0,0 +1,95 @@
+#include "storage/archive_mapper.h"
+
+#include <unistd.h>
+
+#include "exceptions.h"
+#include "file_utils.h"
+#include "mmap_utils.h"
+
+namespace confluo {
+namespace storage {
+
+archive_mapper::archive_mapper(size_t extent_size) {
+  size_t page_size = static_cast<size_t>(getpagesize());
+  extent_size_ = ((extent_size + page_size - 1) / page_size) * page_size;
+}
+
+archive_mapper::~archive_mapper() {
+  for (auto &entry : extents_) {
+    utils::mmap_utils::unmap(entry.second->base, extent_size_);
+    delete entry.second;
+  }
+}
+
+uint8_t *archive_mapper::acquire(const std::string &path, size_t offset, size_t size) {
+  if (extent_size_ == 0 || size == 0)
+    return nullptr;
+  size_t idx = offset / extent_size_;
+  if ((offset + size - 1) / extent_size_ != idx)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key = std::make_pair(path, idx);
+  auto it = files_.find(key);
+  extent *e;
+  if (it != files_.end()) {
+    e = it->second;
+  } else {
+    // Pages past the end of the file are mapped but only touched once the
+    // writer has appended them
+    int fd = utils::file_utils::open_file(path, O_RDWR);
+    void *base = utils::mmap_utils::map(fd, nullptr, idx * extent_size_, extent_size_);
+    utils::file_utils::close_file(fd);
+    e = new extent{path, idx, static_cast<uint8_t *>(base), 0, true};
+    files_.insert(std::make_pair(key, e));
+    extents_.insert(std::make_pair(reinterpret_cast<uintptr_t>(e->base), e));
+  }
+  e->refs++;
+  return e->base + (offset - idx * extent_size_);
+}
+
+void archive_mapper::release(const void *ptr) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = extents_.upper_bound(reinterpret_cast<uintptr_t>(ptr));
+  if (it == extents_.begin()) {
+    THROW(invalid_operation_exception, "Pointer is not in a mapped archive extent");
+  }
+  --it;
+  extent *e = it->second;
+  if (reinterpret_cast<uintptr_t>(ptr) >= it->first + extent_size_) {
+    THROW(invalid_operation_exception, "Pointer is not in a mapped archive extent");
+  }
+  if (--e->refs == 0) {
+    extents_.erase(it);
+    unmap(e);
+  }
+}
+
+void archive_mapper::invalidate(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = files_.lower_bound(std::make_pair(path, static_cast<size_t>(0)));
+  while (it != files_.end() && it->first.first == path) {
+    it->second->valid = false;
+    it = files_.erase(it);
+  }
+}
+
+size_t archive_mapper::num_extents() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return extents_.size();
+}
+
+size_t archive_mapper::mapped_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return extents_.size() * extent_size_;
+}
+
+void archive_mapper::unmap(extent *e) {
+  if (e->valid)
+    files_.erase(std::make_pair(e->path, e->idx));
+  utils::mmap_utils::unmap(e->base, extent_size_);
+  delete e;
+}
+
+}
+}
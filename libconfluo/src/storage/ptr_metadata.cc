@@ -5,6 +5,7 @@ namespace storage {
 
 const uint8_t alloc_type::D_DEFAULT;
 const uint8_t alloc_type::D_MMAP;
+const uint8_t alloc_type::D_ARCHIVE_MAP;
 
 ptr_metadata *ptr_metadata::get(void *ptr) {
   return static_cast<ptr_metadata *>(ptr) - 1;
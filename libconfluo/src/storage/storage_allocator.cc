@@ -8,6 +8,7 @@ const int storage_allocator::MAX_CLEANUP_RETRIES;
 storage_allocator::storage_allocator()
     : mem_stat_(),
       mmap_stat_(),
+      archive_map_(archival_configuration_params::MAP_EXTENT_SIZE()),
       mem_cleanup_callback_(no_op) {
 }
 
@@ -79,6 +80,20 @@ void *storage_allocator::mmap(std::string path, off_t offset, size_t size, ptr_a
   return reinterpret_cast<void *>(metadata + 1);
 }
 
+void *storage_allocator::map_archived(const std::string &path, size_t offset, size_t size, ptr_aux_block aux) {
+  uint8_t *ptr = archive_map_.acquire(path, offset, sizeof(ptr_metadata) + size);
+  if (ptr == nullptr)
+    return mmap(path, static_cast<off_t>(offset), size, aux);
+
+  storage::ptr_metadata *metadata = reinterpret_cast<ptr_metadata *>(ptr);
+  metadata->alloc_type_ = alloc_type::D_ARCHIVE_MAP;
+  metadata->data_size_ = static_cast<uint32_t>(size);
+  metadata->offset_ = 0;
+  metadata->aux_ = *reinterpret_cast<uint8_t *>(&aux);
+
+  return reinterpret_cast<void *>(metadata + 1);
+}
+
 void storage_allocator::dealloc(void *ptr) {
   ptr_metadata *md = ptr_metadata::get(ptr);
   size_t alloc_size = sizeof(ptr_metadata) + md->data_size_ + md->offset_;
@@ -95,6 +110,10 @@ void storage_allocator::dealloc(void *ptr) {
       mmap_stat_.decrement(alloc_size);
       break;
     }
+    case alloc_type::D_ARCHIVE_MAP: {
+      archive_map_.release(md);
+      break;
+    }
     default: {
       throw invalid_operation_exception("Invalid allocation type");
     }
@@ -105,5 +124,9 @@ size_t storage_allocator::memory_utilization() {
   return mem_stat_.get();
 }
 
+archive_mapper &storage_allocator::archive_map() {
+  return archive_map_;
+}
+
 }
 }
\ No newline at end of file
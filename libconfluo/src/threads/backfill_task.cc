@@ -0,0 +1,127 @@
+#include "threads/backfill_task.h"
+
+namespace confluo {
+
+double backfill_status::progress() const {
+  if (total_records == 0)
+    return 1.0;
+  return static_cast<double>(backfilled_records) / static_cast<double>(total_records);
+}
+
+double backfill_status::throughput() const {
+  if (elapsed_ms == 0)
+    return 0.0;
+  return static_cast<double>(backfilled_records) * 1e3 / static_cast<double>(elapsed_ms);
+}
+
+backfill_task::backfill_task(const std::string &name, uint64_t end_offset, size_t record_size)
+    : name_(name),
+      end_offset_(end_offset),
+      record_size_(record_size),
+      chunk_bytes_(record_size),
+      next_offset_(0),
+      backfilled_bytes_(0),
+      active_workers_(0),
+      cancelled_(false),
+      done_(false),
+      failed_(false),
+      start_ms_(now_ms()),
+      end_ms_(0) {
+}
+
+backfill_task::~backfill_task() {
+  cancel();
+  wait();
+}
+
+void backfill_task::start(scan_fn scan, done_fn on_done, int num_workers, uint64_t chunk_records) {
+  scan_ = std::move(scan);
+  on_done_ = std::move(on_done);
+  chunk_bytes_ = std::max<uint64_t>(chunk_records, 1) * record_size_;
+  uint64_t num_chunks = (end_offset_ + chunk_bytes_ - 1) / chunk_bytes_;
+  size_t nworkers = static_cast<size_t>(std::max<uint64_t>(1, std::min<uint64_t>(num_chunks,
+                                                                                  static_cast<uint64_t>(num_workers))));
+  LOG_INFO << name_ << ": Backfilling " << end_offset_ / record_size_ << " records using " << nworkers
+           << " threads...";
+  atomic::init(&active_workers_, static_cast<int>(nworkers));
+  for (size_t i = 0; i < nworkers; i++)
+    workers_.push_back(std::thread(&backfill_task::work, this));
+}
+
+void backfill_task::cancel() {
+  std::lock_guard<std::mutex> lock(done_mtx_);
+  atomic::store(&cancelled_, true);
+}
+
+void backfill_task::wait() {
+  for (auto &worker : workers_)
+    if (worker.joinable())
+      worker.join();
+}
+
+backfill_status backfill_task::status() const {
+  backfill_status s;
+  s.total_records = end_offset_ / record_size_;
+  s.backfilled_records = atomic::load(&backfilled_bytes_) / record_size_;
+  s.done = atomic::load(&done_);
+  s.failed = atomic::load(&failed_);
+  uint64_t end_ms = atomic::load(&end_ms_);
+  s.elapsed_ms = (end_ms == 0 ? now_ms() : end_ms) - start_ms_;
+  return s;
+}
+
+void backfill_task::work() {
+  while (!atomic::load(&cancelled_)) {
+    uint64_t begin = atomic::faa(&next_offset_, chunk_bytes_);
+    if (begin >= end_offset_)
+      break;
+    uint64_t end = std::min(begin + chunk_bytes_, end_offset_);
+    try {
+      scan_(begin, end);
+    } catch (std::exception &e) {
+      // Stops the other workers; the last one to finish reports the failure
+      LOG_ERROR << name_ << ": Backfill failed at offset " << begin << ": " << e.what();
+      cancel();
+      break;
+    }
+    atomic::faa(&backfilled_bytes_, end - begin);
+  }
+
+  finish_worker();
+}
+
+void backfill_task::finish_worker() {
+  if (atomic::fas(&active_workers_, 1) != 1)
+    return;
+
+  atomic::store(&end_ms_, std::max<uint64_t>(now_ms(), start_ms_ + 1));
+  // A cancelled backfill may belong to a removed index or filter whose
+  // name has since been reused, so it must not mark anything complete.
+  std::lock_guard<std::mutex> lock(done_mtx_);
+  bool completed = !atomic::load(&cancelled_) && atomic::load(&backfilled_bytes_) == end_offset_;
+  if (completed) {
+    try {
+      on_done_();
+    } catch (std::exception &e) {
+      LOG_ERROR << name_ << ": Could not complete backfill: " << e.what();
+      completed = false;
+    }
+  }
+  if (completed) {
+    atomic::store(&done_, true);
+    backfill_status s = status();
+    LOG_INFO << name_ << ": Backfilled " << s.backfilled_records << " records in " << s.elapsed_ms << "ms ("
+             << s.throughput() << " records/s)";
+  } else {
+    atomic::store(&failed_, true);
+    if (!atomic::load(&cancelled_) && atomic::load(&backfilled_bytes_) != end_offset_)
+      LOG_ERROR << name_ << ": Backfill terminated before all records were scanned";
+  }
+}
+
+uint64_t backfill_task::now_ms() const {
+  using namespace std::chrono;
+  return static_cast<uint64_t>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+}
@@ -13,6 +13,11 @@ bool periodic_task::stop() {
   LOG_TRACE << "Attempting to stop periodic_task...";
   bool expected = true;
   if (atomic::strong::cas(&enabled_, &expected, false)) {
+    {
+      // Wake the executor if it is waiting for its next run
+      std::lock_guard<std::mutex> lk(wait_mtx_);
+    }
+    wait_cv_.notify_all();
     if (executor_.joinable())
       executor_.join();
     LOG_TRACE << "Task stopped.";
@@ -45,7 +50,8 @@ bool periodic_task::start(std::function<void(void)> task, uint64_t interval_ms)
                 auto elapsed = end - start;
                 auto time_to_wait = interval - elapsed;
                 if (time_to_wait > std::chrono::milliseconds::zero()) {
-                  std::this_thread::sleep_for(time_to_wait);
+                  std::unique_lock<std::mutex> wait_lk(wait_mtx_);
+                  wait_cv_.wait_for(wait_lk, time_to_wait, [this] { return !atomic::load(&enabled_); });
                 } else {
                   auto extra_us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed - interval).count();
                   LOG_WARN << name_ << ": Last execution overshot by " << extra_us << "us";
@@ -0,0 +1,238 @@
+#include "threads/task_scheduler.h"
+
+#include "conf/configuration_params.h"
+
+namespace confluo {
+
+const size_t task_scheduler::LEVELS;
+const size_t task_scheduler::SLOT_BITS;
+const size_t task_scheduler::SLOTS;
+
+task_scheduler::task_scheduler(size_t num_workers, uint64_t tick_ms)
+    : tick_ms_(std::max(tick_ms, static_cast<uint64_t>(1))),
+      epoch_(std::chrono::steady_clock::now()),
+      stop_(false),
+      now_tick_(0),
+      wake_tick_(UINT64_MAX),
+      next_id_(1),
+      wheel_size_(0),
+      workers_(std::max(num_workers, static_cast<size_t>(1))) {
+  timer_ = std::thread([this] { timer_loop(); });
+}
+
+task_scheduler::~task_scheduler() {
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    stop_ = true;
+  }
+  timer_cv_.notify_all();
+  if (timer_.joinable())
+    timer_.join();
+}
+
+task_scheduler::task_id task_scheduler::schedule(const std::string &name,
+                                                 std::function<void(void)> task,
+                                                 uint64_t interval_ms) {
+  entry_ptr e = std::make_shared<entry>();
+  e->name = name;
+  e->task = task;
+  e->interval_ticks = std::max((interval_ms + tick_ms_ - 1) / tick_ms_, static_cast<uint64_t>(1));
+  e->cancelled = false;
+  e->running = false;
+  e->parked = false;
+  std::lock_guard<std::mutex> lk(mtx_);
+  e->id = next_id_++;
+  tasks_[e->id] = e;
+  arm(e, std::max(cur_tick(), now_tick_) + 1);
+  LOG_INFO << name << " task scheduled...";
+  return e->id;
+}
+
+bool task_scheduler::cancel(task_id id) {
+  std::unique_lock<std::mutex> lk(mtx_);
+  auto it = tasks_.find(id);
+  if (it == tasks_.end())
+    return false;
+  entry_ptr e = it->second;
+  tasks_.erase(it);
+  // The wheel drops cancelled entries when their slot is next visited
+  e->cancelled = true;
+  done_cv_.wait(lk, [&e] { return !e->running; });
+  LOG_TRACE << e->name << " task cancelled.";
+  return true;
+}
+
+bool task_scheduler::park(task_id id) {
+  std::lock_guard<std::mutex> lk(mtx_);
+  auto it = tasks_.find(id);
+  if (it == tasks_.end())
+    return false;
+  it->second->parked = true;
+  return true;
+}
+
+bool task_scheduler::wake(task_id id) {
+  std::lock_guard<std::mutex> lk(mtx_);
+  auto it = tasks_.find(id);
+  if (it == tasks_.end() || !it->second->parked)
+    return false;
+  entry_ptr e = it->second;
+  e->parked = false;
+  // A parked task that is not running is not on the wheel
+  if (!e->running && !stop_)
+    arm(e, std::max(cur_tick(), now_tick_) + 1);
+  return true;
+}
+
+size_t task_scheduler::num_tasks() const {
+  std::lock_guard<std::mutex> lk(mtx_);
+  return tasks_.size();
+}
+
+task_scheduler &task_scheduler::shared() {
+  // Never destroyed, since multilogs may outlive static destruction
+  static task_scheduler *scheduler = new task_scheduler(configuration_params::SCHEDULER_NUM_THREADS());
+  return *scheduler;
+}
+
+task_scheduler &task_scheduler::archival() {
+  static task_scheduler *scheduler = new task_scheduler(archival_configuration_params::NUM_THREADS());
+  return *scheduler;
+}
+
+uint64_t task_scheduler::cur_tick() const {
+  auto elapsed = std::chrono::steady_clock::now() - epoch_;
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()) / tick_ms_;
+}
+
+uint64_t task_scheduler::next_event_tick() const {
+  // Either the next non-empty slot of the innermost wheel, or the end of
+  // its rotation, when the outer wheels cascade into it
+  uint64_t t = now_tick_ + 1;
+  while ((t & (SLOTS - 1)) != 0 && wheel_[0][t & (SLOTS - 1)].empty())
+    t++;
+  return t;
+}
+
+void task_scheduler::insert(const entry_ptr &e) {
+  uint64_t delta = e->expires > now_tick_ ? e->expires - now_tick_ : 0;
+  wheel_size_++;
+  for (size_t level = 0; level < LEVELS; level++) {
+    if (delta < (static_cast<uint64_t>(1) << (SLOT_BITS * (level + 1)))) {
+      wheel_[level][(e->expires >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(e);
+      return;
+    }
+  }
+  // Beyond the outermost wheel; re-inserted when its slot cascades
+  uint64_t capped = now_tick_ + (static_cast<uint64_t>(1) << (SLOT_BITS * LEVELS)) - 1;
+  wheel_[LEVELS - 1][(capped >> (SLOT_BITS * (LEVELS - 1))) & (SLOTS - 1)].push_back(e);
+}
+
+void task_scheduler::advance(std::vector<entry_ptr> &due) {
+  now_tick_++;
+  // Cascade entries from the outer wheels whose slot is now current
+  for (size_t level = 1; level < LEVELS; level++) {
+    if ((now_tick_ & ((static_cast<uint64_t>(1) << (SLOT_BITS * level)) - 1)) != 0)
+      break;
+    std::vector<entry_ptr> slot;
+    slot.swap(wheel_[level][(now_tick_ >> (SLOT_BITS * level)) & (SLOTS - 1)]);
+    wheel_size_ -= slot.size();
+    for (const entry_ptr &e : slot)
+      if (!e->cancelled)
+        insert(e);
+  }
+  std::vector<entry_ptr> &slot = wheel_[0][now_tick_ & (SLOTS - 1)];
+  wheel_size_ -= slot.size();
+  for (const entry_ptr &e : slot)
+    if (!e->cancelled)
+      due.push_back(e);
+  slot.clear();
+}
+
+void task_scheduler::arm(const entry_ptr &e, uint64_t expires) {
+  e->expires = std::max(expires, now_tick_ + 1);
+  insert(e);
+  if (e->expires < wake_tick_)
+    timer_cv_.notify_one();
+}
+
+void task_scheduler::run(entry_ptr e) {
+  try {
+    e->task();
+  } catch (std::exception &ex) {
+    LOG_ERROR << e->name << ": Could not execute task: " << ex.what();
+  }
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    e->running = false;
+    if (!e->cancelled && !e->parked && !stop_)
+      arm(e, e->expires + e->interval_ticks);
+  }
+  done_cv_.notify_all();
+}
+
+void task_scheduler::timer_loop() {
+  std::vector<entry_ptr> due;
+  std::unique_lock<std::mutex> lk(mtx_);
+  while (!stop_) {
+    uint64_t target = cur_tick();
+    if (wheel_size_ == 0) {
+      now_tick_ = std::max(now_tick_, target);
+    } else {
+      while (now_tick_ < target)
+        advance(due);
+    }
+    for (entry_ptr &e : due) {
+      e->running = true;
+      workers_.submit([this, e] { run(e); });
+    }
+    due.clear();
+
+    if (wheel_size_ == 0) {
+      wake_tick_ = UINT64_MAX;
+      timer_cv_.wait(lk);
+    } else {
+      wake_tick_ = next_event_tick();
+      timer_cv_.wait_until(lk, epoch_ + std::chrono::milliseconds(wake_tick_ * tick_ms_));
+    }
+  }
+}
+
+scheduled_task::scheduled_task(const std::string &name, task_scheduler &scheduler)
+    : name_(name),
+      scheduler_(&scheduler),
+      enabled_(false),
+      id_(0) {
+}
+
+scheduled_task::~scheduled_task() {
+  stop();
+}
+
+bool scheduled_task::start(std::function<void(void)> task, uint64_t interval_ms) {
+  bool expected = false;
+  if (atomic::strong::cas(&enabled_, &expected, true)) {
+    id_ = scheduler_->schedule(name_, task, interval_ms);
+    return true;
+  }
+  return false;
+}
+
+bool scheduled_task::park() {
+  return atomic::load(&enabled_) && scheduler_->park(id_);
+}
+
+bool scheduled_task::wake() {
+  return atomic::load(&enabled_) && scheduler_->wake(id_);
+}
+
+bool scheduled_task::stop() {
+  bool expected = true;
+  if (atomic::strong::cas(&enabled_, &expected, false)) {
+    scheduler_->cancel(id_);
+    return true;
+  }
+  return false;
+}
+
+}
@@ -6,12 +6,15 @@ monitor::trigger::trigger(const std::string &name,
                           const std::string &aggregate_name,
                           reational_op_id op,
                           const numeric &threshold,
-                          const uint64_t periodicity_ms)
+                          const uint64_t periodicity_ms,
+                          trigger_mode_t mode)
     : name_(name),
       aggregate_name_(aggregate_name),
       op_(op),
       threshold_(threshold),
       periodicity_ms_(periodicity_ms),
+      mode_(mode),
+      alert_id_(0),
       is_valid_(true) {
 }
 
@@ -39,6 +42,22 @@ uint64_t monitor::trigger::periodicity_ms() const {
   return periodicity_ms_;
 }
 
+monitor::trigger_mode_t monitor::trigger::mode() const {
+  return mode_;
+}
+
+bool monitor::trigger::crossed(const numeric &before, const numeric &after) const {
+  return numeric::relop(op_, after, threshold_) && !numeric::relop(op_, before, threshold_);
+}
+
+uint32_t monitor::trigger::alert_id() const {
+  return alert_id_;
+}
+
+void monitor::trigger::set_alert_id(uint32_t alert_id) {
+  alert_id_ = alert_id;
+}
+
 bool monitor::trigger::invalidate() {
   bool expected = true;
   return atomic::strong::cas(&is_valid_, &expected, false);
@@ -175,7 +175,11 @@ uint8_t *byte_string::data() {
   return data_;
 }
 
-size_t byte_string::size() {
+const uint8_t *byte_string::data() const {
+  return data_;
+}
+
+size_t byte_string::size() const {
   return size_;
 }
 
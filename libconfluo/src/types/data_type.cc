@@ -1,5 +1,6 @@
 #include <types/type_properties.h>
 #include "types/data_type.h"
+#include "types/var_ref.h"
 
 namespace confluo {
 
@@ -11,6 +12,8 @@ size_t find_type_properties(const std::string &name) {
       return i;
     }
   }
+  if (uname == utils::string_utils::to_upper(data_type_properties::instance()[primitive_type::D_VARCHAR].name))
+    return primitive_type::D_VARCHAR;
   return 0;
 }
 
@@ -92,7 +95,7 @@ const to_string_op_t &data_type::to_string_op() const {
 }
 
 bool data_type::is_valid() const {
-  return id >= 1 && id < data_type_properties::instance().size();
+  return id >= 1 && data_type_properties::instance().contains(id);
 }
 
 bool data_type::is_none() const {
@@ -103,6 +106,10 @@ bool data_type::is_numeric() const {
   return data_type_properties::instance()[id].is_numeric;
 }
 
+bool data_type::is_var_length() const {
+  return id == primitive_type::D_VARCHAR;
+}
+
 std::string data_type::name() const {
   return data_type_properties::instance()[id].name;
 }
@@ -132,6 +139,10 @@ data_type data_type::from_string(const std::string &str) {
     if (id == 0) {
       THROW(parse_exception, "Unknown type name " + str);
     }
+    if (id == primitive_type::D_VARCHAR) {
+      // Variable-length columns only store a reference in the record
+      size = var_ref::SIZE;
+    }
     return data_type(static_cast<uint16_t>(id),
                      data_type_properties::instance()[id].size ? data_type_properties::instance()[id].size : size);
   }
@@ -29,7 +29,8 @@ byte_string immutable_value::to_key(double bucket_size) const {
 }
 
 bool immutable_value::relop(reational_op_id id, const immutable_value &first, const immutable_value &second) {
-  if (first.type_ != second.type_)
+  // Variable-length values of the same type may differ in size
+  if (first.type_.id != second.type_.id || (first.type_.size != second.type_.size && !first.type_.is_var_length()))
     THROW(invalid_operation_exception, "Comparing values of different types");
   return first.type_.relop(id)(first.to_data(), second.to_data());
 }
@@ -84,7 +84,7 @@ mutable_value::~mutable_value() {
 }
 
 mutable_value mutable_value::parse(const std::string &str, const data_type &type) {
-  mutable_value value(type);
+  mutable_value value(type.is_var_length() ? data_type(type.id, str.length()) : type);
   type.parse_op()(str, value.ptr_);
   return value;
 }
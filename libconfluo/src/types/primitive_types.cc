@@ -101,4 +101,9 @@ double limits::double_one = static_cast<double>(1.0);
 /** The max double value */
 double limits::double_max = std::numeric_limits<double>::max();
 
-}
\ No newline at end of file
+/** The minimum variable-length string reference */
+uint64_t limits::varchar_min = std::numeric_limits<uint64_t>::lowest();
+/** The maximum variable-length string reference */
+uint64_t limits::varchar_max = std::numeric_limits<uint64_t>::max();
+
+}
@@ -14,7 +14,7 @@ data_type type_manager::get_type(const std::string &type_name, size_t size) {
 }
 
 data_type type_manager::get_type(size_t id, size_t size) {
-  if (id < data_type_properties::instance().size()) {
+  if (data_type_properties::instance().contains(id)) {
     return data_type(static_cast<uint16_t>(id), size);
   }
   return data_type();
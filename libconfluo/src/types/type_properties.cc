@@ -76,4 +76,22 @@ std::vector<type_properties> detail::init_primitives() {
   return props;
 }
 
+type_properties detail::init_varchar() {
+  return type_properties("varchar",
+                         0,
+                         &limits::varchar_min,
+                         &limits::varchar_max,
+                         nullptr,
+                         nullptr,
+                         false,
+                         init_relops<std::string>(),
+                         init_unaryops<std::string>(),
+                         init_binaryops<std::string>(),
+                         varchar_key_transform,
+                         varchar_parse,
+                         varchar_to_string,
+                         serialize<std::string>,
+                         deserialize<std::string>);
+}
+
 }
\ No newline at end of file
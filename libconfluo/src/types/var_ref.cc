@@ -0,0 +1,10 @@
+#include "types/var_ref.h"
+
+namespace confluo {
+
+const size_t var_ref::SIZE;
+const size_t var_ref::LENGTH_BITS;
+const size_t var_ref::MAX_LENGTH;
+const uint64_t var_ref::MAX_OFFSET;
+
+}
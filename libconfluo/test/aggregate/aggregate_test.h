@@ -1,7 +1,10 @@
 #ifndef CONFLUO_TEST_AGGREGATE_TEST_H_
 #define CONFLUO_TEST_AGGREGATE_TEST_H_
 
+#include <thread>
+
 #include "aggregate/aggregate.h"
+#include "aggregate/aggregate_kernel.h"
 
 #include "gtest/gtest.h"
 
@@ -98,4 +101,66 @@ TEST_F(AggregateTest, CountTest) {
   }
 }
 
+TEST_F(AggregateTest, PerThreadSlotsTest) {
+  aggregate agg(primitive_types::LONG_TYPE(), aggregate_manager::get_aggregator("sum"));
+  ASSERT_EQ(static_cast<size_t>(0), agg.num_slots());
+  ASSERT_TRUE(numeric(limits::long_zero) == agg.get(0));
+
+  const int nthreads = 4;
+  const int64_t nupdates = 1000;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < nthreads; t++) {
+    workers.push_back(std::thread([&agg, t, nupdates] {
+      // Sparse thread ids only get slots once they update the aggregate
+      for (int64_t i = 1; i <= nupdates; i++)
+        agg.comb_update(t * 16, numeric(i), static_cast<uint64_t>(i));
+    }));
+  }
+  for (auto &w : workers)
+    w.join();
+
+  ASSERT_EQ(static_cast<size_t>(nthreads), agg.num_slots());
+  ASSERT_TRUE(numeric(static_cast<int64_t>(nthreads * nupdates * (nupdates + 1) / 2)) == agg.get(nupdates));
+  ASSERT_TRUE(numeric(static_cast<int64_t>(nthreads * 3)) == agg.get(2));
+
+  aggregate copy(agg);
+  ASSERT_EQ(static_cast<size_t>(nthreads), copy.num_slots());
+  ASSERT_TRUE(numeric(static_cast<int64_t>(nthreads * 3)) == copy.get(2));
+  aggregate moved(std::move(copy));
+  ASSERT_EQ(static_cast<size_t>(0), copy.num_slots());
+  ASSERT_TRUE(numeric(static_cast<int64_t>(nthreads * 3)) == moved.get(2));
+}
+
+TEST_F(AggregateTest, KernelTest) {
+  struct rec {
+    int64_t ts;
+    int32_t a;
+    int64_t b;
+    double c;
+  }__attribute__((packed));
+
+  std::vector<rec> recs;
+  for (int32_t i = 0; i < 100; i++)
+    recs.push_back(rec{0, i - 50, static_cast<int64_t>(i) * 1000, i / 7.0});
+  std::vector<uint8_t *> ptrs;
+  for (auto &r : recs)
+    ptrs.push_back(reinterpret_cast<uint8_t *>(&r));
+
+  std::vector<std::pair<data_type, size_t>> fields = {
+      {primitive_types::INT_TYPE(), offsetof(rec, a)},
+      {primitive_types::LONG_TYPE(), offsetof(rec, b)},
+      {primitive_types::DOUBLE_TYPE(), offsetof(rec, c)}
+  };
+  for (const char *name : {"sum", "min", "max", "count"}) {
+    aggregator agg = aggregate_manager::get_aggregator(name);
+    for (const auto &f : fields) {
+      auto kernel = make_aggregate_kernel(agg, f.first, f.second);
+      generic_kernel expected(agg, f.first, f.second);
+      numeric result = kernel->apply(ptrs.data(), ptrs.size());
+      ASSERT_EQ(agg.result_type.id, result.type().id);
+      ASSERT_TRUE(expected.apply(ptrs.data(), ptrs.size()) == result);
+    }
+  }
+}
+
 #endif /* CONFLUO_TEST_AGGREGATE_TEST_H_ */
@@ -0,0 +1,108 @@
+#ifndef CONFLUO_TEST_ALERT_INDEX_TEST_H_
+#define CONFLUO_TEST_ALERT_INDEX_TEST_H_
+
+#include <thread>
+
+#include "alert_index.h"
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+using namespace ::confluo::monitor;
+
+class AlertIndexTest : public testing::Test {
+ public:
+  static std::vector<alert> collect(const alert_index &idx, const alert_index::alert_list &alerts) {
+    std::vector<alert> out;
+    for (const alert_entry &e : alerts)
+      out.push_back(idx.to_alert(e));
+    return out;
+  }
+};
+
+TEST_F(AlertIndexTest, AddTriggerTest) {
+  alert_index idx;
+  uint32_t t1 = idx.add_trigger("t1", "agg1 > 1");
+  uint32_t t2 = idx.add_trigger("t2", "agg2 > 1");
+  ASSERT_NE(t1, t2);
+  ASSERT_EQ(t1, idx.add_trigger("t1", "agg1 > 1"));
+  ASSERT_NE(t1, idx.add_trigger("t1", "agg1 > 2"));
+}
+
+TEST_F(AlertIndexTest, DedupTest) {
+  alert_index idx;
+  uint32_t t1 = idx.add_trigger("t1", "agg1 > 1");
+  uint32_t t2 = idx.add_trigger("t2", "agg2 > 1");
+
+  idx.add_alert(10, t1, numeric(5), 1);
+  idx.add_alert(10, t1, numeric(5), 2);
+  idx.add_alert(10, t2, numeric(5), 2);
+  idx.add_alert(10, t1, numeric(6), 3);
+  idx.add_alert(11, t1, numeric(5), 3);
+
+  auto alerts = collect(idx, idx.get_alerts(10, 10));
+  ASSERT_EQ(static_cast<size_t>(3), alerts.size());
+  ASSERT_EQ("t1", alerts[0].trigger_name);
+  ASSERT_EQ("agg1 > 1", alerts[0].trigger_expr);
+  ASSERT_TRUE(numeric(5) == alerts[0].value);
+  ASSERT_EQ(static_cast<uint64_t>(1), alerts[0].version);
+  ASSERT_EQ("t2", alerts[1].trigger_name);
+  ASSERT_EQ("t1", alerts[2].trigger_name);
+  ASSERT_TRUE(numeric(6) == alerts[2].value);
+
+  ASSERT_EQ(static_cast<size_t>(4), collect(idx, idx.get_alerts(10, 11)).size());
+}
+
+TEST_F(AlertIndexTest, TriggerLookupTest) {
+  alert_index idx;
+  uint32_t t1 = idx.add_trigger("t1", "agg1 > 1");
+  uint32_t t2 = idx.add_trigger("t2", "agg2 > 1");
+  for (uint64_t bucket = 0; bucket < 100; bucket++) {
+    idx.add_alert(bucket, t1, numeric(static_cast<int64_t>(bucket)), bucket);
+    if (bucket % 2 == 0)
+      idx.add_alert(bucket, t2, numeric(static_cast<int64_t>(bucket)), bucket);
+  }
+
+  auto lists = idx.get_alerts(10, 19, "t2");
+  ASSERT_EQ(static_cast<size_t>(1), lists.size());
+  auto alerts = collect(idx, lists[0]);
+  ASSERT_EQ(static_cast<size_t>(5), alerts.size());
+  for (size_t i = 0; i < alerts.size(); i++) {
+    ASSERT_EQ("t2", alerts[i].trigger_name);
+    ASSERT_EQ(10 + 2 * i, alerts[i].time_bucket);
+  }
+
+  ASSERT_TRUE(idx.get_alerts(10, 19, "t3").empty());
+}
+
+TEST_F(AlertIndexTest, QueuedAlertTest) {
+  alert_index idx;
+  uint32_t t1 = idx.add_trigger("t1", "agg1 > 1");
+  const uint64_t kNumThreads = 4;
+  const uint64_t kNumAlerts = 1000;
+  std::vector<std::thread> workers;
+  for (uint64_t i = 0; i < kNumThreads; i++) {
+    workers.push_back(std::thread([&idx, t1, i, kNumAlerts] {
+      for (uint64_t j = 0; j < kNumAlerts; j++)
+        idx.enqueue_alert(i, t1, numeric(static_cast<int64_t>(j)), j);
+    }));
+  }
+  for (auto &worker : workers)
+    worker.join();
+
+  // Queued alerts are not visible until drained
+  ASSERT_TRUE(idx.has_queued());
+  ASSERT_TRUE(collect(idx, idx.get_alerts(0, kNumThreads)).empty());
+  ASSERT_EQ(kNumThreads * kNumAlerts, idx.drain());
+  ASSERT_FALSE(idx.has_queued());
+
+  for (uint64_t i = 0; i < kNumThreads; i++) {
+    auto alerts = collect(idx, idx.get_alerts(i, i));
+    ASSERT_EQ(kNumAlerts, alerts.size());
+    // Each thread's alerts are added in the order they were queued
+    for (uint64_t j = 0; j < kNumAlerts; j++)
+      ASSERT_EQ(j, alerts[j].version);
+  }
+  ASSERT_EQ(static_cast<size_t>(0), idx.drain());
+}
+
+#endif /* CONFLUO_TEST_ALERT_INDEX_TEST_H_ */
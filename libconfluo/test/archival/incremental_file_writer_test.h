@@ -0,0 +1,108 @@
+#ifndef CONFLUO_TEST_INCREMENTAL_FILE_WRITER_TEST_H_
+#define CONFLUO_TEST_INCREMENTAL_FILE_WRITER_TEST_H_
+
+#include "gtest/gtest.h"
+
+#include "archival/io/incremental_file_reader.h"
+#include "archival/io/incremental_file_writer.h"
+
+using namespace ::confluo::archival;
+
+class IncrementalFileWriterTest : public testing::Test {
+
+ public:
+  static const size_t MAX_FILE_SIZE = 4096;
+  static const size_t NUM_BLOCKS = 20;
+  static const size_t BLOCK_SIZE = 1000;
+
+  static std::string block(size_t i) {
+    return std::string(BLOCK_SIZE, static_cast<char>('a' + i % 26));
+  }
+
+};
+
+const size_t IncrementalFileWriterTest::MAX_FILE_SIZE;
+const size_t IncrementalFileWriterTest::NUM_BLOCKS;
+const size_t IncrementalFileWriterTest::BLOCK_SIZE;
+
+/**
+ * Verifies that committed data is readable right away, and that committed
+ * actions are logged at the next sync.
+ */
+TEST_F(IncrementalFileWriterTest, CommitTest) {
+  std::string path = "/tmp/incremental_file_writer_test/commit";
+  file_utils::clear_dir(path);
+  file_utils::create_dir(path);
+  incremental_file_writer writer(path, "data", MAX_FILE_SIZE);
+
+  std::vector<incremental_file_offset> offsets;
+  for (size_t i = 0; i < NUM_BLOCKS; i++) {
+    size_t id = i;
+    std::string data = block(i);
+    offsets.push_back(writer.append<size_t, const char>(&id, 1, data.data(), BLOCK_SIZE));
+    writer.commit<size_t>(i);
+
+    incremental_file_offset off = offsets.back();
+    ASSERT_EQ(file_utils::file_size(off.path()), off.offset() + sizeof(size_t) + BLOCK_SIZE);
+  }
+  ASSERT_EQ(0U, file_utils::file_size(writer.transaction_log_path()));
+  ASSERT_NE(offsets.front().path(), offsets.back().path());
+
+  writer.sync();
+  ASSERT_EQ(NUM_BLOCKS * sizeof(size_t), file_utils::file_size(writer.transaction_log_path()));
+  writer.close();
+
+  incremental_file_reader reader(path, "data");
+  for (size_t i = 0; i < NUM_BLOCKS; i++) {
+    ASSERT_EQ(i, reader.read_action<size_t>());
+    ASSERT_EQ(i, reader.read<size_t>());
+    ASSERT_EQ(offsets[i].path(), reader.tell().path());
+    ASSERT_EQ(offsets[i].offset() + sizeof(size_t), reader.tell().offset());
+    ASSERT_EQ(block(i), reader.read(BLOCK_SIZE));
+  }
+}
+
+/**
+ * Verifies that committed actions are synced once the pending bound is hit.
+ */
+TEST_F(IncrementalFileWriterTest, PendingCommitsTest) {
+  std::string path = "/tmp/incremental_file_writer_test/pending";
+  file_utils::clear_dir(path);
+  file_utils::create_dir(path);
+  incremental_file_writer writer(path, "data", MAX_FILE_SIZE, 4);
+
+  for (size_t i = 0; i < 10; i++) {
+    writer.append<size_t>(i);
+    writer.commit<size_t>(i);
+    ASSERT_EQ((i + 1) / 4 * 4 * sizeof(size_t), file_utils::file_size(writer.transaction_log_path()));
+  }
+  writer.close();
+  ASSERT_EQ(10 * sizeof(size_t), file_utils::file_size(writer.transaction_log_path()));
+}
+
+/**
+ * Verifies that a reopened writer appends after the existing data.
+ */
+TEST_F(IncrementalFileWriterTest, ReopenTest) {
+  std::string path = "/tmp/incremental_file_writer_test/reopen";
+  file_utils::clear_dir(path);
+  file_utils::create_dir(path);
+  incremental_file_writer writer(path, "data", MAX_FILE_SIZE);
+  writer.close();
+
+  for (size_t i = 0; i < NUM_BLOCKS; i++) {
+    std::string data = block(i);
+    writer.open();
+    writer.append<const char>(data.data(), BLOCK_SIZE);
+    writer.commit<size_t>(i);
+    writer.close();
+  }
+
+  incremental_file_reader reader(path, "data");
+  for (size_t i = 0; i < NUM_BLOCKS; i++) {
+    ASSERT_EQ(i, reader.read_action<size_t>());
+    ASSERT_EQ(block(i), reader.read(BLOCK_SIZE));
+  }
+}
+
+#endif /* CONFLUO_TEST_INCREMENTAL_FILE_WRITER_TEST_H_ */
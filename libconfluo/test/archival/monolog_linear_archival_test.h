@@ -13,13 +13,13 @@ class MonologLinearArchivalTest : public testing::Test {
 
  public:
   static const size_t BUCKET_SIZE = 1024;
-  static const size_t MAX_BUCKETS = 8;
-  static const uint64_t ARRAY_SIZE = MAX_BUCKETS * BUCKET_SIZE;
+  static const size_t NUM_BUCKETS = 8;
+  static const uint64_t ARRAY_SIZE = NUM_BUCKETS * BUCKET_SIZE;
 
   typedef storage::encoded_ptr<uint8_t> encoded_ptr_t;
   typedef storage::read_only_encoded_ptr<uint8_t> read_only_ptr_t;
-  typedef monolog_linear<uint8_t, MAX_BUCKETS, BUCKET_SIZE, 1024> small_monolog_linear;
-  typedef archival::monolog_linear_archiver<uint8_t, MAX_BUCKETS, BUCKET_SIZE, 1024> small_monolog_archiver;
+  typedef monolog_linear<uint8_t, BUCKET_SIZE, 1024> small_monolog_linear;
+  typedef archival::monolog_linear_archiver<uint8_t, BUCKET_SIZE, 1024> small_monolog_archiver;
 
   void write_to_log(small_monolog_linear &log) {
     uint8_t buf[ARRAY_SIZE];
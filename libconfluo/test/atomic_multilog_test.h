@@ -246,6 +246,60 @@ TEST_F(AtomicMultilogTest, ArchiveTest) {
   mlog.archive();
 }
 
+TEST_F(AtomicMultilogTest, CompressArchiveTest) {
+  struct long_rec {
+    int64_t ts;
+    int64_t v;
+    char pad[48];
+  }__attribute__((packed));
+
+  atomic_multilog mlog(
+      "my_table",
+      schema_builder().add_column(primitive_types::LONG_TYPE(), "v")
+                      .add_column(primitive_types::STRING_TYPE(48), "pad").get_columns(),
+      "/tmp", storage::IN_MEMORY, archival_mode::COMPRESS, MGMT_POOL);
+  mlog.add_index("v", 1);
+  mlog.add_filter("zero", "v == 0");
+
+  // Fill one data log bucket and part of the next; timestamps lie far
+  // enough in the past for filter data to be archived
+  size_t nrecords = data_log_constants::BUCKET_SIZE / sizeof(long_rec) + 1024;
+  long_rec r;
+  memset(&r, 'x', sizeof(r));
+  for (size_t i = 0; i < nrecords; i++) {
+    r.ts = static_cast<int64_t>(i / 1024) * 1000000;
+    r.v = static_cast<int64_t>(i % 8);
+    mlog.append(&r);
+  }
+
+  size_t before = allocator::instance().memory_utilization();
+  mlog.archive(data_log_constants::BUCKET_SIZE);
+  size_t after = allocator::instance().memory_utilization();
+  ASSERT_LT(after + data_log_constants::BUCKET_SIZE / 2, before);
+
+  read_only_data_log_ptr bucket;
+  mlog.read(0, bucket);
+  auto aux = ptr_aux_block::get(ptr_metadata::get(bucket.get().ptr()));
+  ASSERT_EQ(state_type::D_ARCHIVED, aux.state_);
+  ASSERT_EQ(alloc_type::D_DEFAULT, ptr_metadata::get(bucket.get().ptr())->alloc_type_);
+
+  for (size_t i = 0; i < nrecords; i += 4099) {
+    std::vector<std::string> rec = mlog.read(i * sizeof(long_rec));
+    ASSERT_EQ(std::to_string(i % 8), rec[1]);
+    ASSERT_EQ(std::string(48, 'x'), rec[2]);
+  }
+
+  size_t count = 0;
+  for (auto c = mlog.execute_filter("v == 3"); c->has_more(); c->advance())
+    count++;
+  ASSERT_EQ(nrecords / 8, count);
+
+  count = 0;
+  for (auto c = mlog.query_filter("zero", 0, static_cast<uint64_t>(nrecords)); c->has_more(); c->advance())
+    count++;
+  ASSERT_EQ(nrecords / 8, count);
+}
+
 TEST_F(AtomicMultilogTest, IndexTest) {
   atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
   mlog.add_index("a");
@@ -386,6 +440,351 @@ TEST_F(AtomicMultilogTest, RemoveIndexTest) {
 
 // TODO: Separate out the tests
 // TODO: Add tests for aggregates only
+TEST_F(AtomicMultilogTest, BackfillIndexFilterTest) {
+  atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  int64_t now_ns = time_utils::cur_ns();
+  uint64_t beg = now_ns / configuration_params::TIME_RESOLUTION_NS();
+  uint64_t end = beg;
+  for (int32_t i = 0; i < 10000; i++) {
+    mlog.append(record(now_ns, i % 2 == 0, '0', 0, i, 0, 0.0, 0.01, "abc"));
+  }
+
+  mlog.add_index("d");
+  mlog.add_filter("filter1", "a == true");
+
+  // Appends proceed while existing records are backfilled
+  for (int32_t i = 10000; i < 20000; i++) {
+    mlog.append(record(now_ns, i % 2 == 0, '0', 0, i, 0, 0.0, 0.01, "abc"));
+  }
+
+  while (!mlog.index_backfill_status("d").done || !mlog.filter_backfill_status("filter1").done) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  backfill_status status = mlog.index_backfill_status("d");
+  ASSERT_FALSE(status.failed);
+  ASSERT_EQ(static_cast<uint64_t>(10000), status.total_records);
+  ASSERT_EQ(static_cast<uint64_t>(10000), status.backfilled_records);
+  ASSERT_TRUE(mlog.get_schema()[mlog.get_schema().get_field_index("d")].is_queryable());
+
+  // Backfilled and live records are both served by the index
+  for (int32_t d : {5, 9999, 10000, 15000}) {
+    size_t n = 0;
+    for (auto r = mlog.execute_filter("d == " + std::to_string(d)); r->has_more(); r->advance()) {
+      ASSERT_EQ(d, r->get().at(4).value().to_data().as<int32_t>());
+      n++;
+    }
+    ASSERT_EQ(static_cast<size_t>(1), n);
+  }
+
+  size_t n = 0;
+  for (auto r = mlog.query_filter("filter1", beg, end); r->has_more(); r->advance()) {
+    ASSERT_EQ(true, r->get().at(1).value().to_data().as<bool>());
+    n++;
+  }
+  ASSERT_EQ(static_cast<size_t>(10000), n);
+}
+
+TEST_F(AtomicMultilogTest, BackfillReaddIndexTest) {
+  atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  int64_t now_ns = time_utils::cur_ns();
+  for (int32_t i = 0; i < 20000; i++) {
+    mlog.append(record(now_ns, i % 2 == 0, '0', 0, i % 100, 0, 0.0, 0.01, "abc"));
+  }
+
+  const column_t &col = mlog.get_schema()[mlog.get_schema().get_field_index("d")];
+  for (int iter = 0; iter < 4; iter++) {
+    mlog.add_index("d");
+    // Let the first backfill run to a varying point before removing it
+    std::this_thread::sleep_for(std::chrono::milliseconds(5 * iter));
+    mlog.remove_index("d");
+    mlog.add_index("d");
+
+    // The index must not become queryable before its own backfill is done
+    while (true) {
+      bool queryable = col.is_queryable();
+      backfill_status status = mlog.index_backfill_status("d");
+      ASSERT_FALSE(queryable && !status.done);
+      if (status.done)
+        break;
+      std::this_thread::yield();
+    }
+    ASSERT_TRUE(col.is_queryable());
+
+    size_t n = 0;
+    for (auto r = mlog.execute_filter("d == 99"); r->has_more(); r->advance())
+      n++;
+    ASSERT_EQ(static_cast<size_t>(200), n);
+    mlog.remove_index("d");
+  }
+}
+
+TEST_F(AtomicMultilogTest, HashIndexTest) {
+  atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  mlog.add_index("d", 1.0, HASH_INDEX);
+  int64_t now_ns = time_utils::cur_ns();
+  for (int32_t i = 0; i < 1000; i++) {
+    mlog.append(record(now_ns, i % 2 == 0, '0', 0, i % 100, i % 10, 0.0, 0.01, "abc"));
+  }
+  // Records appended before the index are backfilled
+  mlog.add_index("e", 1.0, HASH_INDEX);
+  record_batch batch = build_batch(mlog, now_ns);
+  mlog.append_batch(batch);
+  while (!mlog.index_backfill_status("e").done) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  auto count = [&mlog](const std::string &expr) {
+    size_t n = 0;
+    for (auto r = mlog.execute_filter(expr); r->has_more(); r->advance())
+      n++;
+    return n;
+  };
+
+  // Equality predicates are served by the hash index
+  ASSERT_EQ(static_cast<size_t>(11), count("d == 4"));
+  ASSERT_EQ(static_cast<size_t>(101), count("e == 1"));
+  ASSERT_EQ(static_cast<size_t>(1), count("d == 14 && e == 1000000"));
+  ASSERT_EQ(static_cast<size_t>(21), count("d == 7 || d == 8"));
+  ASSERT_EQ(static_cast<size_t>(101), count("d == 4 || e == 4"));
+  ASSERT_EQ(static_cast<size_t>(0), count("d == 4 && d == 5"));
+  ASSERT_EQ(static_cast<size_t>(0), count("d == 1000"));
+
+  // Range predicates fall back to a full scan
+  ASSERT_EQ(static_cast<size_t>(10), count("d > 98"));
+  ASSERT_EQ(static_cast<size_t>(101), count("e == 1 && d >= 0"));
+
+  for (auto r = mlog.execute_filter("d == 42"); r->has_more(); r->advance())
+    ASSERT_EQ(2, r->get().at(5).value().to_data().as<int64_t>());
+}
+
+TEST_F(AtomicMultilogTest, CompositeIndexTest) {
+  atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  int64_t now_ns = time_utils::cur_ns();
+  for (int32_t i = 0; i < 1000; i++) {
+    mlog.append(record(now_ns, false, '0', static_cast<int16_t>(i % 10), i, 0, 0.0, 0.01, "abc"));
+  }
+  // Records appended before the index are backfilled
+  mlog.add_index({"c", "d"});
+  for (int32_t i = 1000; i < 2000; i++) {
+    mlog.append(record(now_ns, false, '0', static_cast<int16_t>(i % 10), i, 0, 0.0, 0.01, "abc"));
+  }
+  record_batch batch = build_batch(mlog, now_ns);
+  mlog.append_batch(batch);
+  while (!mlog.index_backfill_status(std::vector<std::string>{"c", "d"}).done) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  auto count = [&mlog](const std::string &expr) {
+    size_t n = 0;
+    for (auto r = mlog.execute_filter(expr); r->has_more(); r->advance())
+      n++;
+    return n;
+  };
+
+  // Equality prefix, with or without a trailing range
+  ASSERT_EQ(static_cast<size_t>(10), count("c == 3 && d >= 100 && d < 200"));
+  ASSERT_EQ(static_cast<size_t>(10), count("c == 3 && d > 1900"));
+  ASSERT_EQ(static_cast<size_t>(1), count("c == 3 && d == 13"));
+  ASSERT_EQ(static_cast<size_t>(0), count("c == 3 && d == 14"));
+  ASSERT_EQ(static_cast<size_t>(200), count("c == 3"));
+  ASSERT_EQ(static_cast<size_t>(27), count("c >= 8 && d < 100"));
+  ASSERT_EQ(static_cast<size_t>(1), count("c == 10 && d == 2"));
+  ASSERT_EQ(static_cast<size_t>(0), count("c == 3 && c == 4"));
+  ASSERT_EQ(static_cast<size_t>(2), count("(c == 3 && d == 13) || (c == 4 && d == 14)"));
+
+  // Predicates that do not constrain the first column fall back to a scan
+  ASSERT_EQ(static_cast<size_t>(1), count("d == 13"));
+
+  ASSERT_THROW(mlog.add_index({"c", "d"}), management_exception);
+  ASSERT_THROW(mlog.add_index({"c", "zz"}), management_exception);
+  mlog.remove_index(std::vector<std::string>{"c", "d"});
+  ASSERT_THROW(mlog.remove_index(std::vector<std::string>{"c", "d"}), management_exception);
+  ASSERT_EQ(static_cast<size_t>(10), count("c == 3 && d >= 100 && d < 200"));
+}
+
+TEST_F(AtomicMultilogTest, TimeRangeTest) {
+  atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  for (int32_t i = 0; i < 100; i++) {
+    mlog.append(record(1000 + 10 * i, false, '0', 0, i, 0, 0.0, 0.01, "abc"));
+  }
+
+  auto collect = [&mlog](uint64_t begin_ts, uint64_t end_ts, bool reverse) {
+    std::vector<int32_t> ds;
+    for (auto r = mlog.query_time_range(begin_ts, end_ts, reverse); r->has_more(); r->advance())
+      ds.push_back(r->get().at(4).value().to_data().as<int32_t>());
+    return ds;
+  };
+
+  // Timestamps in append order: binary search
+  ASSERT_EQ(std::vector<int32_t>({5, 6, 7, 8, 9, 10}), collect(1050, 1100, false));
+  ASSERT_EQ(std::vector<int32_t>({10, 9, 8, 7, 6, 5}), collect(1050, 1100, true));
+  ASSERT_EQ(std::vector<int32_t>({6, 7}), collect(1051, 1079, false));
+  ASSERT_EQ(std::vector<int32_t>({99}), collect(1990, limits::ulong_max, false));
+  ASSERT_EQ(std::vector<int32_t>({0}), collect(0, 1000, true));
+  ASSERT_TRUE(collect(0, 999, false).empty());
+  ASSERT_TRUE(collect(1001, 1009, false).empty());
+  ASSERT_TRUE(collect(1100, 1050, false).empty());
+  ASSERT_EQ(static_cast<size_t>(100), collect(0, limits::ulong_max, false).size());
+
+  // Out of order timestamps: data log scan
+  mlog.append(record(1005, false, '0', 0, 100, 0, 0.0, 0.01, "abc"));
+  mlog.append(record(1205, false, '0', 0, 101, 0, 0.0, 0.01, "abc"));
+  ASSERT_EQ(std::vector<int32_t>({0, 100, 1}), collect(1000, 1010, false));
+  ASSERT_EQ(std::vector<int32_t>({1, 100, 0}), collect(1000, 1010, true));
+
+  // Out of order timestamps: timestamp index, with multiple timestamps per bucket
+  mlog.add_index("TIMESTAMP", 100.0);
+  while (!mlog.index_backfill_status("TIMESTAMP").done) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(std::vector<int32_t>({0, 100, 1}), collect(1000, 1010, false));
+  ASSERT_EQ(std::vector<int32_t>({1, 100, 0}), collect(1000, 1010, true));
+  ASSERT_EQ(std::vector<int32_t>({19, 20, 101, 21}), collect(1190, 1210, false));
+  ASSERT_EQ(std::vector<int32_t>({21, 101, 20, 19}), collect(1190, 1210, true));
+  ASSERT_EQ(static_cast<size_t>(102), collect(0, limits::ulong_max, true).size());
+  ASSERT_TRUE(collect(5000, 6000, false).empty());
+}
+
+TEST_F(AtomicMultilogTest, AggregateSeriesTest) {
+  atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  mlog.add_filter("all", "d >= 0");
+  mlog.add_aggregate("sum_d", "all", "SUM(d)");
+  mlog.add_aggregate("max_d", "all", "MAX(d)");
+  mlog.add_aggregate("cnt_d", "all", "COUNT(d)");
+
+  // One record per ms in [1000, 1030), except for [1010, 1020)
+  const int64_t ms = static_cast<int64_t>(configuration_params::TIME_RESOLUTION_NS());
+  for (int32_t i = 0; i < 30; i++) {
+    if (i < 10 || i >= 20)
+      mlog.append(record((1000 + i) * ms, false, '0', 0, i, 0, 0.0, 0.01, "abc"));
+    if (i == 25)
+      mlog.append(record((1000 + i) * ms, false, '0', 0, 100, 0, 0.0, 0.01, "abc"));
+  }
+
+  auto sums = mlog.get_aggregate_series("sum_d", 1000, 1029, 10);
+  ASSERT_EQ(static_cast<size_t>(3), sums.size());
+  ASSERT_TRUE(numeric(45) == sums[0]);
+  ASSERT_TRUE(numeric(0) == sums[1]);
+  ASSERT_TRUE(numeric(345) == sums[2]);
+  ASSERT_TRUE(numeric(390) == mlog.get_aggregate("sum_d", 1000, 1029));
+
+  auto maxs = mlog.get_aggregate_series("max_d", 1000, 1029, 10);
+  ASSERT_EQ(static_cast<size_t>(3), maxs.size());
+  ASSERT_TRUE(numeric(9) == maxs[0]);
+  ASSERT_TRUE(numeric(100) == maxs[2]);
+
+  auto counts = mlog.get_aggregate_series("cnt_d", 1000, 1034, 10);
+  ASSERT_EQ(static_cast<size_t>(4), counts.size());
+  ASSERT_TRUE(numeric(10) == counts[0]);
+  ASSERT_TRUE(numeric(0) == counts[1]);
+  ASSERT_TRUE(numeric(11) == counts[2]);
+  ASSERT_TRUE(numeric(0) == counts[3]);
+
+  // Intervals that are not aligned with the range
+  sums = mlog.get_aggregate_series("sum_d", 1005, 1024, 10);
+  ASSERT_EQ(static_cast<size_t>(2), sums.size());
+  ASSERT_TRUE(numeric(35) == sums[0]);
+  ASSERT_TRUE(numeric(110) == sums[1]);
+
+  ASSERT_TRUE(mlog.get_aggregate_series("sum_d", 1029, 1000, 10).empty());
+  ASSERT_THROW(mlog.get_aggregate_series("sum_d", 1000, 1029, 0), invalid_operation_exception);
+  ASSERT_THROW(mlog.get_aggregate_series("none", 1000, 1029, 10), invalid_operation_exception);
+
+  // Series are capped at max_aggregate_series_points intervals
+  size_t max_points = configuration_params::MAX_AGGREGATE_SERIES_POINTS();
+  ASSERT_EQ(max_points, mlog.get_aggregate_series("sum_d", 1000, 1000 + max_points - 1, 1).size());
+  ASSERT_THROW(mlog.get_aggregate_series("sum_d", 1000, 1000 + max_points, 1), invalid_operation_exception);
+  ASSERT_THROW(mlog.get_aggregate_series("sum_d", 0, limits::ulong_max, 1), invalid_operation_exception);
+  ASSERT_THROW(mlog.execute_aggregate_series("SUM(d)", "", 0, limits::ulong_max, 1), invalid_operation_exception);
+
+  ASSERT_EQ("sum", mlog.get_aggregator("sum_d").name);
+  ASSERT_THROW(mlog.get_aggregator("none"), invalid_operation_exception);
+
+  // Ad-hoc aggregates over the raw records
+  sums = mlog.execute_aggregate_series("SUM(d)", "", 1000 * ms, 1030 * ms - 1, 10 * ms);
+  ASSERT_EQ(static_cast<size_t>(3), sums.size());
+  ASSERT_TRUE(numeric(45) == sums[0]);
+  ASSERT_TRUE(numeric(0) == sums[1]);
+  ASSERT_TRUE(numeric(345) == sums[2]);
+
+  sums = mlog.execute_aggregate_series("SUM(d)", "d < 25", 1000 * ms, 1030 * ms - 1, 10 * ms);
+  ASSERT_EQ(static_cast<size_t>(3), sums.size());
+  ASSERT_TRUE(numeric(45) == sums[0]);
+  ASSERT_TRUE(numeric(110) == sums[2]);
+}
+
+TEST_F(AtomicMultilogTest, VarcharTest) {
+  std::vector<column_t> vs = schema_builder()
+      .add_column(primitive_types::INT_TYPE(), "id")
+      .add_column(primitive_types::VARCHAR_TYPE(), "url")
+      .add_column(primitive_types::VARCHAR_TYPE(), "agent")
+      .get_columns();
+  atomic_multilog mlog("my_table", vs, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  ASSERT_EQ(static_cast<size_t>(8 + 4 + 2 * var_ref::SIZE), mlog.record_size());
+  mlog.add_index("url");
+  mlog.add_index("agent", 1.0, HASH_INDEX);
+
+  auto url = [](int32_t i) {
+    return "http://example.com/path/" + std::to_string(i % 10) + std::string(static_cast<size_t>(i % 7), 'x');
+  };
+  auto agent = [](int32_t i) {
+    return i % 2 == 0 ? std::string("curl") : std::string("Mozilla/5.0 (X11; Linux x86_64)");
+  };
+  int64_t now_ns = time_utils::cur_ns();
+  for (int32_t i = 0; i < 100; i++) {
+    mlog.append({std::to_string(now_ns), std::to_string(i), url(i), agent(i)});
+  }
+  record_batch_builder builder = mlog.get_batch_builder();
+  for (int32_t i = 100; i < 200; i++) {
+    builder.add_record({std::to_string(now_ns), std::to_string(i), url(i), agent(i)});
+  }
+  record_batch batch = builder.get_batch();
+  mlog.append_batch(batch);
+  // Empty values
+  size_t empty_off = mlog.append({std::to_string(now_ns), "200", "", ""});
+  ASSERT_EQ(static_cast<size_t>(201), mlog.num_records());
+
+  for (int32_t i = 0; i < 200; i++) {
+    std::vector<std::string> rec = mlog.read(static_cast<uint64_t>(i) * mlog.record_size());
+    ASSERT_EQ(std::to_string(i), rec[1]);
+    ASSERT_EQ(url(i), rec[2]);
+    ASSERT_EQ(agent(i), rec[3]);
+  }
+  std::vector<std::string> empty = mlog.read(empty_off);
+  ASSERT_EQ("", empty[2]);
+  ASSERT_EQ("", empty[3]);
+
+  auto count = [&mlog](const std::string &expr) {
+    size_t n = 0;
+    for (auto r = mlog.execute_filter(expr); r->has_more(); r->advance())
+      n++;
+    return n;
+  };
+
+  // Values share a prefix longer than the index key
+  ASSERT_EQ(static_cast<size_t>(3), count("url == \"" + url(3) + "\""));
+  ASSERT_EQ(static_cast<size_t>(2), count("url == \"http://example.com/path/3\""));
+  ASSERT_EQ(static_cast<size_t>(37), count("url > \"http://example.com/path/8\""));
+  ASSERT_EQ(static_cast<size_t>(21), count("url < \"http://example.com/path/1\""));
+  ASSERT_EQ(static_cast<size_t>(100), count("agent == \"curl\""));
+  ASSERT_EQ(static_cast<size_t>(10), count("agent == \"curl\" && id < 20"));
+  ASSERT_EQ(static_cast<size_t>(0), count("agent == \"wget\""));
+
+  for (auto r = mlog.execute_filter("agent == \"curl\" && id == 42"); r->has_more(); r->advance()) {
+    ASSERT_EQ(url(42), r->get().at(2).value().to_data().as<std::string>());
+    ASSERT_EQ(std::string("curl"), r->get().at(3).value().to_data().as<std::string>());
+  }
+
+  mlog.add_filter("curl", "agent == \"curl\"");
+  mlog.add_aggregate("num_curl", "curl", "COUNT(id)");
+  int64_t later_ns = now_ns + INT64_C(10000000000);
+  mlog.append({std::to_string(later_ns), "201", url(201), "curl"});
+  mlog.append({std::to_string(later_ns), "202", url(202), "wget"});
+  uint64_t later_ms = static_cast<uint64_t>(later_ns / 1000000);
+  ASSERT_EQ(1, mlog.get_aggregate("num_curl", later_ms, later_ms).as<int64_t>());
+}
+
 TEST_F(AtomicMultilogTest, RemoveFilterTriggerTest) {
   atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
   mlog.add_filter("filter1", "a == true");
@@ -452,6 +851,28 @@ TEST_F(AtomicMultilogTest, RemoveFilterTriggerTest) {
 
 }
 
+TEST_F(AtomicMultilogTest, MonitoredCountTest) {
+  atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  mlog.add_filter("filter1", "a == true");
+  mlog.add_aggregate("agg1", "filter1", "SUM(d)");
+  mlog.add_aggregate("agg2", "filter1", "SUM(d)");
+  mlog.install_trigger("trigger1", "agg1 >= 10");
+  mlog.install_trigger("trigger2", "agg2 >= 10");
+  ASSERT_EQ(2U, mlog.num_monitored());
+
+  // Removing an aggregate unregisters its triggers, exactly once
+  mlog.remove_aggregate("agg1");
+  ASSERT_EQ(1U, mlog.num_monitored());
+  mlog.remove_trigger("trigger1");
+  ASSERT_EQ(1U, mlog.num_monitored());
+
+  // So does removing a filter
+  mlog.remove_filter("filter1");
+  ASSERT_EQ(0U, mlog.num_monitored());
+  mlog.remove_trigger("trigger2");
+  ASSERT_EQ(0U, mlog.num_monitored());
+}
+
 // TODO: Separate out the tests
 TEST_F(AtomicMultilogTest, FilterAggregateTriggerTest) {
   atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
@@ -657,6 +1078,55 @@ TEST_F(AtomicMultilogTest, FilterAggregateTriggerTest) {
   ASSERT_TRUE(a8->empty());
 }
 
+TEST_F(AtomicMultilogTest, EagerTriggerTest) {
+  atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  mlog.add_filter("filter1", "a == true");
+  mlog.add_filter("filter2", "b > 4");
+  mlog.add_aggregate("agg1", "filter1", "SUM(d)");
+  mlog.add_aggregate("agg2", "filter2", "SUM(d)");
+  mlog.install_trigger("trigger1", "agg1 >= 10", configuration_params::MONITOR_PERIODICITY_MS(), EAGER_TRIGGER);
+  mlog.install_trigger("trigger2", "agg2 >= 1000", configuration_params::MONITOR_PERIODICITY_MS(), EAGER_TRIGGER);
+
+  int64_t now_ns = time_utils::cur_ns();
+  uint64_t beg = now_ns / configuration_params::TIME_RESOLUTION_NS();
+  mlog.append(record(now_ns, true, '1', 10, 2, 1, 0.1, 0.02, "defg"));
+  mlog.append(record(now_ns, true, '3', 30, 6, 100, 0.3, 0.04, "mnopqr"));
+  mlog.append(record(now_ns, true, '5', 50, 10, 10000, 0.5, 0.06, "yyy"));
+  mlog.append(record(now_ns, true, '7', 70, 14, 1000000, 0.7, 0.08, "zzz"));
+
+  // Raised by the append that crossed the threshold, without waiting for the monitor
+  auto a1 = mlog.get_alerts(beg, beg, "trigger1");
+  ASSERT_TRUE(a1->has_more());
+  ASSERT_EQ("trigger1", a1->get().trigger_name);
+  ASSERT_EQ(beg, a1->get().time_bucket);
+  ASSERT_TRUE(numeric(18) == a1->get().value);
+  a1->advance();
+  ASSERT_TRUE(a1->empty());
+
+  // Batched appends raise one alert for the whole batch
+  int64_t later_ns = now_ns + INT64_C(10000000000);
+  uint64_t later = later_ns / configuration_params::TIME_RESOLUTION_NS();
+  record_batch batch = build_batch(mlog, later_ns);
+  mlog.append_batch(batch);
+  auto a2 = mlog.get_alerts(later, later, "trigger1");
+  ASSERT_TRUE(a2->has_more());
+  ASSERT_TRUE(numeric(32) == a2->get().value);
+  a2->advance();
+  ASSERT_TRUE(a2->empty());
+
+  ASSERT_TRUE(mlog.get_alerts(beg, later, "trigger2")->empty());
+
+  mlog.remove_trigger("trigger1");
+  int64_t last_ns = later_ns + INT64_C(10000000000);
+  mlog.append(record(last_ns, true, '9', 90, 100, 1, 0.1, 0.02, "abc"));
+  size_t alert_count = 0;
+  for (auto a = mlog.get_alerts(beg, last_ns / configuration_params::TIME_RESOLUTION_NS()); a->has_more();
+       a->advance()) {
+    alert_count++;
+  }
+  ASSERT_EQ(size_t(2), alert_count);
+}
+
 TEST_F(AtomicMultilogTest, BatchIndexTest) {
   atomic_multilog mlog("my_table", s, "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
   mlog.add_index("a");
@@ -136,4 +136,52 @@ TEST_F(ConfluoStoreTest, RemoveTableTest) {
   }
 }
 
+TEST_F(ConfluoStoreTest, MaterializedViewTest) {
+  confluo_store store("/tmp");
+  store.create_atomic_multilog("view_src", s, storage::storage_mode::IN_MEMORY);
+  atomic_multilog *src = store.get_atomic_multilog("view_src");
+  src->add_filter("all", "d >= 0");
+
+  std::vector<std::string> aggs = {"SUM(d)", "COUNT(d)"};
+  store.create_materialized_view("by_b", "view_src", "all", "b", aggs, 100);
+  atomic_multilog *view = store.get_atomic_multilog("by_b");
+  ASSERT_EQ(static_cast<size_t>(4), view->get_schema().size());
+  ASSERT_EQ(primitive_types::CHAR_TYPE(), view->get_schema()["B"].type());
+  ASSERT_EQ(primitive_types::DOUBLE_TYPE(), view->get_schema()["SUM_D"].type());
+  ASSERT_EQ(primitive_types::ULONG_TYPE(), view->get_schema()["COUNT_D"].type());
+
+  // Invalid views
+  ASSERT_THROW(store.create_materialized_view("none", "view_src", "none", "b", aggs, 100), management_exception);
+  ASSERT_THROW(store.create_materialized_view("bad_col", "view_src", "all", "x", aggs, 100), management_exception);
+  ASSERT_THROW(src->add_materialized_view("bad_schema", "all", "c", aggs, 100, view), management_exception);
+  ASSERT_THROW(src->add_materialized_view("self", "all", "b", aggs, 100, src), management_exception);
+
+  for (int32_t i = 0; i < 100; i++) {
+    src->append(record(false, static_cast<int8_t>('0' + i % 4), 0, i, 0, 0.0, 0.01, "abc"));
+  }
+
+  // Wait for all windows holding the records to be materialized
+  std::map<int8_t, double> sums;
+  uint64_t count = 0;
+  for (int attempt = 0; attempt < 500 && count < 100; attempt++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    sums.clear();
+    count = 0;
+    for (auto c = view->query_time_range(0, UINT64_MAX); c->has_more(); c->advance()) {
+      const record_t &rec = c->get();
+      sums[rec[1].value().as<int8_t>()] += rec[2].value().as<double>();
+      count += rec[3].value().as<uint64_t>();
+    }
+  }
+  ASSERT_EQ(static_cast<uint64_t>(100), count);
+  ASSERT_EQ(static_cast<size_t>(4), sums.size());
+  for (int8_t b = 0; b < 4; b++) {
+    // Sum of d for d = b, b + 4, ..., b + 96
+    ASSERT_EQ(25.0 * b + 1200.0, sums['0' + b]);
+  }
+
+  src->remove_materialized_view("by_b");
+  ASSERT_THROW(src->remove_materialized_view("by_b"), management_exception);
+}
+
 #endif /* CONFLUO_TEST_CONFLUO_STORE_TEST_H_ */
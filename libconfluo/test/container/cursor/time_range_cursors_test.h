@@ -0,0 +1,68 @@
+#ifndef CONFLUO_TEST_TIME_RANGE_CURSORS_TEST_H_
+#define CONFLUO_TEST_TIME_RANGE_CURSORS_TEST_H_
+
+#include "container/cursor/time_range_cursors.h"
+
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+
+class TimeRangeCursorsTest : public testing::Test {
+ public:
+  struct ts_rec {
+    uint64_t ts;
+    uint64_t val;
+  };
+
+  // Appends records with timestamps (i * 37) % 101, so every timestamp in
+  // [0, 101) occurs once in a shuffled order
+  static void fill(data_log &log) {
+    for (uint64_t i = 0; i < 101; i++) {
+      ts_rec r = {(i * 37) % 101, i};
+      log.append(reinterpret_cast<const uint8_t *>(&r), sizeof(ts_rec));
+    }
+  }
+
+  static std::vector<uint64_t> collect(time_scan_cursor &c, const data_log &log) {
+    std::vector<uint64_t> ts;
+    for (; c.has_more(); c.advance())
+      ts.push_back(record_timestamp(&log, c.get()));
+    return ts;
+  }
+};
+
+TEST_F(TimeRangeCursorsTest, TimeScanCursorTest) {
+  data_log log("data_log", "/tmp", storage::IN_MEMORY);
+  fill(log);
+  uint64_t version = log.size();
+
+  // Batches far smaller than the number of matches
+  for (size_t batch_size : {1, 3, 16, 1024}) {
+    time_scan_cursor fwd(&log, sizeof(ts_rec), 10, 90, version, false, batch_size);
+    std::vector<uint64_t> ts = collect(fwd, log);
+    ASSERT_EQ(static_cast<size_t>(81), ts.size());
+    for (size_t i = 0; i < ts.size(); i++)
+      ASSERT_EQ(10 + i, ts[i]);
+
+    time_scan_cursor rev(&log, sizeof(ts_rec), 10, 90, version, true, batch_size);
+    ts = collect(rev, log);
+    ASSERT_EQ(static_cast<size_t>(81), ts.size());
+    for (size_t i = 0; i < ts.size(); i++)
+      ASSERT_EQ(90 - i, ts[i]);
+  }
+
+  // Duplicate timestamps are returned in offset order
+  ts_rec dup = {50, 101};
+  log.append(reinterpret_cast<const uint8_t *>(&dup), sizeof(ts_rec));
+  time_scan_cursor c(&log, sizeof(ts_rec), 50, 50, log.size(), false, 1);
+  std::vector<uint64_t> offsets;
+  for (; c.has_more(); c.advance())
+    offsets.push_back(c.get());
+  ASSERT_EQ(static_cast<size_t>(2), offsets.size());
+  ASSERT_LT(offsets[0], offsets[1]);
+
+  time_scan_cursor empty(&log, sizeof(ts_rec), 200, 300, log.size(), false, 4);
+  ASSERT_FALSE(empty.has_more());
+}
+
+#endif /* CONFLUO_TEST_TIME_RANGE_CURSORS_TEST_H_ */
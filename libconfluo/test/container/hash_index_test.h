@@ -0,0 +1,89 @@
+#ifndef CONFLUO_TEST_HASH_INDEX_TEST_H_
+#define CONFLUO_TEST_HASH_INDEX_TEST_H_
+
+#include <thread>
+#include <vector>
+
+#include "container/hash_index.h"
+#include "gtest/gtest.h"
+
+using namespace ::confluo::index;
+
+class HashIndexTest : public testing::Test {
+};
+
+TEST_F(HashIndexTest, InsertGetTest) {
+  hash_index idx(sizeof(int32_t), 1024);
+  for (int32_t i = 0; i < 4096; i++)
+    idx.insert(byte_string(i * 8), i);
+
+  ASSERT_EQ(static_cast<size_t>(4096), idx.num_keys());
+  for (int32_t i = 0; i < 4096; i++) {
+    const reflog *r = idx.get(byte_string(i * 8));
+    ASSERT_TRUE(r != nullptr);
+    ASSERT_EQ(static_cast<size_t>(1), r->size());
+    ASSERT_EQ(static_cast<size_t>(i), r->at(0));
+  }
+
+  ASSERT_TRUE(idx.get(byte_string(7)) == nullptr);
+  ASSERT_EQ(static_cast<size_t>(0), idx.approx_count(byte_string(7)));
+}
+
+TEST_F(HashIndexTest, DuplicateKeyTest) {
+  hash_index idx(sizeof(int32_t), 1024);
+  for (int32_t i = 0; i < 1000; i++)
+    idx.insert(byte_string(i % 10), i);
+
+  ASSERT_EQ(static_cast<size_t>(10), idx.num_keys());
+  for (int32_t k = 0; k < 10; k++) {
+    const reflog *r = idx.get(byte_string(k));
+    ASSERT_TRUE(r != nullptr);
+    ASSERT_EQ(static_cast<size_t>(100), r->size());
+    for (size_t j = 0; j < r->size(); j++)
+      ASSERT_EQ(static_cast<size_t>(k), r->at(j) % 10);
+  }
+}
+
+TEST_F(HashIndexTest, ConcurrentInsertTest) {
+  // Starts small so that buckets split while threads insert
+  hash_index idx(sizeof(int32_t), 16);
+  const int32_t nthreads = 4;
+  const int32_t nkeys = 10000;
+  std::vector<std::thread> workers;
+  for (int32_t t = 0; t < nthreads; t++) {
+    workers.push_back(std::thread([&idx, t, nthreads, nkeys] {
+      for (int32_t i = 0; i < nkeys; i++)
+        idx.insert(byte_string(i), static_cast<uint64_t>(i * nthreads + t));
+    }));
+  }
+  for (auto &w : workers)
+    w.join();
+
+  ASSERT_EQ(static_cast<size_t>(nkeys), idx.num_keys());
+  for (int32_t i = 0; i < nkeys; i++) {
+    const reflog *r = idx.get(byte_string(i));
+    ASSERT_TRUE(r != nullptr);
+    ASSERT_EQ(static_cast<size_t>(nthreads), r->size());
+  }
+}
+
+TEST_F(HashIndexTest, GrowthTest) {
+  hash_index idx(sizeof(int32_t), 16);
+  const int32_t nkeys = 10000;
+  for (int32_t i = 0; i < nkeys; i++)
+    idx.insert(byte_string(i), static_cast<uint64_t>(i));
+
+  // Buckets double with the number of keys, bounding the average chain
+  ASSERT_EQ(static_cast<size_t>(nkeys), idx.num_keys());
+  ASSERT_GE(idx.num_buckets() * hash_index::MAX_LOAD, idx.num_keys());
+  ASSERT_LT(idx.num_buckets(), idx.num_keys());
+  for (int32_t i = 0; i < nkeys; i++) {
+    const reflog *r = idx.get(byte_string(i));
+    ASSERT_TRUE(r != nullptr);
+    ASSERT_EQ(static_cast<size_t>(1), r->size());
+    ASSERT_EQ(static_cast<uint64_t>(i), r->at(0));
+  }
+  ASSERT_TRUE(idx.get(byte_string(nkeys)) == nullptr);
+}
+
+#endif /* CONFLUO_TEST_HASH_INDEX_TEST_H_ */
@@ -145,30 +145,78 @@ TEST_F(MonoLogTest, MonoLogExp2LinearTest) {
 }
 
 TEST_F(MonoLogTest, MonoLogLinearIMTest) {
-  monolog_linear<uint8_t, 8, 1048576, 1024> array("mlog", "/tmp", IN_MEMORY);
+  monolog_linear<uint8_t, 1048576, 1024> array("mlog", "/tmp", IN_MEMORY);
   monolog_test(array);
   for (uint32_t num_threads = 1; num_threads <= 4; num_threads++) {
-    monolog_linear<uint8_t, 8, 1048576, 1024> arr("mlog", "/tmp", IN_MEMORY);
+    monolog_linear<uint8_t, 1048576, 1024> arr("mlog", "/tmp", IN_MEMORY);
     monolog_test_mt(arr, num_threads);
   }
 }
 
 TEST_F(MonoLogTest, MonoLogLinearDRTest) {
-  monolog_linear<uint8_t, 8, 1048576, 1024> array("mlog", "/tmp", DURABLE_RELAXED);
+  monolog_linear<uint8_t, 1048576, 1024> array("mlog", "/tmp", DURABLE_RELAXED);
   monolog_test(array);
   for (uint32_t num_threads = 1; num_threads <= 4; num_threads++) {
-    monolog_linear<uint8_t, 8, 1048576, 1024> arr("mlog", "/tmp", DURABLE_RELAXED);
+    monolog_linear<uint8_t, 1048576, 1024> arr("mlog", "/tmp", DURABLE_RELAXED);
     monolog_test_mt(arr, num_threads);
   }
 }
 
 TEST_F(MonoLogTest, MonoLogLinearDTest) {
-  monolog_linear<uint8_t, 8, 1048576, 1024> array("mlog", "/tmp", DURABLE);
+  monolog_linear<uint8_t, 1048576, 1024> array("mlog", "/tmp", DURABLE);
   monolog_test(array);
   for (uint32_t num_threads = 1; num_threads <= 4; num_threads++) {
-    monolog_linear<uint8_t, 8, 1048576, 1024> arr("mlog", "/tmp", DURABLE);
+    monolog_linear<uint8_t, 1048576, 1024> arr("mlog", "/tmp", DURABLE);
     monolog_test_mt(arr, num_threads);
   }
 }
 
+TEST_F(MonoLogTest, BucketGeometryTest) {
+  bucket_geometry geometry(1000, 8192);
+  ASSERT_EQ(1024U, geometry.first_bucket_size());
+  ASSERT_EQ(8192U, geometry.max_bucket_size());
+  size_t sizes[] = {1024, 2048, 4096, 8192, 8192, 8192};
+  size_t start = 0;
+  for (size_t i = 0; i < 6; i++) {
+    ASSERT_EQ(sizes[i], geometry.bucket_size(i));
+    ASSERT_EQ(start, geometry.bucket_start(i));
+    ASSERT_EQ(i, geometry.bucket_idx(start));
+    ASSERT_EQ(i, geometry.bucket_idx(start + sizes[i] - 1));
+    start += sizes[i];
+  }
+
+  bucket_geometry fixed = bucket_geometry::fixed(4096);
+  ASSERT_EQ(4096U, fixed.first_bucket_size());
+  ASSERT_EQ(4096U, fixed.max_bucket_size());
+  ASSERT_EQ(3U, fixed.bucket_idx(3 * 4096 + 7));
+  ASSERT_EQ(3U * 4096, fixed.bucket_start(3));
+  ASSERT_TRUE(geometry.at_least(2048) == bucket_geometry(2048, 8192));
+}
+
+TEST_F(MonoLogTest, MonoLogLinearGeometryTest) {
+  // Small growing buckets, with records that cross bucket boundaries and
+  // enough buckets to grow the bucket directory several times
+  const size_t record_size = 7;
+  const size_t nrecords = 100000;
+  monolog_linear<uint8_t, 1048576, 1024> array("mlog", "/tmp", IN_MEMORY, bucket_geometry(64, 1024));
+  uint8_t rec[record_size];
+  for (size_t i = 0; i < nrecords; i++) {
+    for (size_t j = 0; j < record_size; j++)
+      rec[j] = static_cast<uint8_t>(i + j);
+    ASSERT_EQ(i * record_size, array.append(rec, record_size));
+  }
+
+  uint8_t out[record_size];
+  for (size_t i = 0; i < nrecords; i++) {
+    array.read(i * record_size, out, record_size);
+    read_only_encoded_ptr<uint8_t> ptr;
+    array.cptr(i * record_size, ptr);
+    auto decoded = ptr.decode(0, record_size);
+    for (size_t j = 0; j < record_size; j++) {
+      ASSERT_EQ(static_cast<uint8_t>(i + j), out[j]);
+      ASSERT_EQ(static_cast<uint8_t>(i + j), decoded.get()[j]);
+    }
+  }
+}
+
 #endif // CONFLUO_TEST_MONOLOG_TEST_H_
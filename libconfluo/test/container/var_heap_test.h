@@ -0,0 +1,111 @@
+#ifndef CONFLUO_TEST_VAR_HEAP_TEST_H_
+#define CONFLUO_TEST_VAR_HEAP_TEST_H_
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "container/var_heap.h"
+#include "types/var_ref.h"
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+
+class VarHeapTest : public testing::Test {
+};
+
+TEST_F(VarHeapTest, VarRefTest) {
+  uint64_t ref = var_ref::pack(UINT64_C(123456789), 4321);
+  ASSERT_EQ(UINT64_C(123456789), var_ref::offset(ref));
+  ASSERT_EQ(static_cast<size_t>(4321), var_ref::length(ref));
+
+  ref = var_ref::pack(var_ref::MAX_OFFSET, var_ref::MAX_LENGTH);
+  ASSERT_EQ(var_ref::MAX_OFFSET, var_ref::offset(ref));
+  ASSERT_EQ(var_ref::MAX_LENGTH, var_ref::length(ref));
+
+  uint8_t buf[var_ref::SIZE + 1];
+  var_ref::store(buf + 1, ref);
+  ASSERT_EQ(ref, var_ref::load(buf + 1));
+}
+
+TEST_F(VarHeapTest, AppendReadTest) {
+  var_heap heap("/tmp", storage::IN_MEMORY);
+  std::vector<std::pair<uint64_t, std::string>> values;
+  for (size_t i = 0; i < 1000; i++) {
+    std::string value(i % 37, static_cast<char>('a' + i % 26));
+    uint64_t offset = heap.append(reinterpret_cast<const uint8_t *>(value.data()), value.length());
+    values.push_back(std::make_pair(offset, value));
+  }
+
+  size_t total = 0;
+  for (auto &v : values) {
+    std::string out(v.second.length(), '\0');
+    heap.read(v.first, reinterpret_cast<uint8_t *>(&out[0]), out.length());
+    ASSERT_EQ(v.second, out);
+    total += v.second.length();
+  }
+  ASSERT_EQ(total, heap.size());
+}
+
+TEST_F(VarHeapTest, SpanBucketsTest) {
+  var_heap heap("/tmp", storage::IN_MEMORY);
+  size_t len = data_log_constants::BUCKET_SIZE / 3 + 7;
+  std::vector<uint64_t> offsets;
+  for (size_t i = 0; i < 4; i++) {
+    std::string value(len, static_cast<char>('a' + i));
+    offsets.push_back(heap.append(reinterpret_cast<const uint8_t *>(value.data()), len));
+  }
+  for (size_t i = 0; i < 4; i++) {
+    std::string out(len, '\0');
+    heap.read(offsets[i], reinterpret_cast<uint8_t *>(&out[0]), len);
+    ASSERT_EQ(std::string(len, static_cast<char>('a' + i)), out);
+  }
+}
+
+TEST_F(VarHeapTest, ConcurrentAppendTest) {
+  var_heap heap("/tmp", storage::IN_MEMORY);
+  const size_t num_threads = 4;
+  const size_t num_values = 10000;
+  std::vector<std::vector<uint64_t>> offsets(num_threads);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < num_threads; t++) {
+    workers.push_back(std::thread([&heap, &offsets, t, num_values] {
+      std::string value(t + 1, static_cast<char>('a' + t));
+      for (size_t i = 0; i < num_values; i++)
+        offsets[t].push_back(heap.append(reinterpret_cast<const uint8_t *>(value.data()), value.length()));
+    }));
+  }
+  for (auto &worker : workers)
+    worker.join();
+
+  ASSERT_EQ(num_values * (num_threads * (num_threads + 1) / 2), heap.size());
+  for (size_t t = 0; t < num_threads; t++) {
+    for (uint64_t offset : offsets[t]) {
+      std::string out(t + 1, '\0');
+      heap.read(offset, reinterpret_cast<uint8_t *>(&out[0]), out.length());
+      ASSERT_EQ(std::string(t + 1, static_cast<char>('a' + t)), out);
+    }
+  }
+}
+
+TEST_F(VarHeapTest, OutOfOrderCommitTest) {
+  var_heap heap("/tmp", storage::IN_MEMORY);
+  uint64_t o1 = heap.reserve(8);
+  uint64_t o2 = heap.reserve(16);
+  uint64_t o3 = heap.reserve(4);
+
+  // Later ranges commit without waiting, but the prefix only covers
+  // completely written ranges
+  heap.commit(o3, 4);
+  ASSERT_EQ(static_cast<size_t>(0), heap.size());
+  heap.commit(o2, 16);
+  ASSERT_EQ(static_cast<size_t>(0), heap.size());
+  heap.commit(o1, 8);
+  ASSERT_EQ(static_cast<size_t>(28), heap.size());
+
+  uint64_t o4 = heap.reserve(2);
+  heap.commit(o4, 2);
+  ASSERT_EQ(static_cast<size_t>(30), heap.size());
+}
+
+#endif /* CONFLUO_TEST_VAR_HEAP_TEST_H_ */
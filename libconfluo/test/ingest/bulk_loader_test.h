@@ -0,0 +1,159 @@
+#ifndef CONFLUO_TEST_BULK_LOADER_TEST_H_
+#define CONFLUO_TEST_BULK_LOADER_TEST_H_
+
+#include <fstream>
+#include <sstream>
+
+#include "atomic_multilog.h"
+#include "ingest/bulk_loader.h"
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+using namespace ::confluo::ingest;
+
+class BulkLoaderTest : public testing::Test {
+ public:
+  static task_pool MGMT_POOL;
+  static const size_t NUM_RECORDS = 10000;
+
+  struct rec {
+    int64_t ts;
+    int64_t v;
+    char s[16];
+  }__attribute__((packed));
+
+  static std::vector<column_t> schema() {
+    return schema_builder().add_column(primitive_types::LONG_TYPE(), "v")
+                           .add_column(primitive_types::STRING_TYPE(16), "s").get_columns();
+  }
+
+  static size_t count(atomic_multilog &mlog, const std::string &expr) {
+    size_t n = 0;
+    for (auto c = mlog.execute_filter(expr); c->has_more(); c->advance())
+      n++;
+    return n;
+  }
+
+  static int64_t sum(atomic_multilog &mlog) {
+    int64_t total = 0;
+    for (size_t off = 0; off < mlog.record_size() * mlog.num_records(); off += mlog.record_size())
+      total += std::stoll(mlog.read(off)[1]);
+    return total;
+  }
+
+ protected:
+  virtual void SetUp() override {
+    thread_manager::register_thread();
+  }
+
+  virtual void TearDown() override {
+    thread_manager::deregister_thread();
+  }
+};
+
+task_pool BulkLoaderTest::MGMT_POOL;
+const size_t BulkLoaderTest::NUM_RECORDS;
+
+TEST_F(BulkLoaderTest, SplitTest) {
+  std::vector<std::string> out;
+  std::string line = "1,\"a,\"\"b\"\"\",,x";
+  bulk_loader::split_csv(line.data(), line.data() + line.size(), out);
+  ASSERT_EQ(std::vector<std::string>({"1", "a,\"b\"", "", "x"}), out);
+
+  schema_t s(schema());
+  line = "{\"s\": \"q\\\"\\u00e9\", \"extra\": [1], \"v\": -4}";
+  ASSERT_THROW(bulk_loader::split_json(s, line.data(), line.data() + line.size(), out), parse_exception);
+  line = "{\"s\": \"q\\\"\\u00e9\", \"extra\": 1, \"v\": -4}";
+  bulk_loader::split_json(s, line.data(), line.data() + line.size(), out);
+  ASSERT_EQ(std::vector<std::string>({"-4", "q\"\xc3\xa9"}), out);
+  line = "{\"timestamp\": 7, \"v\": null, \"s\": \"q\"}";
+  ASSERT_THROW(bulk_loader::split_json(s, line.data(), line.data() + line.size(), out), parse_exception);
+
+  ASSERT_EQ(bulk_format::JSON, bulk_loader::parse_format("JSON"));
+  ASSERT_THROW(bulk_loader::parse_format("xml"), parse_exception);
+}
+
+TEST_F(BulkLoaderTest, CSVTest) {
+  atomic_multilog mlog("bulk_csv", schema(), "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  mlog.add_index("v");
+  mlog.add_filter("big", "v >= 9000");
+
+  // Timestamps run backwards, so every chunk spans many time blocks
+  std::string path = "/tmp/bulk_loader_test.csv";
+  {
+    std::ofstream out(path);
+    out << "timestamp,v,s\n";
+    for (size_t i = 0; i < NUM_RECORDS; i++)
+      out << (NUM_RECORDS - i) * 100000 << "," << i << ",\"r," << i % 10 << "\"\r\n";
+  }
+
+  bulk_loader loader(&mlog, 4, 100, 1024);
+  bulk_load_stats stats = loader.load(path, bulk_format::CSV, true);
+  ASSERT_EQ(NUM_RECORDS, stats.num_records);
+  ASSERT_EQ(utils::file_utils::file_size(path), stats.num_bytes);
+  ASSERT_EQ(NUM_RECORDS, mlog.num_records());
+  ASSERT_EQ(static_cast<int64_t>(NUM_RECORDS * (NUM_RECORDS - 1) / 2), sum(mlog));
+  ASSERT_EQ(1000U, count(mlog, "v >= 9000"));
+  std::vector<std::string> r = mlog.read(0);
+  ASSERT_EQ("r," + std::to_string(std::stoll(r[1]) % 10), r[2].substr(0, 3));
+
+  size_t nfiltered = 0;
+  for (auto c = mlog.query_filter("big", 0, 1000); c->has_more(); c->advance())
+    nfiltered++;
+  ASSERT_EQ(1000U, nfiltered);
+  utils::file_utils::delete_file(path);
+}
+
+TEST_F(BulkLoaderTest, QuotedNewlineTest) {
+  atomic_multilog mlog("bulk_quoted", schema(), "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+
+  // Quoted newlines land on and around every chunk boundary, and a header
+  // with a quoted newline is skipped whole
+  std::ostringstream csv;
+  csv << "v,\"s\nt\"\n";
+  for (size_t i = 0; i < NUM_RECORDS; i++)
+    csv << i << ",\"" << std::string(i % 7, '\n') << "q\"\"" << i % 10 << "\"\n";
+  std::string data = csv.str();
+
+  bulk_loader loader(&mlog, 4, 100, 37);
+  ASSERT_EQ(NUM_RECORDS, loader.load(data.data(), data.size(), bulk_format::CSV, true).num_records);
+  ASSERT_EQ(static_cast<int64_t>(NUM_RECORDS * (NUM_RECORDS - 1) / 2), sum(mlog));
+  for (size_t off = 0; off < mlog.record_size() * mlog.num_records(); off += mlog.record_size()) {
+    std::vector<std::string> r = mlog.read(off);
+    int64_t v = std::stoll(r[1]);
+    ASSERT_EQ(std::string(v % 7, '\n') + "q\"" + std::to_string(v % 10), r[2].substr(0, v % 7 + 3));
+  }
+
+  std::string bad = "1,x\n2,\"y\n";
+  ASSERT_THROW(loader.load(bad.data(), bad.size(), bulk_format::CSV), parse_exception);
+}
+
+TEST_F(BulkLoaderTest, JSONAndBinaryTest) {
+  atomic_multilog mlog("bulk_json", schema(), "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  bulk_loader loader(&mlog, 3, 64, 512);
+
+  std::ostringstream json;
+  for (size_t i = 0; i < NUM_RECORDS; i++)
+    json << "{\"v\": " << i << ", \"s\": \"j" << i % 10 << "\"}\n";
+  std::string data = json.str();
+  ASSERT_EQ(NUM_RECORDS, loader.load(data.data(), data.size(), bulk_format::JSON).num_records);
+
+  std::vector<rec> recs(NUM_RECORDS);
+  for (size_t i = 0; i < NUM_RECORDS; i++) {
+    recs[i] = {static_cast<int64_t>(i) * 1000, static_cast<int64_t>(NUM_RECORDS + i), {'b', 0}};
+  }
+  ASSERT_EQ(NUM_RECORDS, loader.load(reinterpret_cast<const char *>(recs.data()), recs.size() * sizeof(rec),
+                                     bulk_format::BINARY).num_records);
+  ASSERT_THROW(loader.load(reinterpret_cast<const char *>(recs.data()), sizeof(rec) - 1, bulk_format::BINARY),
+               parse_exception);
+
+  ASSERT_EQ(2 * NUM_RECORDS, mlog.num_records());
+  ASSERT_EQ(static_cast<int64_t>(2 * NUM_RECORDS * (2 * NUM_RECORDS - 1) / 2), sum(mlog));
+  ASSERT_EQ(NUM_RECORDS / 10, count(mlog, "s == j7"));
+  ASSERT_EQ(NUM_RECORDS, count(mlog, "s == b"));
+
+  std::string bad = "{\"v\": 1, \"s\": \"x\"}\n{\"v\": one, \"s\": \"x\"}\n";
+  ASSERT_THROW(loader.load(bad.data(), bad.size(), bulk_format::JSON), parse_exception);
+}
+
+#endif /* CONFLUO_TEST_BULK_LOADER_TEST_H_ */
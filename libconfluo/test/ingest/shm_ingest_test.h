@@ -0,0 +1,216 @@
+#ifndef CONFLUO_TEST_SHM_INGEST_TEST_H_
+#define CONFLUO_TEST_SHM_INGEST_TEST_H_
+
+#include <cstddef>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "atomic_multilog.h"
+#include "confluo_store.h"
+#include "ingest/shm_ingest.h"
+#include "ingest/shm_ring.h"
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+using namespace ::confluo::ingest;
+
+class ShmIngestTest : public testing::Test {
+ public:
+  static task_pool MGMT_POOL;
+
+  struct long_rec {
+    int64_t ts;
+    int64_t v;
+  }__attribute__((packed));
+
+  static std::vector<column_t> schema() {
+    return schema_builder().add_column(primitive_types::LONG_TYPE(), "v").get_columns();
+  }
+
+ protected:
+  virtual void SetUp() override {
+    thread_manager::register_thread();
+  }
+
+  virtual void TearDown() override {
+    thread_manager::deregister_thread();
+  }
+};
+
+task_pool ShmIngestTest::MGMT_POOL;
+
+TEST_F(ShmIngestTest, RingWrapAroundTest) {
+  shm_ring consumer = shm_ring::create("/tmp/shm_ring_test", sizeof(uint64_t), 5);
+  shm_ring producer = shm_ring::attach("/tmp/shm_ring_test", sizeof(uint64_t));
+  ASSERT_EQ(8U, producer.capacity());
+
+  // Offset the head so that writes and reads wrap around mid-batch
+  uint64_t next = 0;
+  ASSERT_EQ(3U, producer.try_write(&next, 1) + producer.try_write(&next, 1) + producer.try_write(&next, 1));
+  size_t n;
+  consumer.peek(8, n);
+  consumer.consume(n);
+
+  for (size_t round = 0; round < 10; round++) {
+    uint64_t vals[12];
+    for (size_t i = 0; i < 12; i++)
+      vals[i] = next + i;
+    ASSERT_EQ(6U, producer.try_write(vals, 6));
+    ASSERT_EQ(2U, producer.try_write(vals + 6, 6));
+    ASSERT_EQ(0U, producer.try_write(vals + 8, 4));
+    ASSERT_EQ(8U, consumer.size());
+
+    size_t total = 0;
+    const uint8_t *data;
+    while ((data = consumer.peek(8, n)), n > 0) {
+      for (size_t i = 0; i < n; i++)
+        ASSERT_EQ(next + total + i, reinterpret_cast<const uint64_t *>(data)[i]);
+      total += n;
+      consumer.consume(n);
+    }
+    ASSERT_EQ(8U, total);
+    next += 8;
+  }
+  ASSERT_EQ(0U, consumer.size());
+  utils::file_utils::delete_file("/tmp/shm_ring_test");
+  utils::file_utils::delete_file(shm_ring::bell_path("/tmp/shm_ring_test"));
+}
+
+TEST_F(ShmIngestTest, RingAttachTest) {
+  ASSERT_THROW(shm_ring::attach("/tmp/shm_ring_missing", 8), invalid_operation_exception);
+  shm_ring ring = shm_ring::create("/tmp/shm_ring_test", 16, 4);
+  ASSERT_THROW(shm_ring::attach("/tmp/shm_ring_test", 8), invalid_operation_exception);
+  ASSERT_NO_THROW(shm_ring::attach("/tmp/shm_ring_test", 16));
+
+  // Only one producer may be attached at a time
+  {
+    shm_ring producer = shm_ring::attach("/tmp/shm_ring_test", 16);
+    ASSERT_THROW(shm_ring::attach("/tmp/shm_ring_test", 16), invalid_operation_exception);
+  }
+  ASSERT_NO_THROW(shm_ring::attach("/tmp/shm_ring_test", 16));
+
+  // The capacity is used as a mask, so it must be a power of two
+  int fd = utils::file_utils::open_file("/tmp/shm_ring_test", O_RDWR);
+  uint64_t capacity = 3;
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(capacity)),
+            pwrite(fd, &capacity, sizeof(capacity), offsetof(shm_ring_header, capacity)));
+  utils::file_utils::close_file(fd);
+  ASSERT_THROW(shm_ring::attach("/tmp/shm_ring_test", 16), invalid_operation_exception);
+  utils::file_utils::delete_file("/tmp/shm_ring_test");
+  utils::file_utils::delete_file(shm_ring::bell_path("/tmp/shm_ring_test"));
+}
+
+TEST_F(ShmIngestTest, RingBellTest) {
+  {
+    shm_ring consumer = shm_ring::create("/tmp/shm_ring_test", sizeof(uint64_t), 8);
+    shm_ring producer = shm_ring::attach("/tmp/shm_ring_test", sizeof(uint64_t));
+    char b;
+    uint64_t v = 1;
+
+    // Writes only ring the bell while the consumer is parked
+    producer.write(&v, 1);
+    ASSERT_EQ(-1, recv(consumer.bell_fd(), &b, 1, MSG_DONTWAIT));
+    ASSERT_FALSE(consumer.park());
+    size_t n;
+    consumer.peek(8, n);
+    consumer.consume(n);
+    ASSERT_TRUE(consumer.park());
+    producer.write(&v, 1);
+    producer.write(&v, 1);
+    ASSERT_EQ(1, recv(consumer.bell_fd(), &b, 1, MSG_DONTWAIT));
+    ASSERT_EQ(-1, recv(consumer.bell_fd(), &b, 1, MSG_DONTWAIT));
+    ASSERT_EQ(2U, consumer.size());
+  }
+
+  // A ring whose consumer is gone cannot be attached to
+  ASSERT_THROW(shm_ring::attach("/tmp/shm_ring_test", sizeof(uint64_t)), invalid_operation_exception);
+  utils::file_utils::delete_file("/tmp/shm_ring_test");
+  utils::file_utils::delete_file(shm_ring::bell_path("/tmp/shm_ring_test"));
+}
+
+TEST_F(ShmIngestTest, IdleIngestTest) {
+  atomic_multilog mlog("shm_idle_table", schema(), "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  shm_ingest in(&mlog, "/tmp/shm_idle_test", 64, 16);
+  in.start();
+  shm_ring ring = shm_ring::attach("/tmp/shm_idle_test", sizeof(long_rec));
+
+  // Each write after an idle period wakes the parked drain task
+  for (int64_t i = 0; i < 5; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    long_rec r = {static_cast<int64_t>(utils::time_utils::cur_ns()), i};
+    ring.write(&r, 1);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (in.num_ingested() < static_cast<uint64_t>(i + 1) && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::yield();
+    ASSERT_EQ(static_cast<uint64_t>(i + 1), in.num_ingested());
+  }
+  in.stop();
+  ASSERT_EQ(0U, in.num_dropped());
+}
+
+TEST_F(ShmIngestTest, ConcurrentIngestTest) {
+  atomic_multilog mlog("shm_table", schema(), "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  mlog.add_filter("upper", "v >= 50000");
+  const size_t nrecords = 100000;
+  {
+    shm_ingest in(&mlog, "/tmp/shm_ingest_test", 1024, 256);
+    in.start();
+
+    std::thread producer([nrecords]() {
+      shm_ring ring = shm_ring::attach("/tmp/shm_ingest_test", sizeof(long_rec));
+      long_rec batch[100];
+      for (size_t i = 0; i < nrecords; i += 100) {
+        for (size_t j = 0; j < 100; j++)
+          batch[j] = {static_cast<int64_t>((i + j) / 4096) * 1000000, static_cast<int64_t>(i + j)};
+        ring.write(batch, 100);
+      }
+    });
+    producer.join();
+    in.stop();
+    ASSERT_EQ(nrecords, in.num_ingested());
+  }
+  ASSERT_FALSE(utils::file_utils::exists_file("/tmp/shm_ingest_test"));
+  ASSERT_EQ(nrecords, mlog.num_records());
+
+  for (size_t i = 0; i < nrecords; i += 997) {
+    std::vector<std::string> rec = mlog.read(i * sizeof(long_rec));
+    ASSERT_EQ(std::to_string(i), rec[1]);
+  }
+
+  size_t count = 0;
+  for (auto c = mlog.query_filter("upper", 0, static_cast<uint64_t>(nrecords / 4096 + 1) * 1000000);
+       c->has_more(); c->advance())
+    count++;
+  ASSERT_EQ(nrecords / 2, count);
+}
+
+TEST_F(ShmIngestTest, StoreTest) {
+  confluo_store store("/tmp");
+  store.create_atomic_multilog("shm_store_table", schema(), storage::IN_MEMORY);
+  store.create_atomic_multilog("shm_var_table",
+                               schema_builder().add_column(primitive_types::VARCHAR_TYPE(), "s").get_columns(),
+                               storage::IN_MEMORY);
+  store.enable_shm_ingest("/tmp/shm_store_test", 64);
+  ASSERT_THROW(store.get_shm_ingest_path("shm_var_table"), management_exception);
+
+  std::string path = store.get_shm_ingest_path("shm_store_table");
+  ASSERT_EQ(utils::file_utils::full_path("/tmp/shm_store_test") + "/shm_store_table", path);
+  shm_ring ring = shm_ring::attach(path, sizeof(long_rec));
+  for (int64_t i = 0; i < 1000; i++) {
+    long_rec r = {static_cast<int64_t>(utils::time_utils::cur_ns()), i};
+    ring.write(&r, 1);
+  }
+
+  atomic_multilog *mlog = store.get_atomic_multilog("shm_store_table");
+  while (mlog->num_records() < 1000)
+    std::this_thread::yield();
+  ASSERT_EQ(std::to_string(999), mlog->read(999 * sizeof(long_rec))[1]);
+
+  store.remove_atomic_multilog("shm_store_table");
+  ASSERT_FALSE(utils::file_utils::exists_file(path));
+}
+
+#endif /* CONFLUO_TEST_SHM_INGEST_TEST_H_ */
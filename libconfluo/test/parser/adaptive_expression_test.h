@@ -0,0 +1,137 @@
+#ifndef CONFLUO_TEST_ADAPTIVE_EXPRESSION_TEST_H_
+#define CONFLUO_TEST_ADAPTIVE_EXPRESSION_TEST_H_
+
+#include <thread>
+
+#include "parser/adaptive_expression.h"
+#include "gtest/gtest.h"
+#include "schema/schema.h"
+
+using namespace ::confluo::parser;
+using namespace ::confluo;
+
+class AdaptiveExpressionTest : public testing::Test {
+ public:
+  struct rec {
+    int64_t ts;
+    bool a;
+    int32_t b;
+  }__attribute__((packed));
+
+  static schema_t schema() {
+    schema_builder builder;
+    builder.add_column(primitive_types::BOOL_TYPE(), "a");
+    builder.add_column(primitive_types::INT_TYPE(), "b");
+    return schema_t(builder.get_columns());
+  }
+
+  static compiled_expression compile(const std::string &exp, const schema_t &s) {
+    return compile_expression(parse_expression(exp), s);
+  }
+};
+
+TEST_F(AdaptiveExpressionTest, ReorderTest) {
+  schema_t s = schema();
+  auto snap = s.snapshot();
+
+  // The equality is estimated to be more selective, but passes on every
+  // record, while the range predicate passes on 1% of records
+  adaptive_expression e(compile("a==true && b>100", s), 0, 256);
+  ASSERT_EQ("A==bool(true)", e.current()->children()[0].to_string());
+
+  size_t matches = 0;
+  for (int32_t i = 0; i < 1024; i++) {
+    rec r = {0, true, i % 100 == 0 ? 101 : 0};
+    matches += e.test(snap, &r);
+  }
+  ASSERT_EQ(static_cast<size_t>(11), matches);
+  ASSERT_EQ(static_cast<size_t>(1), e.num_reorders());
+  ASSERT_EQ("B>int(100)", e.current()->children()[0].to_string());
+  ASSERT_NEAR(0.01, e.current()->selectivity(), 0.005);
+
+  // The order is stable while the data does not change
+  for (int32_t i = 0; i < 1024; i++) {
+    rec r = {0, true, i % 100 == 0 ? 101 : 0};
+    e.test(snap, &r);
+  }
+  ASSERT_EQ(static_cast<size_t>(1), e.num_reorders());
+}
+
+TEST_F(AdaptiveExpressionTest, AlternatingTest) {
+  schema_t s = schema();
+  auto snap = s.snapshot();
+  adaptive_expression e(compile("a==true && b>100", s), 0, 256);
+
+  // Selectivities that alternate between two orders reuse the same trees
+  for (int32_t phase = 0; phase < 20; phase++) {
+    for (int32_t i = 0; i < 1024; i++) {
+      bool rare = i % 100 == 0;
+      rec r = phase % 2 == 0 ? rec{0, true, rare ? 101 : 0} : rec{0, rare, 101};
+      e.test(snap, &r);
+    }
+    ASSERT_EQ(phase % 2 == 0 ? "B>int(100)" : "A==bool(true)", e.current()->children()[0].to_string());
+  }
+  ASSERT_EQ(static_cast<size_t>(20), e.num_reorders());
+  ASSERT_EQ(static_cast<size_t>(2), e.num_trees());
+
+  // Near-tied selectivities do not reorder
+  adaptive_expression tied(compile("a==true && b>100", s), 0, 256);
+  for (int32_t i = 0; i < 4096; i++) {
+    rec r = {0, i % 25 < 13, i % 2 == 0 ? 101 : 0};
+    tied.test(snap, &r);
+  }
+  ASSERT_EQ(static_cast<size_t>(0), tied.num_reorders());
+
+  // No trees are created beyond the limit
+  adaptive_expression capped(compile("a==true && b>100", s), 0, 256, 1);
+  for (int32_t i = 0; i < 1024; i++) {
+    rec r = {0, true, i % 100 == 0 ? 101 : 0};
+    capped.test(snap, &r);
+  }
+  ASSERT_EQ(static_cast<size_t>(0), capped.num_reorders());
+  ASSERT_EQ(static_cast<size_t>(1), capped.num_trees());
+  ASSERT_EQ("A==bool(true)", capped.current()->children()[0].to_string());
+}
+
+TEST_F(AdaptiveExpressionTest, ConcurrentTest) {
+  schema_t s = schema();
+  auto snap = s.snapshot();
+  adaptive_expression e(compile("(a==true || b<5) && b>100", s), 2, 64);
+
+  std::vector<std::thread> workers;
+  std::vector<size_t> matches(4, 0);
+  for (size_t t = 0; t < 4; t++) {
+    workers.push_back(std::thread([&e, &snap, &matches, t] {
+      for (int32_t i = 0; i < 100000; i++) {
+        rec r = {0, i % 2 == 0, i % 10 == 0 ? 101 : 0};
+        matches[t] += e.test(snap, &r);
+      }
+    }));
+  }
+  for (auto &w : workers)
+    w.join();
+
+  for (size_t t = 0; t < 4; t++)
+    ASSERT_EQ(static_cast<size_t>(10000), matches[t]);
+  ASSERT_EQ("B>int(100)", e.current()->children()[0].to_string());
+}
+
+TEST_F(AdaptiveExpressionTest, MintermTest) {
+  schema_t s = schema();
+  compiled_minterm m;
+  m.add(compiled_predicate("b", reational_op_id::GT, "100", s));
+  compiled_expression cexp;
+  cexp.insert(m);
+
+  adaptive_expression e(cexp);
+  ASSERT_EQ(nullptr, e.current());
+  rec r1 = {0, true, 101};
+  rec r2 = {0, true, 0};
+  ASSERT_TRUE(e.test(s.snapshot(), &r1));
+  ASSERT_FALSE(e.test(s.snapshot(), &r2));
+
+  adaptive_expression all;
+  ASSERT_TRUE(all.test(s.snapshot(), &r2));
+}
+
+#endif /* CONFLUO_TEST_ADAPTIVE_EXPRESSION_TEST_H_ */
@@ -174,6 +174,50 @@ TEST_F(ExpressionCompilerTest, CompilerTest) {
   }
 }
 
+TEST_F(ExpressionCompilerTest, FactoredTreeTest) {
+  // Each conjunct is a disjunction, so the DNF has 2^3 minterms while the
+  // factored tree keeps the six predicates
+  compiled_expression e;
+  compile(e, "(a==true || b<5) && (c<10 || d==7) && (e<10 || g<1.9)", s);
+  const compiled_node *root = e.root();
+  ASSERT_NE(nullptr, root);
+  ASSERT_EQ(compiled_node::AND, root->type());
+  ASSERT_EQ(static_cast<size_t>(3), root->children().size());
+  for (auto &c : root->children()) {
+    ASSERT_EQ(compiled_node::OR, c.type());
+    ASSERT_EQ(static_cast<size_t>(2), c.children().size());
+  }
+  ASSERT_EQ(static_cast<size_t>(8), e.size());
+  for (auto &m : e) {
+    ASSERT_EQ(static_cast<size_t>(3), m.size());
+  }
+
+  // The tree and its DNF agree on every record
+  auto snap = s.snapshot();
+  for (int i = 0; i < 64; i++) {
+    bool a = i & 1;
+    int8_t b = (i & 2) ? 1 : 9;
+    int16_t c = (i & 4) ? 1 : 20;
+    int32_t d = (i & 8) ? 7 : 8;
+    int64_t ee = (i & 16) ? 1 : 20;
+    double g = (i & 32) ? 1.0 : 2.0;
+    bool dnf = false;
+    for (auto &m : e)
+      dnf = dnf || m.test(record(a, b, c, d, ee, 0, g));
+    ASSERT_EQ(dnf, e.test(record(a, b, c, d, ee, 0, g)));
+    ASSERT_EQ(dnf, e.test(snap, record_buf(a, b, c, d, ee, 0, g)));
+  }
+
+  // Nested conjunctions are flattened, and the more selective equality
+  // predicate is tested first
+  compiled_expression f;
+  compile(f, "b<5 && (c<10 && d==7)", s);
+  ASSERT_EQ(compiled_node::AND, f.root()->type());
+  ASSERT_EQ(static_cast<size_t>(3), f.root()->children().size());
+  ASSERT_EQ("D==int(7)", f.root()->children()[0].to_string());
+  ASSERT_EQ(static_cast<size_t>(1), f.size());
+}
+
 TEST_F(ExpressionCompilerTest, TestCompiledExpressionRecordTest) {
   compiled_minterm m1, m2, m3;
   m1.add(predicate("a", reational_op_id::EQ, "true"));
@@ -0,0 +1,171 @@
+#ifndef CONFLUO_TEST_PARTITIONED_MULTILOG_TEST_H_
+#define CONFLUO_TEST_PARTITIONED_MULTILOG_TEST_H_
+
+#include "partitioned_multilog.h"
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+
+class PartitionedMultilogTest : public testing::Test {
+ public:
+  static task_pool MGMT_POOL;
+
+  struct rec {
+    int64_t ts;
+    int32_t k;
+    int64_t v;
+  }__attribute__((packed));
+
+  static std::vector<column_t> schema() {
+    return schema_builder()
+        .add_column(primitive_types::INT_TYPE(), "k")
+        .add_column(primitive_types::LONG_TYPE(), "v")
+        .get_columns();
+  }
+
+  static size_t count(std::unique_ptr<record_cursor> c) {
+    size_t n = 0;
+    for (; c->has_more(); c->advance())
+      n++;
+    return n;
+  }
+
+ protected:
+  virtual void SetUp() override {
+    thread_manager::register_thread();
+  }
+
+  virtual void TearDown() override {
+    thread_manager::deregister_thread();
+  }
+};
+
+task_pool PartitionedMultilogTest::MGMT_POOL;
+
+TEST_F(PartitionedMultilogTest, KeyPartitionTest) {
+  partitioned_multilog mlog("plog", schema(), 4, "k", "/tmp/plog", storage::IN_MEMORY, archival_mode::OFF,
+                            MGMT_POOL);
+  ASSERT_EQ(static_cast<size_t>(4), mlog.num_partitions());
+  mlog.add_filter("all", "v >= 0");
+  mlog.add_aggregate("sum_v", "all", "SUM(v)");
+  mlog.add_aggregate("max_v", "all", "MAX(v)");
+
+  uint64_t now_ms = time_utils::cur_ms();
+  const int64_t ms = static_cast<int64_t>(configuration_params::TIME_RESOLUTION_NS());
+  std::vector<uint64_t> offsets;
+  for (int32_t i = 0; i < 400; i++) {
+    rec r = {static_cast<int64_t>(now_ms) * ms, i % 8, i};
+    offsets.push_back(mlog.append(&r));
+  }
+
+  record_batch_builder builder = mlog.get_batch_builder();
+  for (int32_t i = 400; i < 600; i++) {
+    rec r = {static_cast<int64_t>(now_ms) * ms, i % 8, i};
+    builder.add_record(&r);
+  }
+  record_batch batch = builder.get_batch();
+  mlog.append_batch(batch);
+  ASSERT_EQ(static_cast<size_t>(600), mlog.num_records());
+
+  // All records with the same key live in the same partition
+  size_t total = 0;
+  for (size_t p = 0; p < mlog.num_partitions(); p++) {
+    std::set<int32_t> keys;
+    for (auto c = mlog.partition(p)->execute_filter("v >= 0"); c->has_more(); c->advance())
+      keys.insert(c->get()[1].as<int32_t>());
+    for (size_t q = 0; q < p; q++)
+      for (auto c = mlog.partition(q)->execute_filter("v >= 0"); c->has_more(); c->advance())
+        ASSERT_EQ(static_cast<size_t>(0), keys.count(c->get()[1].as<int32_t>()));
+    total += mlog.partition(p)->num_records();
+  }
+  ASSERT_EQ(static_cast<size_t>(600), total);
+
+  for (int32_t i = 0; i < 400; i++) {
+    auto r = mlog.read(offsets[i]);
+    ASSERT_EQ(std::to_string(i % 8), r[1]);
+    ASSERT_EQ(std::to_string(i), r[2]);
+  }
+
+  ASSERT_EQ(static_cast<size_t>(600), count(mlog.execute_filter("v >= 0")));
+  ASSERT_EQ(static_cast<size_t>(75), count(mlog.execute_filter("k == 3")));
+  ASSERT_EQ(static_cast<size_t>(600), count(mlog.query_filter("all", now_ms, now_ms)));
+  ASSERT_EQ(static_cast<size_t>(600), count(mlog.query_time_range(now_ms * ms, now_ms * ms)));
+
+  ASSERT_TRUE(numeric(static_cast<int64_t>(599 * 600 / 2)) == mlog.get_aggregate("sum_v", now_ms, now_ms));
+  ASSERT_TRUE(numeric(static_cast<int64_t>(599)) == mlog.get_aggregate("max_v", now_ms, now_ms));
+  auto series = mlog.get_aggregate_series("sum_v", now_ms, now_ms, 1);
+  ASSERT_EQ(static_cast<size_t>(1), series.size());
+  ASSERT_TRUE(numeric(static_cast<int64_t>(599 * 600 / 2)) == series[0]);
+  ASSERT_THROW(mlog.get_aggregate_series("sum_v", 0, limits::ulong_max, 1), invalid_operation_exception);
+  ASSERT_TRUE(numeric(static_cast<int64_t>(599 * 600 / 2)) == mlog.execute_aggregate("SUM(v)", "v >= 0"));
+  ASSERT_THROW(mlog.get_aggregate("none", now_ms, now_ms), invalid_operation_exception);
+
+  mlog.remove_aggregate("sum_v");
+  ASSERT_THROW(mlog.get_aggregate("sum_v", now_ms, now_ms), invalid_operation_exception);
+}
+
+TEST_F(PartitionedMultilogTest, RoundRobinTest) {
+  partitioned_multilog mlog("plog", schema(), 3, "", "/tmp/plog", storage::IN_MEMORY, archival_mode::OFF,
+                            MGMT_POOL);
+  const size_t nthreads = 3;
+  const size_t nrecords = 300;
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < nthreads; t++) {
+    workers.push_back(std::thread([&mlog, t, nrecords] {
+      thread_manager::register_thread();
+      for (size_t i = 0; i < nrecords; i++) {
+        rec r = {static_cast<int64_t>(time_utils::cur_ns()), static_cast<int32_t>(t), static_cast<int64_t>(i)};
+        mlog.append(&r);
+      }
+      thread_manager::deregister_thread();
+    }));
+  }
+  for (auto &w : workers)
+    w.join();
+
+  ASSERT_EQ(nthreads * nrecords, mlog.num_records());
+  for (size_t p = 0; p < mlog.num_partitions(); p++)
+    ASSERT_EQ(nrecords, mlog.partition(p)->num_records());
+  ASSERT_EQ(nrecords, count(mlog.execute_filter("k == 1")));
+  ASSERT_THROW(partitioned_multilog("plog", schema(), 0, "", "/tmp/plog", storage::IN_MEMORY, archival_mode::OFF,
+                                    MGMT_POOL), invalid_operation_exception);
+}
+
+TEST_F(PartitionedMultilogTest, RollbackTest) {
+  partitioned_multilog mlog("plog", schema(), 3, "", "/tmp/plog", storage::IN_MEMORY, archival_mode::OFF,
+                            MGMT_POOL);
+
+  // Operations that fail on a later partition are undone on earlier ones
+  mlog.partition(2)->add_filter("f", "v > 0");
+  ASSERT_THROW(mlog.add_filter("f", "v > 0"), management_exception);
+  ASSERT_THROW(mlog.partition(0)->remove_filter("f"), management_exception);
+  ASSERT_THROW(mlog.partition(1)->remove_filter("f"), management_exception);
+  mlog.partition(2)->remove_filter("f");
+  mlog.add_filter("f", "v > 0");
+
+  mlog.partition(1)->add_index("v");
+  ASSERT_THROW(mlog.add_index("v"), management_exception);
+  ASSERT_FALSE(mlog.partition(0)->get_schema()["v"].is_indexed());
+  ASSERT_THROW(mlog.remove_index("v"), management_exception);
+  mlog.partition(1)->remove_index("v");
+
+  mlog.add_aggregate("sum_v", "f", "SUM(v)");
+  mlog.partition(2)->remove_aggregate("sum_v");
+  ASSERT_THROW(mlog.remove_aggregate("sum_v"), management_exception);
+  mlog.partition(2)->add_aggregate("sum_v", "f", "SUM(v)");
+
+  mlog.install_trigger("t", "sum_v > 10");
+  mlog.partition(1)->remove_trigger("t");
+  ASSERT_THROW(mlog.remove_trigger("t"), management_exception);
+  mlog.partition(1)->install_trigger("t", "sum_v > 10");
+  mlog.remove_trigger("t");
+  mlog.remove_aggregate("sum_v");
+
+  // A failure on the first partition changes nothing
+  mlog.partition(0)->add_filter("g", "v > 0");
+  ASSERT_THROW(mlog.add_filter("g", "v > 0"), management_exception);
+  mlog.partition(0)->remove_filter("g");
+  ASSERT_THROW(mlog.partition(1)->remove_filter("g"), management_exception);
+}
+
+#endif /* CONFLUO_TEST_PARTITIONED_MULTILOG_TEST_H_ */
@@ -0,0 +1,136 @@
+#ifndef CONFLUO_TEST_READ_ONLY_MULTILOG_TEST_H_
+#define CONFLUO_TEST_READ_ONLY_MULTILOG_TEST_H_
+
+#include "atomic_multilog.h"
+#include "read_only_multilog.h"
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+
+class ReadOnlyMultilogTest : public testing::Test {
+ public:
+  static task_pool MGMT_POOL;
+
+  struct long_rec {
+    int64_t ts;
+    int64_t v;
+    char pad[48];
+  }__attribute__((packed));
+
+  static std::vector<column_t> schema() {
+    return schema_builder().add_column(primitive_types::LONG_TYPE(), "v")
+                           .add_column(primitive_types::STRING_TYPE(48), "pad").get_columns();
+  }
+
+  static void append_records(atomic_multilog &mlog, size_t begin, size_t end) {
+    const size_t batch_records = 16384;
+    long_rec r;
+    memset(&r, 'x', sizeof(r));
+    for (size_t i = begin; i < end; i += batch_records) {
+      size_t n = std::min(batch_records, end - i);
+      record_batch batch;
+      batch.nrecords = n;
+      batch.blocks.resize(1);
+      batch.blocks[0].time_block = 0;
+      batch.blocks[0].nrecords = n;
+      for (size_t j = i; j < i + n; j++) {
+        r.ts = 0;
+        r.v = static_cast<int64_t>(j);
+        batch.blocks[0].data.append(reinterpret_cast<const char *>(&r), sizeof(r));
+      }
+      mlog.append_batch(batch);
+    }
+  }
+
+ protected:
+  virtual void SetUp() override {
+    thread_manager::register_thread();
+  }
+
+  virtual void TearDown() override {
+    thread_manager::deregister_thread();
+  }
+};
+
+task_pool ReadOnlyMultilogTest::MGMT_POOL;
+
+TEST_F(ReadOnlyMultilogTest, NotDurableTest) {
+  utils::file_utils::create_dir("/tmp/ro_mem_table");
+  atomic_multilog mlog("ro_mem_table", schema(), "/tmp/ro_mem_table", storage::IN_MEMORY, archival_mode::OFF,
+                       MGMT_POOL);
+  ASSERT_THROW(read_only_multilog("/tmp/ro_mem_table"), invalid_operation_exception);
+  ASSERT_THROW(read_only_multilog("/tmp/ro_missing_table"), invalid_operation_exception);
+}
+
+TEST_F(ReadOnlyMultilogTest, AttachTest) {
+  utils::file_utils::create_dir("/tmp/ro_table");
+  atomic_multilog mlog("ro_table", schema(), "/tmp/ro_table", storage::DURABLE, archival_mode::OFF, MGMT_POOL);
+  read_only_multilog ro("/tmp/ro_table");
+  ASSERT_EQ("ro_table", ro.get_name());
+  ASSERT_EQ(mlog.record_size(), ro.record_size());
+  ASSERT_EQ(0U, ro.num_records());
+  ASSERT_TRUE(ro.read(0).empty());
+
+  append_records(mlog, 0, 1000);
+  ASSERT_EQ(1000U, ro.num_records());
+  ASSERT_EQ("999", ro.read(999 * sizeof(long_rec))[1]);
+
+  size_t count = 0;
+  for (auto c = ro.execute_filter("v >= 900"); c->has_more(); c->advance())
+    count++;
+  ASSERT_EQ(100U, count);
+
+  // New records are visible to new cursors only
+  auto c = ro.scan();
+  append_records(mlog, 1000, 1500);
+  count = 0;
+  for (; c->has_more(); c->advance()) {
+    ASSERT_EQ(static_cast<int64_t>(count), c->get().at(1).value().to_data().as<int64_t>());
+    count++;
+  }
+  ASSERT_EQ(1000U, count);
+  ASSERT_EQ(1500U, ro.num_records());
+}
+
+TEST_F(ReadOnlyMultilogTest, FollowBucketsTest) {
+  utils::file_utils::create_dir("/tmp/ro_relaxed_table");
+  atomic_multilog mlog("ro_relaxed_table", schema(), "/tmp/ro_relaxed_table", storage::DURABLE_RELAXED,
+                       archival_mode::OFF, MGMT_POOL);
+  read_only_multilog ro("/tmp/ro_relaxed_table");
+
+  size_t bucket_records = data_log_constants::BUCKET_SIZE / sizeof(long_rec);
+  append_records(mlog, 0, bucket_records / 2);
+  ASSERT_EQ(bucket_records / 2, ro.num_records());
+
+  // The writer moves into a second bucket after the reader has attached
+  append_records(mlog, bucket_records / 2, bucket_records + 1024);
+  ASSERT_EQ(bucket_records + 1024, ro.num_records());
+  for (size_t i = bucket_records - 2; i < bucket_records + 1024; i++)
+    ASSERT_EQ(std::to_string(i), ro.read(i * sizeof(long_rec))[1]);
+
+  size_t count = 0;
+  for (auto c = ro.execute_filter("v >= " + std::to_string(bucket_records - 24)); c->has_more(); c->advance())
+    count++;
+  ASSERT_EQ(1048U, count);
+}
+
+TEST_F(ReadOnlyMultilogTest, BucketGeometryTest) {
+  utils::file_utils::clear_dir("/tmp/ro_growing_table");
+  utils::file_utils::create_dir("/tmp/ro_growing_table");
+  monolog::bucket_geometry geometry(4096, 65536);
+  atomic_multilog mlog("ro_growing_table", schema(), "/tmp/ro_growing_table", storage::DURABLE_RELAXED,
+                       archival_mode::OFF, MGMT_POOL, geometry);
+
+  // Only a small first bucket is allocated up front
+  size_t first_bucket = sizeof(storage::ptr_metadata) + data_log::bucket_type::alloc_size(4096);
+  ASSERT_EQ(first_bucket, utils::file_utils::file_size("/tmp/ro_growing_table/data_log_0.dat"));
+
+  // The reader picks up the geometry from the metadata
+  append_records(mlog, 0, 20000);
+  read_only_multilog ro("/tmp/ro_growing_table");
+  ASSERT_EQ(20000U, ro.num_records());
+  for (size_t i = 0; i < 20000; i++)
+    ASSERT_EQ(std::to_string(i), ro.read(i * sizeof(long_rec))[1]);
+}
+
+#endif /* CONFLUO_TEST_READ_ONLY_MULTILOG_TEST_H_ */
@@ -0,0 +1,73 @@
+#ifndef CONFLUO_TEST_COMPOSITE_INDEX_TEST_H_
+#define CONFLUO_TEST_COMPOSITE_INDEX_TEST_H_
+
+#include "schema/composite_index.h"
+#include "schema/schema.h"
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+
+class CompositeIndexTest : public testing::Test {
+};
+
+TEST_F(CompositeIndexTest, ConcatTest) {
+  composite_index_t c("A,B", {0, 1}, {sizeof(int32_t), sizeof(int64_t)}, {1.0, 1.0});
+  ASSERT_EQ("A,B", c.name());
+  ASSERT_EQ(sizeof(int32_t) + sizeof(int64_t), c.key_size());
+
+  byte_string k1 = c.concat({byte_string(int32_t(1)), byte_string(int64_t(100))});
+  byte_string k2 = c.concat({byte_string(int32_t(1)), byte_string(int64_t(-5))});
+  byte_string k3 = c.concat({byte_string(int32_t(2)), byte_string(int64_t(-100))});
+  ASSERT_EQ(c.key_size(), k1.size());
+
+  // Composite keys order by the first column, then the second
+  ASSERT_TRUE(k2 < k1);
+  ASSERT_TRUE(k1 < k3);
+  ASSERT_TRUE(k1 == c.concat({byte_string(int32_t(1)), byte_string(int64_t(100))}));
+}
+
+TEST_F(CompositeIndexTest, IndexStateTest) {
+  composite_index_t c("A,B", {0, 1}, {sizeof(int32_t), sizeof(int32_t)}, {1.0, 1.0});
+  ASSERT_FALSE(c.is_indexed());
+  ASSERT_TRUE(c.set_indexing());
+  c.set_backfilling(2);
+  c.set_backfill_boundary(64);
+  ASSERT_TRUE(c.is_indexed());
+  ASSERT_FALSE(c.is_queryable());
+  ASSERT_FALSE(c.index_on_write(0));
+  ASSERT_TRUE(c.index_on_write(64));
+  ASSERT_TRUE(c.finish_backfill());
+  ASSERT_TRUE(c.is_queryable());
+  ASSERT_EQ(2, c.index_id());
+  ASSERT_TRUE(c.disable_indexing());
+  ASSERT_FALSE(c.is_indexed());
+}
+
+TEST_F(CompositeIndexTest, GetKeyTest) {
+  schema_builder builder;
+  builder.add_column(primitive_types::INT_TYPE(), "a");
+  builder.add_column(primitive_types::STRING_TYPE(200), "b");
+  schema_t s(builder.get_columns());
+
+  uint8_t buf[sizeof(int64_t) + sizeof(int32_t) + 200] = {};
+  int64_t ts = 42;
+  int32_t a = -7;
+  memcpy(buf, &ts, sizeof(int64_t));
+  memcpy(buf + sizeof(int64_t), &a, sizeof(int32_t));
+  memcpy(buf + sizeof(int64_t) + sizeof(int32_t), "abc", 3);
+  record_t r = s.apply_unsafe(0, buf);
+
+  // Narrow keys are built on the stack, wide keys on the heap; both must
+  // match the concatenation of the column keys
+  composite_index_t narrow("TIMESTAMP,A", {0, 1}, {sizeof(int64_t), sizeof(int32_t)}, {1.0, 1.0});
+  ASSERT_GE(composite_index_t::MAX_STACK_KEY_SIZE, narrow.key_size());
+  ASSERT_TRUE(narrow.concat({r[0].value().to_key(1.0), r[1].value().to_key(1.0)}) == narrow.get_key(r));
+
+  composite_index_t wide("A,B", {1, 2}, {sizeof(int32_t), 200}, {1.0, 1.0});
+  ASSERT_LT(composite_index_t::MAX_STACK_KEY_SIZE, wide.key_size());
+  byte_string key = wide.get_key(r);
+  ASSERT_EQ(wide.key_size(), key.size());
+  ASSERT_TRUE(wide.concat({r[1].value().to_key(1.0), r[2].value().to_key(1.0)}) == key);
+}
+
+#endif /* CONFLUO_TEST_COMPOSITE_INDEX_TEST_H_ */
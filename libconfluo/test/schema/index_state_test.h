@@ -26,4 +26,24 @@ TEST_F(IndexStateTest, StateTransitionTest) {
   ASSERT_FALSE(state.is_indexed());
 }
 
+TEST_F(IndexStateTest, BackfillTransitionTest) {
+  index_state_t state;
+  ASSERT_TRUE(state.set_indexing());
+
+  state.set_backfilling(2, 1.0);
+  state.set_backfill_boundary(1024);
+  ASSERT_TRUE(state.is_indexed());
+  ASSERT_FALSE(state.is_queryable());
+  ASSERT_EQ(2, state.id());
+  ASSERT_FALSE(state.index_on_write(1000));
+  ASSERT_TRUE(state.index_on_write(1024));
+
+  ASSERT_TRUE(state.finish_backfill());
+  ASSERT_TRUE(state.is_queryable());
+  ASSERT_FALSE(state.finish_backfill());
+
+  ASSERT_TRUE(state.disable_indexing());
+  ASSERT_FALSE(state.is_indexed());
+}
+
 #endif /* CONFLUO_TEST_INDEX_STATE_TEST_H_ */
@@ -0,0 +1,123 @@
+#ifndef CONFLUO_TEST_ARCHIVE_MAPPER_TEST_H_
+#define CONFLUO_TEST_ARCHIVE_MAPPER_TEST_H_
+
+#include <unistd.h>
+
+#include "storage/archive_mapper.h"
+#include "storage/storage_allocator.h"
+#include "file_utils.h"
+#include "gtest/gtest.h"
+
+using namespace ::confluo::storage;
+
+class ArchiveMapperTest : public testing::Test {
+
+ public:
+  static size_t page_size() {
+    return static_cast<size_t>(getpagesize());
+  }
+
+  static std::string write_file(const std::string &path, size_t size) {
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; i++) {
+      data[i] = static_cast<char>(i % 251);
+    }
+    utils::file_utils::create_dir("/tmp/archive_mapper_test");
+    int fd = utils::file_utils::open_file(path, O_CREAT | O_TRUNC | O_RDWR);
+    write_all(fd, data);
+    utils::file_utils::close_file(fd);
+    return data;
+  }
+
+ private:
+  static void write_all(int fd, const std::string &data) {
+    size_t written = 0;
+    while (written < data.size()) {
+      ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+      if (n <= 0)
+        break;
+      written += static_cast<size_t>(n);
+    }
+    EXPECT_EQ(data.size(), written);
+  }
+
+};
+
+TEST_F(ArchiveMapperTest, ShareExtentTest) {
+  std::string path = "/tmp/archive_mapper_test/share";
+  std::string data = write_file(path, 4 * page_size());
+  archive_mapper mapper(2 * page_size());
+
+  uint8_t *a = mapper.acquire(path, 16, 100);
+  uint8_t *b = mapper.acquire(path, page_size() + 7, 100);
+  ASSERT_NE(nullptr, a);
+  ASSERT_NE(nullptr, b);
+  ASSERT_EQ(1U, mapper.num_extents());
+  ASSERT_EQ(2 * page_size(), mapper.mapped_bytes());
+  ASSERT_EQ(0, memcmp(a, data.data() + 16, 100));
+  ASSERT_EQ(0, memcmp(b, data.data() + page_size() + 7, 100));
+
+  // A range straddling two extents is not shared
+  ASSERT_EQ(nullptr, mapper.acquire(path, 2 * page_size() - 10, 20));
+
+  uint8_t *c = mapper.acquire(path, 3 * page_size(), 10);
+  ASSERT_EQ(2U, mapper.num_extents());
+  ASSERT_EQ(0, memcmp(c, data.data() + 3 * page_size(), 10));
+
+  mapper.release(a);
+  ASSERT_EQ(2U, mapper.num_extents());
+  mapper.release(b + 50);
+  ASSERT_EQ(1U, mapper.num_extents());
+  mapper.release(c);
+  ASSERT_EQ(0U, mapper.num_extents());
+  ASSERT_THROW(mapper.release(c), invalid_operation_exception);
+
+  archive_mapper disabled(0);
+  ASSERT_EQ(nullptr, disabled.acquire(path, 0, 10));
+}
+
+TEST_F(ArchiveMapperTest, InvalidateTest) {
+  std::string path = "/tmp/archive_mapper_test/invalidate";
+  write_file(path, page_size());
+  archive_mapper mapper(page_size());
+
+  uint8_t *a = mapper.acquire(path, 0, 10);
+  mapper.invalidate(path);
+  std::string data = write_file(path, page_size());
+  uint8_t *b = mapper.acquire(path, 0, 10);
+
+  // The old mapping stays alive for its holder, new requests get a new one
+  ASSERT_NE(a, b);
+  ASSERT_EQ(2U, mapper.num_extents());
+  mapper.release(a);
+  ASSERT_EQ(1U, mapper.num_extents());
+  ASSERT_EQ(0, memcmp(b, data.data(), 10));
+  mapper.release(b);
+  ASSERT_EQ(0U, mapper.num_extents());
+}
+
+TEST_F(ArchiveMapperTest, MapArchivedTest) {
+  std::string path = "/tmp/archive_mapper_test/allocator";
+  size_t size = 64;
+  size_t stride = sizeof(ptr_metadata) + size;
+  write_file(path, 8 * stride);
+  storage_allocator allocator;
+
+  std::vector<void *> ptrs;
+  for (size_t i = 0; i < 8; i++) {
+    void *ptr = allocator.map_archived(path, i * stride, size, ptr_aux_block(state_type::D_ARCHIVED,
+                                                                             encoding_type::D_UNENCODED));
+    ptr_metadata *md = ptr_metadata::get(ptr);
+    ASSERT_EQ(alloc_type::D_ARCHIVE_MAP, md->alloc_type_);
+    ASSERT_EQ(size, md->data_size_);
+    ptrs.push_back(ptr);
+  }
+  ASSERT_EQ(1U, allocator.archive_map().num_extents());
+
+  for (void *ptr : ptrs) {
+    allocator.dealloc(ptr);
+  }
+  ASSERT_EQ(0U, allocator.archive_map().num_extents());
+}
+
+#endif /* CONFLUO_TEST_ARCHIVE_MAPPER_TEST_H_ */
@@ -7,6 +7,7 @@
 #include "storage/allocator.h"
 #include "storage/encoded_ptr.h"
 #include "storage/ptr_metadata.h"
+#include "compression/lz4_encoder.h"
 
 using namespace ::confluo;
 using namespace ::confluo::storage;
@@ -94,4 +95,43 @@ TEST_F(PtrTest, SwapTest) {
   ASSERT_EQ(initial_mem_usage, allocator::instance().memory_utilization());
 }
 
+TEST_F(PtrTest, DecodeRangeTest) {
+  const size_t size = 4 * 65536;
+  uint8_t source[size];
+  for (size_t i = 0; i < size; i++)
+    source[i] = static_cast<uint8_t>(i % 251);
+
+  // Unencoded data is returned in place
+  void *data = allocator::instance().alloc(size, ptr_aux_block());
+  memcpy(data, source, size);
+  encoded_ptr<uint8_t> unencoded(data);
+  ASSERT_FALSE(unencoded.is_encoded());
+  ASSERT_EQ(static_cast<uint8_t *>(data) + 100, unencoded.decode_range(100, 10).get());
+  allocator::instance().dealloc(data);
+
+  auto encoded = compression::lz4_encoder<>::encode(source, size);
+  ptr_aux_block aux(state_type::D_IN_MEMORY, encoding_type::D_LZ4);
+  void *enc_data = allocator::instance().alloc(encoded.size(), aux);
+  memcpy(enc_data, encoded.get(), encoded.size());
+  encoded_ptr<uint8_t> enc_ptr(enc_data);
+  ASSERT_TRUE(enc_ptr.is_encoded());
+
+  // Range within a block, straddling blocks, and spanning a whole block
+  size_t starts[] = {7, 65536 - 40, 65536 * 2 - 3};
+  size_t lens[] = {100, 80, 65536 + 10};
+  for (size_t i = 0; i < 3; i++) {
+    auto decoded = enc_ptr.decode_range(starts[i], lens[i]);
+    for (size_t j = 0; j < lens[i]; j++)
+      ASSERT_EQ(source[starts[i] + j], decoded.get()[j]);
+  }
+
+  uint8_t buf[64];
+  auto decoded = enc_ptr.decode_range(1000, sizeof(buf), buf);
+  ASSERT_EQ(buf, decoded.get());
+  for (size_t j = 0; j < sizeof(buf); j++)
+    ASSERT_EQ(source[1000 + j], buf[j]);
+  ASSERT_EQ(source[size - 1], enc_ptr.decode_at(size - 1));
+  allocator::instance().dealloc(enc_data);
+}
+
 #endif /* CONFLUO_TEST_PTR_TEST_H_ */
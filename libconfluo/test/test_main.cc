@@ -4,35 +4,46 @@
 #include "gtest/gtest.h"
 #include "aggregate/aggregate_test.h"
 #include "aggregated_reflog_test.h"
+#include "alert_index_test.h"
+#include "partitioned_multilog_test.h"
 #include "container/bitmap/bitmap_test.h"
 #include "container/bitmap/bitmap_array_test.h"
 #include "container/cursor/batched_cursor_test.h"
+#include "container/cursor/time_range_cursors_test.h"
 #include "types/byte_string_test.h"
 #include "schema/column_test.h"
+#include "schema/composite_index_test.h"
 #include "types/data_types_test.h"
 #include "compression/lz4_encode_test.h"
 #include "compression/delta_encode_test.h"
 #include "container/bitmap/delta_encoded_array_test.h"
 #include "confluo_store_test.h"
 #include "atomic_multilog_test.h"
+#include "parser/adaptive_expression_test.h"
 #include "parser/expression_compiler_test.h"
 #include "parser/expression_parser_test.h"
 #include "filter_test.h"
 #include "archival/filter_archival_test.h"
 #include "archival/filter_load_test.h"
+#include "archival/incremental_file_writer_test.h"
 #include "container/flatten_test.h"
 #include "types/immutable_value_test.h"
 #include "archival/index_load_test.h"
 #include "schema/index_state_test.h"
 #include "storage/storage_allocator_test.h"
 #include "storage/memory_stat_test.h"
+#include "storage/archive_mapper_test.h"
 #include "container/monolog/monolog_test.h"
 #include "archival/monolog_linear_archival_test.h"
 #include "archival/monolog_linear_load_test.h"
 #include "types/mutable_value_test.h"
 #include "threads/periodic_task_test.h"
+#include "threads/task_scheduler_test.h"
+#include "threads/backfill_task_test.h"
 #include "storage/ptr_test.h"
 #include "container/radix_tree_test.h"
+#include "container/hash_index_test.h"
+#include "container/var_heap_test.h"
 #include "schema/record_batch_test.h"
 #include "parser/schema_parser_test.h"
 #include "schema/schema_test.h"
@@ -44,6 +55,10 @@
 #include "parser/aggregate_parser_test.h"
 #include "parser/trigger_parser_test.h"
 #include "types/type_manager_test.h"
+#include "ingest/bulk_loader_test.h"
+#include "ingest/shm_ingest_test.h"
+#include "read_only_multilog_test.h"
+#include "typed_multilog_test.h"
 
 int main(int argc, char **argv) {
   utils::error_handling::install_signal_handler(argv[0], SIGSEGV, SIGKILL, SIGSTOP);
@@ -0,0 +1,110 @@
+#ifndef CONFLUO_TEST_BACKFILL_TASK_TEST_H_
+#define CONFLUO_TEST_BACKFILL_TASK_TEST_H_
+
+#include "threads/backfill_task.h"
+
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+
+class BackfillTaskTest : public testing::Test {
+ public:
+  static const size_t kRecordSize = 8;
+  static const uint64_t kNumRecords = 100000;
+};
+
+const size_t BackfillTaskTest::kRecordSize;
+const uint64_t BackfillTaskTest::kNumRecords;
+
+TEST_F(BackfillTaskTest, ScanAllTest) {
+  std::vector<atomic::type<int>> visited(kNumRecords);
+  for (auto &v : visited)
+    atomic::init(&v, 0);
+
+  atomic::type<bool> completed(false);
+  backfill_task task("test", kNumRecords * kRecordSize, kRecordSize);
+  task.start([&visited](uint64_t begin, uint64_t end) {
+    for (uint64_t off = begin; off < end; off += kRecordSize)
+      atomic::faa(&visited[off / kRecordSize], 1);
+  }, [&completed] {
+    atomic::store(&completed, true);
+  }, 4, 1000);
+  task.wait();
+
+  for (uint64_t i = 0; i < kNumRecords; i++)
+    ASSERT_EQ(1, atomic::load(&visited[i]));
+  ASSERT_TRUE(atomic::load(&completed));
+
+  backfill_status s = task.status();
+  ASSERT_TRUE(s.done);
+  ASSERT_FALSE(s.failed);
+  ASSERT_EQ(kNumRecords, s.total_records);
+  ASSERT_EQ(kNumRecords, s.backfilled_records);
+  ASSERT_DOUBLE_EQ(1.0, s.progress());
+}
+
+TEST_F(BackfillTaskTest, CancelTest) {
+  atomic::type<bool> completed(false);
+  backfill_task task("test", kNumRecords * kRecordSize, kRecordSize);
+  task.start([](uint64_t begin, uint64_t end) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }, [&completed] {
+    atomic::store(&completed, true);
+  }, 2, 10);
+  task.cancel();
+  task.wait();
+
+  backfill_status s = task.status();
+  ASSERT_FALSE(atomic::load(&completed));
+  ASSERT_FALSE(s.done);
+  ASSERT_TRUE(s.failed);
+  ASSERT_LT(s.backfilled_records, kNumRecords);
+}
+
+TEST_F(BackfillTaskTest, CancelAfterScanTest) {
+  // The only partition completes after the task is cancelled; the done
+  // function must still not be invoked.
+  atomic::type<bool> started(false);
+  atomic::type<bool> cancelled(false);
+  atomic::type<bool> completed(false);
+  backfill_task task("test", kNumRecords * kRecordSize, kRecordSize);
+  task.start([&started, &cancelled](uint64_t begin, uint64_t end) {
+    atomic::store(&started, true);
+    while (!atomic::load(&cancelled))
+      std::this_thread::yield();
+  }, [&completed] {
+    atomic::store(&completed, true);
+  }, 1, kNumRecords);
+  while (!atomic::load(&started))
+    std::this_thread::yield();
+  task.cancel();
+  atomic::store(&cancelled, true);
+  task.wait();
+
+  backfill_status s = task.status();
+  ASSERT_FALSE(atomic::load(&completed));
+  ASSERT_FALSE(s.done);
+  ASSERT_TRUE(s.failed);
+  ASSERT_EQ(kNumRecords, s.backfilled_records);
+}
+
+TEST_F(BackfillTaskTest, ScanErrorTest) {
+  // A partition that throws fails the backfill instead of the process
+  atomic::type<bool> completed(false);
+  backfill_task task("test", kNumRecords * kRecordSize, kRecordSize);
+  task.start([](uint64_t begin, uint64_t end) {
+    if (begin >= kNumRecords * kRecordSize / 2)
+      throw std::bad_alloc();
+  }, [&completed] {
+    atomic::store(&completed, true);
+  }, 4, 1000);
+  task.wait();
+
+  backfill_status s = task.status();
+  ASSERT_FALSE(atomic::load(&completed));
+  ASSERT_FALSE(s.done);
+  ASSERT_TRUE(s.failed);
+  ASSERT_LT(s.backfilled_records, kNumRecords);
+}
+
+#endif /* CONFLUO_TEST_BACKFILL_TASK_TEST_H_ */
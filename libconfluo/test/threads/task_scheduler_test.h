@@ -0,0 +1,130 @@
+#ifndef CONFLUO_TEST_TASK_SCHEDULER_TEST_H_
+#define CONFLUO_TEST_TASK_SCHEDULER_TEST_H_
+
+#include "threads/task_scheduler.h"
+
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+
+class TaskSchedulerTest : public testing::Test {
+
+};
+
+TEST_F(TaskSchedulerTest, PeriodicTaskTest) {
+  task_scheduler scheduler(2);
+  std::vector<int> vec;
+  int num = 0;
+  scheduled_task task("dummy", scheduler);
+  ASSERT_TRUE(task.start([&vec, &num] {
+    vec.push_back(num);
+    num++;
+  }, 1));
+  ASSERT_FALSE(task.start([] {}, 1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_TRUE(task.stop());
+  ASSERT_FALSE(task.stop());
+  ASSERT_EQ(0U, scheduler.num_tasks());
+
+  // Runs of a task never overlap, so they happen in order
+  ASSERT_GT(vec.size(), 10U);
+  for (int i = 0; i < static_cast<int>(vec.size()); i++) {
+    ASSERT_EQ(vec[i], i);
+  }
+}
+
+TEST_F(TaskSchedulerTest, ManyTasksTest) {
+  const size_t kNumTasks = 500;
+  task_scheduler scheduler(2);
+  std::vector<atomic::type<uint64_t>> counts(kNumTasks);
+  std::vector<task_scheduler::task_id> ids;
+  for (size_t i = 0; i < kNumTasks; i++) {
+    atomic::init(&counts[i], static_cast<uint64_t>(0));
+    ids.push_back(scheduler.schedule("task", [&counts, i] {
+      atomic::faa(&counts[i], static_cast<uint64_t>(1));
+    }, 10));
+  }
+  ASSERT_EQ(kNumTasks, scheduler.num_tasks());
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  for (size_t i = 0; i < kNumTasks; i++)
+    ASSERT_TRUE(scheduler.cancel(ids[i]));
+  ASSERT_FALSE(scheduler.cancel(ids[0]));
+
+  std::vector<uint64_t> stopped;
+  for (size_t i = 0; i < kNumTasks; i++) {
+    stopped.push_back(atomic::load(&counts[i]));
+    ASSERT_GT(stopped[i], 0U);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  for (size_t i = 0; i < kNumTasks; i++)
+    ASSERT_EQ(stopped[i], atomic::load(&counts[i]));
+}
+
+TEST_F(TaskSchedulerTest, LongIntervalTest) {
+  // A 100ms interval lives in an outer wheel until it cascades
+  task_scheduler scheduler(1);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<uint64_t> run_ms;
+  std::mutex mtx;
+  scheduled_task task("long", scheduler);
+  task.start([&] {
+    std::lock_guard<std::mutex> lk(mtx);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    run_ms.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+  }, 100);
+  std::this_thread::sleep_for(std::chrono::milliseconds(450));
+  task.stop();
+
+  std::lock_guard<std::mutex> lk(mtx);
+  ASSERT_GE(run_ms.size(), 4U);
+  ASSERT_LE(run_ms.size(), 6U);
+  for (size_t i = 1; i < run_ms.size(); i++)
+    ASSERT_GE(run_ms[i] - run_ms[i - 1], 90U);
+}
+
+TEST_F(TaskSchedulerTest, CancelWaitsForRunTest) {
+  task_scheduler scheduler(1);
+  atomic::type<bool> running(false);
+  atomic::type<bool> finished(false);
+  scheduled_task task("slow", scheduler);
+  task.start([&running, &finished] {
+    atomic::store(&running, true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    atomic::store(&finished, true);
+  }, 1);
+  while (!atomic::load(&running))
+    std::this_thread::yield();
+  task.stop();
+  ASSERT_TRUE(atomic::load(&finished));
+}
+
+TEST_F(TaskSchedulerTest, ParkTest) {
+  task_scheduler scheduler(1);
+  atomic::type<uint64_t> runs(0);
+  scheduled_task task("park", scheduler);
+  ASSERT_FALSE(task.park());
+  task.start([&runs, &task] {
+    atomic::faa(&runs, static_cast<uint64_t>(1));
+    task.park();
+  }, 1);
+
+  // A parked task is not run again until it is woken
+  while (atomic::load(&runs) == 0)
+    std::this_thread::yield();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(1U, atomic::load(&runs));
+
+  ASSERT_TRUE(task.wake());
+  while (atomic::load(&runs) == 1)
+    std::this_thread::yield();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(2U, atomic::load(&runs));
+
+  // Waking a task that is not parked has no effect
+  ASSERT_TRUE(task.wake());
+  ASSERT_FALSE(task.wake());
+  task.stop();
+  ASSERT_FALSE(task.wake());
+}
+
+#endif /* CONFLUO_TEST_TASK_SCHEDULER_TEST_H_ */
@@ -0,0 +1,123 @@
+#ifndef CONFLUO_TEST_TYPED_MULTILOG_TEST_H_
+#define CONFLUO_TEST_TYPED_MULTILOG_TEST_H_
+
+#include "typed_multilog.h"
+#include "gtest/gtest.h"
+
+using namespace ::confluo;
+
+class TypedMultilogTest : public testing::Test {
+ public:
+  static task_pool MGMT_POOL;
+
+  typedef typed_multilog<int64_t, bool, int32_t, double, std::array<char, 8>> typed_log;
+
+  struct rec {
+    int64_t ts;
+    bool a;
+    int32_t b;
+    double c;
+    char d[8];
+  }__attribute__((packed));
+
+  static std::vector<column_t> schema() {
+    return schema_builder().add_column(primitive_types::BOOL_TYPE(), "a")
+                           .add_column(primitive_types::INT_TYPE(), "b")
+                           .add_column(primitive_types::DOUBLE_TYPE(), "c")
+                           .add_column(primitive_types::STRING_TYPE(8), "d").get_columns();
+  }
+
+  static std::array<char, 8> str(const std::string &s) {
+    std::array<char, 8> a;
+    a.fill('\0');
+    memcpy(a.data(), s.data(), std::min(s.size(), a.size()));
+    return a;
+  }
+
+ protected:
+  virtual void SetUp() override {
+    thread_manager::register_thread();
+  }
+
+  virtual void TearDown() override {
+    thread_manager::deregister_thread();
+  }
+};
+
+task_pool TypedMultilogTest::MGMT_POOL;
+
+TEST_F(TypedMultilogTest, BindTest) {
+  atomic_multilog mlog("typed_table", schema(), "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  ASSERT_NO_THROW(typed_log t(&mlog));
+  ASSERT_NO_THROW((typed_multilog<uint64_t, bool, int32_t, double, std::array<char, 8>>(&mlog)));
+  ASSERT_THROW((typed_multilog<int64_t, bool, int32_t, double>(&mlog)), invalid_cast_exception);
+  ASSERT_THROW((typed_multilog<int64_t, bool, int64_t, double, std::array<char, 8>>(&mlog)), invalid_cast_exception);
+  ASSERT_THROW((typed_multilog<int64_t, bool, int32_t, float, std::array<char, 8>>(&mlog)), invalid_cast_exception);
+  ASSERT_THROW((typed_multilog<int64_t, bool, int32_t, double, std::array<char, 4>>(&mlog)), invalid_cast_exception);
+  ASSERT_EQ(mlog.record_size(), typed_log::record_type::SIZE);
+}
+
+TEST_F(TypedMultilogTest, AppendReadTest) {
+  atomic_multilog mlog("typed_table", schema(), "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  typed_log t(&mlog);
+
+  size_t o1 = t.append(std::make_tuple(INT64_C(1000), true, 7, 0.5, str("abc")));
+  rec r = {2000, false, -3, 1.5, {'x', 'y', 'z', 0, 0, 0, 0, 0}};
+  size_t o2 = t.append_struct(r);
+
+  // Typed appends are interchangeable with string-based reads
+  std::vector<std::string> s = mlog.read(o1);
+  ASSERT_EQ("1000", s[0]);
+  ASSERT_EQ("true", s[1]);
+  ASSERT_EQ("7", s[2]);
+  ASSERT_EQ("abc", s[4].substr(0, 3));
+
+  typed_log::tuple_type tup;
+  ASSERT_TRUE(t.read(o2, tup));
+  ASSERT_EQ(2000, std::get<0>(tup));
+  ASSERT_FALSE(std::get<1>(tup));
+  ASSERT_EQ(-3, std::get<2>(tup));
+  ASSERT_EQ(1.5, std::get<3>(tup));
+  ASSERT_EQ(str("xyz"), std::get<4>(tup));
+
+  rec out;
+  ASSERT_TRUE(t.read_struct(o1, out));
+  ASSERT_EQ(1000, out.ts);
+  ASSERT_EQ(7, out.b);
+  ASSERT_FALSE(t.read(o2 + mlog.record_size(), tup));
+}
+
+TEST_F(TypedMultilogTest, BatchCursorTest) {
+  atomic_multilog mlog("typed_table", schema(), "/tmp", storage::IN_MEMORY, archival_mode::OFF, MGMT_POOL);
+  mlog.add_filter("positive", "b > 0");
+  typed_log t(&mlog);
+
+  std::vector<typed_log::tuple_type> tuples;
+  for (int32_t i = 0; i < 1000; i++)
+    tuples.push_back(std::make_tuple(static_cast<int64_t>(i) * 10000, i % 2 == 0, i - 500, i * 0.5, str("t")));
+  size_t offset = t.append_batch(tuples);
+  ASSERT_EQ(0U, offset);
+
+  std::vector<rec> structs(1000);
+  for (int32_t i = 0; i < 1000; i++)
+    structs[i] = {static_cast<int64_t>(i + 1000) * 10000, false, i + 500, 0.0, {'s', 0, 0, 0, 0, 0, 0, 0}};
+  t.append_batch_struct(structs.data(), structs.size());
+  ASSERT_EQ(2000U, mlog.num_records());
+
+  size_t count = 0;
+  for (auto c = t.execute_filter("b > 400 && b < 600"); c.has_more(); c.advance()) {
+    int32_t b = std::get<2>(c.get());
+    ASSERT_TRUE(b > 400 && b < 600);
+    ASSERT_EQ(b, c.get_as<rec>().b);
+    ASSERT_EQ(c.offset() / mlog.record_size() < 1000 ? str("t") : str("s"), std::get<4>(c.get()));
+    count++;
+  }
+  ASSERT_EQ(199U, count);
+
+  count = 0;
+  for (auto c = t.query_filter("positive", 0, 1000); c.has_more(); c.advance())
+    count++;
+  ASSERT_EQ(499U + 1000U, count);
+}
+
+#endif /* CONFLUO_TEST_TYPED_MULTILOG_TEST_H_ */
@@ -1,8 +1,11 @@
 #ifndef CONFLUO_TEST_DATA_TYPES_TEST_H_
 #define CONFLUO_TEST_DATA_TYPES_TEST_H_
 
+#include <sstream>
+
 #include "gtest/gtest.h"
 #include "types/data_type.h"
+#include "types/type_manager.h"
 
 using namespace ::confluo;
 
@@ -35,4 +38,17 @@ TEST_F(DataTypesTest, GetterTest) {
   ASSERT_TRUE(t8.name() == "none");
 }
 
+TEST_F(DataTypesTest, VarcharTest) {
+  data_type t = data_type::from_string("VARCHAR");
+  ASSERT_TRUE(primitive_types::VARCHAR_TYPE() == t);
+  ASSERT_TRUE(t.is_valid());
+  ASSERT_TRUE(t.is_var_length());
+  ASSERT_TRUE(t.name() == "varchar");
+  ASSERT_TRUE(type_manager::get_type(primitive_type::D_VARCHAR, t.size) == t);
+
+  std::stringstream ss;
+  t.serialize(ss);
+  ASSERT_TRUE(data_type::deserialize(ss) == t);
+}
+
 #endif /* CONFLUO_TEST_DATA_TYPES_TEST_H_ */
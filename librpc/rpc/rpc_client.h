@@ -246,6 +246,20 @@ class rpc_client {
    */
   std::string get_aggregate(const std::string &aggregate_name, int64_t begin_ms, int64_t end_ms);
 
+  /**
+   * Gets an aggregate from the client, downsampled into fixed-width
+   * intervals
+   *
+   * @param aggregate_name The name of the aggregate to get
+   * @param begin_ms The beginning time in milliseconds
+   * @param end_ms The end time in milliseconds
+   * @param interval_ms The width of each interval in milliseconds
+   *
+   * @return The aggregated statistic for each interval
+   */
+  std::vector<numeric> get_aggregate_series(const std::string &aggregate_name, int64_t begin_ms, int64_t end_ms,
+                                            int64_t interval_ms);
+
   // TODO: Add tests
   /**
    * Executes an aggregate
@@ -428,6 +442,33 @@ class rpc_client {
    */
   std::string recv_get_aggregate();
 
+  /**
+   * Sends the downsampled aggregate query from the client
+   *
+   * @param aggregate_name The name of the aggregate
+   * @param begin_ms The beginning time in milliseconds
+   * @param end_ms The end time in milliseconds
+   * @param interval_ms The width of each interval in milliseconds
+   */
+  void send_get_aggregate_series(const std::string &aggregate_name, int64_t begin_ms, int64_t end_ms,
+                                 int64_t interval_ms);
+
+  /**
+   * Receives a downsampled aggregate
+   *
+   * @return The aggregated statistic for each interval
+   */
+  std::vector<numeric> recv_get_aggregate_series();
+
+  /**
+   * Receives a downsampled aggregate, along with the name of the aggregator
+   * that produced it on the server
+   *
+   * @param aggregator_name Set to the name of the aggregator, e.g., sum
+   * @return The aggregated statistic for each interval
+   */
+  std::vector<numeric> recv_get_aggregate_series(std::string &aggregator_name);
+
   /**
    * Sends the aggregate from the client
    *
@@ -540,6 +581,16 @@ class rpc_client {
   int64_t recv_num_records();
 
  protected:
+  /**
+   * Gets the expected size of an inline record, including the values of
+   * its variable-length columns
+   *
+   * @param record The record data
+   *
+   * @return The expected size of the record
+   */
+  size_t expected_record_size(const record_data &record) const;
+
   /** The multilog identifier for the client */
   int64_t cur_multilog_id_;
   /** The schema of the multilog */
@@ -0,0 +1,390 @@
+#ifndef RPC_RPC_FEDERATED_CLIENT_H_
+#define RPC_RPC_FEDERATED_CLIENT_H_
+
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "rpc_client.h"
+
+namespace confluo {
+namespace rpc {
+
+/**
+ * A stream over several streams, one after the other
+ */
+template<typename stream_t>
+class rpc_federated_stream {
+ public:
+  /**
+   * Constructs a federated stream
+   *
+   * @param streams The streams
+   */
+  explicit rpc_federated_stream(std::vector<stream_t> &&streams)
+      : streams_(std::move(streams)),
+        cur_(0) {
+    skip_empty();
+  }
+
+  /**
+   * Gets the current element
+   *
+   * @return The current element
+   */
+  auto get() -> decltype(std::declval<stream_t &>().get()) {
+    return streams_[cur_].get();
+  }
+
+  /**
+   * Advances the stream
+   *
+   * @return This updated stream
+   */
+  rpc_federated_stream &operator++() {
+    ++streams_[cur_];
+    skip_empty();
+    return *this;
+  }
+
+  /**
+   * Checks whether there are any more elements in the stream
+   *
+   * @return True if there are more elements, false otherwise
+   */
+  bool has_more() const {
+    return cur_ < streams_.size();
+  }
+
+  /**
+   * Checks whether the stream is empty
+   *
+   * @return True if the stream is empty, false otherwise
+   */
+  bool empty() const {
+    return !has_more();
+  }
+
+ private:
+  void skip_empty() {
+    while (cur_ < streams_.size() && !streams_[cur_].has_more())
+      cur_++;
+  }
+
+  std::vector<stream_t> streams_;
+  size_t cur_;
+};
+
+/** A stream of records from several servers */
+typedef rpc_federated_stream<rpc_record_stream> rpc_federated_record_stream;
+/** A stream of alerts from several servers */
+typedef rpc_federated_stream<rpc_alert_stream> rpc_federated_alert_stream;
+
+/**
+ * A client for a logical atomic multilog whose shards are atomic
+ * multilogs with the same name on several confluo servers. Management
+ * operations are applied on every server. Queries are sent to every
+ * server before any reply is awaited, so that servers evaluate them
+ * concurrently; partial aggregates are combined on the client, and
+ * record and alert streams are concatenated.
+ */
+class rpc_federated_client {
+ public:
+  /**
+   * Constructs a federated client without any shards
+   */
+  rpc_federated_client();
+
+  /**
+   * Connects to a server and adds it as a shard
+   *
+   * @param host The hostname of the server
+   * @param port The port of the server
+   */
+  void add_shard(const std::string &host, int port);
+
+  /**
+   * Gets the number of shards
+   *
+   * @return The number of shards
+   */
+  size_t num_shards() const;
+
+  /**
+   * Gets the client of a shard
+   *
+   * @param i The index of the shard
+   * @return The client
+   */
+  rpc_client &shard(size_t i);
+
+  /**
+   * Disconnects from all servers
+   */
+  void disconnect();
+
+  // Management ops
+  /**
+   * Creates an atomic multilog on every server
+   *
+   * @param name The name of the atomic multilog
+   * @param schema The schema of the atomic multilog
+   * @param mode The storage mode
+   */
+  void create_atomic_multilog(const std::string &name, const schema_t &schema, const storage::storage_mode mode);
+
+  /**
+   * Sets the atomic multilog on every server
+   *
+   * @param name The name of the atomic multilog
+   * @throw illegal_state_exception If the schemas of the servers differ
+   */
+  void set_current_atomic_multilog(const std::string &name);
+
+  /**
+   * Gets the schema of the current atomic multilog
+   *
+   * @return The schema
+   */
+  schema_t const &current_schema() const;
+
+  /**
+   * Removes the current atomic multilog from every server
+   */
+  void remove_atomic_multilog();
+
+  /**
+   * Adds an index on every server
+   *
+   * @param field_name The name of the field
+   * @param bucket_size The bucket size of the index
+   */
+  void add_index(const std::string &field_name, const double bucket_size = 1.0);
+
+  /**
+   * Removes an index from every server
+   *
+   * @param field_name The name of the field
+   */
+  void remove_index(const std::string &field_name);
+
+  /**
+   * Adds a filter on every server
+   *
+   * @param filter_name The name of the filter
+   * @param filter_expr The filter expression
+   */
+  void add_filter(const std::string &filter_name, const std::string &filter_expr);
+
+  /**
+   * Removes a filter from every server
+   *
+   * @param filter_name The name of the filter
+   */
+  void remove_filter(const std::string &filter_name);
+
+  /**
+   * Adds an aggregate on every server
+   *
+   * @param aggregate_name The name of the aggregate
+   * @param filter_name The name of the filter
+   * @param aggregate_expr The aggregate expression
+   */
+  void add_aggregate(const std::string &aggregate_name,
+                     const std::string &filter_name,
+                     const std::string &aggregate_expr);
+
+  /**
+   * Removes an aggregate from every server
+   *
+   * @param aggregate_name The name of the aggregate
+   */
+  void remove_aggregate(const std::string &aggregate_name);
+
+  /**
+   * Installs a trigger on every server; the trigger is evaluated on the
+   * partial aggregate of each server
+   *
+   * @param trigger_name The name of the trigger
+   * @param trigger_expr The trigger expression
+   */
+  void install_trigger(const std::string &trigger_name, const std::string &trigger_expr);
+
+  /**
+   * Removes a trigger from every server
+   *
+   * @param trigger_name The name of the trigger
+   */
+  void remove_trigger(const std::string &trigger_name);
+
+  // Query ops
+  /**
+   * Gets a record batch builder
+   *
+   * @return The record batch builder
+   */
+  rpc_record_batch_builder get_batch_builder() const;
+
+  /**
+   * Appends a batch of records to the next server, round-robin
+   *
+   * @param batch The batch of records
+   */
+  void append_batch(const rpc_record_batch &batch);
+
+  /**
+   * Appends a record to the next server, round-robin
+   *
+   * @param record The record
+   */
+  void append(const std::vector<std::string> &record);
+
+  /**
+   * Gets a stored aggregate, combining the partial aggregates of every
+   * server
+   *
+   * @param aggregate_name The name of the aggregate
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @return The aggregate
+   * @throw rpc_invalid_operation If a server does not have the aggregate
+   * @throw invalid_operation_exception If the servers' aggregates differ
+   */
+  numeric get_aggregate(const std::string &aggregate_name, int64_t begin_ms, int64_t end_ms);
+
+  /**
+   * Gets a stored aggregate over consecutive intervals, combining the
+   * partial aggregates of every server
+   *
+   * @param aggregate_name The name of the aggregate
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @param interval_ms The width of each interval
+   * @return The aggregate of each interval
+   * @throw rpc_invalid_operation If a server does not have the aggregate
+   * @throw invalid_operation_exception If the servers' aggregates differ,
+   * i.e., use different aggregators or return series of different lengths
+   */
+  std::vector<numeric> get_aggregate_series(const std::string &aggregate_name, int64_t begin_ms, int64_t end_ms,
+                                            int64_t interval_ms);
+
+  /**
+   * Executes an aggregate on every server and combines the partial
+   * aggregates
+   *
+   * @param aggregate_expr The aggregate expression
+   * @param filter_expr The filter expression
+   * @return The aggregate
+   */
+  numeric execute_aggregate(const std::string &aggregate_expr, const std::string &filter_expr);
+
+  /**
+   * Executes a filter on every server
+   *
+   * @param filter_expr The filter expression
+   * @return The matching records
+   */
+  rpc_federated_record_stream execute_filter(const std::string &filter_expr);
+
+  /**
+   * Queries a filter on every server
+   *
+   * @param filter_name The name of the filter
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @return The records
+   */
+  rpc_federated_record_stream query_filter(const std::string &filter_name, const int64_t begin_ms,
+                                           const int64_t end_ms);
+
+  /**
+   * Queries a filter on every server with an additional filter expression
+   *
+   * @param filter_name The name of the filter
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @param additional_filter_expr The additional filter expression
+   * @return The records
+   */
+  rpc_federated_record_stream query_filter(const std::string &filter_name,
+                                           const int64_t begin_ms,
+                                           const int64_t end_ms,
+                                           const std::string &additional_filter_expr);
+
+  /**
+   * Gets the alerts of every server
+   *
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @return The alerts
+   */
+  rpc_federated_alert_stream get_alerts(const int64_t begin_ms, const int64_t end_ms);
+
+  /**
+   * Gets the alerts of a trigger from every server
+   *
+   * @param begin_ms The beginning of the time range
+   * @param end_ms The end of the time range
+   * @param trigger_name The name of the trigger
+   * @return The alerts
+   */
+  rpc_federated_alert_stream get_alerts(const int64_t begin_ms, const int64_t end_ms,
+                                        const std::string &trigger_name);
+
+  /**
+   * Gets the number of records on all servers
+   *
+   * @return The number of records
+   */
+  int64_t num_records();
+
+ private:
+  /**
+   * Sends a request to every shard, then receives every shard's reply. A
+   * reply is received from every shard the request was sent to, even if an
+   * earlier send or receive fails, so that no connection is left with an
+   * unread reply; the first exception is rethrown afterwards.
+   *
+   * @tparam SEND The type of the send operation
+   * @tparam RECV The type of the receive operation
+   * @param send Sends the request to a shard
+   * @param recv Receives the reply of the shard with the given index
+   */
+  template<typename SEND, typename RECV>
+  void fan_out(SEND send, RECV recv) {
+    std::exception_ptr ex;
+    size_t nsent = 0;
+    try {
+      for (; nsent < shards_.size(); nsent++)
+        send(*shards_[nsent]);
+    } catch (...) {
+      ex = std::current_exception();
+    }
+    for (size_t i = 0; i < nsent; i++) {
+      try {
+        recv(i, *shards_[i]);
+      } catch (...) {
+        if (!ex)
+          ex = std::current_exception();
+      }
+    }
+    if (ex)
+      std::rethrow_exception(ex);
+  }
+
+  /**
+   * Parses an aggregate returned by a server, e.g., double(0.10000000000000001)
+   *
+   * @param str The string representation of the aggregate
+   * @return The aggregate
+   */
+  static numeric parse_aggregate_result(const std::string &str);
+
+  std::vector<std::unique_ptr<rpc_client>> shards_;
+  size_t next_shard_;
+};
+
+}
+}
+
+#endif /* RPC_RPC_FEDERATED_CLIENT_H_ */
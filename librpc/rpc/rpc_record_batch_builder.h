@@ -75,6 +75,7 @@ class rpc_record_batch_builder {
  private:
   size_t nrecords_;
   std::map<int64_t, size_t> batch_sizes_;
+  std::map<int64_t, size_t> batch_nrecords_;
   std::map<int64_t, std::stringstream> batch_;
   const schema_t &schema_;
 };
@@ -250,6 +250,24 @@ class rpc_service_handler : virtual public rpc_serviceIf {
                        int64_t begin_ms,
                        int64_t end_ms);
 
+  /**
+   * Queries an aggregate from the atomic multilog, downsampled into
+   * fixed-width intervals
+   *
+   * @param _return The packed array of per-interval aggregates
+   * @param id The identifier of the atomic multilog
+   * @param aggregate_name The name of the aggregate
+   * @param begin_ms The beginning time in milliseconds
+   * @param end_ms The end time in milliseconds
+   * @param interval_ms The width of each interval in milliseconds
+   */
+  void query_aggregate_series(std::string &_return,
+                              int64_t id,
+                              const std::string &aggregate_name,
+                              int64_t begin_ms,
+                              int64_t end_ms,
+                              int64_t interval_ms);
+
   // TODO: Add tests
   /**
    * Sets the adhoc aggregate
@@ -355,11 +373,11 @@ class rpc_service_handler : virtual public rpc_serviceIf {
  private:
   rpc_iterator_id new_iterator_id();
 
-  void adhoc_more(rpc_iterator_handle &_return, size_t record_size, rpc_iterator_id it_id);
+  void adhoc_more(rpc_iterator_handle &_return, const schema_t &schema, rpc_iterator_id it_id);
 
-  void predef_more(rpc_iterator_handle &_return, size_t record_size, rpc_iterator_id it_id);
+  void predef_more(rpc_iterator_handle &_return, const schema_t &schema, rpc_iterator_id it_id);
 
-  void combined_more(rpc_iterator_handle &_return, size_t record_size, rpc_iterator_id it_id);
+  void combined_more(rpc_iterator_handle &_return, const schema_t &schema, rpc_iterator_id it_id);
 
   void alerts_more(rpc_iterator_handle &_return, rpc_iterator_id it_id);
 
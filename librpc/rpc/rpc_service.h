@@ -63,6 +63,12 @@ class rpc_serviceIf {
                                const std::string &aggregate_name,
                                const int64_t begin_ms,
                                const int64_t end_ms) = 0;
+  virtual void query_aggregate_series(std::string &_return,
+                                      const int64_t multilog_id,
+                                      const std::string &aggregate_name,
+                                      const int64_t begin_ms,
+                                      const int64_t end_ms,
+                                      const int64_t interval_ms) = 0;
   virtual void adhoc_aggregate(std::string &_return,
                                const int64_t multilog_id,
                                const std::string &aggregate_expr,
@@ -195,6 +201,14 @@ class rpc_serviceNull : virtual public rpc_serviceIf {
                        const int64_t /* end_ms */) {
     return;
   }
+  void query_aggregate_series(std::string & /* _return */,
+                              const int64_t /* multilog_id */,
+                              const std::string & /* aggregate_name */,
+                              const int64_t /* begin_ms */,
+                              const int64_t /* end_ms */,
+                              const int64_t /* interval_ms */) {
+    return;
+  }
   void adhoc_aggregate(std::string & /* _return */,
                        const int64_t /* multilog_id */,
                        const std::string & /* aggregate_expr */,
@@ -2156,6 +2170,148 @@ class rpc_service_query_aggregate_presult {
 
 };
 
+typedef struct _rpc_service_query_aggregate_series_args__isset {
+  _rpc_service_query_aggregate_series_args__isset()
+      : multilog_id(false), aggregate_name(false), begin_ms(false), end_ms(false), interval_ms(false) {}
+  bool multilog_id :1;
+  bool aggregate_name :1;
+  bool begin_ms :1;
+  bool end_ms :1;
+  bool interval_ms :1;
+} _rpc_service_query_aggregate_series_args__isset;
+
+class rpc_service_query_aggregate_series_args {
+ public:
+
+  rpc_service_query_aggregate_series_args(const rpc_service_query_aggregate_series_args &);
+  rpc_service_query_aggregate_series_args &operator=(const rpc_service_query_aggregate_series_args &);
+  rpc_service_query_aggregate_series_args() : multilog_id(0), aggregate_name(), begin_ms(0), end_ms(0), interval_ms(0) {
+  }
+
+  virtual ~rpc_service_query_aggregate_series_args() throw();
+  int64_t multilog_id;
+  std::string aggregate_name;
+  int64_t begin_ms;
+  int64_t end_ms;
+  int64_t interval_ms;
+
+  _rpc_service_query_aggregate_series_args__isset __isset;
+
+  void __set_multilog_id(const int64_t val);
+
+  void __set_aggregate_name(const std::string &val);
+
+  void __set_begin_ms(const int64_t val);
+
+  void __set_end_ms(const int64_t val);
+
+  void __set_interval_ms(const int64_t val);
+
+  bool operator==(const rpc_service_query_aggregate_series_args &rhs) const {
+    if (!(multilog_id == rhs.multilog_id))
+      return false;
+    if (!(aggregate_name == rhs.aggregate_name))
+      return false;
+    if (!(begin_ms == rhs.begin_ms))
+      return false;
+    if (!(end_ms == rhs.end_ms))
+      return false;
+    if (!(interval_ms == rhs.interval_ms))
+      return false;
+    return true;
+  }
+  bool operator!=(const rpc_service_query_aggregate_series_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator<(const rpc_service_query_aggregate_series_args &) const;
+
+  template<class Protocol_>
+  uint32_t read(Protocol_ *iprot);
+  template<class Protocol_>
+  uint32_t write(Protocol_ *oprot) const;
+
+};
+
+class rpc_service_query_aggregate_series_pargs {
+ public:
+
+  virtual ~rpc_service_query_aggregate_series_pargs() throw();
+  const int64_t *multilog_id;
+  const std::string *aggregate_name;
+  const int64_t *begin_ms;
+  const int64_t *end_ms;
+  const int64_t *interval_ms;
+
+  template<class Protocol_>
+  uint32_t write(Protocol_ *oprot) const;
+
+};
+
+typedef struct _rpc_service_query_aggregate_series_result__isset {
+  _rpc_service_query_aggregate_series_result__isset() : success(false), ex(false) {}
+  bool success :1;
+  bool ex :1;
+} _rpc_service_query_aggregate_series_result__isset;
+
+class rpc_service_query_aggregate_series_result {
+ public:
+
+  rpc_service_query_aggregate_series_result(const rpc_service_query_aggregate_series_result &);
+  rpc_service_query_aggregate_series_result &operator=(const rpc_service_query_aggregate_series_result &);
+  rpc_service_query_aggregate_series_result() : success() {
+  }
+
+  virtual ~rpc_service_query_aggregate_series_result() throw();
+  std::string success;
+  rpc_invalid_operation ex;
+
+  _rpc_service_query_aggregate_series_result__isset __isset;
+
+  void __set_success(const std::string &val);
+
+  void __set_ex(const rpc_invalid_operation &val);
+
+  bool operator==(const rpc_service_query_aggregate_series_result &rhs) const {
+    if (!(success == rhs.success))
+      return false;
+    if (!(ex == rhs.ex))
+      return false;
+    return true;
+  }
+  bool operator!=(const rpc_service_query_aggregate_series_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator<(const rpc_service_query_aggregate_series_result &) const;
+
+  template<class Protocol_>
+  uint32_t read(Protocol_ *iprot);
+  template<class Protocol_>
+  uint32_t write(Protocol_ *oprot) const;
+
+};
+
+typedef struct _rpc_service_query_aggregate_series_presult__isset {
+  _rpc_service_query_aggregate_series_presult__isset() : success(false), ex(false) {}
+  bool success :1;
+  bool ex :1;
+} _rpc_service_query_aggregate_series_presult__isset;
+
+class rpc_service_query_aggregate_series_presult {
+ public:
+
+  virtual ~rpc_service_query_aggregate_series_presult() throw();
+  std::string *success;
+  rpc_invalid_operation ex;
+
+  _rpc_service_query_aggregate_series_presult__isset __isset;
+
+  template<class Protocol_>
+  uint32_t read(Protocol_ *iprot);
+
+};
+
 typedef struct _rpc_service_adhoc_aggregate_args__isset {
   _rpc_service_adhoc_aggregate_args__isset() : multilog_id(false), aggregate_expr(false), filter_expr(false) {}
   bool multilog_id :1;
@@ -3258,6 +3414,18 @@ class rpc_serviceClientT : virtual public rpc_serviceIf {
                             const int64_t begin_ms,
                             const int64_t end_ms);
   void recv_query_aggregate(std::string &_return);
+  void query_aggregate_series(std::string &_return,
+                              const int64_t multilog_id,
+                              const std::string &aggregate_name,
+                              const int64_t begin_ms,
+                              const int64_t end_ms,
+                              const int64_t interval_ms);
+  void send_query_aggregate_series(const int64_t multilog_id,
+                                   const std::string &aggregate_name,
+                                   const int64_t begin_ms,
+                                   const int64_t end_ms,
+                                   const int64_t interval_ms);
+  void recv_query_aggregate_series(std::string &_return);
   void adhoc_aggregate(std::string &_return,
                        const int64_t multilog_id,
                        const std::string &aggregate_expr,
@@ -3435,6 +3603,11 @@ class rpc_serviceProcessorT : public ::apache::thrift::TDispatchProcessorT<Proto
                                ::apache::thrift::protocol::TProtocol *oprot,
                                void *callContext);
   void process_query_aggregate(int32_t seqid, Protocol_ *iprot, Protocol_ *oprot, void *callContext);
+  void process_query_aggregate_series(int32_t seqid,
+                                      ::apache::thrift::protocol::TProtocol *iprot,
+                                      ::apache::thrift::protocol::TProtocol *oprot,
+                                      void *callContext);
+  void process_query_aggregate_series(int32_t seqid, Protocol_ *iprot, Protocol_ *oprot, void *callContext);
   void process_adhoc_aggregate(int32_t seqid,
                                ::apache::thrift::protocol::TProtocol *iprot,
                                ::apache::thrift::protocol::TProtocol *oprot,
@@ -3529,6 +3702,9 @@ class rpc_serviceProcessorT : public ::apache::thrift::TDispatchProcessorT<Proto
     processMap_["query_aggregate"] = ProcessFunctions(
         &rpc_serviceProcessorT::process_query_aggregate,
         &rpc_serviceProcessorT::process_query_aggregate);
+    processMap_["query_aggregate_series"] = ProcessFunctions(
+        &rpc_serviceProcessorT::process_query_aggregate_series,
+        &rpc_serviceProcessorT::process_query_aggregate_series);
     processMap_["adhoc_aggregate"] = ProcessFunctions(
         &rpc_serviceProcessorT::process_adhoc_aggregate,
         &rpc_serviceProcessorT::process_adhoc_aggregate);
@@ -3749,6 +3925,21 @@ class rpc_serviceMultiface : virtual public rpc_serviceIf {
     return;
   }
 
+  void query_aggregate_series(std::string &_return,
+                              const int64_t multilog_id,
+                              const std::string &aggregate_name,
+                              const int64_t begin_ms,
+                              const int64_t end_ms,
+                              const int64_t interval_ms) {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->query_aggregate_series(_return, multilog_id, aggregate_name, begin_ms, end_ms, interval_ms);
+    }
+    ifaces_[i]->query_aggregate_series(_return, multilog_id, aggregate_name, begin_ms, end_ms, interval_ms);
+    return;
+  }
+
   void adhoc_aggregate(std::string &_return,
                        const int64_t multilog_id,
                        const std::string &aggregate_expr,
@@ -3944,6 +4135,18 @@ class rpc_serviceConcurrentClientT : virtual public rpc_serviceIf {
                                const int64_t begin_ms,
                                const int64_t end_ms);
   void recv_query_aggregate(std::string &_return, const int32_t seqid);
+  void query_aggregate_series(std::string &_return,
+                              const int64_t multilog_id,
+                              const std::string &aggregate_name,
+                              const int64_t begin_ms,
+                              const int64_t end_ms,
+                              const int64_t interval_ms);
+  int32_t send_query_aggregate_series(const int64_t multilog_id,
+                                      const std::string &aggregate_name,
+                                      const int64_t begin_ms,
+                                      const int64_t end_ms,
+                                      const int64_t interval_ms);
+  void recv_query_aggregate_series(std::string &_return, const int32_t seqid);
   void adhoc_aggregate(std::string &_return,
                        const int64_t multilog_id,
                        const std::string &aggregate_expr,
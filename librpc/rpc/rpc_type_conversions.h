@@ -4,6 +4,7 @@
 #include "schema/record_batch.h"
 #include "schema/schema.h"
 #include "storage/storage.h"
+#include "types/numeric.h"
 #include "rpc_types.h"
 
 namespace confluo {
@@ -55,6 +56,51 @@ class rpc_type_conversions {
    * @return The resultant rpc storage mode
    */
   static rpc_storage_mode convert_mode(const storage::storage_mode &mode);
+
+  /**
+   * Packs a series of aggregate values into a binary array: the type id and
+   * type size of the values and the length of the aggregator name (as 32-bit
+   * integers), the aggregator name, then the raw bytes of each value
+   *
+   * @param series The series of aggregate values, all of the same type
+   * @param aggregator_name The name of the aggregator that produced the
+   * values, e.g., sum
+   *
+   * @return The packed binary array
+   */
+  static std::string convert_series(const std::vector<numeric> &series, const std::string &aggregator_name);
+
+  /**
+   * Unpacks a binary array of aggregate values
+   *
+   * @param packed The packed binary array
+   *
+   * @return The series of aggregate values
+   */
+  static std::vector<numeric> convert_series(const std::string &packed);
+
+  /**
+   * Unpacks a binary array of aggregate values, along with the name of the
+   * aggregator that produced them
+   *
+   * @param packed The packed binary array
+   * @param aggregator_name Set to the name of the aggregator
+   *
+   * @return The series of aggregate values
+   */
+  static std::vector<numeric> convert_series(const std::string &packed, std::string &aggregator_name);
+
+  /**
+   * Converts an aggregate value to its string form, e.g., double(0.5).
+   * Unlike numeric::to_string, floating-point values are printed with
+   * enough digits to be parsed back exactly, so that partial aggregates
+   * from several servers can be combined without loss of precision.
+   *
+   * @param value The aggregate value
+   *
+   * @return The string form of the value
+   */
+  static std::string convert_aggregate(const numeric &value);
 };
 }
 }
@@ -44,6 +44,7 @@ enum rpc_data_type {
   RPC_FLOAT = 10,
   RPC_DOUBLE = 11,
   RPC_STRING = 12,
+  RPC_VARCHAR = 10000,
   RPC_RECORD = 10001,
   RPC_ALERT = 10002
 };
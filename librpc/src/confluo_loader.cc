@@ -0,0 +1,99 @@
+#include <error_handling.h>
+#include <logger.h>
+#include "cmd_parse.h"
+#include "confluo_store.h"
+#include "file_utils.h"
+#include "ingest/bulk_loader.h"
+
+using namespace ::confluo;
+using namespace ::confluo::ingest;
+using namespace ::utils;
+
+int main(int argc, char **argv) {
+  utils::error_handling::install_signal_handler(argv[0], SIGSEGV, SIGKILL, SIGSTOP);
+
+  cmd_options opts;
+  opts.add(cmd_option("data-path", 'd', false).set_default(".").set_description("Data path for Confluo"));
+  opts.add(cmd_option("multilog", 'm', false).set_description("Name of the atomic multilog to load into"));
+  opts.add(cmd_option("input", 'i', false).set_description("Input file"));
+  opts.add(cmd_option("format", 'f', false).set_default("csv").set_description("Input format: csv, json or binary"));
+  opts.add(cmd_option("schema", 's', false).set_description(
+      "Schema for creating the atomic multilog if it does not exist, e.g., {a: INT, b: STRING(8)}"));
+  opts.add(cmd_option("storage-mode", 'o', false).set_default("durable_relaxed").set_description(
+      "Storage mode for creating the atomic multilog: durable or durable_relaxed"));
+  opts.add(cmd_option("threads", 't', false).set_default("0").set_description(
+      "Number of loader threads; 0 uses one per core"));
+  opts.add(cmd_option("batch-size", 'b', false).set_default("16384").set_description("Records per appended batch"));
+  opts.add(cmd_option("skip-header", 'k', true).set_description("Skip the first line of a CSV file"));
+
+  cmd_parser parser(argc, argv, opts);
+  if (parser.get_flag("help")) {
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  std::string data_path;
+  std::string name;
+  std::string input;
+  bulk_format format;
+  storage::storage_mode mode;
+  size_t num_threads;
+  size_t batch_size;
+  bool skip_header;
+
+  try {
+    data_path = parser.get("data-path");
+    name = parser.get("multilog");
+    input = parser.get("input");
+    format = bulk_loader::parse_format(parser.get("format"));
+    std::string mode_str = string_utils::to_lower(parser.get("storage-mode"));
+    if (mode_str == "durable") {
+      mode = storage::DURABLE;
+    } else if (mode_str == "durable_relaxed") {
+      mode = storage::DURABLE_RELAXED;
+    } else {
+      throw parse_exception("Unknown storage mode " + mode_str);
+    }
+    num_threads = static_cast<size_t>(parser.get_long("threads"));
+    batch_size = static_cast<size_t>(parser.get_long("batch-size"));
+    skip_header = parser.get_flag("skip-header");
+  } catch (std::exception &e) {
+    fprintf(stderr, "could not parse cmdline args: %s\n", e.what());
+    fprintf(stderr, "%s\n", parser.help_msg().c_str());
+    return 0;
+  }
+
+  std::string schema;
+  try {
+    schema = parser.get("schema");
+  } catch (std::out_of_range &e) {
+    // The atomic multilog must already exist
+  }
+
+  LOG_INFO << parser.parsed_values();
+
+  thread_manager::register_thread();
+  confluo_store store(data_path);
+  try {
+    if (file_utils::exists_file(data_path + "/" + name + "/metadata")) {
+      store.load_atomic_multilog(name);
+    } else if (!schema.empty()) {
+      store.create_atomic_multilog(name, schema, mode);
+    } else {
+      throw management_exception("No atomic multilog " + name + " in " + data_path + ", and no schema given");
+    }
+
+    bulk_loader loader(store.get_atomic_multilog(name), num_threads, batch_size);
+    bulk_load_stats stats = loader.load(input, format, skip_header);
+    fprintf(stdout, "loaded %llu records (%llu bytes) in %.3f s with %zu threads: %.0f records/s, %.1f MB/s\n",
+            static_cast<unsigned long long>(stats.num_records), static_cast<unsigned long long>(stats.num_bytes),
+            stats.elapsed_s, stats.num_threads, stats.records_per_s(), stats.mb_per_s());
+  } catch (std::exception &e) {
+    LOG_ERROR << "Could not load " << input << " into " << name << ": " << e.what();
+    thread_manager::deregister_thread();
+    return 1;
+  }
+
+  thread_manager::deregister_thread();
+  return 0;
+}
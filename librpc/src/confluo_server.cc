@@ -21,6 +21,8 @@ int main(int argc, char **argv) {
   opts.add(cmd_option("port", 'p', false).set_default("9090").set_description("Port that server listens on"));
   opts.add(cmd_option("address", 'a', false).set_default("127.0.0.1").set_description("Address server binds to"));
   opts.add(cmd_option("data-path", 'd', false).set_default(".").set_description("Data path for Confluo"));
+  opts.add(cmd_option("shm-ingest-dir", 's', false).set_description(
+      "Directory of shared-memory rings for local ingest; disabled if unset"));
 
   cmd_parser parser(argc, argv, opts);
   if (parser.get_flag("help")) {
@@ -31,6 +33,7 @@ int main(int argc, char **argv) {
   int port;
   std::string address;
   std::string data_path;
+  std::string shm_ingest_dir;
 
   try {
     port = parser.get_int("port");
@@ -42,9 +45,17 @@ int main(int argc, char **argv) {
     return 0;
   }
 
+  try {
+    shm_ingest_dir = parser.get("shm-ingest-dir");
+  } catch (std::out_of_range &e) {
+    // Shared-memory ingest is disabled
+  }
+
   LOG_INFO << parser.parsed_values();
 
   confluo_store *store = new confluo_store(data_path);
+  if (!shm_ingest_dir.empty())
+    store->enable_shm_ingest(shm_ingest_dir);
 
   try {
     auto server = rpc_server::create(store, address, port);
@@ -122,9 +122,10 @@ void rpc_client::append(const record_data &record) {
   if (cur_multilog_id_ == -1) {
     throw illegal_state_exception("Must set atomic multilog first");
   }
-  if (record.length() != cur_schema_.record_size()) {
+  size_t expected_size = expected_record_size(record);
+  if (record.length() != expected_size) {
     throw illegal_state_exception("Record size incorrect; expected="
-                                      + std::to_string(cur_schema_.record_size())
+                                      + std::to_string(expected_size)
                                       + ", got=" + std::to_string(record.length()));
   }
   client_->append(cur_multilog_id_, record);
@@ -135,13 +136,19 @@ void rpc_client::append(const std::vector<std::string> &record) {
   }
   record_data rdata;
   cur_schema_.record_vector_to_data(rdata, record);
-  if (rdata.length() != cur_schema_.record_size()) {
+  size_t expected_size = expected_record_size(rdata);
+  if (rdata.length() != expected_size) {
     throw illegal_state_exception("Record size incorrect; expected="
-                                      + std::to_string(cur_schema_.record_size())
+                                      + std::to_string(expected_size)
                                       + ", got=" + std::to_string(rdata.length()));
   }
   client_->append(cur_multilog_id_, rdata);
 }
+size_t rpc_client::expected_record_size(const record_data &record) const {
+  if (record.length() < cur_schema_.record_size())
+    return cur_schema_.record_size();
+  return cur_schema_.inline_record_size(record.data());
+}
 void rpc_client::read(record_data &_return, int64_t offset) {
   read_batch(_return, offset, 1);
 }
@@ -160,10 +167,8 @@ std::vector<std::vector<std::string>> rpc_client::read_batch(int64_t offset, siz
   record_data rdata;
   read_batch(rdata, offset, nrecords);
   std::vector<std::vector<std::string>> _return;
-  size_t nread = rdata.size() / cur_schema_.record_size();
-  for (size_t i = 0; i < nread; i++) {
-    _return.push_back(cur_schema_.data_to_record_vector(rdata.data() +
-        i * cur_schema_.record_size()));
+  for (size_t off = 0; off < rdata.size(); off += cur_schema_.inline_record_size(rdata.data() + off)) {
+    _return.push_back(cur_schema_.data_to_record_vector(rdata.data() + off));
   }
   return _return;
 }
@@ -175,6 +180,17 @@ std::string rpc_client::get_aggregate(const std::string &aggregate_name, int64_t
   client_->query_aggregate(_return, cur_multilog_id_, aggregate_name, begin_ms, end_ms);
   return _return;
 }
+std::vector<numeric> rpc_client::get_aggregate_series(const std::string &aggregate_name,
+                                                      int64_t begin_ms,
+                                                      int64_t end_ms,
+                                                      int64_t interval_ms) {
+  if (cur_multilog_id_ == -1) {
+    throw illegal_state_exception("Must set atomic multilog first");
+  }
+  std::string _return;
+  client_->query_aggregate_series(_return, cur_multilog_id_, aggregate_name, begin_ms, end_ms, interval_ms);
+  return rpc_type_conversions::convert_series(_return);
+}
 std::string rpc_client::execute_aggregate(const std::string &aggregate_expr, const std::string &filter_expr) {
   if (cur_multilog_id_ == -1) {
     throw illegal_state_exception("Must set atomic multilog first");
@@ -248,9 +264,10 @@ void rpc_client::send_append(const record_data &record) {
   if (cur_multilog_id_ == -1) {
     throw illegal_state_exception("Must set atomic multilog first");
   }
-  if (record.length() != cur_schema_.record_size()) {
+  size_t expected_size = expected_record_size(record);
+  if (record.length() != expected_size) {
     throw illegal_state_exception("Record size incorrect; expected="
-                                      + std::to_string(cur_schema_.record_size())
+                                      + std::to_string(expected_size)
                                       + ", got=" + std::to_string(record.length()));
   }
   client_->send_append(cur_multilog_id_, record);
@@ -261,9 +278,10 @@ void rpc_client::send_append(const std::vector<std::string> &record) {
   }
   record_data rdata;
   cur_schema_.record_vector_to_data(rdata, record);
-  if (rdata.length() != cur_schema_.record_size()) {
+  size_t expected_size = expected_record_size(rdata);
+  if (rdata.length() != expected_size) {
     throw illegal_state_exception("Record size incorrect; expected="
-                                      + std::to_string(cur_schema_.record_size())
+                                      + std::to_string(expected_size)
                                       + ", got=" + std::to_string(rdata.length()));
   }
   client_->send_append(cur_multilog_id_, rdata);
@@ -298,9 +316,8 @@ std::vector<std::vector<std::string>> rpc_client::recv_read_batch() {
   record_data data;
   recv_read_batch(data);
   std::vector<std::vector<std::string>> _return;
-  size_t nread = data.size() / cur_schema_.record_size();
-  for (size_t i = 0; i < nread; i++) {
-    _return.push_back(cur_schema_.data_to_record_vector(data.data() + i * cur_schema_.record_size()));
+  for (size_t off = 0; off < data.size(); off += cur_schema_.inline_record_size(data.data() + off)) {
+    _return.push_back(cur_schema_.data_to_record_vector(data.data() + off));
   }
   return _return;
 }
@@ -315,6 +332,25 @@ std::string rpc_client::recv_get_aggregate() {
   client_->recv_query_aggregate(_return);
   return _return;
 }
+void rpc_client::send_get_aggregate_series(const std::string &aggregate_name,
+                                           int64_t begin_ms,
+                                           int64_t end_ms,
+                                           int64_t interval_ms) {
+  if (cur_multilog_id_ == -1) {
+    throw illegal_state_exception("Must set atomic multilog first");
+  }
+  client_->send_query_aggregate_series(cur_multilog_id_, aggregate_name, begin_ms, end_ms, interval_ms);
+}
+std::vector<numeric> rpc_client::recv_get_aggregate_series() {
+  std::string _return;
+  client_->recv_query_aggregate_series(_return);
+  return rpc_type_conversions::convert_series(_return);
+}
+std::vector<numeric> rpc_client::recv_get_aggregate_series(std::string &aggregator_name) {
+  std::string _return;
+  client_->recv_query_aggregate_series(_return);
+  return rpc_type_conversions::convert_series(_return, aggregator_name);
+}
 void rpc_client::send_execute_aggregate(const std::string &aggregate_expr, const std::string &filter_expr) {
   if (cur_multilog_id_ == -1) {
     throw illegal_state_exception("Must set atomic multilog first");
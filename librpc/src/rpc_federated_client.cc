@@ -0,0 +1,253 @@
+#include "rpc_federated_client.h"
+
+#include "aggregate/aggregate_manager.h"
+#include "parser/aggregate_parser.h"
+#include "types/type_manager.h"
+
+namespace confluo {
+namespace rpc {
+
+rpc_federated_client::rpc_federated_client()
+    : next_shard_(0) {
+}
+
+void rpc_federated_client::add_shard(const std::string &host, int port) {
+  shards_.emplace_back(new rpc_client(host, port));
+}
+
+size_t rpc_federated_client::num_shards() const {
+  return shards_.size();
+}
+
+rpc_client &rpc_federated_client::shard(size_t i) {
+  return *shards_.at(i);
+}
+
+void rpc_federated_client::disconnect() {
+  for (auto &s : shards_)
+    s->disconnect();
+}
+
+void rpc_federated_client::create_atomic_multilog(const std::string &name,
+                                                  const schema_t &schema,
+                                                  const storage::storage_mode mode) {
+  for (auto &s : shards_)
+    s->create_atomic_multilog(name, schema, mode);
+}
+
+void rpc_federated_client::set_current_atomic_multilog(const std::string &name) {
+  if (shards_.empty()) {
+    throw illegal_state_exception("Must add a shard first");
+  }
+  for (auto &s : shards_)
+    s->set_current_atomic_multilog(name);
+  std::string schema = shards_[0]->current_schema().to_string();
+  for (size_t i = 1; i < shards_.size(); i++) {
+    if (shards_[i]->current_schema().to_string() != schema) {
+      throw illegal_state_exception("Schema of " + name + " differs across shards");
+    }
+  }
+}
+
+schema_t const &rpc_federated_client::current_schema() const {
+  if (shards_.empty()) {
+    throw illegal_state_exception("Must add a shard first");
+  }
+  return shards_[0]->current_schema();
+}
+
+void rpc_federated_client::remove_atomic_multilog() {
+  for (auto &s : shards_)
+    s->remove_atomic_multilog();
+}
+
+void rpc_federated_client::add_index(const std::string &field_name, const double bucket_size) {
+  for (auto &s : shards_)
+    s->add_index(field_name, bucket_size);
+}
+
+void rpc_federated_client::remove_index(const std::string &field_name) {
+  for (auto &s : shards_)
+    s->remove_index(field_name);
+}
+
+void rpc_federated_client::add_filter(const std::string &filter_name, const std::string &filter_expr) {
+  for (auto &s : shards_)
+    s->add_filter(filter_name, filter_expr);
+}
+
+void rpc_federated_client::remove_filter(const std::string &filter_name) {
+  for (auto &s : shards_)
+    s->remove_filter(filter_name);
+}
+
+void rpc_federated_client::add_aggregate(const std::string &aggregate_name,
+                                         const std::string &filter_name,
+                                         const std::string &aggregate_expr) {
+  for (auto &s : shards_)
+    s->add_aggregate(aggregate_name, filter_name, aggregate_expr);
+}
+
+void rpc_federated_client::remove_aggregate(const std::string &aggregate_name) {
+  for (auto &s : shards_)
+    s->remove_aggregate(aggregate_name);
+}
+
+void rpc_federated_client::install_trigger(const std::string &trigger_name, const std::string &trigger_expr) {
+  for (auto &s : shards_)
+    s->install_trigger(trigger_name, trigger_expr);
+}
+
+void rpc_federated_client::remove_trigger(const std::string &trigger_name) {
+  for (auto &s : shards_)
+    s->remove_trigger(trigger_name);
+}
+
+rpc_record_batch_builder rpc_federated_client::get_batch_builder() const {
+  return rpc_record_batch_builder(current_schema());
+}
+
+void rpc_federated_client::append_batch(const rpc_record_batch &batch) {
+  shards_[next_shard_]->append_batch(batch);
+  next_shard_ = (next_shard_ + 1) % shards_.size();
+}
+
+void rpc_federated_client::append(const std::vector<std::string> &record) {
+  shards_[next_shard_]->append(record);
+  next_shard_ = (next_shard_ + 1) % shards_.size();
+}
+
+numeric rpc_federated_client::get_aggregate(const std::string &aggregate_name, int64_t begin_ms, int64_t end_ms) {
+  if (shards_.empty()) {
+    throw illegal_state_exception("Must add a shard first");
+  }
+  // An empty range holds the aggregate's zero value on every server
+  if (begin_ms > end_ms)
+    return parse_aggregate_result(shards_[0]->get_aggregate(aggregate_name, begin_ms, end_ms));
+  // A single interval spanning the range returns the aggregate in binary form
+  return get_aggregate_series(aggregate_name, begin_ms, end_ms, end_ms - begin_ms + 1).at(0);
+}
+
+std::vector<numeric> rpc_federated_client::get_aggregate_series(const std::string &aggregate_name,
+                                                                int64_t begin_ms,
+                                                                int64_t end_ms,
+                                                                int64_t interval_ms) {
+  // Each server names the aggregator of its aggregate, so aggregates added
+  // by any client can be combined
+  std::vector<numeric> series;
+  std::string agg_name;
+  fan_out([&](rpc_client &s) {
+    s.send_get_aggregate_series(aggregate_name, begin_ms, end_ms, interval_ms);
+  }, [&](size_t i, rpc_client &s) {
+    std::string part_agg_name;
+    std::vector<numeric> part = s.recv_get_aggregate_series(part_agg_name);
+    if (i == 0) {
+      series = std::move(part);
+      agg_name = part_agg_name;
+      return;
+    }
+    if (part_agg_name != agg_name) {
+      throw invalid_operation_exception("Aggregate " + aggregate_name + " uses different aggregators across shards");
+    }
+    if (part.size() != series.size()) {
+      throw invalid_operation_exception("Aggregate " + aggregate_name + " returned " + std::to_string(part.size())
+                                            + " intervals from shard " + std::to_string(i) + ", expected "
+                                            + std::to_string(series.size()));
+    }
+    aggregator agg = aggregate_manager::get_aggregator(agg_name);
+    for (size_t j = 0; j < series.size(); j++)
+      series[j] = agg.comb_op(series[j], part[j]);
+  });
+  return series;
+}
+
+numeric rpc_federated_client::execute_aggregate(const std::string &aggregate_expr, const std::string &filter_expr) {
+  aggregator agg = aggregate_manager::get_aggregator(parser::parse_aggregate(aggregate_expr).agg);
+  numeric result = agg.zero;
+  fan_out([&](rpc_client &s) {
+    s.send_execute_aggregate(aggregate_expr, filter_expr);
+  }, [&](size_t, rpc_client &s) {
+    result = agg.comb_op(result, parse_aggregate_result(s.recv_execute_aggregate()));
+  });
+  return result;
+}
+
+rpc_federated_record_stream rpc_federated_client::execute_filter(const std::string &filter_expr) {
+  std::vector<rpc_record_stream> streams;
+  fan_out([&](rpc_client &s) {
+    s.send_execute_filter(filter_expr);
+  }, [&](size_t, rpc_client &s) {
+    streams.push_back(s.recv_execute_filter());
+  });
+  return rpc_federated_record_stream(std::move(streams));
+}
+
+rpc_federated_record_stream rpc_federated_client::query_filter(const std::string &filter_name,
+                                                               const int64_t begin_ms,
+                                                               const int64_t end_ms) {
+  std::vector<rpc_record_stream> streams;
+  fan_out([&](rpc_client &s) {
+    s.send_query_filter(filter_name, begin_ms, end_ms);
+  }, [&](size_t, rpc_client &s) {
+    streams.push_back(s.recv_query_filter());
+  });
+  return rpc_federated_record_stream(std::move(streams));
+}
+
+rpc_federated_record_stream rpc_federated_client::query_filter(const std::string &filter_name,
+                                                               const int64_t begin_ms,
+                                                               const int64_t end_ms,
+                                                               const std::string &additional_filter_expr) {
+  std::vector<rpc_record_stream> streams;
+  fan_out([&](rpc_client &s) {
+    s.send_query_filter_additional_filter(filter_name, begin_ms, end_ms, additional_filter_expr);
+  }, [&](size_t, rpc_client &s) {
+    streams.push_back(s.recv_query_filter_additional_filter());
+  });
+  return rpc_federated_record_stream(std::move(streams));
+}
+
+rpc_federated_alert_stream rpc_federated_client::get_alerts(const int64_t begin_ms, const int64_t end_ms) {
+  std::vector<rpc_alert_stream> streams;
+  fan_out([&](rpc_client &s) {
+    s.send_get_alerts(begin_ms, end_ms);
+  }, [&](size_t, rpc_client &s) {
+    streams.push_back(s.recv_get_alerts());
+  });
+  return rpc_federated_alert_stream(std::move(streams));
+}
+
+rpc_federated_alert_stream rpc_federated_client::get_alerts(const int64_t begin_ms,
+                                                            const int64_t end_ms,
+                                                            const std::string &trigger_name) {
+  std::vector<rpc_alert_stream> streams;
+  fan_out([&](rpc_client &s) {
+    s.send_get_alerts_by_trigger(begin_ms, end_ms, trigger_name);
+  }, [&](size_t, rpc_client &s) {
+    streams.push_back(s.recv_get_alerts_by_trigger());
+  });
+  return rpc_federated_alert_stream(std::move(streams));
+}
+
+int64_t rpc_federated_client::num_records() {
+  int64_t n = 0;
+  fan_out([](rpc_client &s) {
+    s.send_num_records();
+  }, [&](size_t, rpc_client &s) {
+    n += s.recv_num_records();
+  });
+  return n;
+}
+
+numeric rpc_federated_client::parse_aggregate_result(const std::string &str) {
+  size_t open = str.find('(');
+  size_t close = str.rfind(')');
+  if (open == std::string::npos || close == std::string::npos || close < open) {
+    throw invalid_operation_exception("Malformed aggregate " + str);
+  }
+  data_type type = type_manager::get_type(str.substr(0, open));
+  return numeric::parse(str.substr(open + 1, close - open - 1), type);
+}
+
+}
+}
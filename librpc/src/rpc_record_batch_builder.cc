@@ -16,8 +16,10 @@ rpc_record_batch_builder::rpc_record_batch_builder(const schema_t &schema)
 void rpc_record_batch_builder::add_record(const record_data &rec) {
   int64_t ts = *reinterpret_cast<const int64_t *>(rec.data());
   int64_t time_block = ts / configuration_params::TIME_RESOLUTION_NS();
-  batch_sizes_[time_block] += schema_.record_size();
-  batch_[time_block].write(rec.data(), schema_.record_size());
+  size_t record_size = schema_.inline_record_size(rec.data());
+  batch_sizes_[time_block] += record_size;
+  batch_nrecords_[time_block]++;
+  batch_[time_block].write(rec.data(), record_size);
   nrecords_++;
 }
 void rpc_record_batch_builder::add_record(const std::vector<std::string> &rec) {
@@ -33,7 +35,7 @@ rpc_record_batch rpc_record_batch_builder::get_batch() {
   for (auto &entry : batch_) {
     batch.blocks[i].time_block = entry.first;
     batch.blocks[i].data = entry.second.str();
-    batch.blocks[i].nrecords = static_cast<int64_t>(batch.blocks[i].data.size() / schema_.record_size());
+    batch.blocks[i].nrecords = static_cast<int64_t>(batch_nrecords_[entry.first]);
     i++;
   }
   clear();
@@ -41,6 +43,7 @@ rpc_record_batch rpc_record_batch_builder::get_batch() {
 }
 void rpc_record_batch_builder::clear() {
   batch_sizes_.clear();
+  batch_nrecords_.clear();
   batch_.clear();
   nrecords_ = 0;
 }
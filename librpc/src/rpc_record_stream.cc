@@ -20,7 +20,7 @@ record_t rpc_record_stream::get() {
 
 rpc_record_stream &rpc_record_stream::operator++() {
   if (has_more()) {
-    cur_off_ += schema_.record_size();
+    cur_off_ += schema_.inline_record_size(&handle_.data[cur_off_]);
     if (cur_off_ == handle_.data.size() && handle_.has_more) {
       client_->get_more(handle_, multilog_id_, handle_.desc);
       cur_off_ = 0;
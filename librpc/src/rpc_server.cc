@@ -168,11 +168,23 @@ void rpc_service_handler::read(std::string &_return, int64_t id, const int64_t o
   uint64_t limit;
   read_only_data_log_ptr ptr;
   mlog->read((uint64_t) offset, limit, ptr);
-  data_ptr dptr = ptr.decode();
-  char *data = reinterpret_cast<char *>(dptr.get());
+  const schema_t &schema = mlog->get_schema();
+  if (schema.has_var_columns()) {
+    // Stored records reference the variable-length heap; ship inline records
+    _return.clear();
+    uint64_t end = std::min(limit, static_cast<uint64_t>(offset + nrecords * schema.record_size()));
+    for (uint64_t off = static_cast<uint64_t>(offset); off < end; off += schema.record_size()) {
+      mlog->read(off, ptr);
+      data_ptr dptr = ptr.decode_range(0, schema.record_size());
+      schema.inline_record(_return, schema.apply_unsafe(off, dptr.get()));
+    }
+    return;
+  }
   size_t size = std::min(static_cast<size_t>(limit - offset),
                          static_cast<size_t>(nrecords * mlog->record_size()));
-  _return.assign(data, size);
+  // Decode only the requested records, directly into the response
+  _return.resize(size);
+  ptr.decode(reinterpret_cast<uint8_t *>(&_return[0]), 0, size);
 }
 void rpc_service_handler::query_aggregate(std::string &_return,
                                           int64_t id,
@@ -182,12 +194,34 @@ void rpc_service_handler::query_aggregate(std::string &_return,
   atomic_multilog *m = store_->get_atomic_multilog(id);
   _return = m->get_aggregate(aggregate_name, (uint64_t) begin_ms, (uint64_t) end_ms).to_string();
 }
+void rpc_service_handler::query_aggregate_series(std::string &_return,
+                                                 int64_t id,
+                                                 const std::string &aggregate_name,
+                                                 const int64_t begin_ms,
+                                                 const int64_t end_ms,
+                                                 const int64_t interval_ms) {
+  if (begin_ms < 0 || end_ms < 0 || interval_ms <= 0) {
+    rpc_invalid_operation e;
+    e.msg = "Time range must be non-negative and interval must be positive";
+    throw e;
+  }
+  atomic_multilog *m = store_->get_atomic_multilog(id);
+  try {
+    _return = rpc_type_conversions::convert_series(
+        m->get_aggregate_series(aggregate_name, static_cast<uint64_t>(begin_ms), static_cast<uint64_t>(end_ms),
+                                static_cast<uint64_t>(interval_ms)), m->get_aggregator(aggregate_name).name);
+  } catch (invalid_operation_exception &ex) {
+    rpc_invalid_operation e;
+    e.msg = ex.what();
+    throw e;
+  }
+}
 void rpc_service_handler::adhoc_aggregate(std::string &_return,
                                           int64_t id,
                                           const std::string &aggregate_expr,
                                           const std::string &filter_expr) {
   atomic_multilog *m = store_->get_atomic_multilog(id);
-  _return = m->execute_aggregate(aggregate_expr, filter_expr).to_string();
+  _return = rpc_type_conversions::convert_aggregate(m->execute_aggregate(aggregate_expr, filter_expr));
 }
 void rpc_service_handler::adhoc_filter(rpc_iterator_handle &_return, int64_t id, const std::string &filter_expr) {
   bool success;
@@ -209,7 +243,7 @@ void rpc_service_handler::adhoc_filter(rpc_iterator_handle &_return, int64_t id,
     throw e;
   }
 
-  adhoc_more(_return, mlog->record_size(), it_id);
+  adhoc_more(_return, mlog->get_schema(), it_id);
 }
 void rpc_service_handler::predef_filter(rpc_iterator_handle &_return,
                                         int64_t id,
@@ -226,7 +260,7 @@ void rpc_service_handler::predef_filter(rpc_iterator_handle &_return,
     throw e;
   }
 
-  predef_more(_return, mlog->record_size(), it_id);
+  predef_more(_return, mlog->get_schema(), it_id);
 }
 void rpc_service_handler::combined_filter(rpc_iterator_handle &_return,
                                           int64_t id,
@@ -252,7 +286,7 @@ void rpc_service_handler::combined_filter(rpc_iterator_handle &_return,
     throw e;
   }
 
-  combined_more(_return, mlog->record_size(), it_id);
+  combined_more(_return, mlog->get_schema(), it_id);
 }
 void rpc_service_handler::alerts_by_time(rpc_iterator_handle &_return,
                                          int64_t id,
@@ -294,19 +328,19 @@ void rpc_service_handler::get_more(rpc_iterator_handle &_return, int64_t id, con
     throw ex;
   }
 
-  size_t record_size = store_->get_atomic_multilog(id)->record_size();
+  const schema_t &schema = store_->get_atomic_multilog(id)->get_schema();
 
   switch (desc.type) {
     case rpc_iterator_type::RPC_ADHOC: {
-      adhoc_more(_return, record_size, desc.id);
+      adhoc_more(_return, schema, desc.id);
       break;
     }
     case rpc_iterator_type::RPC_PREDEF: {
-      predef_more(_return, record_size, desc.id);
+      predef_more(_return, schema, desc.id);
       break;
     }
     case rpc_iterator_type::RPC_COMBINED: {
-      combined_more(_return, record_size, desc.id);
+      combined_more(_return, schema, desc.id);
       break;
     }
     case rpc_iterator_type::RPC_ALERTS: {
@@ -323,7 +357,7 @@ int64_t rpc_service_handler::num_records(int64_t id) {
 rpc_iterator_id rpc_service_handler::new_iterator_id() {
   return iterator_id_++;
 }
-void rpc_service_handler::adhoc_more(rpc_iterator_handle &_return, size_t record_size, rpc_iterator_id it_id) {
+void rpc_service_handler::adhoc_more(rpc_iterator_handle &_return, const schema_t &schema, rpc_iterator_id it_id) {
   // Initialize iterator descriptor
   _return.desc.data_type = rpc_data_type::RPC_RECORD;
   _return.desc.handler_id = handler_id_;
@@ -334,11 +368,11 @@ void rpc_service_handler::adhoc_more(rpc_iterator_handle &_return, size_t record
   try {
     auto &res = adhoc_.at(it_id);
     size_t to_read = rpc_configuration_params::ITERATOR_BATCH_SIZE();
-    _return.data.reserve(record_size * to_read);
+    _return.data.reserve(schema.record_size() * to_read);
     size_t i = 0;
     for (; res->has_more() && i < to_read; ++i, res->advance()) {
       record_t rec = res->get();
-      _return.data.append(reinterpret_cast<const char *>(rec.data()), rec.length());
+      schema.inline_record(_return.data, rec);
     }
     _return.num_entries = static_cast<int32_t>(i);
     _return.has_more = res->has_more();
@@ -348,7 +382,7 @@ void rpc_service_handler::adhoc_more(rpc_iterator_handle &_return, size_t record
     throw e;
   }
 }
-void rpc_service_handler::predef_more(rpc_iterator_handle &_return, size_t record_size, rpc_iterator_id it_id) {
+void rpc_service_handler::predef_more(rpc_iterator_handle &_return, const schema_t &schema, rpc_iterator_id it_id) {
   // Initialize iterator descriptor
   _return.desc.data_type = rpc_data_type::RPC_RECORD;
   _return.desc.handler_id = handler_id_;
@@ -359,11 +393,11 @@ void rpc_service_handler::predef_more(rpc_iterator_handle &_return, size_t recor
   try {
     auto &res = predef_.at(it_id);
     size_t to_read = rpc_configuration_params::ITERATOR_BATCH_SIZE();
-    _return.data.reserve(record_size * to_read);
+    _return.data.reserve(schema.record_size() * to_read);
     size_t i = 0;
     for (; res->has_more() && i < to_read; ++i, res->advance()) {
       record_t rec = res->get();
-      _return.data.append(reinterpret_cast<const char *>(rec.data()), rec.length());
+      schema.inline_record(_return.data, rec);
     }
     _return.num_entries = static_cast<int32_t>(i);
     _return.has_more = res->has_more();
@@ -373,7 +407,7 @@ void rpc_service_handler::predef_more(rpc_iterator_handle &_return, size_t recor
     throw e;
   }
 }
-void rpc_service_handler::combined_more(rpc_iterator_handle &_return, size_t record_size, rpc_iterator_id it_id) {
+void rpc_service_handler::combined_more(rpc_iterator_handle &_return, const schema_t &schema, rpc_iterator_id it_id) {
   // Initialize iterator descriptor
   _return.desc.data_type = rpc_data_type::RPC_RECORD;
   _return.desc.handler_id = handler_id_;
@@ -384,11 +418,11 @@ void rpc_service_handler::combined_more(rpc_iterator_handle &_return, size_t rec
   try {
     auto &res = combined_.at(it_id);
     size_t to_read = rpc_configuration_params::ITERATOR_BATCH_SIZE();
-    _return.data.reserve(record_size * to_read);
+    _return.data.reserve(schema.record_size() * to_read);
     size_t i = 0;
     for (; res->has_more() && i < to_read; ++i, res->advance()) {
       record_t rec = res->get();
-      _return.data.append(reinterpret_cast<const char *>(rec.data()), rec.length());
+      schema.inline_record(_return.data, rec);
     }
     _return.num_entries = static_cast<int32_t>(i);
     _return.has_more = res->has_more();
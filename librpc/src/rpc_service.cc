@@ -213,6 +213,18 @@ rpc_service_query_aggregate_result::~rpc_service_query_aggregate_result() throw(
 rpc_service_query_aggregate_presult::~rpc_service_query_aggregate_presult() throw() {
 }
 
+rpc_service_query_aggregate_series_args::~rpc_service_query_aggregate_series_args() throw() {
+}
+
+rpc_service_query_aggregate_series_pargs::~rpc_service_query_aggregate_series_pargs() throw() {
+}
+
+rpc_service_query_aggregate_series_result::~rpc_service_query_aggregate_series_result() throw() {
+}
+
+rpc_service_query_aggregate_series_presult::~rpc_service_query_aggregate_series_presult() throw() {
+}
+
 rpc_service_adhoc_aggregate_args::~rpc_service_adhoc_aggregate_args() throw() {
 }
 
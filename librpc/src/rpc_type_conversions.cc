@@ -1,5 +1,10 @@
 #include "rpc_type_conversions.h"
 
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
 namespace confluo {
 namespace rpc {
 
@@ -46,5 +51,68 @@ rpc_storage_mode rpc_type_conversions::convert_mode(const storage::storage_mode
   return static_cast<rpc_storage_mode>(mode);
 }
 
+std::string rpc_type_conversions::convert_series(const std::vector<numeric> &series,
+                                                 const std::string &aggregator_name) {
+  int32_t type_id = 0;
+  int32_t type_size = 0;
+  if (!series.empty()) {
+    type_id = static_cast<int32_t>(series.front().type().id);
+    type_size = static_cast<int32_t>(series.front().type().size);
+  }
+  int32_t name_size = static_cast<int32_t>(aggregator_name.size());
+  std::string packed;
+  packed.reserve(3 * sizeof(int32_t) + aggregator_name.size() + series.size() * type_size);
+  packed.append(reinterpret_cast<const char *>(&type_id), sizeof(int32_t));
+  packed.append(reinterpret_cast<const char *>(&type_size), sizeof(int32_t));
+  packed.append(reinterpret_cast<const char *>(&name_size), sizeof(int32_t));
+  packed.append(aggregator_name);
+  for (const numeric &n : series) {
+    packed.append(reinterpret_cast<const char *>(n.to_data().ptr), type_size);
+  }
+  return packed;
+}
+
+std::vector<numeric> rpc_type_conversions::convert_series(const std::string &packed) {
+  std::string aggregator_name;
+  return convert_series(packed, aggregator_name);
+}
+
+std::vector<numeric> rpc_type_conversions::convert_series(const std::string &packed, std::string &aggregator_name) {
+  std::vector<numeric> series;
+  aggregator_name.clear();
+  if (packed.size() < 3 * sizeof(int32_t)) {
+    return series;
+  }
+  const char *buf = packed.data();
+  int32_t type_id = *reinterpret_cast<const int32_t *>(buf);
+  int32_t type_size = *reinterpret_cast<const int32_t *>(buf + sizeof(int32_t));
+  int32_t name_size = *reinterpret_cast<const int32_t *>(buf + 2 * sizeof(int32_t));
+  size_t values_off = 3 * sizeof(int32_t) + static_cast<size_t>(std::max(name_size, 0));
+  if (values_off > packed.size()) {
+    return series;
+  }
+  aggregator_name.assign(buf + 3 * sizeof(int32_t), values_off - 3 * sizeof(int32_t));
+  if (type_size <= 0) {
+    return series;
+  }
+  data_type type(static_cast<uint16_t>(type_id), static_cast<size_t>(type_size));
+  for (size_t off = values_off; off + type_size <= packed.size(); off += type_size) {
+    series.push_back(numeric(type, const_cast<char *>(buf + off)));
+  }
+  return series;
+}
+
+std::string rpc_type_conversions::convert_aggregate(const numeric &value) {
+  std::ostringstream ss;
+  if (value.type() == primitive_types::DOUBLE_TYPE()) {
+    ss << std::setprecision(std::numeric_limits<double>::max_digits10) << value.as<double>();
+  } else if (value.type() == primitive_types::FLOAT_TYPE()) {
+    ss << std::setprecision(std::numeric_limits<float>::max_digits10) << value.as<float>();
+  } else {
+    return value.to_string();
+  }
+  return value.type().name() + "(" + ss.str() + ")";
+}
+
 }
 }
\ No newline at end of file
@@ -51,6 +51,7 @@ int _krpc_data_typeValues[] = {
     RPC_FLOAT,
     RPC_DOUBLE,
     RPC_STRING,
+    RPC_VARCHAR,
     RPC_RECORD,
     RPC_ALERT
 };
@@ -68,11 +69,12 @@ const char *_krpc_data_typeNames[] = {
     "RPC_FLOAT",
     "RPC_DOUBLE",
     "RPC_STRING",
+    "RPC_VARCHAR",
     "RPC_RECORD",
     "RPC_ALERT"
 };
 const std::map<int, const char *> _rpc_data_type_VALUES_TO_NAMES
-    (::apache::thrift::TEnumIterator(15, _krpc_data_typeValues, _krpc_data_typeNames),
+    (::apache::thrift::TEnumIterator(16, _krpc_data_typeValues, _krpc_data_typeNames),
      ::apache::thrift::TEnumIterator(-1, NULL, NULL));
 
 std::ostream &operator<<(std::ostream &out, const rpc_data_type val) {
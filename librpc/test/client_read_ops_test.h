@@ -516,6 +516,13 @@ TEST_F(ClientReadOpsTest, FilterAggregateTriggerTest) {
   std::string val8 = client.get_aggregate("agg8", beg, end);
   ASSERT_TRUE("double(26.000000)" == val8);
 
+  // Negative ranges and intervals, and unbounded series, are rejected
+  ASSERT_THROW(client.get_aggregate_series("agg1", -1, end, 1), rpc_invalid_operation);
+  ASSERT_THROW(client.get_aggregate_series("agg1", beg, -1, 1), rpc_invalid_operation);
+  ASSERT_THROW(client.get_aggregate_series("agg1", beg, end, -1), rpc_invalid_operation);
+  ASSERT_THROW(client.get_aggregate_series("agg1", 0, INT64_MAX, 1), rpc_invalid_operation);
+  ASSERT_EQ(static_cast<size_t>(1), client.get_aggregate_series("agg1", beg, end, end - beg + 1).size());
+
   // Test triggers
   sleep(1);  // To make sure all triggers have been evaluated
 
@@ -0,0 +1,126 @@
+#ifndef RPC_TEST_FEDERATED_CLIENT_TEST_H_
+#define RPC_TEST_FEDERATED_CLIENT_TEST_H_
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "confluo_store.h"
+#include "rpc_federated_client.h"
+#include "rpc_server.h"
+#include "rpc_test_utils.h"
+
+using namespace ::confluo::rpc;
+using namespace ::confluo;
+
+class FederatedClientTest : public testing::Test {
+ public:
+  const std::string SERVER_ADDRESS = "127.0.0.1";
+  const int SERVER_PORT1 = 9091;
+  const int SERVER_PORT2 = 9092;
+
+  static std::vector<column_t> schema() {
+    return schema_builder()
+        .add_column(primitive_types::INT_TYPE(), "k")
+        .add_column(primitive_types::LONG_TYPE(), "v")
+        .add_column(primitive_types::DOUBLE_TYPE(), "w")
+        .get_columns();
+  }
+
+  static std::string exact_string(double d) {
+    std::ostringstream ss;
+    ss << std::setprecision(std::numeric_limits<double>::max_digits10) << d;
+    return ss.str();
+  }
+};
+
+TEST_F(FederatedClientTest, FanOutTest) {
+  std::string multilog_name = "my_multilog";
+  auto store1 = new confluo_store("/tmp/fed1");
+  auto store2 = new confluo_store("/tmp/fed2");
+  auto server1 = rpc_server::create(store1, SERVER_ADDRESS, SERVER_PORT1);
+  auto server2 = rpc_server::create(store2, SERVER_ADDRESS, SERVER_PORT2);
+  std::thread serve_thread1([&server1] {
+    server1->serve();
+  });
+  std::thread serve_thread2([&server2] {
+    server2->serve();
+  });
+
+  rpc_test_utils::wait_till_server_ready(SERVER_ADDRESS, SERVER_PORT1);
+  rpc_test_utils::wait_till_server_ready(SERVER_ADDRESS, SERVER_PORT2);
+
+  rpc_federated_client client;
+  client.add_shard(SERVER_ADDRESS, SERVER_PORT1);
+  client.add_shard(SERVER_ADDRESS, SERVER_PORT2);
+  ASSERT_EQ(static_cast<size_t>(2), client.num_shards());
+
+  client.create_atomic_multilog(multilog_name, schema_t(schema()), storage::IN_MEMORY);
+  client.set_current_atomic_multilog(multilog_name);
+  client.add_filter("all", "v >= 0");
+  client.add_aggregate("sum_v", "all", "SUM(v)");
+  client.add_aggregate("max_v", "all", "MAX(v)");
+
+  int64_t now_ms = static_cast<int64_t>(utils::time_utils::cur_ms());
+  int64_t ts = now_ms * static_cast<int64_t>(configuration_params::TIME_RESOLUTION_NS());
+  for (int64_t i = 0; i < 100; i++)
+    client.append({std::to_string(ts), std::to_string(i % 4), std::to_string(i), exact_string(i / 1024.0)});
+
+  ASSERT_EQ(100, client.num_records());
+  ASSERT_EQ(static_cast<size_t>(50), store1->get_atomic_multilog(multilog_name)->num_records());
+  ASSERT_EQ(static_cast<size_t>(50), store2->get_atomic_multilog(multilog_name)->num_records());
+
+  ASSERT_TRUE(numeric(static_cast<int64_t>(99 * 100 / 2)) == client.get_aggregate("sum_v", now_ms, now_ms));
+  ASSERT_TRUE(numeric(static_cast<int64_t>(99)) == client.get_aggregate("max_v", now_ms, now_ms));
+  ASSERT_TRUE(numeric(static_cast<int64_t>(99 * 100 / 2)) == client.execute_aggregate("SUM(v)", "v >= 0"));
+  ASSERT_THROW(client.get_aggregate("none", now_ms, now_ms), rpc_invalid_operation);
+
+  // Aggregates added on the servers directly are combined with their own aggregators
+  store1->get_atomic_multilog(multilog_name)->add_aggregate("min_v", "all", "MIN(v)");
+  store2->get_atomic_multilog(multilog_name)->add_aggregate("min_v", "all", "MIN(v)");
+  ASSERT_TRUE(numeric(static_cast<int64_t>(0)) == client.get_aggregate("min_v", now_ms, now_ms));
+  std::vector<numeric> mins = client.get_aggregate_series("min_v", now_ms - 1, now_ms, 1);
+  ASSERT_EQ(static_cast<size_t>(2), mins.size());
+  ASSERT_TRUE(numeric(static_cast<int64_t>(0)) == mins[1]);
+  store1->get_atomic_multilog(multilog_name)->add_aggregate("mixed_v", "all", "MIN(v)");
+  store2->get_atomic_multilog(multilog_name)->add_aggregate("mixed_v", "all", "MAX(v)");
+  ASSERT_THROW(client.get_aggregate("mixed_v", now_ms, now_ms), invalid_operation_exception);
+
+  size_t count = 0;
+  for (auto s = client.execute_filter("k == 1"); s.has_more(); ++s)
+    count++;
+  ASSERT_EQ(static_cast<size_t>(25), count);
+
+  count = 0;
+  for (auto s = client.query_filter("all", now_ms, now_ms); s.has_more(); ++s)
+    count++;
+  ASSERT_EQ(static_cast<size_t>(100), count);
+
+  count = 0;
+  for (auto s = client.query_filter("all", now_ms, now_ms, "v < 10"); s.has_more(); ++s)
+    count++;
+  ASSERT_EQ(static_cast<size_t>(10), count);
+
+  // A failed fan-out still reads every shard's reply, so later calls work
+  ASSERT_THROW(client.execute_filter("v >>= 1"), rpc_invalid_operation);
+  ASSERT_THROW(client.execute_filter("v >>= 1"), rpc_invalid_operation);
+  ASSERT_EQ(100, client.num_records());
+
+  // Floating-point partials are combined without loss of precision
+  ASSERT_TRUE(numeric(99 * 100 / 2 / 1024.0) == client.execute_aggregate("SUM(w)", "v >= 0"));
+
+  client.remove_atomic_multilog();
+  client.disconnect();
+  server1->stop();
+  server2->stop();
+  if (serve_thread1.joinable()) {
+    serve_thread1.join();
+  }
+  if (serve_thread2.joinable()) {
+    serve_thread2.join();
+  }
+}
+
+#endif /* RPC_TEST_FEDERATED_CLIENT_TEST_H_ */
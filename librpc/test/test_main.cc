@@ -4,6 +4,7 @@
 #include "client_connection_test.h"
 #include "client_read_ops_test.h"
 #include "client_write_ops_test.h"
+#include "federated_client_test.h"
 #include "error_handling.h"
 
 int main(int argc, char **argv) {
@@ -125,8 +125,8 @@ class bit_utils {
         : "r" (x)
     );
 #else
-    while (x >>= 1)
-      ++y;
+    if (x != 0)
+      y = 63 - static_cast<uint32_t>(__builtin_clzll(x));
 #endif
     return y;
   }
@@ -156,6 +156,13 @@ class bit_utils {
     return highest_bit(n) + 1;
   }
 
+  static inline uint64_t reverse_64(uint64_t n) {
+    n = ((n >> 1) & UINT64_C(0x5555555555555555)) | ((n & UINT64_C(0x5555555555555555)) << 1);
+    n = ((n >> 2) & UINT64_C(0x3333333333333333)) | ((n & UINT64_C(0x3333333333333333)) << 2);
+    n = ((n >> 4) & UINT64_C(0x0F0F0F0F0F0F0F0F)) | ((n & UINT64_C(0x0F0F0F0F0F0F0F0F)) << 4);
+    return __builtin_bswap64(n);
+  }
+
   static inline uint8_t popcount_64(uint64_t n) {
     return __builtin_popcountll(n);
   }
@@ -196,8 +196,12 @@ class RpcClient:
         """
         if self.cur_multilog_id_ == -1:
             raise ValueError("Must set atomic multilog first.")
-        if len(data) != self.cur_schema_.record_size_:
-            raise ValueError("Record length must be: {}, is: {}".format(self.cur_schema_.record_size_, len(data)))
+        if len(data) < self.cur_schema_.record_size_:
+            raise ValueError("Record length must be at least: {}, is: {}".format(self.cur_schema_.record_size_,
+                                                                              len(data)))
+        expected_size = self.cur_schema_.inline_record_size(data)
+        if len(data) != expected_size:
+            raise ValueError("Record length must be: {}, is: {}".format(expected_size, len(data)))
         return self.client_.append(self.cur_multilog_id_, data)
 
     def append(self, rec):
@@ -229,7 +233,7 @@ class RpcClient:
         """
         if self.cur_multilog_id_ == -1:
             raise ValueError("Must set atomic multilog first.")
-        return self.client_.read(self.cur_multilog_id_, offset, self.cur_schema_.record_size_)
+        return self.client_.read(self.cur_multilog_id_, offset, 1)
 
     def read(self, offset):
         buf = self.read_raw(offset)
@@ -251,6 +255,25 @@ class RpcClient:
             raise ValueError("Must set atomic multilog first.")
         return self.client_.query_aggregate(self.cur_multilog_id_, aggregate_name, begin_ms, end_ms)
 
+    def get_aggregate_series(self, aggregate_name, begin_ms, end_ms, interval_ms):
+        """ Gets an aggregate from the atomic multilog, downsampled into fixed-width intervals.
+
+        Args:
+            aggregate_name: The name of the aggregate.
+            begin_ms: The beginning time in milliseconds.
+            end_ms: The end time in milliseconds.
+            interval_ms: The width of each interval in milliseconds.
+        Raises:
+            ValueError.
+        Returns:
+            The list of aggregates, one per interval.
+        """
+        if self.cur_multilog_id_ == -1:
+            raise ValueError("Must set atomic multilog first.")
+        packed = self.client_.query_aggregate_series(self.cur_multilog_id_, aggregate_name, begin_ms, end_ms,
+                                                     interval_ms)
+        return type_conversions.convert_to_series(packed)
+
     def execute_filter(self, filter_expr):
         """ Executes a specified filter.
 
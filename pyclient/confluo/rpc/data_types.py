@@ -24,6 +24,7 @@ class TypeID:
     FLOAT = rpc_data_type.RPC_FLOAT
     DOUBLE = rpc_data_type.RPC_DOUBLE
     STRING = rpc_data_type.RPC_STRING
+    VARCHAR = rpc_data_type.RPC_VARCHAR
 
 
 FORMAT_CODES = {
@@ -38,9 +39,24 @@ FORMAT_CODES = {
     TypeID.ULONG: 'Q',
     TypeID.FLOAT: 'f',
     TypeID.DOUBLE: 'd',
-    TypeID.STRING: 's'
+    TypeID.STRING: 's',
+    TypeID.VARCHAR: 'Q'
 }
 
+# A VARCHAR slot holds a reference to the value: its offset in the upper
+# 40 bits and its length in the lower 24 bits (see var_ref.h)
+VAR_REF_LENGTH_BITS = 24
+VAR_REF_MAX_LENGTH = (1 << VAR_REF_LENGTH_BITS) - 1
+
+
+def pack_var_ref(offset, length):
+    return struct.pack('Q', (offset << VAR_REF_LENGTH_BITS) | length)
+
+
+def unpack_var_ref(data):
+    ref = struct.unpack('Q', data)[0]
+    return ref >> VAR_REF_LENGTH_BITS, ref & VAR_REF_MAX_LENGTH
+
 
 def to_string(tid, size):
     if tid == TypeID.NONE:
@@ -69,6 +85,8 @@ def to_string(tid, size):
         return 'DOUBLE'
     elif tid == TypeID.STRING:
         return 'STRING({})'.format(size)
+    elif tid == TypeID.VARCHAR:
+        return 'VARCHAR'
 
 
 class DataType:
@@ -116,6 +134,14 @@ class DataType:
         """
         return not self.__eq__(other)
 
+    def is_var_length(self):
+        """ Checks whether values of the data type vary in length
+
+        Returns:
+            True if the data type is variable-length, false otherwise
+        """
+        return self.type_id_ == TypeID.VARCHAR
+
     def format_code(self):
         """ Get format code corresponding to data type
 
@@ -152,6 +178,7 @@ ULONG_TYPE = DataType(TypeID.ULONG, 8)
 FLOAT_TYPE = DataType(TypeID.FLOAT, 4)
 DOUBLE_TYPE = DataType(TypeID.DOUBLE, 8)
 STRING_TYPE = lambda size: DataType(TypeID.STRING, size)
+VARCHAR_TYPE = DataType(TypeID.VARCHAR, 8)
 
 
 def make_type(t_str):
@@ -178,6 +205,8 @@ def make_type(t_str):
         return FLOAT_TYPE
     elif t_str == 'DOUBLE':
         return DOUBLE_TYPE
+    elif t_str == 'VARCHAR':
+        return VARCHAR_TYPE
     elif m:
         return STRING_TYPE(int(m.group(1)))
     else:
@@ -26,6 +26,7 @@ class Schema:
         self.columns_ = columns
         for c in self.columns_:
             self.record_size_ += c.data_type_.size_
+        self.var_columns_ = [c for c in self.columns_ if c.data_type_.is_var_length()]
 
     def __str__(self):
         """ Convert to string
@@ -43,6 +44,22 @@ class Schema:
         """
         return self.record_size_
 
+    def inline_record_size(self, data, offset=0):
+        """ Get the size of an inline record, i.e., the fixed-size record
+        followed by the values of its VARCHAR columns
+
+        Args:
+            data: The buffer holding the record
+            offset: The offset of the record in the buffer
+        Returns:
+            Inline record size in bytes
+        """
+        size = self.record_size_
+        for c in self.var_columns_:
+            start = offset + c.offset_
+            size += data_types.unpack_var_ref(data[start:start + c.data_type_.size_])[1]
+        return size
+
     def columns(self):
         """ Get list of columns
 
@@ -80,9 +97,18 @@ class Schema:
         else:
             raise ValueError("Record does not conform to schema: incorrect number of fields")
 
+        # VARCHAR values follow the fixed-size record, and are referenced by
+        # their offset from the start of the record
+        var_data = ""
         for f, c in zip(rec[off:], self.columns_[1:]):
-            packed += c.data_type_.pack(f)
-        return packed
+            if c.data_type_.is_var_length():
+                if len(f) > data_types.VAR_REF_MAX_LENGTH:
+                    raise ValueError("Value of {} is too long: {} bytes".format(c.name_, len(f)))
+                packed += data_types.pack_var_ref(self.record_size_ + len(var_data), len(f))
+                var_data += f
+            else:
+                packed += c.data_type_.pack(f)
+        return packed + var_data
 
 
 class Column:
@@ -124,7 +150,11 @@ class Column:
             A field containing the data.
         """
 
-        return Field(self.idx_, self.data_type_, data[self.offset_: self.offset_ + self.data_type_.size_])
+        slot = data[self.offset_: self.offset_ + self.data_type_.size_]
+        if self.data_type_.is_var_length():
+            var_offset, length = data_types.unpack_var_ref(slot)
+            return Field(self.idx_, self.data_type_, data[var_offset: var_offset + length])
+        return Field(self.idx_, self.data_type_, slot)
 
 
 class Record:
@@ -188,6 +218,8 @@ class Field:
             The data in the field.
         """
         tid = self.data_type_.type_id_
+        if tid == TypeID.VARCHAR:
+            return self.data_
         if tid == TypeID.STRING:
             format_code = str(self.data_type_.size_) + data_types.FORMAT_CODES[tid]
         else:
@@ -31,7 +31,7 @@ class RecordStream:
         """
         while self.has_more():
             yield self.schema_.apply(0, self.handle_.data[self.cur_off_:])
-            self.cur_off_ += self.schema_.record_size_
+            self.cur_off_ += self.schema_.inline_record_size(self.handle_.data, self.cur_off_)
             if self.cur_off_ == len(self.handle_.data) and self.handle_.has_more:
                 self.handle_ = self.client_.get_more(self.multilog_id_, self.handle_.desc)
                 self.cur_off_ = 0
@@ -48,6 +48,7 @@ class rpc_data_type(object):
     RPC_FLOAT = 10
     RPC_DOUBLE = 11
     RPC_STRING = 12
+    RPC_VARCHAR = 10000
     RPC_RECORD = 10001
     RPC_ALERT = 10002
 
@@ -65,6 +66,7 @@ class rpc_data_type(object):
         10: "RPC_FLOAT",
         11: "RPC_DOUBLE",
         12: "RPC_STRING",
+        10000: "RPC_VARCHAR",
         10001: "RPC_RECORD",
         10002: "RPC_ALERT",
     }
@@ -83,6 +85,7 @@ class rpc_data_type(object):
         "RPC_FLOAT": 10,
         "RPC_DOUBLE": 11,
         "RPC_STRING": 12,
+        "RPC_VARCHAR": 10000,
         "RPC_RECORD": 10001,
         "RPC_ALERT": 10002,
     }
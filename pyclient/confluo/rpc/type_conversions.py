@@ -1,3 +1,5 @@
+import struct
+
 from data_types import DataType
 from schema import SchemaBuilder, Schema
 from ttypes import rpc_column
@@ -30,3 +32,23 @@ def convert_to_schema(rpc_schema):
     for column in rpc_schema:
         builder.add_column(DataType(column.type_id, column.type_size), column.name)
     return Schema(builder.build())
+
+
+def convert_to_series(packed):
+    """ Converts a packed array of aggregate values to a list.
+
+    Args:
+        packed: The packed array, i.e., the type id and type size of the
+            values and the length of the aggregator name as 32-bit
+            integers, the aggregator name, then the values.
+    Returns:
+        The list of aggregate values.
+    """
+    if len(packed) < 12:
+        return []
+    type_id, type_size, name_size = struct.unpack('iii', packed[:12])
+    if type_size <= 0:
+        return []
+    code = DataType(type_id, type_size).format_code()
+    start = 12 + max(name_size, 0)
+    return [struct.unpack(code, packed[off:off + type_size])[0] for off in range(start, len(packed), type_size)]
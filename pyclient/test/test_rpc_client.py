@@ -77,6 +77,35 @@ class TestRpcClient(unittest.TestCase):
         self.read_write(StorageMode.DURABLE_RELAXED)
         self.read_write(StorageMode.DURABLE)
 
+    def test_varchar_read_write(self):
+        self.start_server()
+        client = RpcClient("127.0.0.1", 9090)
+
+        try:
+            client.create_atomic_multilog("my_multilog", '{ a: INT, url: VARCHAR, ua: VARCHAR }',
+                                          StorageMode.IN_MEMORY)
+            client.append([1, "http://example.com/a", "curl"])
+            client.append([2, "", "mozilla/5.0"])
+            rec = client.read(0)
+            self.assertTrue(rec[1] == 1)
+            self.assertTrue(rec[2] == "http://example.com/a")
+            self.assertTrue(rec[3] == "curl")
+
+            i = 0
+            for record in client.execute_filter("a > 0"):
+                self.assertTrue(record[1] in (1, 2))
+                if record[1] == 2:
+                    self.assertTrue(record[2] == "")
+                    self.assertTrue(record[3] == "mozilla/5.0")
+                i += 1
+            self.assertTrue(i == 2)
+        except:
+            self.stop_server()
+            raise
+
+        client.disconnect()
+        self.stop_server()
+
     def test_execute_filter(self):
 
         self.start_server()
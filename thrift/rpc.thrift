@@ -22,6 +22,7 @@ enum rpc_data_type {
   RPC_FLOAT = 10,
   RPC_DOUBLE = 11,
   RPC_STRING = 12,
+  RPC_VARCHAR = 10000,
   RPC_RECORD = 10001,
   RPC_ALERT = 10002
 }
@@ -127,6 +128,8 @@ service rpc_service {
   // Query op
   string query_aggregate(1: i64 mid, 2: string aggregate_name, 3: i64 beg_ms, 4: i64 end_ms)
           throws (1: rpc_invalid_operation ex),
+  binary query_aggregate_series(1: i64 mid, 2: string aggregate_name, 3: i64 beg_ms, 4: i64 end_ms, 5: i64 interval_ms)
+          throws (1: rpc_invalid_operation ex),
   string adhoc_aggregate(1: i64 mid, 2: string aggregate_expr, 3: string filter_ex)
           throws (1: rpc_invalid_operation ex),
   rpc_iterator_handle adhoc_filter(1: i64 mid, 2: string filter_ex)